@@ -3,107 +3,142 @@
 
 #include <samurai/cell_array.hpp>
 #include <samurai/cell_list.hpp>
+#include <samurai/sorted_cell_list.hpp>
 
-static void BM_CellListConstruction_2D(benchmark::State& state)
+template <class CellList>
+void add_random_cells(CellList& cl, std::size_t n_cells)
 {
-    constexpr std::size_t dim = 2;
+    constexpr std::size_t dim = CellList::dim;
 
     std::size_t min_level = 1;
     std::size_t max_level = 12;
 
-    samurai::CellList<dim> cl;
-
-    for (auto _ : state)
+    for (std::size_t s = 0; s < n_cells; ++s)
     {
-        for (std::size_t s = 0; s < state.range(0); ++s)
-        {
-            auto level = std::experimental::randint(min_level, max_level);
-            auto x     = std::experimental::randint(0, (100 << level) - 1);
-            auto y     = std::experimental::randint(0, (100 << level) - 1);
+        auto level = std::experimental::randint(min_level, max_level);
+        auto x     = std::experimental::randint(0, (100 << level) - 1);
+        auto y     = std::experimental::randint(0, (100 << level) - 1);
 
+        if constexpr (dim == 2)
+        {
             cl[level][{y}].add_point(x);
         }
+        else
+        {
+            auto z = std::experimental::randint(0, (100 << level) - 1);
+            cl[level][{y, z}].add_point(x);
+        }
     }
 }
 
-BENCHMARK(BM_CellListConstruction_2D)->Range(8, 8 << 18);
-
-static void BM_CellListConstruction_3D(benchmark::State& state)
+// Only the CellList is timed alone: the insertions in a SortedCellList are
+// plain push_backs, its normalization is timed by the conversion below.
+template <class CellList>
+static void BM_CellListConstruction_2D(benchmark::State& state)
 {
-    constexpr std::size_t dim = 3;
+    CellList cl;
 
-    std::size_t min_level = 1;
-    std::size_t max_level = 12;
+    for (auto _ : state)
+    {
+        add_random_cells(cl, static_cast<std::size_t>(state.range(0)));
+    }
+}
 
-    samurai::CellList<dim> cl;
+BENCHMARK_TEMPLATE(BM_CellListConstruction_2D, samurai::CellList<2>)->Range(8, 8 << 18);
+
+template <class CellList>
+static void BM_CellListConstruction_3D(benchmark::State& state)
+{
+    CellList cl;
 
     for (auto _ : state)
     {
-        for (std::size_t s = 0; s < state.range(0); ++s)
-        {
-            auto level = std::experimental::randint(min_level, max_level);
-            auto x     = std::experimental::randint(0, (100 << level) - 1);
-            auto y     = std::experimental::randint(0, (100 << level) - 1);
-            auto z     = std::experimental::randint(0, (100 << level) - 1);
-
-            cl[level][{y, z}].add_point(x);
-        }
+        add_random_cells(cl, static_cast<std::size_t>(state.range(0)));
     }
 }
 
-BENCHMARK(BM_CellListConstruction_3D)->Range(8, 8 << 18);
+BENCHMARK_TEMPLATE(BM_CellListConstruction_3D, samurai::CellList<3>)->Range(8, 8 << 18);
 
+template <class CellList>
 static void BM_CellList2CellArray_2D(benchmark::State& state)
 {
     constexpr std::size_t dim = 2;
 
-    std::size_t min_level = 1;
-    std::size_t max_level = 12;
-
-    samurai::CellList<dim> cl;
+    CellList cl;
+    CellList cl_copy;
     samurai::CellArray<dim> ca;
 
-    for (std::size_t s = 0; s < state.range(0); ++s)
-    {
-        auto level = std::experimental::randint(min_level, max_level);
-        auto x     = std::experimental::randint(0, (100 << level) - 1);
-        auto y     = std::experimental::randint(0, (100 << level) - 1);
-
-        cl[level][{y}].add_point(x);
-    }
+    add_random_cells(cl, static_cast<std::size_t>(state.range(0)));
 
     for (auto _ : state)
     {
-        ca = {cl};
+        // Fresh copy of the list: the normalization of a SortedCellList is cached after a conversion
+        state.PauseTiming();
+        cl_copy = cl;
+        state.ResumeTiming();
+        ca = {cl_copy};
     }
 }
 
-BENCHMARK(BM_CellList2CellArray_2D)->Range(8, 8 << 18);
+BENCHMARK_TEMPLATE(BM_CellList2CellArray_2D, samurai::CellList<2>)->Range(8, 8 << 18);
+BENCHMARK_TEMPLATE(BM_CellList2CellArray_2D, samurai::SortedCellList<2>)->Range(8, 8 << 18);
 
+template <class CellList>
 static void BM_CellList2CellArray_3D(benchmark::State& state)
 {
     constexpr std::size_t dim = 3;
 
-    std::size_t min_level = 1;
-    std::size_t max_level = 12;
-
-    samurai::CellList<dim> cl;
+    CellList cl;
+    CellList cl_copy;
     samurai::CellArray<dim> ca;
 
-    for (std::size_t s = 0; s < state.range(0); ++s)
+    add_random_cells(cl, static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
     {
-        auto level = std::experimental::randint(min_level, max_level);
-        auto x     = std::experimental::randint(0, (100 << level) - 1);
-        auto y     = std::experimental::randint(0, (100 << level) - 1);
-        auto z     = std::experimental::randint(0, (100 << level) - 1);
+        // Fresh copy of the list: the normalization of a SortedCellList is cached after a conversion
+        state.PauseTiming();
+        cl_copy = cl;
+        state.ResumeTiming();
+        ca = {cl_copy};
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_CellList2CellArray_3D, samurai::CellList<3>)->Range(8, 8 << 18);
+BENCHMARK_TEMPLATE(BM_CellList2CellArray_3D, samurai::SortedCellList<3>)->Range(8, 8 << 18);
+
+// The sorted cell list is normalized once and then cached: the whole
+// construction + conversion must be timed to compare both lists.
+template <class CellList>
+static void BM_CellListConstructionAndConversion_2D(benchmark::State& state)
+{
+    constexpr std::size_t dim = 2;
 
-        cl[level][{y, z}].add_point(x);
+    for (auto _ : state)
+    {
+        CellList cl;
+        add_random_cells(cl, static_cast<std::size_t>(state.range(0)));
+        samurai::CellArray<dim> ca = {cl};
+        benchmark::DoNotOptimize(ca);
     }
+}
+
+BENCHMARK_TEMPLATE(BM_CellListConstructionAndConversion_2D, samurai::CellList<2>)->Range(8, 8 << 18);
+BENCHMARK_TEMPLATE(BM_CellListConstructionAndConversion_2D, samurai::SortedCellList<2>)->Range(8, 8 << 18);
+
+template <class CellList>
+static void BM_CellListConstructionAndConversion_3D(benchmark::State& state)
+{
+    constexpr std::size_t dim = 3;
 
     for (auto _ : state)
     {
-        ca = {cl};
+        CellList cl;
+        add_random_cells(cl, static_cast<std::size_t>(state.range(0)));
+        samurai::CellArray<dim> ca = {cl};
+        benchmark::DoNotOptimize(ca);
     }
 }
 
-BENCHMARK(BM_CellList2CellArray_3D)->Range(8, 8 << 18);
+BENCHMARK_TEMPLATE(BM_CellListConstructionAndConversion_3D, samurai::CellList<3>)->Range(8, 8 << 18);
+BENCHMARK_TEMPLATE(BM_CellListConstructionAndConversion_3D, samurai::SortedCellList<3>)->Range(8, 8 << 18);
@@ -0,0 +1,112 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Imbalance of an adapted mesh before and after load balancing.
+//
+//     mpirun -np 4 ./bench_load_balancing [min_level] [max_level]
+//
+// The mesh is refined around an off-centre disc, so that the subdomains of
+// the initial partition get very different numbers of cells.
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <samurai/algorithm/update.hpp>
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/load_balancing.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/samurai.hpp>
+
+template <class Field>
+double ghost_update_time(Field& u, std::size_t nb_updates)
+{
+#ifdef SAMURAI_WITH_MPI
+    mpi::communicator world;
+    world.barrier();
+#endif
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < nb_updates; ++n)
+    {
+        samurai::update_ghost_mr(u);
+    }
+#ifdef SAMURAI_WITH_MPI
+    world.barrier();
+#endif
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(nb_updates);
+}
+
+template <class Mesh>
+void print_loads(const std::string& title, const Mesh& mesh)
+{
+    int rank = 0;
+#ifdef SAMURAI_WITH_MPI
+    mpi::communicator world;
+    rank = world.rank();
+#endif
+    std::cout << fmt::format("[{}] {}: {} cells\n", rank, title, mesh.nb_cells(Mesh::mesh_id_t::cells)) << std::flush;
+}
+
+int main(int argc, char* argv[])
+{
+    samurai::initialize(argc, argv);
+
+    constexpr std::size_t dim = 2;
+    using Config              = samurai::MRConfig<dim>;
+
+    const std::size_t min_level  = argc > 1 ? std::stoul(argv[1]) : 4;
+    const std::size_t max_level  = argc > 2 ? std::stoul(argv[2]) : 9;
+    const std::size_t nb_updates = 20;
+
+    int rank = 0;
+#ifdef SAMURAI_WITH_MPI
+    mpi::communicator world;
+    rank = world.rank();
+#endif
+
+    const samurai::Box<double, dim> box({0., 0.}, {1., 1.});
+    samurai::MRMesh<Config> mesh{box, min_level, max_level};
+
+    auto u = samurai::make_field<double, 1>("u", mesh);
+    samurai::for_each_cell(mesh,
+                           [&](auto& cell)
+                           {
+                               auto center         = cell.center();
+                               const double radius = .15;
+                               const double dx     = center[0] - .2;
+                               const double dy     = center[1] - .2;
+                               u[cell]             = (dx * dx + dy * dy <= radius * radius) ? 1. : 0.;
+                           });
+    samurai::make_bc<samurai::Dirichlet<1>>(u, 0.);
+
+    auto MRadaptation = samurai::make_MRAdapt(u);
+    MRadaptation(1e-4, 1.);
+
+    print_loads("before", mesh);
+    const double imbalance_before = samurai::load_imbalance(mesh);
+    const double time_before      = ghost_update_time(u, nb_updates);
+
+    auto start = std::chrono::steady_clock::now();
+    samurai::load_balance(u);
+    const double balance_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    print_loads("after", mesh);
+    const double imbalance_after = samurai::load_imbalance(mesh);
+    const double time_after      = ghost_update_time(u, nb_updates);
+
+    if (rank == 0)
+    {
+        std::cout << fmt::format("imbalance (max / mean): {:.3f} -> {:.3f}\n", imbalance_before, imbalance_after);
+        std::cout << fmt::format("ghost update: {:.3e} s -> {:.3e} s\n", time_before, time_after);
+        std::cout << fmt::format("load balancing: {:.3e} s\n", balance_time);
+    }
+
+    samurai::finalize();
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include <array>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include <xtensor/xtensor.hpp>
+#include <xtensor/xview.hpp>
+
+#include <samurai/numeric/prediction.hpp>
+#include <samurai/numeric/simd_kernels.hpp>
+#include <samurai/samurai_config.hpp>
+
+using interval_t = samurai::default_config::interval_t;
+
+/// Lengths of the intervals of an adapted mesh: geometric distribution of
+/// given mean, that is a lot of short intervals and a few long ones.
+static std::vector<int> interval_lengths(std::size_t n_cells, double mean_length)
+{
+    std::mt19937 gen(0);
+    std::geometric_distribution<int> dist(1. / mean_length);
+
+    std::vector<int> lengths;
+    std::size_t n = 0;
+    while (n < n_cells)
+    {
+        int length = 1 + dist(gen);
+        lengths.push_back(length);
+        n += static_cast<std::size_t>(length);
+    }
+    return lengths;
+}
+
+/// Contiguous intervals of the coarse level separated by a halo of 2 cells.
+static std::vector<interval_t> make_intervals(const std::vector<int>& lengths)
+{
+    std::vector<interval_t> intervals;
+    int start = 2;
+    for (auto length : lengths)
+    {
+        intervals.push_back({start, start + length});
+        start += length + 4;
+    }
+    return intervals;
+}
+
+/// Access to a 1d array with the signature of a field
+struct array_field
+{
+    auto operator()(std::size_t, const interval_t& i) const
+    {
+        return xt::view(data, xt::range(i.start, i.end, i.step));
+    }
+
+    xt::xtensor<double, 1>& data;
+};
+
+constexpr std::size_t n_cells = 1 << 16;
+
+template <std::size_t dim>
+static void BM_Projection_xtensor(benchmark::State& state)
+{
+    constexpr std::size_t n_rows = 1 << (dim - 1);
+    auto intervals               = make_intervals(interval_lengths(n_cells, static_cast<double>(state.range(0))));
+    auto size                    = static_cast<std::size_t>(intervals.back().end + 2);
+
+    xt::xtensor<double, 1> dest = xt::zeros<double>({size});
+    std::array<xt::xtensor<double, 1>, n_rows> fine;
+    for (auto& row : fine)
+    {
+        row = xt::ones<double>({2 * size});
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& i : intervals)
+        {
+            auto even = xt::range(2 * i.start, 2 * i.end, 2);
+            auto odd  = xt::range(2 * i.start + 1, 2 * i.end + 1, 2);
+            if constexpr (dim == 1)
+            {
+                xt::view(dest, xt::range(i.start, i.end)) = .5 * (xt::view(fine[0], even) + xt::view(fine[0], odd));
+            }
+            else if constexpr (dim == 2)
+            {
+                xt::view(dest, xt::range(i.start, i.end)) = .25
+                                                          * (xt::view(fine[0], even) + xt::view(fine[1], even) + xt::view(fine[0], odd)
+                                                             + xt::view(fine[1], odd));
+            }
+            else
+            {
+                xt::view(dest, xt::range(i.start, i.end)) = .125
+                                                          * (xt::view(fine[0], even) + xt::view(fine[0], odd) + xt::view(fine[1], even)
+                                                             + xt::view(fine[1], odd) + xt::view(fine[2], even) + xt::view(fine[2], odd)
+                                                             + xt::view(fine[3], even) + xt::view(fine[3], odd));
+            }
+        }
+        benchmark::DoNotOptimize(dest.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n_cells));
+}
+
+template <std::size_t dim>
+static void BM_Projection_simd(benchmark::State& state)
+{
+    constexpr std::size_t n_rows = 1 << (dim - 1);
+    auto intervals               = make_intervals(interval_lengths(n_cells, static_cast<double>(state.range(0))));
+    auto size                    = static_cast<std::size_t>(intervals.back().end + 2);
+
+    std::vector<double> dest(size, 0.);
+    std::array<std::vector<double>, n_rows> fine;
+    fine.fill(std::vector<double>(2 * size, 1.));
+
+    for (auto _ : state)
+    {
+        for (const auto& i : intervals)
+        {
+            std::array<const double*, n_rows> rows;
+            for (std::size_t r = 0; r < n_rows; ++r)
+            {
+                rows[r] = fine[r].data() + 2 * i.start;
+            }
+            samurai::simd::projection<dim>(dest.data() + i.start, rows, i.size());
+        }
+        benchmark::DoNotOptimize(dest.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n_cells));
+    state.SetLabel(samurai::simd::instruction_set());
+}
+
+// Prediction of the children of the coarse intervals (prediction_op with dest_on_level = true)
+template <std::size_t order>
+static void BM_Prediction_xtensor(benchmark::State& state)
+{
+    auto intervals = make_intervals(interval_lengths(n_cells, static_cast<double>(state.range(0))));
+    auto size      = static_cast<std::size_t>(intervals.back().end + 2);
+
+    xt::xtensor<double, 1> coarse = xt::ones<double>({size});
+    xt::xtensor<double, 1> fine   = xt::zeros<double>({2 * size});
+    array_field src{coarse};
+    array_field dest{fine};
+
+    for (auto _ : state)
+    {
+        for (const auto& i : intervals)
+        {
+            auto ii = i << 1;
+            ii.step = 2;
+
+            auto qs_i = samurai::Qs_i<order>(src, 0, i);
+
+            dest(1, ii)     = src(0, i) + qs_i;
+            dest(1, ii + 1) = src(0, i) - qs_i;
+        }
+        benchmark::DoNotOptimize(fine.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n_cells));
+}
+
+template <std::size_t order>
+static void BM_Prediction_simd(benchmark::State& state)
+{
+    auto intervals = make_intervals(interval_lengths(n_cells, static_cast<double>(state.range(0))));
+    auto size      = static_cast<std::size_t>(intervals.back().end + 2);
+
+    std::vector<double> coarse(size, 1.);
+    std::vector<double> fine(2 * size, 0.);
+
+    for (auto _ : state)
+    {
+        for (const auto& i : intervals)
+        {
+            samurai::simd::prediction_stencil<1, order> stencil;
+            stencil.build(
+                [&](int start, int, const std::array<int, 0>&)
+                {
+                    return coarse.data() + start;
+                },
+                i.start,
+                i.end);
+            stencil.apply(fine.data() + 2 * i.start, static_cast<const double*>(nullptr), 2 * i.start, 2 * i.end, {});
+        }
+        benchmark::DoNotOptimize(fine.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n_cells));
+    state.SetLabel(samurai::simd::instruction_set());
+}
+
+// The argument is the mean length of the intervals
+BENCHMARK_TEMPLATE(BM_Projection_xtensor, 1)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_Projection_simd, 1)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_Projection_xtensor, 2)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_Projection_simd, 2)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_Projection_xtensor, 3)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_Projection_simd, 3)->RangeMultiplier(4)->Range(4, 256);
+
+BENCHMARK_TEMPLATE(BM_Prediction_xtensor, 1)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_Prediction_simd, 1)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_Prediction_xtensor, 2)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(BM_Prediction_simd, 2)->RangeMultiplier(4)->Range(4, 256);
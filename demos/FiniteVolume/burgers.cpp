@@ -112,10 +112,7 @@ int main_dim(int argc, char* argv[])
     Box box(box_corner1, box_corner2);
     samurai::MRMesh<Config> mesh{box, min_level, max_level};
 
-    auto u    = samurai::make_field<field_size>("u", mesh);
-    auto u1   = samurai::make_field<field_size>("u1", mesh);
-    auto u2   = samurai::make_field<field_size>("u2", mesh);
-    auto unp1 = samurai::make_field<field_size>("unp1", mesh);
+    auto u = samurai::make_field<field_size>("u", mesh);
 
     // Initial solution
     if (dim == 1 && init_sol == "linear")
@@ -212,12 +209,12 @@ int main_dim(int argc, char* argv[])
         }
     }
 
-    u1.copy_bc_from(u);
-    u2.copy_bc_from(u);
-
     double cst = dim == 1 ? 0.5 : 1; // if dim == 1, we want f(u) = (1/2)*u^2
     auto conv  = cst * samurai::make_convection_weno5<decltype(u)>();
 
+    // RK3 time scheme
+    samurai::ExplicitRungeKutta<decltype(u)> rk3(samurai::RungeKuttaMethod::SSPRK3);
+
     //--------------------//
     //   Time iteration   //
     //--------------------//
@@ -250,9 +247,6 @@ int main_dim(int argc, char* argv[])
 
         // Mesh adaptation
         MRadaptation(mr_epsilon, mr_regularity);
-        u1.resize();
-        u2.resize();
-        unp1.resize();
 
         // Boundary conditions
         if (dim == 1 && init_sol == "linear")
@@ -265,16 +259,8 @@ int main_dim(int argc, char* argv[])
                                                     });
         }
 
-        // RK3 time scheme
-        samurai::update_ghost_mr(u);
-        u1 = u - dt * conv(u);
-        samurai::update_ghost_mr(u1);
-        u2 = 3. / 4 * u + 1. / 4 * (u1 - dt * conv(u1));
-        samurai::update_ghost_mr(u2);
-        unp1 = 1. / 3 * u + 2. / 3 * (u2 - dt * conv(u2));
-
-        // u <-- unp1
-        std::swap(u.array(), unp1.array());
+        // Time step
+        rk3.step(conv, u, dt);
 
         // Save the result
         // if (t >= static_cast<double>(nsave + 1) * dt_save || t == Tf)
@@ -79,6 +79,7 @@ int main(int argc, char* argv[])
     double Tf            = 1.;
     double dt            = Tf / 100;
     bool explicit_scheme = false;
+    bool matrix_free     = false;
     double cfl           = 0.95;
 
     // Multiresolution parameters
@@ -98,6 +99,8 @@ int main(int argc, char* argv[])
     app.add_option("--init-sol", init_sol, "Initial solution: dirac/crenel")->capture_default_str()->group("Simulation parameters");
     app.add_option("--diff-coeff", diff_coeff, "Diffusion coefficient")->capture_default_str()->group("Simulation parameters");
     app.add_flag("--explicit", explicit_scheme, "Explicit scheme instead of implicit")->group("Simulation parameters");
+    app.add_flag("--matrix-free", matrix_free, "Implicit scheme applied without assembling its matrix (e.g. with -pc_type jacobi)")
+        ->group("Simulation parameters");
     app.add_option("--Tf", Tf, "Final time")->capture_default_str()->group("Simulation parameters");
     app.add_option("--dt", dt, "Time step")->capture_default_str()->group("Simulation parameters");
     app.add_option("--cfl", cfl, "The CFL")->capture_default_str()->group("Simulation parameters");
@@ -188,6 +191,14 @@ int main(int argc, char* argv[])
         dt        = cfl * (dx * dx) / (pow(2, dim) * diff_coeff);
     }
 
+    // The solver is kept from one time step to the next: its matrix is only
+    // rebuilt when the mesh changes, and refreshed otherwise (dt may change)
+    auto back_euler = id + dt * diff;
+    auto solver     = samurai::petsc::make_solver(back_euler);
+    solver.refresh_matrix_if(true);
+    solver.reuse_preconditioner(10);
+    solver.matrix_free_if(matrix_free);
+
     auto MRadaptation = samurai::make_MRAdapt(u);
     MRadaptation(mr_epsilon, mr_regularity);
 
@@ -220,8 +231,8 @@ int main(int argc, char* argv[])
         }
         else
         {
-            auto back_euler = id + dt * diff;
-            samurai::petsc::solve(back_euler, unp1, u); // solves the linear equation   [Id + dt*Diff](unp1) = u
+            back_euler = id + dt * diff;
+            solver.solve(unp1, u); // solves the linear equation   [Id + dt*Diff](unp1) = u
         }
 
         // u <-- unp1
@@ -260,6 +271,7 @@ int main(int argc, char* argv[])
         save(path, filename, u);
     }
 
+    solver.destroy_petsc_objects();
     PetscFinalize();
 
     samurai::finalize();
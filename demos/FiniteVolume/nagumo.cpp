@@ -201,6 +201,11 @@ int main(int argc, char* argv[])
 
     auto rhs = samurai::make_field<1>("rhs", mesh);
 
+    // The solver of the implicit diffusion is kept from one time step to the
+    // next: its matrix is only rebuilt when the mesh changes
+    auto implicit_diffusion = id + dt * diff;
+    auto diffusion_solver   = samurai::petsc::make_solver(implicit_diffusion);
+
     double t = 0;
     while (t != Tf)
     {
@@ -210,6 +215,9 @@ int main(int argc, char* argv[])
         {
             dt += Tf - t;
             t = Tf;
+            // The matrix depends on dt
+            implicit_diffusion = id + dt * diff;
+            diffusion_solver.refresh_matrix_if(true);
         }
         std::cout << fmt::format("iteration {}: t = {:.2f}, dt = {}", nt++, t, dt) << std::flush;
 
@@ -226,10 +234,9 @@ int main(int argc, char* argv[])
         else if (!explicit_diffusion && explicit_reaction)
         {
             // u_np1 + dt*diff(u_np1) = u + dt*react(u)
-            auto implicit_operator = id + dt * diff;
-            rhs                    = u + dt * react(u);
+            rhs = u + dt * react(u);
             // Solve the linear equation   [Id + dt*Diff](unp1) = rhs
-            samurai::petsc::solve(implicit_operator, unp1, rhs);
+            diffusion_solver.solve(unp1, rhs);
         }
         else if (explicit_diffusion && !explicit_reaction)
         {
@@ -286,6 +293,7 @@ int main(int argc, char* argv[])
         save(path, filename, u);
     }
 
+    diffusion_solver.destroy_petsc_objects();
     PetscFinalize();
 
     samurai::finalize();
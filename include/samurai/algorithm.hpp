@@ -116,6 +116,19 @@ namespace samurai
             });
     }
 
+    template <std::size_t dim, class TInterval>
+    class MaterializedSubset;
+
+    template <class Func, std::size_t dim, class TInterval>
+    inline void for_each_interval(const MaterializedSubset<dim, TInterval>& set, Func&& f)
+    {
+        set(
+            [&](const auto& i, const auto& index)
+            {
+                f(set.level(), i, index);
+            });
+    }
+
     //////////////////////////////////////////
     // for_each_meshinterval implementation //
     //////////////////////////////////////////
@@ -159,19 +172,35 @@ namespace samurai
     template <class MeshIntervalType, class SetType, class Func>
     inline void parallel_for_each_meshinterval(SetType& set, Func&& f)
     {
-#pragma omp parallel
-#pragma omp single nowait
-        set(
-            [&](const auto& i, const auto& index)
-            {
-#pragma omp task
+        if constexpr (SetType::dim > 1)
+        {
+            // The rows of the outermost dimension are split in balanced chunks
+            // traversed by the threads
+            set.parallel_apply(
+                [&](const auto& i, const auto& index)
                 {
                     MeshIntervalType mesh_interval(set.level());
                     mesh_interval.i     = i;
                     mesh_interval.index = index;
                     f(mesh_interval);
-                }
-            });
+                });
+        }
+        else
+        {
+#pragma omp parallel
+#pragma omp single nowait
+            set(
+                [&](const auto& i, const auto& index)
+                {
+#pragma omp task
+                    {
+                        MeshIntervalType mesh_interval(set.level());
+                        mesh_interval.i     = i;
+                        mesh_interval.index = index;
+                        f(mesh_interval);
+                    }
+                });
+        }
     }
 
     template <class MeshIntervalType, bool parallel, class SetType, class Func>
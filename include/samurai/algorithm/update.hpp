@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <xtensor/xfixed.hpp>
 
 #include "../bc.hpp"
 #include "../mr/operators.hpp"
 #include "../numeric/prediction.hpp"
 #include "../numeric/projection.hpp"
+#include "../profiling.hpp"
 #include "../subset/subset_op.hpp"
 #include "utils.hpp"
 
@@ -33,14 +36,28 @@ namespace samurai
 
         for (std::size_t level = max_level; level >= 1; --level)
         {
-            auto set_at_levelm1 = intersection(mesh[mesh_id_t::proj_cells][level], mesh[mesh_id_t::reference][level - 1]).on(level - 1);
+            auto& set_at_levelm1 = mesh.subset_plan("update_ghost/projection",
+                                                    level - 1,
+                                                    [&]()
+                                                    {
+                                                        return intersection(mesh[mesh_id_t::proj_cells][level],
+                                                                            mesh[mesh_id_t::reference][level - 1])
+                                                            .on(level - 1);
+                                                    });
             set_at_levelm1.apply_op(variadic_projection(field, fields...));
         }
 
         update_bc(0, field, fields...);
         for (std::size_t level = mesh[mesh_id_t::reference].min_level(); level <= max_level; ++level)
         {
-            auto set_at_level = intersection(mesh[mesh_id_t::pred_cells][level], mesh[mesh_id_t::reference][level - 1]).on(level);
+            auto& set_at_level = mesh.subset_plan("update_ghost/prediction",
+                                                  level,
+                                                  [&]()
+                                                  {
+                                                      return intersection(mesh[mesh_id_t::pred_cells][level],
+                                                                          mesh[mesh_id_t::reference][level - 1])
+                                                          .on(level);
+                                                  });
             set_at_level.apply_op(variadic_prediction<pred_order, false>(field, fields...));
             update_bc(level, field, fields...);
         }
@@ -85,12 +102,20 @@ namespace samurai
         }
     }
 
+    /**
+     * Updates the ghosts of the levels from_level and above only: the values
+     * of the finer levels are projected down to from_level, and the ghosts
+     * of from_level which are predicted from the coarser levels are kept as
+     * they are. from_level must be the same on all the processes.
+     */
     template <class Field, class... Fields>
-    void update_ghost_mr(Field& field, Fields&... other_fields)
+    void update_ghost_mr_from(std::size_t from_level, Field& field, Fields&... other_fields)
     {
         using mesh_id_t                  = typename Field::mesh_t::mesh_id_t;
         constexpr std::size_t pred_order = Field::mesh_t::config::prediction_order;
 
+        SAMURAI_PROFILE_SCOPE("update_ghost_mr");
+
         auto& mesh = field.mesh();
 
 #ifdef SAMURAI_WITH_MPI
@@ -101,27 +126,62 @@ namespace samurai
         auto min_level = mesh[mesh_id_t::reference].min_level();
         auto max_level = mesh[mesh_id_t::reference].max_level();
 #endif
+        std::size_t first_level = std::min(std::max(min_level, from_level), max_level);
 
-        for (std::size_t level = max_level; level > min_level; --level)
+        for (std::size_t level = max_level; level > first_level; --level)
         {
+            if (!mesh.mpi_neighbourhood().empty())
+            {
+                // The parents whose children are all in the subdomain are projected during the exchange
+                auto& exchange = field.ghost_exchange();
+                start_ghost_exchange(level, field, other_fields...);
+                exchange.projection_interior(mesh, level).apply_op(variadic_projection(field, other_fields...));
+                finish_ghost_exchange(level, field, other_fields...);
+                update_ghost_periodic(level, field, other_fields...);
+                exchange.projection_boundary(mesh, level).apply_op(variadic_projection(field, other_fields...));
+                continue;
+            }
+
             update_ghost_subdomains(level, field, other_fields...);
             update_ghost_periodic(level, field, other_fields...);
 
-            auto set_at_levelm1 = intersection(mesh[mesh_id_t::reference][level], mesh[mesh_id_t::proj_cells][level - 1]).on(level - 1);
+            auto& set_at_levelm1 = mesh.subset_plan("update_ghost_mr/projection",
+                                                    level - 1,
+                                                    [&]()
+                                                    {
+                                                        return intersection(mesh[mesh_id_t::reference][level],
+                                                                            mesh[mesh_id_t::proj_cells][level - 1])
+                                                            .on(level - 1);
+                                                    });
             set_at_levelm1.apply_op(variadic_projection(field, other_fields...));
         }
-        update_ghost_subdomains(field);
+        if (first_level == min_level)
+        {
+            update_ghost_subdomains(field);
+        }
+        else
+        {
+            update_ghost_subdomains(first_level, field, other_fields...);
+        }
 
-        update_bc(min_level, field, other_fields...);
-        update_ghost_periodic(min_level, field, other_fields...);
+        update_bc(first_level, field, other_fields...);
+        update_ghost_periodic(first_level, field, other_fields...);
 
-        for (std::size_t level = min_level + 1; level <= max_level; ++level)
+        for (std::size_t level = first_level + 1; level <= max_level; ++level)
         {
-            auto expr = intersection(difference(mesh[mesh_id_t::all_cells][level],
-                                                union_(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::proj_cells][level])),
-                                     mesh.subdomain(),
-                                     mesh[mesh_id_t::all_cells][level - 1])
-                            .on(level);
+            // The subset only depends on the mesh: it is evaluated once per
+            // mesh version and then reused at each call
+            auto& expr = mesh.subset_plan("update_ghost_mr/prediction",
+                                          level,
+                                          [&]()
+                                          {
+                                              return intersection(difference(mesh[mesh_id_t::all_cells][level],
+                                                                             union_(mesh[mesh_id_t::cells][level],
+                                                                                    mesh[mesh_id_t::proj_cells][level])),
+                                                                  mesh.subdomain(),
+                                                                  mesh[mesh_id_t::all_cells][level - 1])
+                                                  .on(level);
+                                          });
 
             expr.apply_op(variadic_prediction<pred_order, false>(field, other_fields...));
             update_ghost_periodic(level, field, other_fields...);
@@ -130,6 +190,12 @@ namespace samurai
         }
     }
 
+    template <class Field, class... Fields>
+    void update_ghost_mr(Field& field, Fields&... other_fields)
+    {
+        update_ghost_mr_from(0, field, other_fields...);
+    }
+
     inline void update_ghost_mr()
     {
     }
@@ -151,72 +217,35 @@ namespace samurai
         update_ghost_mr(fields.elements());
     }
 
-    template <class Field>
-    void update_ghost_subdomains([[maybe_unused]] std::size_t level, [[maybe_unused]] Field& field)
+    /**
+     * Starts the exchange of the ghosts of the fields at level between the
+     * subdomains (see GhostExchange): the ghosts of the level must not be
+     * read until finish_ghost_exchange().
+     */
+    template <class Field, class... Fields>
+    void start_ghost_exchange(std::size_t level, Field& field, Fields&... other_fields)
     {
-#ifdef SAMURAI_WITH_MPI
-        // static constexpr std::size_t dim = Field::dim;
-        using mesh_t    = typename Field::mesh_t;
-        using value_t   = typename Field::value_type;
-        using mesh_id_t = typename mesh_t::mesh_id_t;
-        std::vector<mpi::request> req;
-
-        auto& mesh = field.mesh();
-        mpi::communicator world;
-        std::vector<std::vector<value_t>> to_send(mesh.mpi_neighbourhood().size());
-
-        std::size_t i_neigh = 0;
-        for (auto& neighbour : mesh.mpi_neighbourhood())
-        {
-            if (!mesh[mesh_id_t::reference][level].empty() && !neighbour.mesh[mesh_id_t::reference][level].empty())
-            {
-                auto out_interface = intersection(mesh[mesh_id_t::reference][level],
-                                                  neighbour.mesh[mesh_id_t::reference][level],
-                                                  mesh.subdomain())
-                                         .on(level);
-                out_interface(
-                    [&](const auto& i, const auto& index)
-                    {
-                        std::copy(field(level, i, index).begin(), field(level, i, index).end(), std::back_inserter(to_send[i_neigh]));
-                    });
-
-                req.push_back(world.isend(neighbour.rank, neighbour.rank, to_send[i_neigh++]));
-            }
-        }
-
-        for (auto& neighbour : mesh.mpi_neighbourhood())
-        {
-            if (!mesh[mesh_id_t::reference][level].empty() && !neighbour.mesh[mesh_id_t::reference][level].empty())
-            {
-                std::vector<value_t> to_recv;
-                std::ptrdiff_t count = 0;
+        SAMURAI_PROFILE_SCOPE_LEVEL("ghost_exchange/start", level);
+        field.ghost_exchange().start(field, level);
+        (other_fields.ghost_exchange().start(other_fields, level), ...);
+    }
 
-                world.recv(neighbour.rank, world.rank(), to_recv);
-                auto in_interface = intersection(neighbour.mesh[mesh_id_t::reference][level],
-                                                 mesh[mesh_id_t::reference][level],
-                                                 neighbour.mesh.subdomain())
-                                        .on(level);
-                in_interface(
-                    [&](const auto& i, const auto& index)
-                    {
-                        std::copy(to_recv.begin() + count,
-                                  to_recv.begin() + count + static_cast<ptrdiff_t>(i.size()),
-                                  field(level, i, index).begin());
-                        count += static_cast<ptrdiff_t>(i.size());
-                    });
-            }
-        }
-        mpi::wait_all(req.begin(), req.end());
-#endif
+    template <class Field, class... Fields>
+    void finish_ghost_exchange(std::size_t level, Field& field, Fields&... other_fields)
+    {
+        SAMURAI_PROFILE_SCOPE_LEVEL("ghost_exchange/finish", level);
+        field.ghost_exchange().finish(field, level);
+        (other_fields.ghost_exchange().finish(other_fields, level), ...);
     }
 
     template <class Field, class... Fields>
     void update_ghost_subdomains(std::size_t level, Field& field, Fields&... other_fields)
     {
-        update_ghost_subdomains(level, field);
-        update_ghost_subdomains(level, other_fields...);
+        start_ghost_exchange(level, field, other_fields...);
+        finish_ghost_exchange(level, field, other_fields...);
     }
 
+    /// Exchanges the ghosts of all the levels: the messages of all the levels are in flight together
     template <class Field>
     void update_ghost_subdomains([[maybe_unused]] Field& field)
     {
@@ -231,11 +260,36 @@ namespace samurai
 
         for (std::size_t level = min_level; level <= max_level; ++level)
         {
-            update_ghost_subdomains(level, field);
+            start_ghost_exchange(level, field);
+        }
+        for (std::size_t level = min_level; level <= max_level; ++level)
+        {
+            finish_ghost_exchange(level, field);
         }
 #endif
     }
 
+    /**
+     * Applies func on the cells of the mesh at level while the ghosts of the
+     * fields are exchanged between the subdomains.
+     *
+     * func(plan) is called on the MaterializedSubset of the cells whose
+     * stencil, of stencil_width cells in each direction, does not reach the
+     * subdomains of the neighbours, then, once the ghosts are received, on
+     * the one of the other cells. func must not read the ghosts of the
+     * subdomains in the first call.
+     */
+    template <class Func, class Field, class... Fields>
+    void apply_with_ghost_exchange(std::size_t level, std::size_t stencil_width, Func&& func, Field& field, Fields&... other_fields)
+    {
+        auto& mesh = field.mesh();
+
+        start_ghost_exchange(level, field, other_fields...);
+        func(field.ghost_exchange().interior(mesh, level, stencil_width));
+        finish_ghost_exchange(level, field, other_fields...);
+        func(field.ghost_exchange().boundary(mesh, level, stencil_width));
+    }
+
     template <bool out = true, class Field>
     void update_tag_subdomains([[maybe_unused]] std::size_t level,
                                [[maybe_unused]] Field& tag,
@@ -809,6 +863,8 @@ namespace samurai
         using value_t                    = typename interval_t::value_t;
         using cl_type                    = typename Field::mesh_t::cl_type;
 
+        SAMURAI_PROFILE_SCOPE("update_field_mr");
+
         auto& mesh = field.mesh();
         cl_type cl;
 
@@ -865,7 +921,10 @@ namespace samurai
             return true;
         }
 
-        detail::update_fields(new_mesh, field, other_fields...);
+        {
+            SAMURAI_PROFILE_SCOPE("update_field_mr/transfer");
+            detail::update_fields(new_mesh, field, other_fields...);
+        }
 
         field.mesh().swap(new_mesh);
 
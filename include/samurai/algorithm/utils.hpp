@@ -27,22 +27,27 @@ namespace samurai
         template <class T>
         inline void operator()(Dim<1>, T& dest, const T& src) const
         {
-            dest(level, i) = src(level, i);
+            dest(cursor) = src(cursor);
         }
 
         template <class T>
         inline void operator()(Dim<2>, T& dest, const T& src) const
         {
-            dest(level, i, j) = src(level, i, j);
+            dest(cursor) = src(cursor);
         }
 
         template <class T>
         inline void operator()(Dim<3>, T& dest, const T& src) const
         {
-            dest(level, i, j, k) = src(level, i, j, k);
+            dest(cursor) = src(cursor);
         }
     };
 
+    template <>
+    struct is_parallel_operator<copy_op> : std::true_type
+    {
+    };
+
     template <class T>
     inline auto copy(T&& dest, T&& src)
     {
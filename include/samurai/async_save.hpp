@@ -0,0 +1,321 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include "hdf5.hpp"
+#include "profiling.hpp"
+
+namespace samurai
+{
+    namespace detail
+    {
+        template <class T>
+        struct is_hdf5_options : std::false_type
+        {
+        };
+
+        template <class D>
+        struct is_hdf5_options<Hdf5Options<D>> : std::true_type
+        {
+        };
+
+        /**
+         * Copy of a mesh and of fields defined on it, owned by the output
+         * thread: the solver can modify the originals while it is written.
+         */
+        template <class Mesh, class... T>
+        class SaveSnapshot
+        {
+          public:
+
+            static_assert(std::conjunction_v<std::is_same<typename T::mesh_t, Mesh>...>, "The fields must be defined on the saved mesh");
+
+            explicit SaveSnapshot(const Mesh& mesh, const T&... fields)
+                : m_mesh(mesh)
+                , m_fields(copy_field(fields)...)
+            {
+            }
+
+            SaveSnapshot(const SaveSnapshot&)            = delete;
+            SaveSnapshot& operator=(const SaveSnapshot&) = delete;
+
+            template <class Func>
+            void apply(Func&& func) const
+            {
+                std::apply(
+                    [&](const auto&... fields)
+                    {
+                        func(m_mesh, fields...);
+                    },
+                    m_fields);
+            }
+
+          private:
+
+            template <class Field>
+            Field copy_field(const Field& field)
+            {
+                Field copy(field.name(), m_mesh);
+                copy.array() = field.array();
+                return copy;
+            }
+
+            Mesh m_mesh;
+            std::tuple<T...> m_fields;
+        };
+    }
+
+    /**
+     * @class AsyncSaver
+     * @brief Writes the outputs in a background thread.
+     *
+     * save() copies the mesh and the fields, queues the copy and returns: the
+     * extraction of the points, the XDMF building and the HDF5 writes are
+     * done by the output thread while the solver goes on. At most
+     * max_pending copies are alive at the same time (the one being written
+     * included): save() waits for the oldest one to be written otherwise, so
+     * that the memory used by the outputs is bounded.
+     *
+     * The HDF5 output is collective with MPI, so that save() is synchronous
+     * when SAMURAI_WITH_MPI is defined. Without MPI, the accesses to HDF5 of
+     * the output thread and of the other ones (samurai::save, the
+     * checkpoints) are serialized by detail::hdf5_mutex(); the direct uses of
+     * HighFive by the caller must take it as well while outputs are pending.
+     * An error raised while writing is rethrown by the next call to save()
+     * or wait().
+     */
+    class AsyncSaver
+    {
+      public:
+
+        explicit AsyncSaver(std::size_t max_pending = 2);
+        ~AsyncSaver();
+
+        AsyncSaver(const AsyncSaver&)            = delete;
+        AsyncSaver& operator=(const AsyncSaver&) = delete;
+        AsyncSaver(AsyncSaver&&)                 = delete;
+        AsyncSaver& operator=(AsyncSaver&&)      = delete;
+
+        template <class Mesh, class... T, std::enable_if_t<!detail::is_hdf5_options<Mesh>::value, int> = 0>
+        void save(const fs::path& path, const std::string& filename, const Mesh& mesh, const T&... fields);
+
+        template <class Options, class Mesh, class... T, std::enable_if_t<detail::is_hdf5_options<Options>::value, int> = 0>
+        void save(const fs::path& path, const std::string& filename, const Options& options, const Mesh& mesh, const T&... fields);
+
+        void wait();
+        std::size_t nb_pending() const;
+
+      private:
+
+        void wait_for_room();
+        void push(std::function<void()>&& task);
+        void run();
+        void rethrow_error();
+
+        std::size_t m_max_pending;
+        std::deque<std::function<void()>> m_tasks; ///< The front one is being written
+        std::exception_ptr m_error;
+        bool m_stop = false;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::thread m_thread;
+    };
+
+    ///////////////////////////////
+    // AsyncSaver implementation //
+    ///////////////////////////////
+
+    inline AsyncSaver::AsyncSaver(std::size_t max_pending)
+        : m_max_pending(std::max(max_pending, std::size_t{1}))
+    {
+#ifndef SAMURAI_WITH_MPI
+        m_thread = std::thread(
+            [this]()
+            {
+                run();
+            });
+#endif
+    }
+
+    /**
+     * Waits for the queued outputs to be written. The errors are lost: call
+     * wait() before to get them.
+     */
+    inline AsyncSaver::~AsyncSaver()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    template <class Mesh, class... T, std::enable_if_t<!detail::is_hdf5_options<Mesh>::value, int>>
+    inline void AsyncSaver::save(const fs::path& path, const std::string& filename, const Mesh& mesh, const T&... fields)
+    {
+#ifdef SAMURAI_WITH_MPI
+        samurai::save(path, filename, mesh, fields...);
+#else
+        rethrow_error();
+        wait_for_room();
+
+        std::shared_ptr<const detail::SaveSnapshot<Mesh, T...>> snapshot;
+        {
+            SAMURAI_PROFILE_SCOPE("save/snapshot");
+            snapshot = std::make_shared<const detail::SaveSnapshot<Mesh, T...>>(mesh, fields...);
+        }
+        push(
+            [=]()
+            {
+                snapshot->apply(
+                    [&](const auto& snapshot_mesh, const auto&... snapshot_fields)
+                    {
+                        samurai::save(path, filename, snapshot_mesh, snapshot_fields...);
+                    });
+            });
+#endif
+    }
+
+    template <class Options, class Mesh, class... T, std::enable_if_t<detail::is_hdf5_options<Options>::value, int>>
+    inline void
+    AsyncSaver::save(const fs::path& path, const std::string& filename, const Options& options, const Mesh& mesh, const T&... fields)
+    {
+#ifdef SAMURAI_WITH_MPI
+        samurai::save(path, filename, options, mesh, fields...);
+#else
+        rethrow_error();
+        wait_for_room();
+
+        std::shared_ptr<const detail::SaveSnapshot<Mesh, T...>> snapshot;
+        {
+            SAMURAI_PROFILE_SCOPE("save/snapshot");
+            snapshot = std::make_shared<const detail::SaveSnapshot<Mesh, T...>>(mesh, fields...);
+        }
+        push(
+            [=]()
+            {
+                snapshot->apply(
+                    [&](const auto& snapshot_mesh, const auto&... snapshot_fields)
+                    {
+                        samurai::save(path, filename, options, snapshot_mesh, snapshot_fields...);
+                    });
+            });
+#endif
+    }
+
+    /**
+     * Waits for all the queued outputs to be written, and rethrows the first
+     * error raised by the output thread.
+     */
+    inline void AsyncSaver::wait()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock,
+                      [&]()
+                      {
+                          return m_tasks.empty();
+                      });
+        }
+        rethrow_error();
+    }
+
+    /// Number of outputs queued or being written
+    inline std::size_t AsyncSaver::nb_pending() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_tasks.size();
+    }
+
+    inline void AsyncSaver::wait_for_room()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock,
+                  [&]()
+                  {
+                      return m_tasks.size() < m_max_pending;
+                  });
+    }
+
+    inline void AsyncSaver::push(std::function<void()>&& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_cv.notify_all();
+    }
+
+    /// Loop of the output thread: the tasks are run in their order of submission
+    inline void AsyncSaver::run()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock,
+                          [&]()
+                          {
+                              return m_stop || !m_tasks.empty();
+                          });
+                if (m_tasks.empty())
+                {
+                    return;
+                }
+                task = m_tasks.front();
+            }
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_error)
+                {
+                    m_error = std::current_exception();
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.pop_front();
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    inline void AsyncSaver::rethrow_error()
+    {
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::swap(error, m_error);
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -15,9 +16,11 @@
 #include <xtensor/xview.hpp>
 
 #include "samurai/cell.hpp"
+#include "profiling.hpp"
 #include "samurai_config.hpp"
 #include "static_algorithm.hpp"
 #include "stencil.hpp"
+#include "subset/materialized_subset.hpp"
 
 #define APPLY_AND_STENCIL_FUNCTIONS(STENCIL_SIZE)                                                                                         \
     using apply_function_##STENCIL_SIZE = std::function<void(Field&, const std::array<cell_t, STENCIL_SIZE>&, const value_t&)>;           \
@@ -60,6 +63,11 @@
     std::size_t stencil_size() const override                                                                                      \
     {                                                                                                                              \
         return STENCIL_SIZE;                                                                                                       \
+    }                                                                                                                              \
+                                                                                                                                   \
+    std::string name() const override                                                                                              \
+    {                                                                                                                              \
+        return #NAME;                                                                                                              \
     }
 
 namespace samurai
@@ -575,6 +583,8 @@ namespace samurai
         using lca_t      = typename bcregion_t::lca_t;
         using region_t   = typename bcregion_t::region_t;
 
+        using subset_plans_t = SubsetPlanCache<dim, interval_t>;
+
         virtual ~Bc() = default;
 
         Bc(const lca_t& domain, const bcvalue_t& bcv);
@@ -589,6 +599,7 @@ namespace samurai
 
         virtual std::unique_ptr<Bc> clone() const = 0;
         virtual std::size_t stencil_size() const  = 0;
+        virtual std::string name() const          = 0; ///< Stable identifier of the kind of boundary condition
 
         static constexpr std::size_t max_stencil_size_implemented = 10;
         APPLY_AND_STENCIL_FUNCTIONS(1)
@@ -609,6 +620,7 @@ namespace samurai
         auto on(const Regions&... regions);
 
         const region_t& get_region() const;
+        subset_plans_t& subset_plans() const;
 
         value_t constant_value();
         value_t value(const direction_t& d, const cell_t& cell_in, const coords_t& coords) const;
@@ -619,6 +631,8 @@ namespace samurai
         bcvalue_impl p_bcvalue;
         const lca_t& m_domain; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
         region_t m_region;
+        mutable subset_plans_t m_subset_plans; ///< Subsets of the region
+                                               ///< evaluated on the mesh
         xt::xtensor<typename Field::value_type, detail::return_type<typename Field::value_type, size>::dim> m_value;
     };
 
@@ -653,6 +667,7 @@ namespace samurai
         : p_bcvalue(bc.p_bcvalue->clone())
         , m_domain(bc.m_domain)
         , m_region(bc.m_region)
+        , m_subset_plans(bc.m_subset_plans)
     {
     }
 
@@ -665,8 +680,9 @@ namespace samurai
         }
         bcvalue_impl bcvalue = bc.p_bcvalue->clone();
         std::swap(p_bcvalue, bcvalue);
-        m_domain = bc.m_domain;
-        m_region = bc.m_region;
+        m_domain       = bc.m_domain;
+        m_region       = bc.m_region;
+        m_subset_plans = bc.m_subset_plans;
         return *this;
     }
 
@@ -675,6 +691,7 @@ namespace samurai
     inline auto Bc<Field>::on(const Region& region)
     {
         m_region = make_region<dim, interval_t>(region).get_region(m_domain);
+        m_subset_plans.clear();
         return this;
     }
 
@@ -683,6 +700,7 @@ namespace samurai
     inline auto Bc<Field>::on(const Regions&... regions)
     {
         m_region = make_region<dim, interval_t>(regions...).get_region(m_domain);
+        m_subset_plans.clear();
         return this;
     }
 
@@ -692,6 +710,13 @@ namespace samurai
         return m_region;
     }
 
+    /// Materialized subsets built from the region of the B.C.
+    template <class Field>
+    inline auto Bc<Field>::subset_plans() const -> subset_plans_t&
+    {
+        return m_subset_plans;
+    }
+
     template <class Field>
     inline auto Bc<Field>::constant_value() -> value_t
     {
@@ -878,15 +903,39 @@ namespace samurai
                 {
                     auto stencil = convert_for_direction(stencil_0, direction[d]);
 
+                    // The subsets only depend on the mesh and on the region:
+                    // they are cached on the B.C. for the current mesh
+                    auto& plans           = bc.subset_plans();
+                    const auto& reference = mesh[mesh_id_t::reference][level];
+
                     // 1. Inner cells in the boundary region
-                    auto bdry_cells = intersection(mesh[mesh_id_t::cells][level], lca[d]).on(level);
+                    auto& bdry_cells = plans.get("bdry_cells",
+                                                 d,
+                                                 level,
+                                                 direction[d],
+                                                 reference,
+                                                 mesh.version(),
+                                                 [&]()
+                                                 {
+                                                     return intersection(mesh[mesh_id_t::cells][level], lca[d]).on(level);
+                                                 });
 
                     __apply_bc_on_subset(bc, field, bdry_cells, stencil, direction[d]);
 
                     // 2. Inner ghosts in the boundary region that have a neigbouring ghost outside the domain
-                    auto translated_outer_nghbr        = translate(mesh[mesh_id_t::reference][level], -(stencil_size / 2) * direction[d]);
-                    auto inner_cells_and_ghosts        = intersection(translated_outer_nghbr, lca[d]);
-                    auto inner_ghosts_with_outer_nghbr = difference(inner_cells_and_ghosts, bdry_cells).on(level);
+                    auto& inner_ghosts_with_outer_nghbr = plans.get(
+                        "inner_ghosts_with_outer_nghbr",
+                        d,
+                        level,
+                        direction[d],
+                        reference,
+                        mesh.version(),
+                        [&]()
+                        {
+                            auto translated_outer_nghbr = translate(mesh[mesh_id_t::reference][level], -(stencil_size / 2) * direction[d]);
+                            auto inner_cells_and_ghosts = intersection(translated_outer_nghbr, lca[d]);
+                            return difference(inner_cells_and_ghosts, intersection(mesh[mesh_id_t::cells][level], lca[d])).on(level);
+                        });
 
                     __apply_bc_on_subset(bc, field, inner_ghosts_with_outer_nghbr, stencil, direction[d]);
                 }
@@ -908,22 +957,42 @@ namespace samurai
         auto stencil_0 = bc.get_stencil(std::integral_constant<std::size_t, stencil_size>());
         auto stencil   = convert_for_direction(stencil_0, direction);
 
+        // The subset is built from the domain: the evaluated subsets only
+        // depend on the mesh and are cached on it
+
         // 1. Inner cells in the boundary region
         {
-            auto bdry_cells = intersection(mesh[mesh_id_t::cells][level], subset);
-            // We need to check that the furthest ghost exists. It's not always the case for large stencils!
-            auto translated_outer_nghbr = translate(mesh[mesh_id_t::reference][level], -(stencil_size / 2) * direction);
-            auto cells                  = intersection(translated_outer_nghbr, bdry_cells).on(level);
+            auto& cells = mesh.subset_plan("extrapolation_bc/cells",
+                                           stencil_size,
+                                           level,
+                                           direction,
+                                           [&]()
+                                           {
+                                               auto bdry_cells = intersection(mesh[mesh_id_t::cells][level], subset);
+                                               // We need to check that the furthest ghost exists. It's not always the case for large
+                                               // stencils!
+                                               auto translated_outer_nghbr = translate(mesh[mesh_id_t::reference][level],
+                                                                                       -(stencil_size / 2) * direction);
+                                               return intersection(translated_outer_nghbr, bdry_cells).on(level);
+                                           });
 
             __apply_bc_on_subset(bc, field, cells, stencil, direction);
         }
 
         // 2. Inner ghosts in the boundary region that have a neigbouring ghost outside the domain
         {
-            auto bdry_cells                    = intersection(mesh[mesh_id_t::cells][level], subset);
-            auto translated_outer_nghbr        = translate(mesh[mesh_id_t::reference][level], -(stencil_size / 2) * direction);
-            auto inner_cells_and_ghosts        = intersection(translated_outer_nghbr, subset).on(level);
-            auto inner_ghosts_with_outer_nghbr = difference(inner_cells_and_ghosts, bdry_cells).on(level);
+            auto& inner_ghosts_with_outer_nghbr = mesh.subset_plan(
+                "extrapolation_bc/inner_ghosts_with_outer_nghbr",
+                stencil_size,
+                level,
+                direction,
+                [&]()
+                {
+                    auto bdry_cells             = intersection(mesh[mesh_id_t::cells][level], subset);
+                    auto translated_outer_nghbr = translate(mesh[mesh_id_t::reference][level], -(stencil_size / 2) * direction);
+                    auto inner_cells_and_ghosts = intersection(translated_outer_nghbr, subset).on(level);
+                    return difference(inner_cells_and_ghosts, bdry_cells).on(level);
+                });
 
             __apply_bc_on_subset(bc, field, inner_ghosts_with_outer_nghbr, stencil, direction);
         }
@@ -1185,6 +1254,80 @@ namespace samurai
         }
     };
 
+    /**
+     * Polynomial extrapolations used by update_bc to fill the ghosts that are not
+     * set by the B.C. attached to the field.
+     * They are built once and kept as long as the mesh is the same.
+     */
+    template <class Field>
+    class ExtrapolationBcCache
+    {
+      public:
+
+        ExtrapolationBcCache() = default;
+
+        // The cached B.C. refer to the domain of the field they belong to: they are not copied
+        ExtrapolationBcCache(const ExtrapolationBcCache&);
+        ExtrapolationBcCache& operator=(const ExtrapolationBcCache&);
+
+        ExtrapolationBcCache(ExtrapolationBcCache&&) noexcept            = default;
+        ExtrapolationBcCache& operator=(ExtrapolationBcCache&&) noexcept = default;
+
+        template <std::size_t stencil_size, class Domain>
+        Bc<Field>& get(const Domain& domain, std::size_t mesh_version);
+
+        void clear();
+
+      private:
+
+        std::vector<std::unique_ptr<Bc<Field>>> m_bc; ///< Indexed by stencil_size/2
+        const void* m_domain  = nullptr;
+        std::size_t m_version = 0;
+    };
+
+    template <class Field>
+    ExtrapolationBcCache<Field>::ExtrapolationBcCache(const ExtrapolationBcCache&)
+    {
+    }
+
+    template <class Field>
+    auto ExtrapolationBcCache<Field>::operator=(const ExtrapolationBcCache&) -> ExtrapolationBcCache&
+    {
+        clear();
+        return *this;
+    }
+
+    template <class Field>
+    template <std::size_t stencil_size, class Domain>
+    inline Bc<Field>& ExtrapolationBcCache<Field>::get(const Domain& domain, std::size_t mesh_version)
+    {
+        if (m_domain != &domain || m_version != mesh_version)
+        {
+            clear();
+            m_domain  = &domain;
+            m_version = mesh_version;
+        }
+
+        std::size_t index = stencil_size / 2;
+        if (m_bc.size() <= index)
+        {
+            m_bc.resize(index + 1);
+        }
+        if (!m_bc[index])
+        {
+            m_bc[index] = std::make_unique<PolynomialExtrapolation<Field, stencil_size>>(domain, ConstantBc<Field>(), true);
+        }
+        return *m_bc[index];
+    }
+
+    template <class Field>
+    inline void ExtrapolationBcCache<Field>::clear()
+    {
+        m_bc.clear();
+        m_domain  = nullptr;
+        m_version = 0;
+    }
+
     template <class Field>
     void update_bc(std::size_t level, Field& field)
     {
@@ -1193,6 +1336,8 @@ namespace samurai
         static constexpr std::size_t max_stencil_size_implemented_BC = Bc<Field>::max_stencil_size_implemented;
         static constexpr std::size_t max_stencil_size_implemented_PE = PolynomialExtrapolation<Field, 2>::max_stencil_size_implemented_PE;
 
+        SAMURAI_PROFILE_SCOPE_LEVEL("update_bc", level);
+
         // Step 0:
         // One level below the boundary cells, there are outer ghosts used for prediction (for the computation of details).
         // Those ghosts are supposed (for now) to be filled by the boundary conditions.
@@ -1215,8 +1360,8 @@ namespace samurai
                         {
                             if (stencil_s == i)
                             {
-                                auto& mesh = detail::get_mesh(field.mesh());
-                                PolynomialExtrapolation<Field, i> bc(mesh, ConstantBc<Field>(), true);
+                                auto& bc = field.extrapolation_bc().template get<i>(detail::get_mesh(field.mesh()),
+                                                                                   field.mesh().version());
 
                                 bool only_fill_corners = false;
                                 apply_extrapolation_bc_impl<Field, i>(bc, level, field, only_fill_corners);
@@ -1262,8 +1407,7 @@ namespace samurai
                     {
                         if (stencil_s == i)
                         {
-                            auto& mesh = detail::get_mesh(field.mesh());
-                            PolynomialExtrapolation<Field, i> bc(mesh, ConstantBc<Field>(), true);
+                            auto& bc = field.extrapolation_bc().template get<i>(detail::get_mesh(field.mesh()), field.mesh().version());
 
                             // If the ghost layer is managed by the B.C., we only populate the corners.
                             // Otherwise, we populate the Cartesian directions as well, by polynomial extrapolation.
@@ -13,6 +13,7 @@
 #include "cell_list.hpp"
 #include "level_cell_array.hpp"
 #include "samurai_config.hpp"
+#include "sorted_cell_list.hpp"
 #include "utils.hpp"
 
 #ifdef SAMURAI_WITH_MPI
@@ -90,6 +91,7 @@ namespace samurai
 
         CellArray();
         CellArray(const cl_type& cl, bool with_update_index = true);
+        CellArray(const SortedCellList<dim, TInterval, max_size>& cl, bool with_update_index = true);
 
         const lca_type& operator[](std::size_t i) const;
         lca_type& operator[](std::size_t i);
@@ -261,6 +263,27 @@ namespace samurai
         }
     }
 
+    /**
+     * Construction of a CellArray from a SortedCellList.
+     *
+     * @param cl The sorted cell list.
+     * @param with_update_index A boolean indicating if the index of the
+     * x-intervals must be computed.
+     */
+    template <std::size_t dim_, class TInterval, std::size_t max_size_>
+    inline CellArray<dim_, TInterval, max_size_>::CellArray(const SortedCellList<dim, TInterval, max_size>& cl, bool with_update_index)
+    {
+        for (std::size_t level = 0; level <= max_size; ++level)
+        {
+            m_cells[level] = cl[level];
+        }
+
+        if (with_update_index)
+        {
+            update_index();
+        }
+    }
+
     template <std::size_t dim_, class TInterval, std::size_t max_size_>
     inline auto CellArray<dim_, TInterval, max_size_>::operator[](std::size_t i) const -> const lca_type&
     {
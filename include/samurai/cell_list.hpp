@@ -5,6 +5,13 @@
 #pragma once
 
 #include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef SAMURAI_WITH_OPENMP
+#include <omp.h>
+#endif
 
 #include <fmt/color.h>
 
@@ -35,6 +42,8 @@ namespace samurai
 
         void to_stream(std::ostream& os) const;
 
+        void merge(CellList&& other);
+
       private:
 
         std::array<lcl_type, max_size + 1> m_cells;
@@ -79,6 +88,73 @@ namespace samurai
         }
     }
 
+    /**
+     * Add the cells of another list level by level.
+     */
+    template <std::size_t dim_, class TInterval, std::size_t max_size_>
+    inline void CellList<dim_, TInterval, max_size_>::merge(CellList&& other)
+    {
+        for (std::size_t level = 0; level <= max_size; ++level)
+        {
+            m_cells[level].merge(std::move(other.m_cells[level]));
+        }
+    }
+
+    namespace detail
+    {
+        template <class Partial, class... CellLists, std::size_t... I>
+        inline void merge_cell_lists(Partial& partial, std::index_sequence<I...>, CellLists&... cell_lists)
+        {
+            (cell_lists.merge(std::move(std::get<I>(partial))), ...);
+        }
+    } // namespace detail
+
+    /**
+     * Add cells to one or more cell lists (CellList, SortedCellList or
+     * LevelCellList) for each element of a subset.
+     *
+     * With OpenMP, the subset is traversed in parallel by chunks of its
+     * outermost dimension (see subset_operator::parallel_apply): each thread
+     * fills its own cell lists which are then merged into @p cell_lists. The
+     * result is the same as with the sequential traversal.
+     * @param set the subset to traverse
+     * @param func function called with the interval, the index and the cell lists to fill
+     */
+    template <class Set, class Func, class... CellLists>
+    inline void parallel_fill(Set& set, Func&& func, CellLists&... cell_lists)
+    {
+#ifdef SAMURAI_WITH_OPENMP
+        if constexpr (Set::dim > 1)
+        {
+            if (omp_get_max_threads() > 1 && !omp_in_parallel())
+            {
+                std::vector<std::tuple<CellLists...>> partial(static_cast<std::size_t>(omp_get_max_threads()));
+                set.parallel_apply(
+                    [&](const auto& interval, const auto& index)
+                    {
+                        std::apply(
+                            [&](auto&... thread_cell_lists)
+                            {
+                                func(interval, index, thread_cell_lists...);
+                            },
+                            partial[static_cast<std::size_t>(omp_get_thread_num())]);
+                    });
+
+                for (auto& p : partial)
+                {
+                    detail::merge_cell_lists(p, std::index_sequence_for<CellLists...>{}, cell_lists...);
+                }
+                return;
+            }
+        }
+#endif
+        set(
+            [&](const auto& interval, const auto& index)
+            {
+                func(interval, index, cell_lists...);
+            });
+    }
+
     template <std::size_t dim_, class TInterval, std::size_t max_size_>
     inline std::ostream& operator<<(std::ostream& out, const CellList<dim_, TInterval, max_size_>& cell_list)
     {
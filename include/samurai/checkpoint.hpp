@@ -0,0 +1,347 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <highfive/H5DataType.hpp>
+#include <highfive/H5File.hpp>
+
+#include <fmt/format.h>
+
+#ifdef SAMURAI_WITH_MPI
+#include <boost/mpi.hpp>
+namespace mpi = boost::mpi;
+#endif
+
+#include "bc.hpp"
+#include "cell_array.hpp"
+#include "hdf5.hpp"
+#include "level_cell_array.hpp"
+#include "mesh.hpp"
+#include "profiling.hpp"
+
+namespace samurai
+{
+    namespace detail
+    {
+        /// Version of the layout of the checkpoint files
+        static constexpr int checkpoint_format_version = 2;
+
+        inline std::size_t checkpoint_nb_ranks()
+        {
+#ifdef SAMURAI_WITH_MPI
+            mpi::communicator world;
+            return static_cast<std::size_t>(world.size());
+#else
+            return 1;
+#endif
+        }
+
+        inline std::filesystem::path checkpoint_file(const std::filesystem::path& path, const std::string& filename)
+        {
+#ifdef SAMURAI_WITH_MPI
+            mpi::communicator world;
+            if (world.size() > 1)
+            {
+                return path / fmt::format("{}_rank_{}.h5", filename, world.rank());
+            }
+#endif
+            return path / fmt::format("{}.h5", filename);
+        }
+
+        /// HDF5 type with the memory layout of an interval: the intervals are written and read without conversion
+        template <class TInterval>
+        inline HighFive::CompoundType interval_datatype()
+        {
+            using value_t = typename TInterval::value_t;
+            using index_t = typename TInterval::index_t;
+
+            return HighFive::CompoundType({{"start", HighFive::AtomicType<value_t>{}, offsetof(TInterval, start)},
+                                           {"end", HighFive::AtomicType<value_t>{}, offsetof(TInterval, end)},
+                                           {"step", HighFive::AtomicType<value_t>{}, offsetof(TInterval, step)},
+                                           {"index", HighFive::AtomicType<index_t>{}, offsetof(TInterval, index)}},
+                                          sizeof(TInterval));
+        }
+
+        /// Description of the boundary conditions of a field
+        template <class Field>
+        auto bc_description(const Field& field)
+        {
+            std::vector<std::string> description;
+            for (const auto& bc : field.get_bc())
+            {
+                description.push_back(fmt::format("{} (stencil size {}, {} value)",
+                                                  bc->name(),
+                                                  bc->stencil_size(),
+                                                  bc->get_value_type() == BCVType::constant ? "constant" : "function"));
+            }
+            return description;
+        }
+
+        class CheckpointWriter
+        {
+          public:
+
+            CheckpointWriter(HighFive::File& file, const std::string& prefix)
+                : m_file(file)
+                , m_prefix(prefix)
+            {
+            }
+
+            /// Scalars and std::vector
+            template <class T>
+            void write(const std::string& name, const T& value)
+            {
+                m_file.createDataSet(path(name), value);
+            }
+
+            template <std::size_t dim, class TInterval>
+            void write(const std::string& name, const LevelCellArray<dim, TInterval>& lca)
+            {
+                write(name + "/level", lca.level());
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    auto datatype = interval_datatype<TInterval>();
+                    auto dataset  = m_file.createDataSet(path(fmt::format("{}/cells_{}", name, d)),
+                                                        HighFive::DataSpace(std::vector<std::size_t>{lca[d].size()}),
+                                                        datatype);
+                    if (!lca[d].empty())
+                    {
+                        dataset.write_raw(lca[d].data(), datatype);
+                    }
+                }
+                for (std::size_t d = 1; d < dim; ++d)
+                {
+                    write(fmt::format("{}/offsets_{}", name, d), lca.offsets(d));
+                }
+            }
+
+            template <std::size_t dim, class TInterval, std::size_t max_size>
+            void write(const std::string& name, const CellArray<dim, TInterval, max_size>& ca)
+            {
+                for (std::size_t level = 0; level <= max_size; ++level)
+                {
+                    if (!ca[level].empty())
+                    {
+                        write(fmt::format("{}/level_{}", name, level), ca[level]);
+                    }
+                }
+            }
+
+          private:
+
+            std::string path(const std::string& name) const
+            {
+                return fmt::format("{}/{}", m_prefix, name);
+            }
+
+            HighFive::File& m_file; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+            std::string m_prefix;
+        };
+
+        class CheckpointReader
+        {
+          public:
+
+            CheckpointReader(const HighFive::File& file, const std::string& prefix)
+                : m_file(file)
+                , m_prefix(prefix)
+            {
+            }
+
+            template <class T>
+            void read(const std::string& name, T& value) const
+            {
+                m_file.getDataSet(path(name)).read(value);
+            }
+
+            template <std::size_t dim, class TInterval>
+            void read(const std::string& name, LevelCellArray<dim, TInterval>& lca) const
+            {
+                std::size_t level;
+                read(name + "/level", level);
+                lca = LevelCellArray<dim, TInterval>(level);
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    auto dataset = m_file.getDataSet(path(fmt::format("{}/cells_{}", name, d)));
+                    lca[d].resize(dataset.getElementCount());
+                    if (!lca[d].empty())
+                    {
+                        dataset.read_raw(lca[d].data(), interval_datatype<TInterval>());
+                    }
+                }
+                for (std::size_t d = 1; d < dim; ++d)
+                {
+                    read(fmt::format("{}/offsets_{}", name, d), lca.offsets(d));
+                }
+            }
+
+            template <std::size_t dim, class TInterval, std::size_t max_size>
+            void read(const std::string& name, CellArray<dim, TInterval, max_size>& ca) const
+            {
+                for (std::size_t level = 0; level <= max_size; ++level)
+                {
+                    std::string level_name = fmt::format("{}/level_{}", name, level);
+                    if (m_file.exist(path(level_name)))
+                    {
+                        read(level_name, ca[level]);
+                    }
+                    else
+                    {
+                        ca[level] = LevelCellArray<dim, TInterval>(level);
+                    }
+                }
+            }
+
+          private:
+
+            std::string path(const std::string& name) const
+            {
+                return fmt::format("{}/{}", m_prefix, name);
+            }
+
+            const HighFive::File& m_file; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+            std::string m_prefix;
+        };
+
+        template <class Field>
+        void save_field_checkpoint(HighFive::File& file, const Field& field)
+        {
+            using value_t = typename Field::value_type;
+
+            std::string prefix = fmt::format("/fields/{}", field.name());
+            const auto& array  = field.array();
+            auto dataset = file.createDataSet<value_t>(prefix + "/values", HighFive::DataSpace(std::vector<std::size_t>{array.size()}));
+            if (array.size() != 0)
+            {
+                dataset.write_raw(array.data(), HighFive::AtomicType<value_t>{});
+            }
+            file.createDataSet(prefix + "/bc", bc_description(field));
+        }
+
+        template <class Field>
+        void load_field_checkpoint(const HighFive::File& file, Field& field)
+        {
+            using value_t = typename Field::value_type;
+
+            std::string path = fmt::format("/fields/{}/values", field.name());
+            if (!file.exist(path))
+            {
+                throw std::runtime_error(fmt::format("The field {} is not in the checkpoint.", field.name()));
+            }
+            field.resize();
+            auto dataset = file.getDataSet(path);
+            auto& array  = field.array();
+            if (dataset.getElementCount() != array.size())
+            {
+                throw std::runtime_error(fmt::format("The size of the field {} does not match the checkpoint.", field.name()));
+            }
+            if (array.size() != 0)
+            {
+                dataset.read_raw(array.data(), HighFive::AtomicType<value_t>{});
+            }
+        }
+
+        inline void check_checkpoint_header(const HighFive::File& file, std::size_t dim)
+        {
+            int version;
+            std::size_t stored_dim;
+            std::size_t nb_ranks;
+            file.getDataSet("/format_version").read(version);
+            file.getDataSet("/dim").read(stored_dim);
+            file.getDataSet("/nb_ranks").read(nb_ranks);
+            if (version != checkpoint_format_version)
+            {
+                throw std::runtime_error(fmt::format("Unsupported checkpoint format version {}.", version));
+            }
+            if (stored_dim != dim)
+            {
+                throw std::runtime_error(fmt::format("The checkpoint holds a mesh of dimension {} instead of {}.", stored_dim, dim));
+            }
+            if (nb_ranks != checkpoint_nb_ranks())
+            {
+                throw std::runtime_error(fmt::format("The checkpoint was written by {} processes and must be read by as many.", nb_ranks));
+            }
+        }
+    }
+
+    /**
+     * Writes a checkpoint of the mesh and the fields in path/filename.h5
+     * (path/filename_rank_{r}.h5 with several MPI processes, each process
+     * writing its own file).
+     *
+     * The sub meshes are stored in their native form (the intervals with their
+     * storage indices and the offsets of each LevelCellArray) and the fields as
+     * their raw arrays, so that a restart costs about a copy of the data.
+     * The boundary conditions hold functions and cannot be stored: only their
+     * description is, for check_checkpoint_bc.
+     */
+    template <class D, class Config, class... T>
+    void save_checkpoint(const std::filesystem::path& path,
+                         const std::string& filename,
+                         const Mesh_base<D, Config>& mesh,
+                         const T&... fields)
+    {
+        SAMURAI_PROFILE_SCOPE("checkpoint/save");
+        std::lock_guard<std::recursive_mutex> lock(detail::hdf5_mutex());
+        HighFive::File file(detail::checkpoint_file(path, filename).string(), HighFive::File::Overwrite);
+
+        file.createDataSet("/format_version", detail::checkpoint_format_version);
+        file.createDataSet("/dim", Mesh_base<D, Config>::dim);
+        file.createDataSet("/nb_ranks", detail::checkpoint_nb_ranks());
+
+        detail::CheckpointWriter writer(file, "/mesh");
+        mesh.save_state(writer);
+        (detail::save_field_checkpoint(file, fields), ...);
+    }
+
+    /**
+     * Restores the mesh and the fields (found by name) written by
+     * save_checkpoint, on the same number of processes. The mesh is neither
+     * adapted nor rebuilt. The fields must be defined on @p mesh, and their
+     * boundary conditions attached again afterwards.
+     */
+    template <class D, class Config, class... T>
+    void load_checkpoint(const std::filesystem::path& path, const std::string& filename, Mesh_base<D, Config>& mesh, T&... fields)
+    {
+        SAMURAI_PROFILE_SCOPE("checkpoint/load");
+        std::lock_guard<std::recursive_mutex> lock(detail::hdf5_mutex());
+        HighFive::File file(detail::checkpoint_file(path, filename).string(), HighFive::File::ReadOnly);
+        detail::check_checkpoint_header(file, Mesh_base<D, Config>::dim);
+
+        detail::CheckpointReader reader(file, "/mesh");
+        mesh.load_state(reader);
+        (detail::load_field_checkpoint(file, fields), ...);
+    }
+
+    /**
+     * Checks that the boundary conditions attached to the fields are of the
+     * same kind as the ones of the checkpoint, and throws otherwise.
+     */
+    template <class... T>
+    void check_checkpoint_bc(const std::filesystem::path& path, const std::string& filename, const T&... fields)
+    {
+        std::lock_guard<std::recursive_mutex> lock(detail::hdf5_mutex());
+        HighFive::File file(detail::checkpoint_file(path, filename).string(), HighFive::File::ReadOnly);
+
+        auto check = [&](const auto& field)
+        {
+            std::vector<std::string> stored;
+            file.getDataSet(fmt::format("/fields/{}/bc", field.name())).read(stored);
+            if (stored != detail::bc_description(field))
+            {
+                throw std::runtime_error(fmt::format("The boundary conditions of the field {} differ from the ones of the checkpoint.",
+                                                     field.name()));
+            }
+        };
+        (check(fields), ...);
+    }
+}
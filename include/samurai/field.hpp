@@ -23,9 +23,12 @@ namespace fs = std::filesystem;
 #include "cell.hpp"
 #include "cell_array.hpp"
 #include "field_expression.hpp"
+#include "ghost_exchange.hpp"
 // #include "hdf5.hpp"
+#include "memory_pool.hpp"
 #include "mesh_holder.hpp"
 #include "numeric/gauss_legendre.hpp"
+#include "storage_cursor.hpp"
 
 namespace samurai
 {
@@ -53,6 +56,22 @@ namespace samurai
         template <class Field>
         struct inner_field_types;
 
+        /// Storage of the values, recycled across the adaptations with SAMURAI_WITH_FIELD_POOL
+#ifdef SAMURAI_WITH_FIELD_POOL
+        template <class value_t, std::size_t N>
+        using field_data_t = xt::xtensor<value_t, N, XTENSOR_DEFAULT_LAYOUT, pool_allocator<value_t>>;
+#else
+        template <class value_t, std::size_t N>
+        using field_data_t = xt::xtensor<value_t, N>;
+#endif
+
+        /// Range of the cells of interval in the storage, interval.start being at start
+        template <class index_t, class interval_t>
+        inline auto storage_range(index_t start, const interval_t& interval)
+        {
+            return xt::range(start, start + (interval.end - interval.start), interval.step);
+        }
+
         template <class D>
         struct crtp_field
         {
@@ -81,7 +100,8 @@ namespace samurai
             using interval_t                 = typename mesh_t::interval_t;
             using index_t                    = typename interval_t::index_t;
             using cell_t                     = Cell<dim, interval_t>;
-            using data_type                  = xt::xtensor<value_t, 1>;
+            using cursor_t                   = StorageCursor<dim, interval_t>;
+            using data_type                  = field_data_t<value_t, 1>;
 
             inline const value_t& operator[](index_t i) const
             {
@@ -147,6 +167,18 @@ namespace samurai
                 return data;
             }
 
+            inline auto operator()(const cursor_t& cursor)
+            {
+                auto start = this->derived_cast().storage_start("READ OR WRITE", cursor);
+                return xt::view(this->derived_cast().m_data, storage_range(start, cursor.interval));
+            }
+
+            inline auto operator()(const cursor_t& cursor) const
+            {
+                auto start = this->derived_cast().storage_start("READ", cursor);
+                return xt::view(this->derived_cast().m_data, storage_range(start, cursor.interval));
+            }
+
             void resize()
             {
                 this->derived_cast().m_data.resize({this->derived_cast().mesh().nb_cells()});
@@ -168,7 +200,8 @@ namespace samurai
             using interval_t                 = typename mesh_t::interval_t;
             using index_t                    = typename interval_t::index_t;
             using cell_t                     = Cell<dim, interval_t>;
-            using data_type                  = xt::xtensor<value_t, 2>;
+            using cursor_t                   = StorageCursor<dim, interval_t>;
+            using data_type                  = field_data_t<value_t, 2>;
 
             inline auto operator[](index_t i) const
             {
@@ -281,6 +314,42 @@ namespace samurai
                                 xt::range(item_s, item_e));
             }
 
+            inline auto operator()(const cursor_t& cursor)
+            {
+                auto start = this->derived_cast().storage_start("READ OR WRITE", cursor);
+                return xt::view(this->derived_cast().m_data, storage_range(start, cursor.interval));
+            }
+
+            inline auto operator()(const cursor_t& cursor) const
+            {
+                auto start = this->derived_cast().storage_start("READ", cursor);
+                return xt::view(this->derived_cast().m_data, storage_range(start, cursor.interval));
+            }
+
+            inline auto operator()(std::size_t item, const cursor_t& cursor)
+            {
+                auto start = this->derived_cast().storage_start("WRITE", cursor);
+                return xt::view(this->derived_cast().m_data, storage_range(start, cursor.interval), item);
+            }
+
+            inline auto operator()(std::size_t item, const cursor_t& cursor) const
+            {
+                auto start = this->derived_cast().storage_start("READ", cursor);
+                return xt::view(this->derived_cast().m_data, storage_range(start, cursor.interval), item);
+            }
+
+            inline auto operator()(std::size_t item_s, std::size_t item_e, const cursor_t& cursor)
+            {
+                auto start = this->derived_cast().storage_start("WRITE", cursor);
+                return xt::view(this->derived_cast().m_data, storage_range(start, cursor.interval), xt::range(item_s, item_e));
+            }
+
+            inline auto operator()(std::size_t item_s, std::size_t item_e, const cursor_t& cursor) const
+            {
+                auto start = this->derived_cast().storage_start("READ", cursor);
+                return xt::view(this->derived_cast().m_data, storage_range(start, cursor.interval), xt::range(item_s, item_e));
+            }
+
             void resize()
             {
                 this->derived_cast().m_data.resize({this->derived_cast().mesh().nb_cells(), size});
@@ -296,7 +365,8 @@ namespace samurai
             static constexpr std::size_t dim = mesh_t::dim;
             using interval_t                 = typename mesh_t::interval_t;
             using cell_t                     = Cell<dim, interval_t>;
-            using data_type                  = xt::xtensor<value_t, 2>;
+            using cursor_t                   = StorageCursor<dim, interval_t>;
+            using data_type                  = field_data_t<value_t, 2>;
 
             inline auto operator[](std::size_t i) const
             {
@@ -402,6 +472,42 @@ namespace samurai
                                 xt::range(interval_tmp.index + interval.start, interval_tmp.index + interval.end, interval.step));
             }
 
+            inline auto operator()(const cursor_t& cursor)
+            {
+                auto start = this->derived_cast().storage_start("READ OR WRITE", cursor);
+                return xt::view(this->derived_cast().m_data, xt::all(), storage_range(start, cursor.interval));
+            }
+
+            inline auto operator()(const cursor_t& cursor) const
+            {
+                auto start = this->derived_cast().storage_start("READ", cursor);
+                return xt::view(this->derived_cast().m_data, xt::all(), storage_range(start, cursor.interval));
+            }
+
+            inline auto operator()(std::size_t item, const cursor_t& cursor)
+            {
+                auto start = this->derived_cast().storage_start("WRITE", cursor);
+                return xt::view(this->derived_cast().m_data, item, storage_range(start, cursor.interval));
+            }
+
+            inline auto operator()(std::size_t item, const cursor_t& cursor) const
+            {
+                auto start = this->derived_cast().storage_start("READ", cursor);
+                return xt::view(this->derived_cast().m_data, item, storage_range(start, cursor.interval));
+            }
+
+            inline auto operator()(std::size_t item_s, std::size_t item_e, const cursor_t& cursor)
+            {
+                auto start = this->derived_cast().storage_start("WRITE", cursor);
+                return xt::view(this->derived_cast().m_data, xt::range(item_s, item_e), storage_range(start, cursor.interval));
+            }
+
+            inline auto operator()(std::size_t item_s, std::size_t item_e, const cursor_t& cursor) const
+            {
+                auto start = this->derived_cast().storage_start("READ", cursor);
+                return xt::view(this->derived_cast().m_data, xt::range(item_s, item_e), storage_range(start, cursor.interval));
+            }
+
             void resize()
             {
                 this->derived_cast().m_data.resize({size, this->derived_cast().mesh().nb_cells()});
@@ -439,6 +545,8 @@ namespace samurai
         using inner_types::dim;
         using interval_t = typename mesh_t::interval_t;
         using cell_t     = typename inner_types::cell_t;
+        using cursor_t   = typename inner_types::cursor_t;
+        using index_t    = typename interval_t::index_t;
 
         using iterator               = Field_iterator<self_type, false>;
         using const_iterator         = Field_iterator<const self_type, true>;
@@ -478,6 +586,12 @@ namespace samurai
         auto& get_bc();
         const auto& get_bc() const;
         void copy_bc_from(const Field& other);
+        ExtrapolationBcCache<Field>& extrapolation_bc();
+        GhostExchange<Field>& ghost_exchange();
+
+        template <class... T>
+        cursor_t storage_cursor(std::size_t level, const interval_t& interval, const T... index) const;
+        index_t storage_offset(const cursor_t& cursor) const;
 
         iterator begin();
         const_iterator begin() const;
@@ -498,17 +612,21 @@ namespace samurai
       private:
 
         template <class... T>
-        const interval_t& get_interval(std::string rw, std::size_t level, const interval_t& interval, const T... index) const;
+        const interval_t& get_interval(const char* rw, std::size_t level, const interval_t& interval, const T... index) const;
 
-        const interval_t& get_interval(std::string rw,
+        const interval_t& get_interval(const char* rw,
                                        std::size_t level,
                                        const interval_t& interval,
                                        const xt::xtensor_fixed<value_t, xt::xshape<dim - 1>>& index) const;
 
+        index_t storage_start(const char* rw, const cursor_t& cursor) const;
+
         std::string m_name;
         data_type m_data;
 
         bc_container p_bc;
+        ExtrapolationBcCache<Field> m_extrapolation_bc;          ///< Built by update_bc for the current mesh
+        std::unique_ptr<GhostExchange<Field>> m_ghost_exchange; ///< Not copied: built by the first exchange
 
         friend struct detail::inner_field_types<Field<mesh_t, value_t, size_, SOA>>;
     };
@@ -677,7 +795,7 @@ namespace samurai
     template <class mesh_t, class value_t, std::size_t size_, bool SOA>
     template <class... T>
     inline auto
-    Field<mesh_t, value_t, size_, SOA>::get_interval(std::string rw, std::size_t level, const interval_t& interval, const T... index) const
+    Field<mesh_t, value_t, size_, SOA>::get_interval(const char* rw, std::size_t level, const interval_t& interval, const T... index) const
         -> const interval_t&
     {
         const interval_t& interval_tmp = this->mesh().get_interval(level, interval, index...);
@@ -709,7 +827,7 @@ namespace samurai
     }
 
     template <class mesh_t, class value_t, std::size_t size_, bool SOA>
-    inline auto Field<mesh_t, value_t, size_, SOA>::get_interval(std::string rw,
+    inline auto Field<mesh_t, value_t, size_, SOA>::get_interval(const char* rw,
                                                                  std::size_t level,
                                                                  const interval_t& interval,
                                                                  const xt::xtensor_fixed<value_t, xt::xshape<dim - 1>>& index) const
@@ -725,6 +843,50 @@ namespace samurai
         return interval_tmp;
     }
 
+    /**
+     * Position in the storage of interval.start, from the offset of the cursor
+     * if it has been computed on the mesh of the field.
+     */
+    template <class mesh_t, class value_t, std::size_t size_, bool SOA>
+    inline auto Field<mesh_t, value_t, size_, SOA>::storage_start(const char* rw, const cursor_t& cursor) const -> index_t
+    {
+        if (cursor.is_stored_in(detail::mesh_version(this->mesh())))
+        {
+            return cursor.offset;
+        }
+        return get_interval(rw, cursor.level, cursor.interval, cursor.index).index + cursor.interval.start;
+    }
+
+    /**
+     * Cursor on the cells of interval at level, with its position in the
+     * storage: the accesses through the cursor do not look for the interval
+     * again.
+     */
+    template <class mesh_t, class value_t, std::size_t size_, bool SOA>
+    template <class... T>
+    inline auto Field<mesh_t, value_t, size_, SOA>::storage_cursor(std::size_t level, const interval_t& interval, const T... index) const
+        -> cursor_t
+    {
+        static_assert(sizeof...(T) == dim - 1, "The cursor needs the dim-1 coordinates of the interval");
+
+        cursor_t cursor;
+        cursor.level    = level;
+        cursor.interval = interval;
+        if constexpr (dim > 1)
+        {
+            cursor.index = {static_cast<typename interval_t::coord_index_t>(index)...};
+        }
+        cursor.offset  = get_interval("READ OR WRITE", level, interval, index...).index + interval.start;
+        cursor.version = detail::mesh_version(this->mesh());
+        return cursor;
+    }
+
+    template <class mesh_t, class value_t, std::size_t size_, bool SOA>
+    inline auto Field<mesh_t, value_t, size_, SOA>::storage_offset(const cursor_t& cursor) const -> index_t
+    {
+        return storage_start("READ OR WRITE", cursor);
+    }
+
     template <class mesh_t, class value_t, std::size_t size_, bool SOA>
     inline auto Field<mesh_t, value_t, size_, SOA>::array() const -> const data_type&
     {
@@ -794,6 +956,24 @@ namespace samurai
         return p_bc;
     }
 
+    /// Polynomial extrapolations of the ghosts that are not set by the B.C.
+    template <class mesh_t, class value_t, std::size_t size_, bool SOA>
+    inline auto Field<mesh_t, value_t, size_, SOA>::extrapolation_bc() -> ExtrapolationBcCache<Field>&
+    {
+        return m_extrapolation_bc;
+    }
+
+    /// Buffers and requests of the ghost exchanges between the subdomains
+    template <class mesh_t, class value_t, std::size_t size_, bool SOA>
+    inline auto Field<mesh_t, value_t, size_, SOA>::ghost_exchange() -> GhostExchange<Field>&
+    {
+        if (!m_ghost_exchange)
+        {
+            m_ghost_exchange = std::make_unique<GhostExchange<Field>>();
+        }
+        return *m_ghost_exchange;
+    }
+
     template <class mesh_t, class value_t, std::size_t size_, bool SOA>
     void Field<mesh_t, value_t, size_, SOA>::copy_bc_from(const Field<mesh_t, value_t, size_, SOA>& other)
     {
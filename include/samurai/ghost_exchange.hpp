@@ -0,0 +1,416 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#ifdef SAMURAI_WITH_MPI
+#include <boost/mpi.hpp>
+namespace mpi = boost::mpi;
+#endif
+
+#include "algorithm.hpp"
+#include "level_cell_list.hpp"
+#include "mesh_halo.hpp"
+#include "samurai.hpp"
+#include "subset/materialized_subset.hpp"
+#include "subset/node_op.hpp"
+#include "subset/subset_op.hpp"
+
+namespace samurai
+{
+    namespace detail
+    {
+        /// Tag of the ghost exchanges of a level in ghost_exchange_comm()
+        inline int ghost_exchange_tag(std::size_t level)
+        {
+            return static_cast<int>(level);
+        }
+    }
+
+    /**
+     * @class GhostExchange
+     * @brief Exchange of the ghosts of a field between the subdomains, split
+     * in two phases.
+     *
+     * The interfaces with the neighbouring subdomains, the pack buffers and
+     * the persistent MPI requests of a level are built by the first exchange
+     * on a version of the mesh and reused by the next ones. Between start()
+     * and finish(), the cells of the level which do not depend on the
+     * neighbours (see interior()) can be computed.
+     *
+     * Every process exchanges with each of its neighbours at each level
+     * (possibly empty messages): the exchanges of the fields of a level must
+     * be started in the same order on all the processes. Without MPI,
+     * start() and finish() do nothing.
+     */
+    template <class Field>
+    class GhostExchange
+    {
+      public:
+
+        using mesh_t                     = typename Field::mesh_t;
+        using value_t                    = typename Field::value_type;
+        using interval_t                 = typename mesh_t::interval_t;
+        using lca_type                   = typename mesh_t::lca_type;
+        static constexpr std::size_t dim = mesh_t::dim;
+        using plan_t                     = MaterializedSubset<dim, interval_t>;
+
+        GhostExchange() = default;
+        ~GhostExchange();
+
+        // The persistent requests refer to the buffers of this object
+        GhostExchange(const GhostExchange&)            = delete;
+        GhostExchange& operator=(const GhostExchange&) = delete;
+        GhostExchange(GhostExchange&&)                 = delete;
+        GhostExchange& operator=(GhostExchange&&)      = delete;
+
+        void start(Field& field, std::size_t level);
+        void finish(Field& field, std::size_t level);
+
+        const plan_t& interior(const mesh_t& mesh, std::size_t level, std::size_t stencil_width);
+        const plan_t& boundary(const mesh_t& mesh, std::size_t level, std::size_t stencil_width);
+
+        const plan_t& projection_interior(const mesh_t& mesh, std::size_t level);
+        const plan_t& projection_boundary(const mesh_t& mesh, std::size_t level);
+
+        void clear();
+
+      private:
+
+        struct channel_t
+        {
+            plan_t out; ///< Cells of the subdomain which are ghosts of the neighbour
+            plan_t in;  ///< Ghosts of the subdomain which are cells of the neighbour
+            std::vector<value_t> send;
+            std::vector<value_t> recv;
+        };
+
+        struct level_t
+        {
+            bool has_channels   = false;
+            std::size_t version = 0;
+            std::vector<channel_t> channels;
+#ifdef SAMURAI_WITH_MPI
+            std::vector<MPI_Request> requests; ///< Sends, then receives
+#endif
+            bool active = false;
+
+            bool has_overlap            = false;
+            std::size_t overlap_version = 0;
+            std::size_t stencil_width   = 0;
+            plan_t interior;
+            plan_t boundary;
+
+            bool has_projection            = false;
+            std::size_t projection_version = 0;
+            plan_t projection_interior;
+            plan_t projection_boundary;
+        };
+
+        level_t& get(std::size_t level);
+        void build_channels(const mesh_t& mesh, std::size_t level);
+        void build_overlap(const mesh_t& mesh, std::size_t level, std::size_t stencil_width);
+        void build_projection_overlap(const mesh_t& mesh, std::size_t level);
+        void free_requests(level_t& l);
+
+        std::vector<level_t> m_levels;
+    };
+
+    template <class Field>
+    GhostExchange<Field>::~GhostExchange()
+    {
+        for (auto& l : m_levels)
+        {
+            free_requests(l);
+        }
+    }
+
+    /**
+     * Packs the cells of the subdomain at level which are ghosts of the
+     * neighbours and starts the sends and the receives: the ghosts of the
+     * level must not be read until finish().
+     */
+    template <class Field>
+    void GhostExchange<Field>::start([[maybe_unused]] Field& field, [[maybe_unused]] std::size_t level)
+    {
+#ifdef SAMURAI_WITH_MPI
+        const auto& mesh = field.mesh();
+        auto& l          = get(level);
+        if (!l.has_channels || l.version != mesh.version() || l.channels.size() != mesh.mpi_neighbourhood().size())
+        {
+            build_channels(mesh, level);
+        }
+
+        assert(!l.active && "The ghost exchange of this level is already started");
+        for (auto& channel : l.channels)
+        {
+            auto* data = channel.send.data();
+            for (const auto& record : channel.out.records())
+            {
+                auto values = field(channel.out.cursor(record));
+                data        = std::copy(values.begin(), values.end(), data);
+            }
+        }
+        MPI_Startall(static_cast<int>(l.requests.size()), l.requests.data());
+        l.active = true;
+#endif
+    }
+
+    /// Waits for the ghosts of the neighbours at level and unpacks them
+    template <class Field>
+    void GhostExchange<Field>::finish([[maybe_unused]] Field& field, [[maybe_unused]] std::size_t level)
+    {
+#ifdef SAMURAI_WITH_MPI
+        auto& l = get(level);
+        assert(l.active && "The ghost exchange of this level is not started");
+        MPI_Waitall(static_cast<int>(l.requests.size()), l.requests.data(), MPI_STATUSES_IGNORE);
+        l.active = false;
+
+        for (auto& channel : l.channels)
+        {
+            const auto* data = channel.recv.data();
+            for (const auto& record : channel.in.records())
+            {
+                auto values = field(channel.in.cursor(record));
+                auto size   = static_cast<std::ptrdiff_t>(values.size());
+                std::copy(data, data + size, values.begin());
+                data += size;
+            }
+        }
+#endif
+    }
+
+    /**
+     * Cells of the mesh at level whose stencil, of stencil_width cells in
+     * each direction, does not reach the subdomains of the neighbours: they
+     * can be computed while the ghosts are exchanged.
+     */
+    template <class Field>
+    auto GhostExchange<Field>::interior(const mesh_t& mesh, std::size_t level, std::size_t stencil_width) -> const plan_t&
+    {
+        build_overlap(mesh, level, stencil_width);
+        return get(level).interior;
+    }
+
+    /// The other cells of the mesh at level, to be computed after finish()
+    template <class Field>
+    auto GhostExchange<Field>::boundary(const mesh_t& mesh, std::size_t level, std::size_t stencil_width) -> const plan_t&
+    {
+        build_overlap(mesh, level, stencil_width);
+        return get(level).boundary;
+    }
+
+    /**
+     * Parents at level - 1 projected from the cells of level by
+     * update_ghost_mr whose children are all in the subdomain: they can be
+     * projected while the ghosts of level are exchanged.
+     */
+    template <class Field>
+    auto GhostExchange<Field>::projection_interior(const mesh_t& mesh, std::size_t level) -> const plan_t&
+    {
+        build_projection_overlap(mesh, level);
+        return get(level).projection_interior;
+    }
+
+    /// The other parents, to be projected after finish() and the update of the periodic ghosts
+    template <class Field>
+    auto GhostExchange<Field>::projection_boundary(const mesh_t& mesh, std::size_t level) -> const plan_t&
+    {
+        build_projection_overlap(mesh, level);
+        return get(level).projection_boundary;
+    }
+
+    template <class Field>
+    void GhostExchange<Field>::clear()
+    {
+        for (auto& l : m_levels)
+        {
+            free_requests(l);
+        }
+        m_levels.clear();
+    }
+
+    template <class Field>
+    auto GhostExchange<Field>::get(std::size_t level) -> level_t&
+    {
+        if (m_levels.size() <= level)
+        {
+            m_levels.resize(level + 1);
+        }
+        return m_levels[level];
+    }
+
+    template <class Field>
+    void GhostExchange<Field>::build_channels([[maybe_unused]] const mesh_t& mesh, [[maybe_unused]] std::size_t level)
+    {
+#ifdef SAMURAI_WITH_MPI
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+
+        auto& l = get(level);
+        free_requests(l);
+        l.channels.clear();
+        l.channels.resize(mesh.mpi_neighbourhood().size());
+        l.has_channels = true;
+        l.version      = mesh.version();
+
+        const auto& reference = mesh[mesh_id_t::reference][level];
+        const int tag         = detail::ghost_exchange_tag(level);
+        MPI_Comm comm         = detail::ghost_exchange_comm();
+        for (std::size_t n = 0; n < l.channels.size(); ++n)
+        {
+            const auto& neighbour = mesh.mpi_neighbourhood()[n];
+            auto& channel         = l.channels[n];
+            if (!reference.empty() && !neighbour.mesh[mesh_id_t::reference][level].empty())
+            {
+                auto out_interface = intersection(reference, neighbour.mesh[mesh_id_t::reference][level], mesh.subdomain()).on(level);
+                auto in_interface  = intersection(neighbour.mesh[mesh_id_t::reference][level], reference, neighbour.mesh.subdomain())
+                                        .on(level);
+                channel.out.assign(out_interface, reference, mesh.version());
+                channel.in.assign(in_interface, reference, mesh.version());
+            }
+            channel.send.resize(channel.out.nb_cells() * Field::size);
+            channel.recv.resize(channel.in.nb_cells() * Field::size);
+        }
+
+        // The buffers are not resized until the next version of the mesh
+        l.requests.resize(2 * l.channels.size());
+        for (std::size_t n = 0; n < l.channels.size(); ++n)
+        {
+            const int rank = mesh.mpi_neighbourhood()[n].rank;
+            auto& channel  = l.channels[n];
+            MPI_Send_init(channel.send.data(),
+                          static_cast<int>(channel.send.size() * sizeof(value_t)),
+                          MPI_BYTE,
+                          rank,
+                          tag,
+                          comm,
+                          &l.requests[n]);
+            MPI_Recv_init(channel.recv.data(),
+                          static_cast<int>(channel.recv.size() * sizeof(value_t)),
+                          MPI_BYTE,
+                          rank,
+                          tag,
+                          comm,
+                          &l.requests[l.channels.size() + n]);
+        }
+#endif
+    }
+
+    /**
+     * The cells depending on the neighbours are the ones of level cells
+     * around the subdomains of the neighbours, in the band they have sent.
+     */
+    template <class Field>
+    void GhostExchange<Field>::build_overlap(const mesh_t& mesh, std::size_t level, std::size_t stencil_width)
+    {
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+
+        auto& l = get(level);
+        if (l.has_overlap && l.overlap_version == mesh.version() && l.stencil_width == stencil_width)
+        {
+            return;
+        }
+
+        LevelCellList<dim, interval_t> lcl{level};
+#ifdef SAMURAI_WITH_MPI
+        for (const auto& neighbour : mesh.mpi_neighbourhood())
+        {
+            const auto& subdomain = neighbour.mesh.subdomain();
+            if (!subdomain.empty())
+            {
+                lca_type projected = intersection(subdomain, subdomain).on(level);
+                for_each_interval(detail::dilate(projected, stencil_width),
+                                  [&](std::size_t, const auto& i, const auto& index)
+                                  {
+                                      lcl[index].add_interval(i);
+                                  });
+            }
+        }
+#endif
+        lca_type dependent = {lcl};
+
+        const auto& cells     = mesh[mesh_id_t::cells][level];
+        const auto& reference = mesh[mesh_id_t::reference][level];
+        if (dependent.empty())
+        {
+            auto all_cells = intersection(cells, cells).on(level);
+            l.interior.assign(all_cells, reference, mesh.version());
+            l.boundary.clear();
+        }
+        else
+        {
+            auto interior_cells = difference(cells, dependent).on(level);
+            auto boundary_cells = intersection(cells, dependent).on(level);
+            l.interior.assign(interior_cells, reference, mesh.version());
+            l.boundary.assign(boundary_cells, reference, mesh.version());
+        }
+        l.has_overlap     = true;
+        l.overlap_version = mesh.version();
+        l.stencil_width   = stencil_width;
+    }
+
+    /**
+     * A parent which meets the subdomain eroded by its width minus one cell
+     * of the subdomain level is in the subdomain.
+     */
+    template <class Field>
+    void GhostExchange<Field>::build_projection_overlap(const mesh_t& mesh, std::size_t level)
+    {
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+
+        assert(level > 0);
+        auto& l = get(level);
+        if (l.has_projection && l.projection_version == mesh.version())
+        {
+            return;
+        }
+
+        const auto& subdomain = mesh.subdomain();
+        std::size_t radius    = 0;
+        if (subdomain.level() > level - 1)
+        {
+            radius = (std::size_t{1} << (subdomain.level() - (level - 1))) - 1;
+        }
+        lca_type inner = detail::erode(subdomain, radius);
+
+        lca_type parents   = intersection(mesh[mesh_id_t::reference][level], mesh[mesh_id_t::proj_cells][level - 1]).on(level - 1);
+        lca_type contained = intersection(parents, inner).on(level - 1);
+
+        const auto& reference = mesh[mesh_id_t::reference][level - 1];
+        auto interior_parents = intersection(contained, contained).on(level - 1);
+        auto boundary_parents = difference(parents, contained).on(level - 1);
+        l.projection_interior.assign(interior_parents, reference, mesh.version());
+        l.projection_boundary.assign(boundary_parents, reference, mesh.version());
+        l.has_projection     = true;
+        l.projection_version = mesh.version();
+    }
+
+    template <class Field>
+    void GhostExchange<Field>::free_requests([[maybe_unused]] level_t& l)
+    {
+#ifdef SAMURAI_WITH_MPI
+        // The fields may outlive MPI
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+        {
+            if (l.active)
+            {
+                MPI_Waitall(static_cast<int>(l.requests.size()), l.requests.data(), MPI_STATUSES_IGNORE);
+            }
+            for (auto& request : l.requests)
+            {
+                MPI_Request_free(&request);
+            }
+        }
+        l.requests.clear();
+        l.active = false;
+#endif
+    }
+}
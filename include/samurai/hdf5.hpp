@@ -6,10 +6,18 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <fstream>
 #include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -38,6 +46,9 @@ namespace mpi = boost::mpi;
 
 #include "algorithm.hpp"
 #include "cell.hpp"
+#include "cell_array.hpp"
+#include "cell_list.hpp"
+#include "profiling.hpp"
 #include "utils.hpp"
 
 namespace samurai
@@ -82,6 +93,259 @@ namespace samurai
         };
     }
 
+    namespace detail
+    {
+        /// Number of rows written at once in a dataset by default
+        static constexpr std::size_t default_chunk_size = 1 << 16;
+
+        /**
+         * Mutex held during every access to the HDF5 library (outputs and
+         * checkpoints): HDF5 is not built thread-safe in general, and the
+         * outputs of AsyncSaver are written by a background thread.
+         */
+        inline std::recursive_mutex& hdf5_mutex()
+        {
+            static std::recursive_mutex mutex;
+            return mutex;
+        }
+
+        /// Gathers a size from all the processes
+        inline std::vector<std::size_t> gather_sizes(std::size_t local_size)
+        {
+#ifdef SAMURAI_WITH_MPI
+            mpi::communicator world;
+            std::vector<std::size_t> sizes;
+            mpi::all_gather(world, local_size, sizes);
+            return sizes;
+#else
+            return {local_size};
+#endif
+        }
+
+        template <std::size_t dim, class TInterval>
+        inline std::size_t finest_level(const LevelCellArray<dim, TInterval>& lca)
+        {
+            return lca.level();
+        }
+
+        template <std::size_t dim, class TInterval, std::size_t max_size>
+        inline std::size_t finest_level(const CellArray<dim, TInterval, max_size>& ca)
+        {
+            return ca.max_level();
+        }
+
+        /**
+         * Integer coordinates on the finest level of the corners of a cell,
+         * in the order of get_element.
+         */
+        template <std::size_t dim, class Cell>
+        inline auto corner_indices(const Cell& cell, std::size_t finest_level)
+        {
+            static const auto element = get_element(std::integral_constant<std::size_t, dim>{});
+            const std::int64_t scale  = std::int64_t{1} << (finest_level - cell.level);
+
+            std::array<std::array<std::int64_t, dim>, (1 << dim)> corners;
+            for (std::size_t e = 0; e < corners.size(); ++e)
+            {
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    std::int64_t offset;
+                    if constexpr (dim == 1)
+                    {
+                        offset = static_cast<std::int64_t>(element[e]);
+                    }
+                    else
+                    {
+                        offset = static_cast<std::int64_t>(element[e][d]);
+                    }
+                    corners[e][d] = (static_cast<std::int64_t>(cell.indices[d]) + offset) * scale;
+                }
+            }
+            return corners;
+        }
+
+        /// Bounding box of the corners of the cells of a mesh on the finest level
+        template <class Mesh>
+        auto corner_bounds(const Mesh& mesh, std::size_t finest_level)
+        {
+            static constexpr std::size_t dim = Mesh::dim;
+
+            std::array<std::int64_t, dim> min;
+            std::array<std::int64_t, dim> max;
+            min.fill(std::numeric_limits<std::int64_t>::max());
+            max.fill(std::numeric_limits<std::int64_t>::min());
+            for_each_interval(mesh,
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  const std::int64_t scale = std::int64_t{1} << (finest_level - level);
+                                  min[0] = std::min(min[0], static_cast<std::int64_t>(i.start) * scale);
+                                  max[0] = std::max(max[0], static_cast<std::int64_t>(i.end) * scale);
+                                  for (std::size_t d = 1; d < dim; ++d)
+                                  {
+                                      min[d] = std::min(min[d], static_cast<std::int64_t>(index[d - 1]) * scale);
+                                      max[d] = std::max(max[d], (static_cast<std::int64_t>(index[d - 1]) + 1) * scale);
+                                  }
+                              });
+            return std::make_pair(min, max);
+        }
+
+        /**
+         * Numbers the corners of the cells of a mesh without duplicates.
+         *
+         * The corners are identified by a key built from their integer coordinates
+         * on the finest level: there is neither a tree nor any floating point
+         * comparison. The keys of each chunk of cells are sorted and deduplicated
+         * before being appended to the sorted list of the distinct corners, so that
+         * the keys of all the corners of the mesh are never stored at once. The
+         * points are then numbered in the order of their first appearance in the
+         * traversal of the cells, as with the former std::map, and passed to the
+         * callbacks instead of being stored.
+         *
+         * @param make_key converts the integer coordinates of a corner into a Key
+         * @param on_nb_points called with the number of points before the numbering
+         * @param on_point called with the coordinates of each point, by increasing number
+         * @param on_corner called with the number of each corner of each cell, in the order of the cells
+         */
+        template <class Key, class Mesh, class MakeKey, class NbPointsFunc, class PointFunc, class CornerFunc>
+        void number_points(const Mesh& mesh,
+                           std::size_t finest_level,
+                           MakeKey&& make_key,
+                           NbPointsFunc&& on_nb_points,
+                           PointFunc&& on_point,
+                           CornerFunc&& on_corner)
+        {
+            static constexpr std::size_t dim                = Mesh::dim;
+            static constexpr std::size_t nb_points_per_cell = 1 << dim;
+
+            // Sorted keys of the distinct corners
+            std::vector<Key> points;
+            {
+                std::vector<Key> chunk;
+                chunk.reserve(std::min(mesh.nb_cells(), default_chunk_size) * nb_points_per_cell);
+                std::size_t nb_sorted = 0;
+
+                auto sort_unique = [](std::vector<Key>& keys)
+                {
+                    std::sort(keys.begin(), keys.end());
+                    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+                };
+                auto flush = [&]()
+                {
+                    sort_unique(chunk);
+                    points.insert(points.end(), chunk.begin(), chunk.end());
+                    chunk.clear();
+                    // The corners shared by several chunks are removed when they may double the list
+                    if (points.size() > 2 * nb_sorted)
+                    {
+                        sort_unique(points);
+                        nb_sorted = points.size();
+                    }
+                };
+
+                for_each_cell(mesh,
+                              [&](const auto& cell)
+                              {
+                                  for (const auto& corner : corner_indices<dim>(cell, finest_level))
+                                  {
+                                      chunk.push_back(make_key(corner));
+                                  }
+                                  if (chunk.size() >= default_chunk_size * nb_points_per_cell)
+                                  {
+                                      flush();
+                                  }
+                              });
+                flush();
+                if (points.size() != nb_sorted)
+                {
+                    sort_unique(points);
+                }
+                points.shrink_to_fit();
+            }
+
+            static constexpr std::size_t not_numbered = std::numeric_limits<std::size_t>::max();
+            std::vector<std::size_t> new_id(points.size(), not_numbered);
+            on_nb_points(points.size());
+
+            const double length   = cell_length(finest_level);
+            std::size_t nb_points = 0;
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              for (const auto& corner : corner_indices<dim>(cell, finest_level))
+                              {
+                                  auto position = static_cast<std::size_t>(
+                                      std::lower_bound(points.begin(), points.end(), make_key(corner)) - points.begin());
+                                  if (new_id[position] == not_numbered)
+                                  {
+                                      new_id[position] = nb_points++;
+                                      std::array<double, 3> coords{0., 0., 0.};
+                                      for (std::size_t d = 0; d < dim; ++d)
+                                      {
+                                          coords[d] = length * static_cast<double>(corner[d]);
+                                      }
+                                      on_point(coords);
+                                  }
+                                  on_corner(new_id[position]);
+                              }
+                          });
+        }
+
+        /**
+         * Writes the rows of the local part of a dataset by chunks of bounded size,
+         * so that the data never has to be fully copied in memory.
+         */
+        template <class T>
+        class ChunkedWriter
+        {
+          public:
+
+            /// @param row_size number of values per row, 0 for a 1d dataset
+            ChunkedWriter(const HighFive::DataSet& dataset, std::size_t row_size, std::size_t chunk_size)
+                : m_dataset(dataset)
+                , m_row_size(row_size)
+                , m_capacity(std::max(chunk_size, std::size_t{1}) * std::max(row_size, std::size_t{1}))
+            {
+                m_buffer.reserve(m_capacity);
+            }
+
+            void push(const T& value)
+            {
+                m_buffer.push_back(value);
+                if (m_buffer.size() == m_capacity)
+                {
+                    flush();
+                }
+            }
+
+            void flush()
+            {
+                std::size_t nb_rows = m_buffer.size() / std::max(m_row_size, std::size_t{1});
+                if (nb_rows == 0)
+                {
+                    return;
+                }
+                if (m_row_size == 0)
+                {
+                    m_dataset.select({m_row}, {nb_rows}).write_raw(m_buffer.data(), HighFive::AtomicType<T>{});
+                }
+                else
+                {
+                    m_dataset.select({m_row, 0}, {nb_rows, m_row_size}).write_raw(m_buffer.data(), HighFive::AtomicType<T>{});
+                }
+                m_row += nb_rows;
+                m_buffer.clear();
+            }
+
+          private:
+
+            HighFive::DataSet m_dataset;
+            std::size_t m_row_size;
+            std::size_t m_capacity;
+            std::size_t m_row = 0;
+            std::vector<T> m_buffer;
+        };
+    }
+
     template <class Field, class SubMesh>
     auto extract_data(const Field& field, const SubMesh& submesh)
     {
@@ -101,67 +365,74 @@ namespace samurai
         return data;
     }
 
-    template <class Mesh>
-    auto extract_coords_and_connectivity(const Mesh& mesh)
+    /**
+     * Traverses the points and the connectivity of a mesh without storing
+     * them (see detail::number_points): on_nb_points is called first, with 0
+     * if the mesh is empty, then on_point with the coordinates (x, y, z) of
+     * each point by increasing number and on_corner with the number of each
+     * corner of each cell.
+     */
+    template <class Mesh, class NbPointsFunc, class PointFunc, class CornerFunc>
+    void for_each_point_and_connectivity(const Mesh& mesh, NbPointsFunc&& on_nb_points, PointFunc&& on_point, CornerFunc&& on_corner)
     {
         static constexpr std::size_t dim = Mesh::dim;
-        std::size_t nb_cells             = mesh.nb_cells();
+        using indices_t                  = std::array<std::int64_t, dim>;
 
-        if (nb_cells == 0)
+        if (mesh.nb_cells() == 0)
         {
-            xt::xtensor<std::size_t, 2> connectivity = xt::zeros<std::size_t>({0, 0});
-            xt::xtensor<double, 2> coords            = xt::zeros<double>({0, 0});
-            return std::make_pair(coords, connectivity);
+            on_nb_points(0);
+            return;
         }
 
-        std::size_t nb_points_per_cell = 1 << dim;
-
-        std::map<std::array<double, dim>, std::size_t> points_id;
-        auto element = get_element(std::integral_constant<std::size_t, dim>{});
+        auto finest_level = detail::finest_level(mesh);
+        auto bounds       = detail::corner_bounds(mesh, finest_level);
+        const auto& min   = bounds.first;
+        const auto& max   = bounds.second;
 
-        xt::xtensor<std::size_t, 2> connectivity;
-        connectivity.resize({nb_cells, nb_points_per_cell});
-
-        std::size_t id    = 0;
-        std::size_t index = 0;
-        for_each_cell(mesh,
-                      [&](auto cell)
-                      {
-                          std::array<double, dim> a;
-                          auto start_corner = cell.corner();
-                          auto c            = xt::xtensor<std::size_t, 1>::from_shape({element.size()});
-                          ;
-
-                          for (std::size_t i = 0; i < element.size(); ++i)
-                          {
-                              auto corner = start_corner + cell.length * element[i];
+        // The coordinates relative to the bounding box are packed in a single integer when they fit in 64 bits
+        std::array<unsigned, dim> shift;
+        std::array<unsigned, dim> width;
+        unsigned nb_bits = 0;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            width[d] = 0;
+            for (auto extent = static_cast<std::uint64_t>(max[d] - min[d]); extent != 0; extent >>= 1)
+            {
+                ++width[d];
+            }
+            shift[d] = nb_bits;
+            nb_bits += width[d];
+        }
 
-                              std::copy(corner.cbegin(), corner.cend(), a.begin());
-                              auto search = points_id.find(a);
-                              if (search == points_id.end())
-                              {
-                                  points_id.emplace(std::make_pair(a, id));
-                                  c[i] = id++;
-                              }
-                              else
-                              {
-                                  c[i] = search->second;
-                              }
-                          }
-                          auto connectivity_view = xt::view(connectivity, index, xt::all());
-                          connectivity_view      = c;
-                          index++;
-                      });
-
-        auto coords = xt::xtensor<double, 2>::from_shape({points_id.size(), 3});
-        coords.fill(0.);
-        for (auto& e : points_id)
+        if (nb_bits <= 64)
         {
-            std::size_t idx  = e.second;
-            auto coords_view = xt::view(coords, idx, xt::range(0, dim));
-            coords_view      = xt::adapt(e.first);
+            detail::number_points<std::uint64_t>(
+                mesh,
+                finest_level,
+                [&](const indices_t& corner)
+                {
+                    std::uint64_t key = 0;
+                    for (std::size_t d = 0; d < dim; ++d)
+                    {
+                        key |= static_cast<std::uint64_t>(corner[d] - min[d]) << shift[d];
+                    }
+                    return key;
+                },
+                on_nb_points,
+                on_point,
+                on_corner);
+            return;
         }
-        return std::make_pair(coords, connectivity);
+        detail::number_points<indices_t>(
+            mesh,
+            finest_level,
+            [](const indices_t& corner)
+            {
+                return corner;
+            },
+            on_nb_points,
+            on_point,
+            on_corner);
     }
 
     template <class D>
@@ -175,6 +446,11 @@ namespace samurai
 
         bool by_level   = false;
         bool by_mesh_id = false;
+        /// Store the intervals (level, start, end, y[, z]) instead of the points and the connectivity.
+        /// This file can be read back with load_compact but not displayed by XDMF readers.
+        bool compact = false;
+        /// Maximum number of rows written at once in a dataset
+        std::size_t chunk_size = detail::default_chunk_size;
     };
 
     template <class Config>
@@ -189,6 +465,8 @@ namespace samurai
         }
 
         bool by_mesh_id;
+        bool compact           = false;
+        std::size_t chunk_size = detail::default_chunk_size;
     };
 
     template <class D>
@@ -224,8 +502,15 @@ namespace samurai
 
       private:
 
+        std::string dataset_path(const std::string& prefix, std::size_t rank, const std::string& name) const;
+
+        template <class T>
+        std::optional<HighFive::DataSet>
+        create_datasets(const std::string& prefix, const std::string& name, const std::vector<std::size_t>& nb_rows, std::size_t row_size);
+
         static HighFive::File create_h5file(const fs::path& path, const std::string& filename);
 
+        std::unique_lock<std::recursive_mutex> m_lock; ///< Held from the opening of the file to the writing of the XDMF
         HighFive::File h5_file;
         fs::path m_path;
         std::string m_filename;
@@ -266,10 +551,11 @@ namespace samurai
         const derived_type& derived_cast() const& noexcept;
         derived_type derived_cast() && noexcept;
 
+        const options_t& options() const;
+
       protected:
 
         const mesh_t& mesh() const;
-        const options_t& options() const;
 
       private:
 
@@ -374,6 +660,7 @@ namespace samurai
     template <class D, class Mesh, class... T>
     inline void SaveCellArray<D, Mesh, T...>::save()
     {
+        SAMURAI_PROFILE_SCOPE("save");
         if (this->options().by_level)
         {
 #ifdef SAMURAI_WITH_MPI
@@ -472,6 +759,7 @@ namespace samurai
     template <class D, class Mesh, class... T>
     inline void SaveLevelCellArray<D, Mesh, T...>::save()
     {
+        SAMURAI_PROFILE_SCOPE("save");
         if (this->options().by_mesh_id)
         {
             for (std::size_t im = 0; im < this->derived_cast().nb_submesh(); ++im)
@@ -498,7 +786,8 @@ namespace samurai
 
     template <class D>
     inline Hdf5<D>::Hdf5(const fs::path& path, const std::string& filename)
-        : h5_file(create_h5file(path, filename))
+        : m_lock(detail::hdf5_mutex())
+        , h5_file(create_h5file(path, filename))
         , m_path(path)
         , m_filename(filename)
     {
@@ -537,255 +826,272 @@ namespace samurai
     }
 
     template <class D>
-    template <class Submesh>
-    inline void
-    Hdf5<D>::save_on_mesh(pugi::xml_node& grid_parent, const std::string& prefix, const Submesh& submesh, const std::string& mesh_name)
+    inline std::string Hdf5<D>::dataset_path(const std::string& prefix, [[maybe_unused]] std::size_t rank, const std::string& name) const
     {
-        static constexpr std::size_t dim = derived_type_save::dim;
-
-        xt::xtensor<std::size_t, 2> local_connectivity;
-        xt::xtensor<double, 2> local_coords;
-        std::tie(local_coords, local_connectivity) = extract_coords_and_connectivity(submesh);
-
 #ifdef SAMURAI_WITH_MPI
         mpi::communicator world;
+        if (world.size() > 1)
+        {
+            return fmt::format("{}/rank_{}/{}", prefix, rank, name);
+        }
+#endif
+        return fmt::format("{}/{}", prefix, name);
+    }
 
-        auto rank = static_cast<std::size_t>(world.rank());
-        auto size = static_cast<std::size_t>(world.size());
-
-        xt::xtensor<std::size_t, 1> connectivity_sizes = xt::empty<std::size_t>({size});
-        mpi::all_gather(world, local_connectivity.shape(0), connectivity_sizes.begin());
-        xt::xtensor<std::size_t, 1> coords_sizes = xt::empty<std::size_t>({size});
-        mpi::all_gather(world, local_coords.shape(0), coords_sizes.begin());
-#else
+    /**
+     * Creates the dataset of each process having rows (collective operation)
+     * and returns the one of the current process, if any.
+     *
+     * @param row_size number of values per row, 0 for a 1d dataset
+     */
+    template <class D>
+    template <class T>
+    inline std::optional<HighFive::DataSet> Hdf5<D>::create_datasets(const std::string& prefix,
+                                                                     const std::string& name,
+                                                                     const std::vector<std::size_t>& nb_rows,
+                                                                     std::size_t row_size)
+    {
         std::size_t rank = 0;
-        std::size_t size = 1;
-        xt::xtensor_fixed<std::size_t, xt::xshape<1>> connectivity_sizes = {local_connectivity.shape(0)};
-        xt::xtensor_fixed<std::size_t, xt::xshape<1>> coords_sizes = {local_coords.shape(0)};
+#ifdef SAMURAI_WITH_MPI
+        mpi::communicator world;
+        rank = static_cast<std::size_t>(world.rank());
 #endif
-
-        std::vector<std::size_t> connectivity_cumsum(size + 1, 0);
-        std::vector<std::size_t> coords_cumsum(size + 1, 0);
-        for (std::size_t i = 0; i < size; ++i)
+        std::optional<HighFive::DataSet> local_dataset;
+        for (std::size_t r = 0; r < nb_rows.size(); ++r)
         {
-            connectivity_cumsum[i + 1] += connectivity_cumsum[i] + connectivity_sizes[i];
+            if (nb_rows[r] != 0)
+            {
+                std::vector<std::size_t> shape{nb_rows[r]};
+                if (row_size != 0)
+                {
+                    shape.push_back(row_size);
+                }
+                auto dataset = h5_file.createDataSet<T>(dataset_path(prefix, r, name), HighFive::DataSpace(shape));
+                if (r == rank)
+                {
+                    local_dataset = dataset;
+                }
+            }
         }
+        return local_dataset;
+    }
 
-        for (std::size_t i = 0; i < size; ++i)
+    template <class D>
+    template <class Submesh>
+    inline void
+    Hdf5<D>::save_on_mesh(pugi::xml_node& grid_parent, const std::string& prefix, const Submesh& submesh, const std::string& mesh_name)
+    {
+        static constexpr std::size_t dim = derived_type_save::dim;
+        const auto& options              = this->derived_cast().options();
+
+        auto nb_cells = detail::gather_sizes(submesh.nb_cells());
+        if (std::accumulate(nb_cells.begin(), nb_cells.end(), std::size_t{0}) == 0)
         {
-            coords_cumsum[i + 1] += coords_cumsum[i] + coords_sizes[i];
+            return;
         }
 
-        if (coords_cumsum.back() != 0)
-        {
-            auto xfer_props = HighFive::DataTransferProps{};
+        std::size_t rank = 0;
 #ifdef SAMURAI_WITH_MPI
-            xfer_props.add(HighFive::UseCollectiveIO{});
+        mpi::communicator world;
+        rank = static_cast<std::size_t>(world.rank());
 #endif
-            if (size == 1)
+        std::size_t size = nb_cells.size();
+
+        std::vector<std::size_t> nb_points;
+        if (options.compact)
+        {
+            std::size_t nb_local_intervals = 0;
+            for_each_interval(submesh,
+                              [&](auto, const auto&, const auto&)
+                              {
+                                  ++nb_local_intervals;
+                              });
+
+            auto intervals = create_datasets<std::int64_t>(prefix, "intervals", detail::gather_sizes(nb_local_intervals), dim + 2);
+            if (intervals)
             {
-                auto connectivity = h5_file.createDataSet<std::size_t>(
-                    prefix + "/connectivity",
-                    HighFive::DataSpace(std::vector<std::size_t>{connectivity_sizes[rank], 1 << dim}));
-                auto coords = h5_file.createDataSet<double>(prefix + "/points",
-                                                            HighFive::DataSpace(std::vector<std::size_t>{coords_sizes[rank], 3}));
-
-                auto connectivity_slice = connectivity.select({connectivity_cumsum[rank], 0}, {connectivity_sizes[rank], 1 << dim});
-                local_connectivity += coords_cumsum[rank];
-                connectivity_slice.write_raw(local_connectivity.data(), HighFive::AtomicType<std::size_t>{}, xfer_props);
-
-                auto coords_slice = coords.select({0, 0}, {coords_sizes[rank], 3});
-                coords_slice.write_raw(local_coords.data(), HighFive::AtomicType<double>{}, xfer_props);
+                detail::ChunkedWriter<std::int64_t> writer(*intervals, dim + 2, options.chunk_size);
+                for_each_interval(submesh,
+                                  [&](std::size_t level, const auto& i, const auto& index)
+                                  {
+                                      writer.push(static_cast<std::int64_t>(level));
+                                      writer.push(i.start);
+                                      writer.push(i.end);
+                                      for (std::size_t d = 0; d < dim - 1; ++d)
+                                      {
+                                          writer.push(index[d]);
+                                      }
+                                  });
+                writer.flush();
             }
-            else
-            {
-                for (std::size_t r = 0; r < size; ++r)
+        }
+        else
+        {
+            // The datasets are created once the number of points is known and written during the numbering
+            std::optional<detail::ChunkedWriter<std::size_t>> connectivity_writer;
+            std::optional<detail::ChunkedWriter<double>> points_writer;
+            for_each_point_and_connectivity(
+                submesh,
+                [&](std::size_t nb_local_points)
                 {
-                    if (coords_sizes[r] != 0)
+                    nb_points         = detail::gather_sizes(nb_local_points);
+                    auto connectivity = create_datasets<std::size_t>(prefix, "connectivity", nb_cells, 1 << dim);
+                    auto points       = create_datasets<double>(prefix, "points", nb_points, 3);
+                    if (connectivity)
                     {
-                        auto connectivity = h5_file.createDataSet<std::size_t>(
-                            prefix + fmt::format("/rank_{}/connectivity", r),
-                            HighFive::DataSpace(std::vector<std::size_t>{connectivity_sizes[r], 1 << dim}));
-                        std::vector<std::size_t> conn_size(2, 0);
-                        if (rank == r && connectivity_sizes[r] != 0)
-                        {
-                            conn_size = {connectivity_sizes[r], 1 << dim};
-                        }
-                        std::size_t* conn_ptr = (rank == r && connectivity_sizes[r] != 0) ? local_connectivity.data() : nullptr;
-
-                        auto connectivity_slice = connectivity.select({0, 0}, conn_size);
-                        connectivity_slice.write_raw(conn_ptr, HighFive::AtomicType<std::size_t>{}, xfer_props);
-
-                        auto coords = h5_file.createDataSet<double>(prefix + fmt::format("/rank_{}/points", r),
-                                                                    HighFive::DataSpace(std::vector<std::size_t>{coords_sizes[r], 3}));
-
-                        std::vector<std::size_t> coord_size(2, 0);
-                        double* coord_ptr = nullptr;
-                        if (rank == r && coords_sizes[r] != 0)
-                        {
-                            coord_size = {coords_sizes[r], 3};
-                            coord_ptr  = local_coords.data();
-                        }
-                        auto coords_slice = coords.select({0, 0}, coord_size);
-                        coords_slice.write_raw(coord_ptr, HighFive::AtomicType<double>{}, xfer_props);
+                        connectivity_writer.emplace(*connectivity, 1 << dim, options.chunk_size);
+                        points_writer.emplace(*points, 3, options.chunk_size);
                     }
-                }
+                },
+                [&](const std::array<double, 3>& coords)
+                {
+                    for (double x : coords)
+                    {
+                        points_writer->push(x);
+                    }
+                },
+                [&](std::size_t id)
+                {
+                    connectivity_writer->push(id);
+                });
+            if (connectivity_writer)
+            {
+                connectivity_writer->flush();
+                points_writer->flush();
             }
+        }
 
-            auto grid = grid_parent.append_child("Grid");
-            if (rank == 0)
+        auto grid = grid_parent.append_child("Grid");
+        if (rank == 0)
+        {
+            auto add_topology = [&](pugi::xml_node& node, std::size_t r)
             {
-                if (size == 1)
+                if (options.compact)
                 {
-                    grid.append_attribute("Name") = mesh_name.data();
+                    auto info                      = node.append_child("Information");
+                    info.append_attribute("Name")  = "Intervals";
+                    info.append_attribute("Value") = fmt::format("{}.h5:{}", m_filename, dataset_path(prefix, r, "intervals")).data();
+                    return;
+                }
 
-                    auto topo                                 = grid.append_child("Topology");
-                    topo.append_attribute("TopologyType")     = element_type(derived_type_save::dim).c_str();
-                    topo.append_attribute("NumberOfElements") = connectivity_sizes[rank];
+                auto topo                                 = node.append_child("Topology");
+                topo.append_attribute("TopologyType")     = element_type(dim).c_str();
+                topo.append_attribute("NumberOfElements") = nb_cells[r];
 
-                    auto topo_data                           = topo.append_child("DataItem");
-                    topo_data.append_attribute("Dimensions") = connectivity_sizes[rank] * (1 << dim);
-                    topo_data.append_attribute("Format")     = "HDF";
-                    topo_data.text()                         = fmt::format("{}.h5:{}/connectivity", m_filename, prefix).data();
+                auto topo_data                           = topo.append_child("DataItem");
+                topo_data.append_attribute("Dimensions") = nb_cells[r] * (1 << dim);
+                topo_data.append_attribute("Format")     = "HDF";
+                topo_data.text() = fmt::format("{}.h5:{}", m_filename, dataset_path(prefix, r, "connectivity")).data();
 
-                    auto geom                             = grid.append_child("Geometry");
-                    geom.append_attribute("GeometryType") = "XYZ";
+                auto geom                             = node.append_child("Geometry");
+                geom.append_attribute("GeometryType") = "XYZ";
 
-                    auto geom_data                           = geom.append_child("DataItem");
-                    geom_data.append_attribute("Dimensions") = coords_sizes[rank] * 3;
-                    geom_data.append_attribute("Format")     = "HDF";
-                    geom_data.text()                         = fmt::format("{}.h5:{}/points", m_filename, prefix).data();
-                }
-                else
+                auto geom_data                           = geom.append_child("DataItem");
+                geom_data.append_attribute("Dimensions") = nb_points[r] * 3;
+                geom_data.append_attribute("Format")     = "HDF";
+                geom_data.text()                         = fmt::format("{}.h5:{}", m_filename, dataset_path(prefix, r, "points")).data();
+            };
+
+            if (size == 1)
+            {
+                grid.append_attribute("Name") = mesh_name.data();
+                add_topology(grid, rank);
+            }
+            else
+            {
+                grid.append_attribute("GridType")       = "Collection";
+                grid.append_attribute("CollectionType") = "Spatial";
+                for (std::size_t irank = 0; irank < size; ++irank)
                 {
-                    grid.append_attribute("GridType")       = "Collection";
-                    grid.append_attribute("CollectionType") = "Spatial";
-                    for (std::size_t irank = 0; irank < size; ++irank)
+                    if (nb_cells[irank] != 0)
                     {
-                        if (coords_sizes[irank] != 0)
-                        {
-                            auto subgrid                     = grid.append_child("Grid");
-                            subgrid.append_attribute("Name") = fmt::format("{}_rank_{}", mesh_name, irank).data();
-                            subgrid.append_attribute("Rank") = irank;
-
-                            auto topo                                 = subgrid.append_child("Topology");
-                            topo.append_attribute("TopologyType")     = element_type(derived_type_save::dim).c_str();
-                            topo.append_attribute("NumberOfElements") = connectivity_sizes[irank];
-
-                            auto topo_data                           = topo.append_child("DataItem");
-                            topo_data.append_attribute("Dimensions") = connectivity_sizes[irank] * (1 << dim);
-                            topo_data.append_attribute("Format")     = "HDF";
-                            topo_data.text() = fmt::format("{}.h5:{}/rank_{}/connectivity", m_filename, prefix, irank).data();
-
-                            auto geom                             = subgrid.append_child("Geometry");
-                            geom.append_attribute("GeometryType") = "XYZ";
-
-                            auto geom_data                           = geom.append_child("DataItem");
-                            geom_data.append_attribute("Dimensions") = coords_sizes[irank] * 3;
-                            geom_data.append_attribute("Format")     = "HDF";
-                            geom_data.text() = fmt::format("{}.h5:{}/rank_{}/points", m_filename, prefix, irank).data();
-                        }
+                        auto subgrid                     = grid.append_child("Grid");
+                        subgrid.append_attribute("Name") = fmt::format("{}_rank_{}", mesh_name, irank).data();
+                        subgrid.append_attribute("Rank") = irank;
+                        add_topology(subgrid, irank);
                     }
                 }
             }
-
-            this->derived_cast().save_fields(grid, prefix, submesh);
         }
+
+        this->derived_cast().save_fields(grid, prefix, submesh);
     }
 
     template <class D>
     template <class Submesh, class Field>
     inline void Hdf5<D>::save_field(pugi::xml_node& grid, const std::string& prefix, const Submesh& submesh, const Field& field)
     {
-        auto xfer_props = HighFive::DataTransferProps{};
-#ifdef SAMURAI_WITH_MPI
-        mpi::communicator world;
-
-        auto rank = static_cast<std::size_t>(world.rank());
-        auto size = static_cast<std::size_t>(world.size());
-        xfer_props.add(HighFive::UseCollectiveIO{});
+        using value_t       = typename Field::value_type;
+        const auto& options = this->derived_cast().options();
 
-        xt::xtensor<std::size_t, 1> field_sizes = xt::empty<std::size_t>({size});
-        mpi::all_gather(world, submesh.nb_cells(), field_sizes.begin());
-#else
         std::size_t rank = 0;
-        std::size_t size = 1;
-        xt::xtensor_fixed<std::size_t, xt::xshape<1>> field_sizes = {submesh.nb_cells()};
+#ifdef SAMURAI_WITH_MPI
+        mpi::communicator world;
+        rank = static_cast<std::size_t>(world.rank());
 #endif
-        std::vector<std::size_t> field_cumsum(size + 1, 0);
-        for (std::size_t i = 0; i < size; ++i)
-        {
-            field_cumsum[i + 1] += field_cumsum[i] + field_sizes[i];
-        }
+        auto field_sizes = detail::gather_sizes(submesh.nb_cells());
+        std::size_t size = field_sizes.size();
 
+        std::vector<std::string> field_names;
         for (std::size_t i = 0; i < field.size; ++i)
         {
-            std::string field_name;
             if constexpr (Field::size == 1)
             {
-                field_name = field.name();
+                field_names.push_back(field.name());
             }
             else
             {
-                field_name = fmt::format("{}_{}", field.name(), i);
+                field_names.push_back(fmt::format("{}_{}", field.name(), i));
             }
+        }
 
-            if (size == 1)
+        // All the components are written during the same traversal of the cells
+        std::vector<detail::ChunkedWriter<value_t>> writers;
+        for (const auto& field_name : field_names)
+        {
+            auto dataset = create_datasets<value_t>(prefix, "fields/" + field_name, field_sizes, 0);
+            if (dataset)
             {
-                auto local_data  = extract_data(field, submesh);
-                std::string path = fmt::format("{}/fields/{}", prefix, field_name);
-
-                auto data = h5_file.createDataSet<typename Field::value_type>(
-                    path,
-                    HighFive::DataSpace(std::vector<std::size_t>{field_cumsum.back()}));
-
-                auto data_slice = data.select({field_cumsum[rank]}, {field_sizes[rank]});
-                data_slice.write_raw(xt::eval(xt::view(local_data, xt::all(), i)).data(),
-                                     HighFive::AtomicType<typename Field::value_type>{},
-                                     xfer_props);
-
-                auto attribute                       = grid.append_child("Attribute");
-                attribute.append_attribute("Name")   = field_name.data();
-                attribute.append_attribute("Center") = "Cell";
-
-                auto dataitem                           = attribute.append_child("DataItem");
-                dataitem.append_attribute("Dimensions") = field_cumsum.back();
-                dataitem.append_attribute("Format")     = "HDF";
-                dataitem.append_attribute("Precision")  = "8";
-                dataitem.text()                         = fmt::format("{}.h5:{}", m_filename, path).data();
+                writers.emplace_back(*dataset, 0, options.chunk_size);
             }
-            else
+        }
+        if (!writers.empty())
+        {
+            for_each_cell(submesh,
+                          [&](const auto& cell)
+                          {
+                              for (std::size_t i = 0; i < writers.size(); ++i)
+                              {
+                                  writers[i].push(field_value(field, cell, i));
+                              }
+                          });
+            for (auto& writer : writers)
             {
-                auto local_data = extract_data(field, submesh);
-                xt::xtensor<typename Field::value_type, 1> data_tmp;
-                for (std::size_t irank = 0; irank < size; ++irank)
+                writer.flush();
+            }
+        }
+
+        if (rank == 0)
+        {
+            for (const auto& field_name : field_names)
+            {
+                if (size == 1)
                 {
-                    if (field_sizes[irank] != 0)
-                    {
-                        std::string path = fmt::format("{}/rank_{}/fields/{}", prefix, irank, field_name);
-                        auto data        = h5_file.createDataSet<typename Field::value_type>(
-                            path,
-                            HighFive::DataSpace(std::vector<std::size_t>{field_sizes[irank]}));
-
-                        std::vector<std::size_t> data_size(1, 0);
-                        typename Field::value_type* data_ptr = nullptr;
-
-                        if (rank == irank)
-                        {
-                            data_tmp     = xt::eval(xt::view(local_data, xt::all(), i));
-                            data_ptr     = data_tmp.data();
-                            data_size[0] = field_sizes[irank];
-                        }
-                        auto data_slice = data.select({0}, data_size);
-                        data_slice.write_raw(data_ptr, HighFive::AtomicType<typename Field::value_type>{}, xfer_props);
-                    }
+                    auto attribute                       = grid.append_child("Attribute");
+                    attribute.append_attribute("Name")   = field_name.data();
+                    attribute.append_attribute("Center") = "Cell";
+
+                    auto dataitem                           = attribute.append_child("DataItem");
+                    dataitem.append_attribute("Dimensions") = field_sizes[rank];
+                    dataitem.append_attribute("Format")     = "HDF";
+                    dataitem.append_attribute("Precision")  = "8";
+                    dataitem.text() = fmt::format("{}.h5:{}", m_filename, dataset_path(prefix, rank, "fields/" + field_name)).data();
                 }
-                if (rank == 0)
+                else
                 {
                     for (pugi::xml_node subgrid : grid.children("Grid"))
                     {
                         std::size_t irank = subgrid.attribute("Rank").as_uint();
-                        std::string path  = fmt::format("{}/rank_{}/fields/{}", prefix, irank, field_name);
 
                         auto attribute                       = subgrid.append_child("Attribute");
                         attribute.append_attribute("Name")   = field_name.data();
@@ -794,7 +1100,7 @@ namespace samurai
                         auto dataitem                           = attribute.append_child("DataItem");
                         dataitem.append_attribute("Dimensions") = field_sizes[irank];
                         dataitem.append_attribute("Format")     = "HDF";
-                        dataitem.text()                         = fmt::format("{}.h5:{}", m_filename, path).data();
+                        dataitem.text() = fmt::format("{}.h5:{}", m_filename, dataset_path(prefix, irank, "fields/" + field_name)).data();
                     }
                 }
             }
@@ -1118,4 +1424,71 @@ namespace samurai
         auto h5      = hdf5_t(fs::current_path(), filename, options, mesh, fields...);
         h5.save();
     }
+    /**
+     * Rebuilds the cells of the current process from a file saved with the
+     * option Hdf5Options::compact.
+     *
+     * The intervals are read by chunks of rows and added to a CellList, the
+     * points and the connectivity are not needed.
+     *
+     * @param prefix group of the mesh in the file: "/mesh" when the mesh was
+     *               saved neither by level nor by mesh id
+     */
+    template <std::size_t dim, class TInterval = default_config::interval_t, std::size_t max_size = default_config::max_level>
+    CellArray<dim, TInterval, max_size>
+    load_compact(const fs::path& path, const std::string& filename, const std::string& prefix = "/mesh")
+    {
+        using cl_t          = CellList<dim, TInterval, max_size>;
+        using index_yz_t    = typename cl_t::lcl_type::index_yz_t;
+        using value_t       = typename TInterval::value_t;
+        using coord_index_t = typename TInterval::coord_index_t;
+
+        std::lock_guard<std::recursive_mutex> lock(detail::hdf5_mutex());
+
+        HighFive::FileAccessProps fapl;
+        std::string dataset_name = fmt::format("{}/intervals", prefix);
+#ifdef SAMURAI_WITH_MPI
+        fapl.add(HighFive::MPIOFileAccess{MPI_COMM_WORLD, MPI_INFO_NULL});
+        mpi::communicator world;
+        if (world.size() > 1)
+        {
+            dataset_name = fmt::format("{}/rank_{}/intervals", prefix, world.rank());
+        }
+#endif
+        HighFive::File file(fmt::format("{}.h5", (path / filename).string()), HighFive::File::ReadOnly, fapl);
+
+        cl_t cl;
+        // A process without cells has no dataset
+        if (file.exist(dataset_name))
+        {
+            auto dataset = file.getDataSet(dataset_name);
+            auto shape   = dataset.getDimensions();
+            if (shape.size() != 2 || shape[1] != dim + 2)
+            {
+                throw std::runtime_error(fmt::format("load_compact: {} is not a dataset of {}d intervals", dataset_name, dim));
+            }
+
+            const std::size_t nb_rows = shape[0];
+            std::vector<std::int64_t> buffer;
+            for (std::size_t row = 0; row < nb_rows; row += detail::default_chunk_size)
+            {
+                const std::size_t nb_chunk_rows = std::min(detail::default_chunk_size, nb_rows - row);
+                buffer.resize(nb_chunk_rows * (dim + 2));
+                dataset.select({row, 0}, {nb_chunk_rows, dim + 2}).read_raw(buffer.data(), HighFive::AtomicType<std::int64_t>{});
+
+                for (std::size_t r = 0; r < nb_chunk_rows; ++r)
+                {
+                    const std::int64_t* values = buffer.data() + r * (dim + 2);
+                    index_yz_t index;
+                    for (std::size_t d = 0; d < dim - 1; ++d)
+                    {
+                        index[d] = static_cast<coord_index_t>(values[3 + d]);
+                    }
+                    cl[static_cast<std::size_t>(values[0])][index].add_interval(
+                        {static_cast<value_t>(values[1]), static_cast<value_t>(values[2])});
+                }
+            }
+        }
+        return CellArray<dim, TInterval, max_size>(cl);
+    }
 } // namespace samurai
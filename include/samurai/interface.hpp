@@ -74,15 +74,22 @@ namespace samurai
     }
 
     /**
-     * Iterates over the interfaces of same level only (no level jump).
-     * Same parameters as the preceding function.
+     * Iterates over the interfaces of same level, by intervals of consecutive interfaces in the x-direction.
+     *
+     * The provided callback @param f has the following signature:
+     *           void f(auto& interface_cells, auto& comput_cells, std::size_t n)
+     * where
+     *       'interface_cells' and 'comput_cells' are the cells of the first interface of the interval,
+     *       'n'               is the number of interfaces in the interval.
+     * The interface ii of the interval is defined by the same cells translated by ii in the x-direction:
+     * their indices are consecutive, so that their values are contiguous in the field storage.
      */
     template <bool parallel = false, class Mesh, class Vector, std::size_t comput_stencil_size, class Func>
-    void for_each_interior_interface___same_level(const Mesh& mesh,
-                                                  std::size_t level,
-                                                  Vector direction,
-                                                  const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
-                                                  Func&& f)
+    void for_each_interior_interface___same_level___by_interval(const Mesh& mesh,
+                                                                std::size_t level,
+                                                                Vector direction,
+                                                                const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                                                Func&& f)
     {
         static constexpr std::size_t dim = Mesh::dim;
         using mesh_id_t                  = typename Mesh::mesh_id_t;
@@ -90,9 +97,17 @@ namespace samurai
 
         Stencil<2, dim> interface_stencil = in_out_stencil<dim>(direction);
 
-        auto& cells        = mesh[mesh_id_t::cells][level];
-        auto shifted_cells = translate(cells, -direction);
-        auto intersect     = intersection(cells, shifted_cells);
+        // The interfaces only depend on the mesh: they are evaluated once per
+        // mesh version (see Mesh_base::subset_plan)
+        auto& intersect = mesh.subset_plan("interior_interface___same_level",
+                                           level,
+                                           direction,
+                                           [&]()
+                                           {
+                                               auto& cells        = mesh[mesh_id_t::cells][level];
+                                               auto shifted_cells = translate(cells, -direction);
+                                               return intersection(cells, shifted_cells).on(level);
+                                           });
 
 #ifdef SAMURAI_WITH_OPENMP
         std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
@@ -108,23 +123,204 @@ namespace samurai
         auto comput_stencil_it = make_stencil_iterator(mesh, comput_stencil);
 #endif
 
-        for_each_meshinterval<mesh_interval_t, parallel>(intersect,
-                                                         [&](auto mesh_interval)
-                                                         {
+        auto apply_on_interval = [&](const auto& mesh_interval)
+        {
 #ifdef SAMURAI_WITH_OPENMP
-                                                             std::size_t thread      = static_cast<std::size_t>(omp_get_thread_num());
-                                                             auto& interface_it      = interface_its[thread];
-                                                             auto& comput_stencil_it = comput_stencil_its[thread];
+            std::size_t thread      = static_cast<std::size_t>(omp_get_thread_num());
+            auto& interface_it      = interface_its[thread];
+            auto& comput_stencil_it = comput_stencil_its[thread];
 #endif
-                                                             interface_it.init(mesh_interval);
-                                                             comput_stencil_it.init(mesh_interval);
-                                                             for (std::size_t ii = 0; ii < mesh_interval.i.size(); ++ii)
-                                                             {
-                                                                 f(interface_it.cells(), comput_stencil_it.cells());
-                                                                 interface_it.move_next();
-                                                                 comput_stencil_it.move_next();
-                                                             }
-                                                         });
+            interface_it.init(mesh_interval);
+            comput_stencil_it.init(mesh_interval);
+            f(interface_it.cells(), comput_stencil_it.cells(), mesh_interval.i.size());
+        };
+
+        if constexpr (parallel)
+        {
+            // The callback writes on both sides of the interfaces: the intervals are coloured so that
+            // two concurrent intervals never share a cell, and the result does not depend on the number of threads.
+            std::size_t d = 0;
+            while (d < dim - 1 && direction[d] == 0)
+            {
+                ++d;
+            }
+            intersect.colored_parallel_apply(d,
+                                             [&](const auto& i, const auto& index)
+                                             {
+                                                 mesh_interval_t mesh_interval(level);
+                                                 mesh_interval.i     = i;
+                                                 mesh_interval.index = index;
+                                                 apply_on_interval(mesh_interval);
+                                             });
+        }
+        else
+        {
+            for_each_meshinterval<mesh_interval_t>(intersect, apply_on_interval);
+        }
+    }
+
+    /**
+     * Iterates over the interfaces of same level only (no level jump).
+     * Same parameters as the preceding function.
+     */
+    template <bool parallel = false, class Mesh, class Vector, std::size_t comput_stencil_size, class Func>
+    void for_each_interior_interface___same_level(const Mesh& mesh,
+                                                  std::size_t level,
+                                                  Vector direction,
+                                                  const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                                  Func&& f)
+    {
+        for_each_interior_interface___same_level___by_interval<parallel>(mesh,
+                                                                         level,
+                                                                         direction,
+                                                                         comput_stencil,
+                                                                         [&](auto& interface_cells, auto& comput_cells, std::size_t n)
+                                                                         {
+                                                                             for (std::size_t ii = 0; ii < n; ++ii)
+                                                                             {
+                                                                                 f(interface_cells, comput_cells);
+                                                                                 move_next(interface_cells);
+                                                                                 move_next(comput_cells);
+                                                                             }
+                                                                         });
+    }
+
+    namespace detail
+    {
+        /**
+         * Iterates over the interfaces of same level whose left cells (in
+         * @param direction) are the cells of @param left_cells.
+         */
+        template <class Mesh, class Set, class Vector, std::size_t comput_stencil_size, class Func>
+        void for_each_interface___same_level(const Mesh& mesh,
+                                             Set& left_cells,
+                                             Vector direction,
+                                             const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                             Func&& f)
+        {
+            static constexpr std::size_t dim = Mesh::dim;
+            using mesh_interval_t            = typename Mesh::mesh_interval_t;
+
+            Stencil<2, dim> interface_stencil = in_out_stencil<dim>(direction);
+            auto interface_it                 = make_stencil_iterator(mesh, interface_stencil);
+            auto comput_stencil_it            = make_stencil_iterator(mesh, comput_stencil);
+
+            for_each_meshinterval<mesh_interval_t>(left_cells,
+                                                   [&](auto mesh_interval)
+                                                   {
+                                                       interface_it.init(mesh_interval);
+                                                       comput_stencil_it.init(mesh_interval);
+                                                       for (std::size_t ii = 0; ii < mesh_interval.i.size(); ++ii)
+                                                       {
+                                                           f(interface_it.cells(), comput_stencil_it.cells());
+                                                           interface_it.move_next();
+                                                           comput_stencil_it.move_next();
+                                                       }
+                                                   });
+        }
+
+        /**
+         * Iterates over the level jumps (level --> level+1) in @param direction
+         * whose fine cells are at the right of the cells of @param fine_intersect
+         * (at level+1, in the coarse cells).
+         */
+        template <class Mesh, class Set, class Vector, std::size_t comput_stencil_size, class Func>
+        void for_each_interface___level_jump_direction(const Mesh& mesh,
+                                                       std::size_t level,
+                                                       Set& fine_intersect,
+                                                       Vector direction,
+                                                       const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                                       Func&& f)
+        {
+            static constexpr std::size_t dim = Mesh::dim;
+            using mesh_interval_t            = typename Mesh::mesh_interval_t;
+            using cell_t                     = Cell<dim, typename Mesh::interval_t>;
+
+            Stencil<1, dim> coarse_cell_stencil = center_only_stencil<dim>();
+            auto coarse_it                      = make_stencil_iterator(mesh, coarse_cell_stencil);
+
+            auto comput_stencil_it = make_stencil_iterator(mesh, comput_stencil);
+
+            int direction_index_int = find(comput_stencil, direction);
+            auto direction_index    = static_cast<std::size_t>(direction_index_int);
+
+            for_each_meshinterval<mesh_interval_t>(
+                fine_intersect,
+                [&](auto fine_mesh_interval)
+                {
+                    mesh_interval_t coarse_mesh_interval(level, fine_mesh_interval.i >> 1, fine_mesh_interval.index >> 1);
+
+                    comput_stencil_it.init(fine_mesh_interval);
+                    coarse_it.init(coarse_mesh_interval);
+
+                    for (std::size_t ii = 0; ii < fine_mesh_interval.i.size(); ++ii)
+                    {
+                        std::array<cell_t, 2> interface_cells;
+                        interface_cells[0] = coarse_it.cells()[0];
+                        interface_cells[1] = comput_stencil_it.cells()[direction_index];
+
+                        f(interface_cells, comput_stencil_it.cells());
+                        comput_stencil_it.move_next();
+
+                        if (ii % 2 == 1)
+                        {
+                            coarse_it.move_next();
+                        }
+                    }
+                });
+        }
+
+        /**
+         * Iterates over the level jumps (level --> level+1) in the opposite
+         * of @param direction whose fine cells are at the left of the cells
+         * of @param fine_intersect (at level+1, in the coarse cells).
+         */
+        template <class Mesh, class Set, class Vector, std::size_t comput_stencil_size, class Func>
+        void for_each_interface___level_jump_opposite_direction(const Mesh& mesh,
+                                                                std::size_t level,
+                                                                Set& fine_intersect,
+                                                                Vector direction,
+                                                                const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                                                Func&& f)
+        {
+            static constexpr std::size_t dim = Mesh::dim;
+            using mesh_interval_t            = typename Mesh::mesh_interval_t;
+            using cell_t                     = Cell<dim, typename Mesh::interval_t>;
+
+            Stencil<1, dim> coarse_cell_stencil = center_only_stencil<dim>();
+            auto coarse_it                      = make_stencil_iterator(mesh, coarse_cell_stencil);
+
+            Stencil<comput_stencil_size, dim> minus_comput_stencil = comput_stencil - direction;
+            Vector minus_direction                                 = -direction;
+            int minus_direction_index_int                          = find(minus_comput_stencil, minus_direction);
+            auto minus_direction_index                             = static_cast<std::size_t>(minus_direction_index_int);
+            auto minus_comput_stencil_it                           = make_stencil_iterator(mesh, minus_comput_stencil);
+
+            for_each_meshinterval<mesh_interval_t>(
+                fine_intersect,
+                [&](auto fine_mesh_interval)
+                {
+                    mesh_interval_t coarse_mesh_interval(level, fine_mesh_interval.i >> 1, fine_mesh_interval.index >> 1);
+
+                    minus_comput_stencil_it.init(fine_mesh_interval);
+                    coarse_it.init(coarse_mesh_interval);
+
+                    for (std::size_t ii = 0; ii < fine_mesh_interval.i.size(); ++ii)
+                    {
+                        std::array<cell_t, 2> interface_cells;
+                        interface_cells[0] = minus_comput_stencil_it.cells()[minus_direction_index];
+                        interface_cells[1] = coarse_it.cells()[0];
+
+                        f(interface_cells, minus_comput_stencil_it.cells());
+                        minus_comput_stencil_it.move_next();
+
+                        if (ii % 2 == 1)
+                        {
+                            coarse_it.move_next();
+                        }
+                    }
+                });
+        }
     }
 
     /**
@@ -147,54 +343,25 @@ namespace samurai
                                                             const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
                                                             Func&& f)
     {
-        static constexpr std::size_t dim = Mesh::dim;
-        using mesh_id_t                  = typename Mesh::mesh_id_t;
-        using mesh_interval_t            = typename Mesh::mesh_interval_t;
-        using cell_t                     = Cell<dim, typename Mesh::interval_t>;
+        using mesh_id_t = typename Mesh::mesh_id_t;
 
         if (level >= mesh.max_level())
         {
             return;
         }
 
-        Stencil<1, dim> coarse_cell_stencil = center_only_stencil<dim>();
-        auto coarse_it                      = make_stencil_iterator(mesh, coarse_cell_stencil);
-
-        auto comput_stencil_it = make_stencil_iterator(mesh, comput_stencil);
-
-        int direction_index_int = find(comput_stencil, direction);
-        auto direction_index    = static_cast<std::size_t>(direction_index_int);
-
-        auto& coarse_cells = mesh[mesh_id_t::cells][level];
-        auto& fine_cells   = mesh[mesh_id_t::cells][level + 1];
-
-        auto shifted_fine_cells = translate(fine_cells, -direction);
-        auto fine_intersect     = intersection(coarse_cells, shifted_fine_cells).on(level + 1);
-
-        for_each_meshinterval<mesh_interval_t>(
-            fine_intersect,
-            [&](auto fine_mesh_interval)
-            {
-                mesh_interval_t coarse_mesh_interval(level, fine_mesh_interval.i >> 1, fine_mesh_interval.index >> 1);
-
-                comput_stencil_it.init(fine_mesh_interval);
-                coarse_it.init(coarse_mesh_interval);
-
-                for (std::size_t ii = 0; ii < fine_mesh_interval.i.size(); ++ii)
-                {
-                    std::array<cell_t, 2> interface_cells;
-                    interface_cells[0] = coarse_it.cells()[0];
-                    interface_cells[1] = comput_stencil_it.cells()[direction_index];
-
-                    f(interface_cells, comput_stencil_it.cells());
-                    comput_stencil_it.move_next();
-
-                    if (ii % 2 == 1)
-                    {
-                        coarse_it.move_next();
-                    }
-                }
-            });
+        auto& fine_intersect = mesh.subset_plan("interior_interface___level_jump_direction",
+                                                level + 1,
+                                                direction,
+                                                [&]()
+                                                {
+                                                    auto& coarse_cells = mesh[mesh_id_t::cells][level];
+                                                    auto& fine_cells   = mesh[mesh_id_t::cells][level + 1];
+
+                                                    auto shifted_fine_cells = translate(fine_cells, -direction);
+                                                    return intersection(coarse_cells, shifted_fine_cells).on(level + 1);
+                                                });
+        detail::for_each_interface___level_jump_direction(mesh, level, fine_intersect, direction, comput_stencil, std::forward<Func>(f));
     }
 
     /**
@@ -217,55 +384,145 @@ namespace samurai
                                                                      const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
                                                                      Func&& f)
     {
-        static constexpr std::size_t dim = Mesh::dim;
-        using mesh_id_t                  = typename Mesh::mesh_id_t;
-        using mesh_interval_t            = typename Mesh::mesh_interval_t;
-        using cell_t                     = Cell<dim, typename Mesh::interval_t>;
+        using mesh_id_t = typename Mesh::mesh_id_t;
 
         if (level >= mesh.max_level())
         {
             return;
         }
 
-        Stencil<1, dim> coarse_cell_stencil = center_only_stencil<dim>();
-        auto coarse_it                      = make_stencil_iterator(mesh, coarse_cell_stencil);
+        auto& fine_intersect = mesh.subset_plan("interior_interface___level_jump_opposite_direction",
+                                                level + 1,
+                                                direction,
+                                                [&]()
+                                                {
+                                                    auto& coarse_cells = mesh[mesh_id_t::cells][level];
+                                                    auto& fine_cells   = mesh[mesh_id_t::cells][level + 1];
+
+                                                    auto shifted_fine_cells = translate(fine_cells, direction);
+                                                    return intersection(coarse_cells, shifted_fine_cells).on(level + 1);
+                                                });
+        detail::for_each_interface___level_jump_opposite_direction(mesh,
+                                                                   level,
+                                                                   fine_intersect,
+                                                                   direction,
+                                                                   comput_stencil,
+                                                                   std::forward<Func>(f));
+    }
 
-        Stencil<comput_stencil_size, dim> minus_comput_stencil = comput_stencil - direction;
-        Vector minus_direction                                 = -direction;
-        int minus_direction_index_int                          = find(minus_comput_stencil, minus_direction);
-        auto minus_direction_index                             = static_cast<std::size_t>(minus_direction_index_int);
-        auto minus_comput_stencil_it                           = make_stencil_iterator(mesh, minus_comput_stencil);
+    /**
+     * Iterates over the interfaces of same level between the cells of the
+     * subdomain and the cells of the neighbouring subdomains (SAMURAI_WITH_MPI),
+     * which are ghosts of the local mesh. Same callback as
+     * for_each_interior_interface___same_level(), which only pairs the cells
+     * of the subdomain: each of these interfaces is seen by both subdomains.
+     */
+    template <class Mesh, class Vector, std::size_t comput_stencil_size, class Func>
+    void for_each_subdomain_interface___same_level(const Mesh& mesh,
+                                                   std::size_t level,
+                                                   Vector direction,
+                                                   const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                                   Func&& f)
+    {
+        using mesh_id_t = typename Mesh::mesh_id_t;
 
-        auto& coarse_cells = mesh[mesh_id_t::cells][level];
-        auto& fine_cells   = mesh[mesh_id_t::cells][level + 1];
+        const auto& cells = mesh[mesh_id_t::cells][level];
+        for (const auto& neighbour : mesh.mpi_neighbourhood())
+        {
+            const auto& neighbour_cells = neighbour.mesh[mesh_id_t::cells][level];
 
-        auto shifted_fine_cells = translate(fine_cells, direction);
-        auto fine_intersect     = intersection(coarse_cells, shifted_fine_cells).on(level + 1);
+            auto left_cells = intersection(cells, translate(neighbour_cells, -direction)).on(level);
+            detail::for_each_interface___same_level(mesh, left_cells, direction, comput_stencil, f);
 
-        for_each_meshinterval<mesh_interval_t>(
-            fine_intersect,
-            [&](auto fine_mesh_interval)
-            {
-                mesh_interval_t coarse_mesh_interval(level, fine_mesh_interval.i >> 1, fine_mesh_interval.index >> 1);
+            auto left_neighbour_cells = intersection(neighbour_cells, translate(cells, -direction)).on(level);
+            detail::for_each_interface___same_level(mesh, left_neighbour_cells, direction, comput_stencil, f);
+        }
+    }
 
-                minus_comput_stencil_it.init(fine_mesh_interval);
-                coarse_it.init(coarse_mesh_interval);
+    /**
+     * Same as for_each_interior_interface___level_jump_direction() between
+     * the cells of the subdomain and the cells of the neighbouring subdomains.
+     */
+    template <class Mesh, class Vector, std::size_t comput_stencil_size, class Func>
+    void for_each_subdomain_interface___level_jump_direction(const Mesh& mesh,
+                                                             std::size_t level,
+                                                             Vector direction,
+                                                             const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                                             Func&& f)
+    {
+        using mesh_id_t = typename Mesh::mesh_id_t;
 
-                for (std::size_t ii = 0; ii < fine_mesh_interval.i.size(); ++ii)
-                {
-                    std::array<cell_t, 2> interface_cells;
-                    interface_cells[0] = minus_comput_stencil_it.cells()[minus_direction_index];
-                    interface_cells[1] = coarse_it.cells()[0];
+        if (level >= mesh.max_level())
+        {
+            return;
+        }
 
-                    f(interface_cells, minus_comput_stencil_it.cells());
-                    minus_comput_stencil_it.move_next();
+        const auto& coarse_cells = mesh[mesh_id_t::cells][level];
+        const auto& fine_cells   = mesh[mesh_id_t::cells][level + 1];
+        for (const auto& neighbour : mesh.mpi_neighbourhood())
+        {
+            const auto& neighbour_coarse_cells = neighbour.mesh[mesh_id_t::cells][level];
+            const auto& neighbour_fine_cells   = neighbour.mesh[mesh_id_t::cells][level + 1];
 
-                    if (ii % 2 == 1)
-                    {
-                        coarse_it.move_next();
-                    }
-                }
-            });
+            auto coarse_intersect = intersection(coarse_cells, translate(neighbour_fine_cells, -direction)).on(level + 1);
+            detail::for_each_interface___level_jump_direction(mesh, level, coarse_intersect, direction, comput_stencil, f);
+
+            auto fine_intersect = intersection(neighbour_coarse_cells, translate(fine_cells, -direction)).on(level + 1);
+            detail::for_each_interface___level_jump_direction(mesh, level, fine_intersect, direction, comput_stencil, f);
+        }
+    }
+
+    /**
+     * Same as for_each_interior_interface___level_jump_opposite_direction()
+     * between the cells of the subdomain and the cells of the neighbouring
+     * subdomains.
+     */
+    template <class Mesh, class Vector, std::size_t comput_stencil_size, class Func>
+    void for_each_subdomain_interface___level_jump_opposite_direction(const Mesh& mesh,
+                                                                      std::size_t level,
+                                                                      Vector direction,
+                                                                      const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                                                      Func&& f)
+    {
+        using mesh_id_t = typename Mesh::mesh_id_t;
+
+        if (level >= mesh.max_level())
+        {
+            return;
+        }
+
+        const auto& coarse_cells = mesh[mesh_id_t::cells][level];
+        const auto& fine_cells   = mesh[mesh_id_t::cells][level + 1];
+        for (const auto& neighbour : mesh.mpi_neighbourhood())
+        {
+            const auto& neighbour_coarse_cells = neighbour.mesh[mesh_id_t::cells][level];
+            const auto& neighbour_fine_cells   = neighbour.mesh[mesh_id_t::cells][level + 1];
+
+            auto coarse_intersect = intersection(coarse_cells, translate(neighbour_fine_cells, direction)).on(level + 1);
+            detail::for_each_interface___level_jump_opposite_direction(mesh, level, coarse_intersect, direction, comput_stencil, f);
+
+            auto fine_intersect = intersection(neighbour_coarse_cells, translate(fine_cells, direction)).on(level + 1);
+            detail::for_each_interface___level_jump_opposite_direction(mesh, level, fine_intersect, direction, comput_stencil, f);
+        }
+    }
+
+    /**
+     * Iterates over the interfaces between the cells of the subdomain and the
+     * cells of the neighbouring subdomains, at all levels (see
+     * for_each_interior_interface()). One of the interface cells is a ghost.
+     */
+    template <class Mesh, class Vector, std::size_t comput_stencil_size, class Func>
+    void for_each_subdomain_interface(const Mesh& mesh,
+                                      Vector direction,
+                                      const Stencil<comput_stencil_size, Mesh::dim>& comput_stencil,
+                                      Func&& f)
+    {
+        for (std::size_t level = mesh.min_level(); level <= mesh.max_level(); ++level)
+        {
+            for_each_subdomain_interface___same_level(mesh, level, direction, comput_stencil, f);
+            for_each_subdomain_interface___level_jump_direction(mesh, level, direction, comput_stencil, f);
+            for_each_subdomain_interface___level_jump_opposite_direction(mesh, level, direction, comput_stencil, f);
+        }
     }
 
     /**
@@ -315,7 +572,13 @@ namespace samurai
         auto comput_stencil_it = make_stencil_iterator(mesh, comput_stencil);
 #endif
 
-        auto bdry = boundary(mesh, level, direction);
+        auto& bdry = mesh.subset_plan("boundary_interface",
+                                      level,
+                                      direction,
+                                      [&]()
+                                      {
+                                          return boundary(mesh, level, direction);
+                                      });
         for_each_meshinterval<mesh_interval_t, parallel>(bdry,
                                                          [&](auto mesh_interval)
                                                          {
@@ -23,6 +23,7 @@
 #include "level_cell_list.hpp"
 #include "mesh_interval.hpp"
 #include "samurai_config.hpp"
+#include "sorted_level_cell_list.hpp"
 #include "subset/subset_op_base.hpp"
 #include "utils.hpp"
 
@@ -84,6 +85,7 @@ namespace samurai
 
         LevelCellArray() = default;
         LevelCellArray(const LevelCellList<Dim, TInterval>& lcl);
+        LevelCellArray(const SortedLevelCellList<Dim, TInterval>& lcl);
 
         template <class F, class... CT>
         LevelCellArray(subset_operator<F, CT...> set);
@@ -191,6 +193,9 @@ namespace samurai
                                        const std::array<value_t, dim - 1>& index,
                                        std::integral_constant<std::size_t, 0>);
 
+        /// Construction from the sorted records of a flat level cell list
+        void init_from_sorted_level_cell_list(const SortedLevelCellList<Dim, TInterval>& lcl);
+
         void init_from_box(const Box<value_t, dim>& box);
 
         std::array<std::vector<interval_t>, dim> m_cells;        ///< All intervals in every direction
@@ -299,6 +304,22 @@ namespace samurai
         }
     }
 
+    template <std::size_t Dim, class TInterval>
+    inline LevelCellArray<Dim, TInterval>::LevelCellArray(const SortedLevelCellList<Dim, TInterval>& lcl)
+        : m_level(lcl.level())
+    {
+        if (!lcl.empty())
+        {
+            init_from_sorted_level_cell_list(lcl);
+            // Additionnal offset so that [m_offset[i], m_offset[i+1][ is always
+            // valid.
+            for (std::size_t d = 0; d < dim - 1; ++d)
+            {
+                m_offsets[d].emplace_back(m_cells[d].size());
+            }
+        }
+    }
+
     template <std::size_t Dim, class TInterval>
     template <class F, class... CT>
     inline LevelCellArray<Dim, TInterval>::LevelCellArray(subset_operator<F, CT...> set)
@@ -776,6 +797,97 @@ namespace samurai
         std::copy(interval_list.begin(), interval_list.end(), std::back_inserter(m_cells[0]));
     }
 
+    /**
+     * Same construction as init_from_level_cell_list but in one pass over the
+     * sorted rows: for each row, we look for the highest dimension N where the
+     * coordinates differ from the previous row. The working intervals of the
+     * dimensions lower than N are closed and the ones from N down to 1 are
+     * continued or created, exactly as the recursive version does.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline void LevelCellArray<Dim, TInterval>::init_from_sorted_level_cell_list(const SortedLevelCellList<Dim, TInterval>& lcl)
+    {
+        const auto& records = lcl.records();
+
+        if constexpr (dim == 1)
+        {
+            m_cells[0].reserve(records.size());
+            for (const auto& r : records)
+            {
+                m_cells[0].emplace_back(r.start, r.end);
+            }
+        }
+        else
+        {
+            // Working interval along each dimension > 0
+            std::array<interval_t, dim> curr_interval;
+            curr_interval.fill(interval_t(0, 0, 0));
+
+            m_cells[0].reserve(records.size());
+
+            std::size_t r = 0;
+            while (r < records.size())
+            {
+                const auto& yz = records[r].yz;
+
+                // Highest dimension where the row has changed
+                std::size_t N = dim - 1;
+                if (r > 0)
+                {
+                    const auto& prev_yz = records[r - 1].yz;
+                    while (N > 1 && yz[N - 1] == prev_yz[N - 1])
+                    {
+                        --N;
+                    }
+                }
+
+                // Closing the working intervals of the lower dimensions
+                for (std::size_t d = 1; d < N; ++d)
+                {
+                    if (curr_interval[d].is_valid())
+                    {
+                        m_cells[d].emplace_back(curr_interval[d]);
+                        curr_interval[d] = interval_t(0, 0, 0);
+                    }
+                }
+
+                for (std::size_t d = N; d > 0; --d)
+                {
+                    const auto i = yz[d - 1];
+                    if (curr_interval[d].is_valid() && i == curr_interval[d].end)
+                    {
+                        // Continuing the current interval
+                        ++curr_interval[d].end;
+                    }
+                    else
+                    {
+                        if (curr_interval[d].is_valid())
+                        {
+                            m_cells[d].emplace_back(curr_interval[d]);
+                        }
+                        curr_interval[d] = interval_t(i, i + 1, static_cast<index_t>(m_offsets[d - 1].size()) - i);
+                    }
+                    m_offsets[d - 1].emplace_back(m_cells[d - 1].size());
+                }
+
+                // Along the X axis, simply copy the intervals of the row in
+                // cells[0]
+                for (; r < records.size() && records[r].yz == yz; ++r)
+                {
+                    m_cells[0].emplace_back(records[r].start, records[r].end);
+                }
+            }
+
+            for (std::size_t d = 1; d < dim; ++d)
+            {
+                if (curr_interval[d].is_valid())
+                {
+                    m_cells[d].emplace_back(curr_interval[d]);
+                }
+            }
+        }
+    }
+
     template <std::size_t Dim, class TInterval>
     inline void LevelCellArray<Dim, TInterval>::init_from_box(const Box<value_t, dim>& box)
     {
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <map>
 #include <type_traits>
+#include <utility>
 
 #include <xtensor/xfixed.hpp>
 #include <xtensor/xview.hpp>
@@ -51,6 +52,34 @@ namespace samurai
             // For other dimensions, we dive into the nested std::map
             return access_grid_yz(grid_yz[index[dim - 1]], index, std::integral_constant<std::size_t, dim - 1>{});
         }
+
+        /// Add the interval lists of @param src to @param dst (the rows of src
+        /// that are not in dst are moved).
+        template <typename GridYZ>
+        inline void merge_grid_yz(GridYZ& dst, GridYZ& src, std::integral_constant<std::size_t, 0>)
+        {
+            for (const auto& interval : src)
+            {
+                dst.add_interval(interval);
+            }
+        }
+
+        template <typename GridYZ, std::size_t dim>
+        inline void merge_grid_yz(GridYZ& dst, GridYZ& src, std::integral_constant<std::size_t, dim>)
+        {
+            for (auto& [coord, sub_grid] : src)
+            {
+                auto it = dst.find(coord);
+                if (it == dst.end())
+                {
+                    dst.emplace(coord, std::move(sub_grid));
+                }
+                else
+                {
+                    merge_grid_yz(it->second, sub_grid, std::integral_constant<std::size_t, dim - 1>{});
+                }
+            }
+        }
     } // namespace detail
 
     //////////////////////////////
@@ -88,6 +117,8 @@ namespace samurai
 
         void add_cell(const Cell<dim, interval_t>& cell);
 
+        void merge(LevelCellList&& other);
+
       private:
 
         grid_t m_grid_yz; ///< Sparse dim-1 array that points to the interval
@@ -159,6 +190,19 @@ namespace samurai
         (*this)[xt::view(cell.indices, xt::range(1, _))].add_point(cell.indices[0]);
     }
 
+    /**
+     * Add the cells of another list (its level is ignored).
+     *
+     * The lists of intervals are kept sorted and merged: the result doesn't
+     * depend on the order in which the cells have been added to both lists.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline void LevelCellList<Dim, TInterval>::merge(LevelCellList&& other)
+    {
+        detail::merge_grid_yz(m_grid_yz, other.m_grid_yz, std::integral_constant<std::size_t, dim - 1>{});
+        other.m_grid_yz = {};
+    }
+
     template <std::size_t Dim, class TInterval>
     inline std::ostream& operator<<(std::ostream& out, const LevelCellList<Dim, TInterval>& level_cell_list)
     {
@@ -0,0 +1,502 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef SAMURAI_WITH_MPI
+#include <boost/mpi.hpp>
+namespace mpi = boost::mpi;
+#endif
+
+#include "cell_array.hpp"
+#include "level_cell_list.hpp"
+#include "mesh_halo.hpp"
+#include "profiling.hpp"
+#include "space_filling_curve.hpp"
+
+namespace samurai
+{
+    struct LoadBalancingOptions
+    {
+        SFCType curve = SFCType::Hilbert;
+        /// Cost of a cell of each level, 1 for the levels which are not given
+        std::vector<double> level_weights;
+        /// Cost of the cell of the given level and storage index: replaces level_weights if set (a cost field for example)
+        std::function<double(std::size_t, std::size_t)> cell_weight;
+        /// The cells are not moved while the load of each process is below (1 + tolerance) times the mean load
+        double tolerance = 0.05;
+    };
+
+    namespace detail
+    {
+        inline int load_balancing_size()
+        {
+#ifdef SAMURAI_WITH_MPI
+            mpi::communicator world;
+            return world.size();
+#else
+            return 1;
+#endif
+        }
+
+        inline auto load_balancing_weight(const LoadBalancingOptions& options)
+        {
+            return [&options](std::size_t level, std::size_t index)
+            {
+                if (options.cell_weight)
+                {
+                    return options.cell_weight(level, index);
+                }
+                return level < options.level_weights.size() ? options.level_weights[level] : 1.;
+            };
+        }
+
+        /**
+         * Sends buffers[r] to the process r and returns the buffers received
+         * from each process (the own buffer is moved). The messages go through
+         * a duplicate of the world communicator.
+         */
+        inline std::vector<std::vector<char>> exchange_buffers(std::vector<std::vector<char>>& buffers)
+        {
+#ifdef SAMURAI_WITH_MPI
+            static constexpr int tag = 0;
+
+            mpi::communicator world(MPI_COMM_WORLD, mpi::comm_duplicate);
+            const auto size = static_cast<std::size_t>(world.size());
+            const auto rank = static_cast<std::size_t>(world.rank());
+
+            std::vector<std::size_t> send_sizes(size);
+            std::vector<std::size_t> recv_sizes;
+            for (std::size_t r = 0; r < size; ++r)
+            {
+                send_sizes[r] = buffers[r].size();
+            }
+            mpi::all_to_all(world, send_sizes, recv_sizes);
+
+            std::vector<std::vector<char>> received(size);
+            std::vector<mpi::request> req;
+            for (std::size_t r = 0; r < size; ++r)
+            {
+                if (r != rank && recv_sizes[r] > 0)
+                {
+                    received[r].resize(recv_sizes[r]);
+                    req.push_back(world.irecv(static_cast<int>(r), tag, received[r].data(), static_cast<int>(recv_sizes[r])));
+                }
+            }
+            for (std::size_t r = 0; r < size; ++r)
+            {
+                if (r != rank && send_sizes[r] > 0)
+                {
+                    req.push_back(world.isend(static_cast<int>(r), tag, buffers[r].data(), static_cast<int>(send_sizes[r])));
+                }
+            }
+            received[rank] = std::move(buffers[rank]);
+            mpi::wait_all(req.begin(), req.end());
+            return received;
+#else
+            return std::move(buffers);
+#endif
+        }
+
+        template <class Run>
+        void write_run(HaloWriter& writer, const Run& run)
+        {
+            writer.write(run.level);
+            writer.write(run.start);
+            writer.write(run.end);
+            for (std::size_t d = 0; d < run.index.size(); ++d)
+            {
+                writer.write(run.index[d]);
+            }
+        }
+
+        template <class Run>
+        void read_run(HaloReader& reader, Run& run)
+        {
+            reader.read(run.level);
+            reader.read(run.start);
+            reader.read(run.end);
+            for (std::size_t d = 0; d < run.index.size(); ++d)
+            {
+                reader.read(run.index[d]);
+            }
+        }
+
+        template <class Field>
+        auto& storage_value(Field& field, std::size_t index, [[maybe_unused]] std::size_t field_i)
+        {
+            if constexpr (Field::size == 1)
+            {
+                return field(index);
+            }
+            else
+            {
+                return field(index)(field_i);
+            }
+        }
+
+        /// Values of the cells of the run, cell by cell
+        template <class Field, class Run>
+        void write_values(HaloWriter& writer, Field& field, const Run& run)
+        {
+            std::vector<typename Field::value_type> values;
+            values.reserve(static_cast<std::size_t>(run.end - run.start) * Field::size);
+            for (auto x = run.start; x < run.end; ++x)
+            {
+                auto index = static_cast<std::size_t>(run.storage + (x - run.start));
+                for (std::size_t field_i = 0; field_i < Field::size; ++field_i)
+                {
+                    values.push_back(storage_value(field, index, field_i));
+                }
+            }
+            writer.write(values);
+        }
+
+        template <class Field, class Run>
+        void read_values(HaloReader& reader, Field& field, const Run& run)
+        {
+            std::vector<typename Field::value_type> values;
+            reader.read(values);
+            std::size_t n = 0;
+            for (auto x = run.start; x < run.end; ++x)
+            {
+                auto index = static_cast<std::size_t>(run.storage + (x - run.start));
+                for (std::size_t field_i = 0; field_i < Field::size; ++field_i)
+                {
+                    storage_value(field, index, field_i) = values[n++];
+                }
+            }
+        }
+
+        /// Cells of the given level covered, even partially, by the cells
+        template <std::size_t dim, class TInterval, std::size_t max_size>
+        LevelCellArray<dim, TInterval> footprint(const CellArray<dim, TInterval, max_size>& cells, std::size_t level)
+        {
+            LevelCellList<dim, TInterval> lcl{level};
+            for (std::size_t l = 0; l <= max_size; ++l)
+            {
+                if (!cells[l].empty())
+                {
+                    auto projected = intersection(cells[l], cells[l]).on(level);
+                    for_each_interval(projected,
+                                      [&](std::size_t, const auto& i, const auto& index)
+                                      {
+                                          lcl[index].add_interval(i);
+                                      });
+                }
+            }
+            return {lcl};
+        }
+
+        /**
+         * Ranks of the processes whose cells are at most margin cells of the
+         * given level away from the local cells: the footprint of the local
+         * cells on the level, dilated by margin, intersects the one of their
+         * cells. The bounding boxes of the footprints select the processes
+         * with which the footprints are exchanged. The relation is symmetric.
+         *
+         * The level is meant to be the coarsest one of the mesh: the size of
+         * the footprints does not depend on the finest level, and the cells
+         * partially covered make the test conservative. The footprints are
+         * exchanged on a duplicate of the world communicator, so that their
+         * messages cannot match the ones of the mesh exchanges.
+         *
+         * The periodic boundaries are not taken into account.
+         */
+        template <std::size_t dim, class TInterval, std::size_t max_size>
+        std::vector<int> neighbour_ranks([[maybe_unused]] const CellArray<dim, TInterval, max_size>& cells,
+                                         [[maybe_unused]] std::size_t level,
+                                         [[maybe_unused]] typename TInterval::value_t margin)
+        {
+            std::vector<int> ranks;
+#ifdef SAMURAI_WITH_MPI
+            using value_t = typename TInterval::value_t;
+            using lca_t   = LevelCellArray<dim, TInterval>;
+            using box_t   = std::array<value_t, 2 * dim>; // min corner, then max corner (excluded)
+
+            lca_t local = footprint(cells, level);
+
+            box_t box;
+            std::fill(box.begin(), box.begin() + dim, std::numeric_limits<value_t>::max());
+            std::fill(box.begin() + dim, box.end(), std::numeric_limits<value_t>::min());
+            for_each_interval(local,
+                              [&](std::size_t, const auto& i, const auto& index)
+                              {
+                                  box[0]   = std::min(box[0], i.start);
+                                  box[dim] = std::max(box[dim], i.end);
+                                  for (std::size_t d = 1; d < dim; ++d)
+                                  {
+                                      box[d]       = std::min(box[d], index[d - 1]);
+                                      box[dim + d] = std::max(box[dim + d], index[d - 1] + 1);
+                                  }
+                              });
+
+            mpi::communicator world(MPI_COMM_WORLD, mpi::comm_duplicate);
+            std::vector<box_t> boxes;
+            mpi::all_gather(world, box, boxes);
+
+            auto is_empty = [&](const box_t& b)
+            {
+                return b[0] >= b[dim];
+            };
+            std::vector<int> candidates;
+            for (int r = 0; r < world.size(); ++r)
+            {
+                const auto& other = boxes[static_cast<std::size_t>(r)];
+                if (r == world.rank() || is_empty(box) || is_empty(other))
+                {
+                    continue;
+                }
+                bool touch = true;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    touch = touch && box[d] - margin <= other[dim + d] && other[d] <= box[dim + d] + margin;
+                }
+                if (touch)
+                {
+                    candidates.push_back(r);
+                }
+            }
+
+            std::vector<char> send;
+            HaloWriter writer(send);
+            writer.write(local);
+            std::vector<mpi::request> req;
+            for (int r : candidates)
+            {
+                req.push_back(world.isend(r, r, send.data(), static_cast<int>(send.size())));
+            }
+
+            lca_t dilated = dilate(local, static_cast<std::size_t>(margin));
+            std::vector<char> buffer;
+            for (int r : candidates)
+            {
+                auto status = world.probe(r, world.rank());
+                buffer.resize(static_cast<std::size_t>(*status.count<char>()));
+                world.recv(r, world.rank(), buffer.data(), static_cast<int>(buffer.size()));
+                HaloReader reader(buffer);
+                lca_t other;
+                reader.read(other);
+                lca_t common = intersection(dilated, other);
+                if (!common.empty())
+                {
+                    ranks.push_back(r);
+                }
+            }
+            mpi::wait_all(req.begin(), req.end());
+#endif
+            return ranks;
+        }
+
+        /**
+         * Moves the cells of the runs to their rank and returns the cells
+         * received by this process.
+         */
+        template <class CellList, class Run>
+        CellList migrate_cells(const std::vector<Run>& runs)
+        {
+            std::vector<std::vector<char>> buffers(static_cast<std::size_t>(load_balancing_size()));
+            for (const auto& run : runs)
+            {
+                HaloWriter writer(buffers[static_cast<std::size_t>(run.rank)]);
+                write_run(writer, run);
+            }
+            auto received = exchange_buffers(buffers);
+
+            CellList cl;
+            for (const auto& buffer : received)
+            {
+                HaloReader reader(buffer);
+                while (!reader.at_end())
+                {
+                    Run run{};
+                    read_run(reader, run);
+                    cl[run.level][run.index].add_interval({run.start, run.end});
+                }
+            }
+            return cl;
+        }
+
+        /// Buffers of each part: the cells of its runs, each one followed by the values of the fields on it
+        template <class Run, class... Fields>
+        std::vector<std::vector<char>> pack_runs(const std::vector<Run>& runs, std::size_t nb_parts, Fields&... fields)
+        {
+            std::vector<std::vector<char>> buffers(nb_parts);
+            for (const auto& run : runs)
+            {
+                HaloWriter writer(buffers[static_cast<std::size_t>(run.rank)]);
+                write_run(writer, run);
+                (write_values(writer, fields, run), ...);
+            }
+            return buffers;
+        }
+
+        /// Cells of the buffers written by pack_runs() for the fields of types Fields
+        template <class CellList, class Run, class... Fields>
+        CellList unpack_cells(const std::vector<std::vector<char>>& buffers)
+        {
+            CellList cl;
+            for (const auto& buffer : buffers)
+            {
+                HaloReader reader(buffer);
+                while (!reader.at_end())
+                {
+                    Run run{};
+                    read_run(reader, run);
+                    cl[run.level][run.index].add_interval({run.start, run.end});
+                    (reader.skip_vector<typename Fields::value_type>(), ...);
+                }
+            }
+            return cl;
+        }
+
+        /// Values of the buffers written by pack_runs() in the fields defined on the mesh built from unpack_cells()
+        template <class Run, class Mesh, class... Fields>
+        void unpack_values(const std::vector<std::vector<char>>& buffers, const Mesh& mesh, Fields&... fields)
+        {
+            using interval_t = typename Mesh::interval_t;
+
+            for (const auto& buffer : buffers)
+            {
+                HaloReader reader(buffer);
+                while (!reader.at_end())
+                {
+                    Run run{};
+                    read_run(reader, run);
+                    run.storage = mesh.get_interval(run.level, interval_t{run.start, run.start + 1}, run.index).index + run.start;
+                    (read_values(reader, fields, run), ...);
+                }
+            }
+        }
+    }
+
+    /**
+     * Ratio between the maximum and the mean of the loads of the processes
+     * (1 for a perfect balance), the load being the sum of the costs of the
+     * cells.
+     */
+    template <class Mesh>
+    double load_imbalance(const Mesh& mesh, const LoadBalancingOptions& options = {})
+    {
+        using mesh_id_t = typename Mesh::mesh_id_t;
+
+        auto weight = detail::load_balancing_weight(options);
+        double load = 0;
+        for_each_interval(mesh[mesh_id_t::cells],
+                          [&](std::size_t level, const auto& i, const auto&)
+                          {
+                              for (auto x = i.start; x < i.end; ++x)
+                              {
+                                  load += weight(level, static_cast<std::size_t>(x + i.index));
+                              }
+                          });
+
+        double max_load = load;
+        double sum_load = load;
+#ifdef SAMURAI_WITH_MPI
+        mpi::communicator world;
+        max_load = mpi::all_reduce(world, load, mpi::maximum<double>());
+        sum_load = mpi::all_reduce(world, load, std::plus<double>());
+#endif
+        double mean_load = sum_load / static_cast<double>(detail::load_balancing_size());
+        return mean_load > 0 ? max_load / mean_load : 1.;
+    }
+
+    /**
+     * Redistributes the cells of the mesh of the fields between the MPI
+     * processes so that the processes have the same load, and moves the
+     * values of the fields with their cells.
+     *
+     * The cells are split along a space-filling curve weighted by the costs
+     * of the cells, the neighbourhood of the subdomains is rebuilt and the
+     * mesh is rebuilt as after an adaptation. All the fields defined on the
+     * mesh must be given: the other ones are invalidated. Call it after the
+     * adaptation, before the update of the ghosts. The periodic meshes are
+     * not supported (std::runtime_error is thrown if they are unbalanced).
+     *
+     * @returns true if cells have been moved.
+     */
+    template <class Field, class... Fields>
+    bool load_balance(const LoadBalancingOptions& options, Field& field, Fields&... fields)
+    {
+        using mesh_t     = typename Field::mesh_t;
+        using mesh_id_t  = typename mesh_t::mesh_id_t;
+        using cl_type    = typename mesh_t::cl_type;
+        using ca_type    = typename mesh_t::ca_type;
+        using interval_t = typename mesh_t::interval_t;
+        using value_t    = typename interval_t::value_t;
+        using run_t      = SFCRun<mesh_t::dim, interval_t>;
+
+        static_assert(std::conjunction_v<std::is_same<typename Fields::mesh_t, mesh_t>...>, "The fields must be defined on the same mesh");
+
+        auto& mesh = field.mesh();
+        if (load_imbalance(mesh, options) <= 1. + options.tolerance)
+        {
+            return false;
+        }
+        // The neighbours across the periodic boundaries would be lost
+        for (std::size_t d = 0; d < mesh_t::dim; ++d)
+        {
+            if (mesh.is_periodic(d))
+            {
+                throw std::runtime_error("load_balance does not support the periodic meshes");
+            }
+        }
+
+        SAMURAI_PROFILE_SCOPE("load_balance");
+
+        const auto nb_ranks = static_cast<std::size_t>(detail::load_balancing_size());
+        auto runs           = sfc_partition(mesh[mesh_id_t::cells], options.curve, nb_ranks, detail::load_balancing_weight(options));
+
+        // The values follow the cells of each run
+        auto buffers  = detail::pack_runs(runs, nb_ranks, field, fields...);
+        auto received = detail::exchange_buffers(buffers);
+        cl_type cl    = detail::unpack_cells<cl_type, run_t, Field, Fields...>(received);
+
+        // The neighbourhood is rebuilt before the mesh, whose construction exchanges the halos
+        ca_type new_cells   = {cl};
+        auto margin         = static_cast<value_t>(mesh_t::config::ghost_width);
+        auto& neighbourhood = mesh.mpi_neighbourhood();
+        neighbourhood.clear();
+        for (int rank : detail::neighbour_ranks(new_cells, mesh.min_level(), margin))
+        {
+            neighbourhood.emplace_back(rank);
+        }
+        mesh_t new_mesh = {cl, mesh};
+
+        Field new_field(field.name(), new_mesh);
+        std::tuple<Fields...> new_fields{Fields(fields.name(), new_mesh)...};
+        std::apply(
+            [&](auto&... new_f)
+            {
+                detail::unpack_values<run_t>(received, new_mesh, new_field, new_f...);
+            },
+            new_fields);
+
+        std::swap(field.array(), new_field.array());
+        std::apply(
+            [&](auto&... new_f)
+            {
+                (std::swap(fields.array(), new_f.array()), ...);
+            },
+            new_fields);
+        mesh.swap(new_mesh);
+        return true;
+    }
+
+    template <class Field, class... Fields>
+    bool load_balance(Field& field, Fields&... fields)
+    {
+        return load_balance(LoadBalancingOptions{}, field, fields...);
+    }
+}
@@ -0,0 +1,311 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#ifdef SAMURAI_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace samurai
+{
+    /**
+     * @class FieldMemoryPool
+     * Process-wide pool of the buffers of the fields.
+     *
+     * The large buffers are rounded up to a size class (four classes per
+     * power of two, so that at most 25% is lost) and are kept in a free list
+     * of their class when they are released: the fields created on a new
+     * mesh after an adaptation reuse the buffers of the fields of the old
+     * mesh instead of going back to the system. The cached memory is bounded
+     * by the memory in use (or min_cached_bytes(), 0 by default, if larger),
+     * which is what an adaptation needs; release() gives it back to the
+     * system.
+     *
+     * The new buffers are aligned on a cache line, or on a huge page with
+     * huge_pages_if(true) for those of at least min_huge_page_size bytes
+     * (Linux only, through madvise): their size classes are multiples of
+     * huge_page_size, so that the accounted size is the reserved one. With
+     * OpenMP, the pages of the buffers allocated by the thread which created
+     * the pool, outside of a parallel region, are first touched by the
+     * threads with a static schedule, so that they are placed on the NUMA
+     * node of the threads which compute the corresponding cells.
+     */
+    class FieldMemoryPool
+    {
+      public:
+
+        static constexpr std::size_t alignment       = 64;
+        static constexpr std::size_t page_size       = 4096;
+        static constexpr std::size_t huge_page_size     = 2 * 1024 * 1024;
+        static constexpr std::size_t min_huge_page_size = 4 * huge_page_size; ///< Smaller buffers are on regular pages
+        static constexpr std::size_t min_pooled_size    = 64 * 1024;          ///< Smaller buffers bypass the pool
+
+        static FieldMemoryPool& instance()
+        {
+            // Never destroyed: the fields with static storage may outlive it
+            static auto* pool = new FieldMemoryPool();
+            return *pool;
+        }
+
+        FieldMemoryPool(const FieldMemoryPool&)            = delete;
+        FieldMemoryPool& operator=(const FieldMemoryPool&) = delete;
+
+        void* allocate(std::size_t bytes)
+        {
+            if (bytes < min_pooled_size)
+            {
+                return aligned_allocate(alignment, round_up(std::max(bytes, std::size_t{1}), alignment));
+            }
+
+            auto size = size_class(bytes);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_in_use += size;
+                auto it = m_free_lists.find(size);
+                if (it != m_free_lists.end() && !it->second.empty())
+                {
+                    void* ptr = it->second.back();
+                    it->second.pop_back();
+                    m_cached -= size;
+                    ++m_nb_reuses;
+                    return ptr;
+                }
+                ++m_nb_allocations;
+            }
+            return allocate_new(size);
+        }
+
+        void deallocate(void* ptr, std::size_t bytes)
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+            if (bytes < min_pooled_size)
+            {
+                std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+                return;
+            }
+
+            auto size = size_class(bytes);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_in_use -= size;
+                if (m_cached + size <= std::max(m_in_use, m_min_cached_bytes))
+                {
+                    m_free_lists[size].push_back(ptr);
+                    m_cached += size;
+                    return;
+                }
+            }
+            std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+        }
+
+        /// Gives the cached buffers back to the system
+        void release()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& [size, buffers] : m_free_lists)
+            {
+                for (void* ptr : buffers)
+                {
+                    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+                }
+            }
+            m_free_lists.clear();
+            m_cached = 0;
+        }
+
+        /// Allocates the new large buffers on huge pages (Linux only)
+        void huge_pages_if(bool enable)
+        {
+            m_huge_pages.store(enable, std::memory_order_relaxed);
+        }
+
+        bool huge_pages() const
+        {
+            return m_huge_pages.load(std::memory_order_relaxed);
+        }
+
+        /// Bytes of released buffers kept for reuse even if fewer are in use
+        void set_min_cached_bytes(std::size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_min_cached_bytes = bytes;
+        }
+
+        std::size_t min_cached_bytes() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_min_cached_bytes;
+        }
+
+        /// Bytes of the pooled buffers currently used
+        std::size_t in_use_bytes() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_in_use;
+        }
+
+        /// Bytes of the released buffers kept for reuse
+        std::size_t cached_bytes() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_cached;
+        }
+
+        /// Number of pooled buffers taken from the system
+        std::size_t nb_allocations() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_nb_allocations;
+        }
+
+        /// Number of pooled buffers taken from the free lists
+        std::size_t nb_reuses() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_nb_reuses;
+        }
+
+        /// Size of the buffer actually reserved for a request of 'bytes' bytes
+        static std::size_t size_class(std::size_t bytes)
+        {
+            if (bytes < min_pooled_size)
+            {
+                return round_up(std::max(bytes, std::size_t{1}), alignment);
+            }
+            // Largest power of two lower than or equal to bytes, then quarters of it
+            std::size_t power = min_pooled_size;
+            while (power <= bytes / 2)
+            {
+                power *= 2;
+            }
+            return round_up(bytes, power / 4);
+        }
+
+      private:
+
+        FieldMemoryPool() = default;
+
+        static std::size_t round_up(std::size_t bytes, std::size_t multiple)
+        {
+            return (bytes + multiple - 1) / multiple * multiple;
+        }
+
+        static void* aligned_allocate(std::size_t align, std::size_t bytes)
+        {
+            void* ptr = std::aligned_alloc(align, bytes); // NOLINT(cppcoreguidelines-no-malloc)
+            if (ptr == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return ptr;
+        }
+
+        void* allocate_new(std::size_t size)
+        {
+            void* ptr = nullptr;
+            if (huge_pages() && size >= min_huge_page_size)
+            {
+                // The size classes of these buffers are multiples of huge_page_size
+                assert(size % huge_page_size == 0);
+                ptr = aligned_allocate(huge_page_size, size);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+                madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+            }
+            else
+            {
+                ptr = aligned_allocate(alignment, size);
+            }
+            first_touch(static_cast<char*>(ptr), size);
+            return ptr;
+        }
+
+        /// Maps the pages with the threads which will compute on them
+        void first_touch([[maybe_unused]] char* ptr, [[maybe_unused]] std::size_t size) const
+        {
+#ifdef SAMURAI_WITH_OPENMP
+            // No nested team: the buffers allocated in a parallel region or
+            // by another thread are mapped by the allocating thread
+            if (omp_in_parallel() || std::this_thread::get_id() != m_owner_thread)
+            {
+                return;
+            }
+            auto nb_pages = static_cast<std::ptrdiff_t>(size / page_size);
+#pragma omp parallel for schedule(static)
+            for (std::ptrdiff_t p = 0; p < nb_pages; ++p)
+            {
+                ptr[p * static_cast<std::ptrdiff_t>(page_size)] = 0;
+            }
+#endif
+        }
+
+        mutable std::mutex m_mutex;
+        std::map<std::size_t, std::vector<void*>> m_free_lists;
+        std::size_t m_in_use           = 0;
+        std::size_t m_cached           = 0;
+        std::size_t m_nb_allocations   = 0;
+        std::size_t m_nb_reuses        = 0;
+        std::size_t m_min_cached_bytes = 0;
+        std::atomic<bool> m_huge_pages{false};
+        std::thread::id m_owner_thread = std::this_thread::get_id(); ///< Thread which created the pool, normally the main thread
+    };
+
+    /**
+     * Allocator of the field storage (see Field::data_type) taking its
+     * buffers from the FieldMemoryPool.
+     */
+    template <class T>
+    struct pool_allocator
+    {
+        using value_type = T;
+
+        pool_allocator() noexcept = default;
+
+        template <class U>
+        pool_allocator(const pool_allocator<U>&) noexcept // NOLINT(google-explicit-constructor)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(FieldMemoryPool::instance().allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept
+        {
+            FieldMemoryPool::instance().deallocate(ptr, n * sizeof(T));
+        }
+    };
+
+    template <class T, class U>
+    bool operator==(const pool_allocator<T>&, const pool_allocator<U>&) noexcept
+    {
+        return true;
+    }
+
+    template <class T, class U>
+    bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&) noexcept
+    {
+        return false;
+    }
+}
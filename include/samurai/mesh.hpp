@@ -4,14 +4,26 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
 #include "box.hpp"
 #include "cell_array.hpp"
 #include "cell_list.hpp"
+#include "load_balancing.hpp"
+#include "mesh_halo.hpp"
+#include "sorted_cell_list.hpp"
 
+#include "subset/materialized_subset.hpp"
 #include "subset/subset_op.hpp"
 
 #ifdef SAMURAI_WITH_MPI
@@ -55,6 +67,29 @@ namespace samurai
         }
     };
 
+    namespace detail
+    {
+        /// Cell list type of a mesh: Config::cl_type if defined, CellList otherwise
+        template <class Config, class = void>
+        struct mesh_cl_type
+        {
+            using type = CellList<Config::dim, typename Config::interval_t, Config::max_refinement_level>;
+        };
+
+        template <class Config>
+        struct mesh_cl_type<Config, std::void_t<typename Config::cl_type>>
+        {
+            using type = typename Config::cl_type;
+        };
+
+        /// New identifier for a mesh whose sub meshes have been (re)built
+        inline std::size_t new_mesh_version()
+        {
+            static std::atomic<std::size_t> counter{0};
+            return ++counter;
+        }
+    } // namespace detail
+
     template <class D, class Config>
     class Mesh_base
     {
@@ -72,7 +107,7 @@ namespace samurai
         using index_t    = typename interval_t::index_t;
 
         using cell_t   = Cell<dim, interval_t>;
-        using cl_type  = CellList<dim, interval_t, max_refinement_level>;
+        using cl_type  = typename detail::mesh_cl_type<config>::type;
         using lcl_type = typename cl_type::lcl_type;
 
         using ca_type  = CellArray<dim, interval_t, max_refinement_level>;
@@ -84,6 +119,8 @@ namespace samurai
 
         using mpi_subdomain_t = MPI_Subdomain<D>;
 
+        using subset_plan_t = MaterializedSubset<dim, interval_t>;
+
         std::size_t nb_cells(mesh_id_t mesh_id = mesh_id_t::reference) const;
         std::size_t nb_cells(std::size_t level, mesh_id_t mesh_id = mesh_id_t::reference) const;
 
@@ -98,9 +135,20 @@ namespace samurai
         const std::array<bool, dim>& periodicity() const;
         // std::vector<int>& neighbouring_ranks();
         std::vector<mpi_subdomain_t>& mpi_neighbourhood();
+        const std::vector<mpi_subdomain_t>& mpi_neighbourhood() const;
 
         void swap(Mesh_base& mesh) noexcept;
 
+        std::size_t version() const;
+
+        template <class Func>
+        const subset_plan_t& subset_plan(std::string_view name, std::size_t level, Func&& make_subset) const;
+        template <class Vector, class Func>
+        const subset_plan_t& subset_plan(std::string_view name, std::size_t level, const Vector& direction, Func&& make_subset) const;
+        template <class Vector, class Func>
+        const subset_plan_t&
+        subset_plan(std::string_view name, std::size_t index, std::size_t level, const Vector& direction, Func&& make_subset) const;
+
         template <typename... T>
         const interval_t& get_interval(std::size_t level, const interval_t& interval, T... index) const;
         template <class E>
@@ -123,8 +171,15 @@ namespace samurai
         cell_t get_cell(std::size_t level, const xt::xexpression<E>& coord) const;
 
         void update_mesh_neighbour();
+        std::size_t mpi_halo_width() const;
+        void set_mpi_halo_width(std::size_t width);
         void to_stream(std::ostream& os) const;
 
+        template <class Archive>
+        void save_state(Archive& ar) const;
+        template <class Archive>
+        void load_state(Archive& ar);
+
       protected:
 
         using derived_type = D;
@@ -145,6 +200,9 @@ namespace samurai
 
         mesh_t& cells();
 
+        void start_mesh_neighbour_exchange();
+        void finish_mesh_neighbour_exchange();
+
       private:
 
         void construct_subdomain();
@@ -152,8 +210,10 @@ namespace samurai
         void update_sub_mesh();
         void renumbering();
         void partition_mesh(std::size_t start_level, const Box<double, dim>& global_box);
-        void load_balancing();
-        void load_transfer(const std::vector<double>& load_fluxes);
+        void partition_mesh_sfc(std::size_t start_level, const Box<double, dim>& global_box);
+        void compute_halo_bands();
+        void pack_halo(std::vector<char>& buffer, const lca_type* neighbour_subdomain) const;
+        detail::HaloHeader unpack_halo(const std::vector<char>& buffer, const lca_type& domain);
 
         lca_type m_domain;
         lca_type m_subdomain;
@@ -164,8 +224,19 @@ namespace samurai
         ca_type m_union;
         // std::vector<int> m_neighbouring_ranks;
         std::vector<mpi_subdomain_t> m_mpi_neighbourhood;
+        std::size_t m_version = 0; ///< Changed each time the sub meshes are built
+        mutable SubsetPlanCache<dim, interval_t> m_subset_plans;
+        std::size_t m_halo_width = detail::mesh_halo_width<Config>::value; ///< Width of the band sent to the neighbouring subdomains
+        mesh_t m_halo_bands;            ///< Band of each sub mesh along the boundary of the subdomain, during an exchange
+        lca_type m_halo_subdomain_band; ///< Band of the subdomain, during an exchange
+        lca_type m_halo_subdomain;      ///< Subdomain sent by the previous exchange
+        bool m_halo_subdomain_changed = false;
 
 #ifdef SAMURAI_WITH_MPI
+        std::vector<std::vector<char>> m_halo_send; ///< Halo sent to each neighbour, kept until the end of the exchange
+        std::vector<bool> m_halo_filtered;          ///< Whether the halo sent to each neighbour was restricted to its subdomain
+        std::vector<mpi::request> m_halo_requests;
+
         friend class boost::serialization::access;
 
         template <class Archive>
@@ -179,7 +250,7 @@ namespace samurai
             ar& m_subdomain;
             ar& m_union;
             ar& m_min_level;
-            ar& m_min_level;
+            ar& m_max_level;
         }
 #endif
     };
@@ -216,15 +287,16 @@ namespace samurai
 
 #ifdef SAMURAI_WITH_MPI
         partition_mesh(start_level, b);
-        // load_balancing();
 #else
         this->m_cells[mesh_id_t::cells][start_level] = {start_level, b};
 #endif
         construct_subdomain();
         construct_union();
         update_sub_mesh();
+        // The indices of the cells are not sent: the renumbering overlaps the exchange
+        start_mesh_neighbour_exchange();
         renumbering();
-        update_mesh_neighbour();
+        finish_mesh_neighbour_exchange();
     }
 
     template <class D, class Config>
@@ -242,7 +314,6 @@ namespace samurai
 
 #ifdef SAMURAI_WITH_MPI
         partition_mesh(start_level, b);
-        // load_balancing();
 #else
         this->m_cells[mesh_id_t::cells][start_level] = {start_level, b};
 #endif
@@ -277,12 +348,14 @@ namespace samurai
         , m_max_level(ref_mesh.m_max_level)
         , m_periodic(ref_mesh.m_periodic)
         , m_mpi_neighbourhood(ref_mesh.m_mpi_neighbourhood)
-
+        , m_halo_width(ref_mesh.m_halo_width)
     {
         m_cells[mesh_id_t::cells] = {cl, false};
+        // The neighbours know the subdomain of ref_mesh
+        m_halo_subdomain = ref_mesh.m_halo_subdomain;
 
-        update_mesh_neighbour();
         construct_subdomain();
+        update_mesh_neighbour();
         construct_union();
         update_sub_mesh();
         renumbering();
@@ -424,6 +497,12 @@ namespace samurai
         return m_mpi_neighbourhood;
     }
 
+    template <class D, class Config>
+    inline auto Mesh_base<D, Config>::mpi_neighbourhood() const -> const std::vector<mpi_subdomain_t>&
+    {
+        return m_mpi_neighbourhood;
+    }
+
     template <class D, class Config>
     inline void Mesh_base<D, Config>::swap(Mesh_base<D, Config>& mesh) noexcept
     {
@@ -435,12 +514,78 @@ namespace samurai
         swap(m_union, mesh.m_union);
         swap(m_max_level, mesh.m_max_level);
         swap(m_min_level, mesh.m_min_level);
+        swap(m_version, mesh.m_version);
+        swap(m_subset_plans, mesh.m_subset_plans);
+        swap(m_halo_width, mesh.m_halo_width);
+        swap(m_halo_subdomain, mesh.m_halo_subdomain);
+    }
+
+    /**
+     * Identifier of the current state of the mesh: two meshes with the same
+     * version have the same cells.
+     */
+    template <class D, class Config>
+    inline std::size_t Mesh_base<D, Config>::version() const
+    {
+        return m_version;
+    }
+
+    /**
+     * Materialized subset of the mesh at the given level.
+     *
+     * The subset returned by make_subset() is evaluated the first time it is
+     * requested and reused until the mesh changes.
+     * @param name the name identifying the subset (a string literal)
+     * @param level the level of the subset
+     * @param make_subset function returning the subset at level
+     */
+    template <class D, class Config>
+    template <class Func>
+    inline auto Mesh_base<D, Config>::subset_plan(std::string_view name, std::size_t level, Func&& make_subset) const
+        -> const subset_plan_t&
+    {
+        return m_subset_plans.get(name, level, m_cells[mesh_id_t::reference][level], m_version, std::forward<Func>(make_subset));
+    }
+
+    /**
+     * Same as the preceding function for a subset that also depends on a
+     * direction.
+     */
+    template <class D, class Config>
+    template <class Vector, class Func>
+    inline auto
+    Mesh_base<D, Config>::subset_plan(std::string_view name, std::size_t level, const Vector& direction, Func&& make_subset) const
+        -> const subset_plan_t&
+    {
+        return m_subset_plans.get(name, level, direction, m_cells[mesh_id_t::reference][level], m_version, std::forward<Func>(make_subset));
+    }
+
+    /**
+     * Same as the preceding function for one of several subsets of the same
+     * name, identified by index.
+     */
+    template <class D, class Config>
+    template <class Vector, class Func>
+    inline auto Mesh_base<D, Config>::subset_plan(std::string_view name,
+                                                  std::size_t index,
+                                                  std::size_t level,
+                                                  const Vector& direction,
+                                                  Func&& make_subset) const -> const subset_plan_t&
+    {
+        return m_subset_plans.get(name,
+                                  index,
+                                  level,
+                                  direction,
+                                  m_cells[mesh_id_t::reference][level],
+                                  m_version,
+                                  std::forward<Func>(make_subset));
     }
 
     template <class D, class Config>
     inline void Mesh_base<D, Config>::update_sub_mesh()
     {
         this->derived_cast().update_sub_mesh_impl();
+        m_version = detail::new_mesh_version();
     }
 
     template <class D, class Config>
@@ -468,33 +613,344 @@ namespace samurai
                 }
             }
         }
+        // The storage indices cached by the subset plans are no longer valid
+        m_version = detail::new_mesh_version();
     }
 
+    /**
+     * Exchanges the meshes with the neighbouring subdomains: each neighbour
+     * receives the cells of this subdomain which are at most mpi_halo_width()
+     * cells of their level away from its own subdomain, for each mesh id, and
+     * the part of the band of the subdomain close to it.
+     */
     template <class D, class Config>
     inline void Mesh_base<D, Config>::update_mesh_neighbour()
+    {
+        start_mesh_neighbour_exchange();
+        finish_mesh_neighbour_exchange();
+    }
+
+    template <class D, class Config>
+    inline std::size_t Mesh_base<D, Config>::mpi_halo_width() const
+    {
+        return m_halo_width;
+    }
+
+    /**
+     * Sets the width, in cells of each level, of the band sent to the
+     * neighbouring subdomains by the next exchanges. It must cover the
+     * stencils and the ghosts of the neighbours (twice the ghost width by
+     * default): a width larger than the subdomain sends the whole mesh.
+     */
+    template <class D, class Config>
+    inline void Mesh_base<D, Config>::set_mpi_halo_width(std::size_t width)
+    {
+        m_halo_width = width;
+    }
+
+    /**
+     * Packs the halo of the current mesh for each neighbour and starts their
+     * non-blocking sends: the mesh can be modified until
+     * finish_mesh_neighbour_exchange(), which receives the halos of the
+     * neighbours.
+     *
+     * The halo sent to a neighbour is restricted to the cells close to its
+     * subdomain received by the previous exchange. The whole band is sent
+     * when this subdomain is unknown, or when the subdomain of this process
+     * changed: the neighbour only sent the part of its subdomain close to the
+     * former one.
+     */
+    template <class D, class Config>
+    inline void Mesh_base<D, Config>::start_mesh_neighbour_exchange()
     {
 #ifdef SAMURAI_WITH_MPI
-        // send/recv the meshes of the neighbouring subdomains
         mpi::communicator world;
-        std::vector<mpi::request> req;
 
-        std::transform(m_mpi_neighbourhood.cbegin(),
-                       m_mpi_neighbourhood.cend(),
-                       std::back_inserter(req),
-                       [&](const auto& neighbour)
-                       {
-                           return world.isend(neighbour.rank, neighbour.rank, derived_cast());
-                       });
+        assert(m_halo_requests.empty());
+        compute_halo_bands();
+        m_halo_subdomain_changed = !(m_subdomain == m_halo_subdomain);
+        m_halo_subdomain         = m_subdomain;
 
-        for (auto& neighbour : m_mpi_neighbourhood)
+        const std::size_t nb_neighbours = m_mpi_neighbourhood.size();
+        m_halo_send.resize(nb_neighbours);
+        m_halo_filtered.assign(nb_neighbours, false);
+        for (std::size_t n = 0; n < nb_neighbours; ++n)
         {
-            world.recv(neighbour.rank, world.rank(), neighbour.mesh);
+            const auto& neighbour               = m_mpi_neighbourhood[n];
+            const lca_type& neighbour_subdomain = neighbour.mesh.subdomain();
+
+            m_halo_filtered[n] = !m_halo_subdomain_changed && !neighbour_subdomain.empty() && !m_domain.empty()
+                              && neighbour_subdomain.level() == m_subdomain.level();
+            auto& halo = m_halo_send[n];
+            pack_halo(halo, m_halo_filtered[n] ? &neighbour_subdomain : nullptr);
+            m_halo_requests.push_back(world.isend(neighbour.rank, neighbour.rank, halo.data(), static_cast<int>(halo.size())));
         }
+#endif
+    }
+
+    /**
+     * Receives the halos of the neighbours. A neighbour whose subdomain
+     * changed may have received a halo restricted to its former subdomain:
+     * it is then sent the whole band, and a process whose subdomain changed
+     * receives the whole band of the neighbours which restricted its halo.
+     */
+    template <class D, class Config>
+    inline void Mesh_base<D, Config>::finish_mesh_neighbour_exchange()
+    {
+#ifdef SAMURAI_WITH_MPI
+        mpi::communicator world;
+        std::vector<char> buffer;
+
+        auto receive = [&](int rank)
+        {
+            auto status = world.probe(rank, world.rank());
+            buffer.resize(static_cast<std::size_t>(*status.count<char>()));
+            world.recv(rank, world.rank(), buffer.data(), static_cast<int>(buffer.size()));
+        };
+
+        std::vector<char> full_halo;
+        std::vector<std::size_t> restricted_halos;
+        for (std::size_t n = 0; n < m_mpi_neighbourhood.size(); ++n)
+        {
+            auto& neighbour = m_mpi_neighbourhood[n];
+            receive(neighbour.rank);
+            auto header = neighbour.mesh.unpack_halo(buffer, m_domain);
 
-        mpi::wait_all(req.begin(), req.end());
+            if (header.subdomain_changed && m_halo_filtered[n])
+            {
+                if (full_halo.empty())
+                {
+                    pack_halo(full_halo, nullptr);
+                }
+                auto request = world.isend(neighbour.rank, neighbour.rank, full_halo.data(), static_cast<int>(full_halo.size()));
+                m_halo_requests.push_back(request);
+            }
+            if (header.filtered && m_halo_subdomain_changed)
+            {
+                restricted_halos.push_back(n);
+            }
+        }
+        // The messages from a process are received in the order of their sends
+        for (auto n : restricted_halos)
+        {
+            auto& neighbour = m_mpi_neighbourhood[n];
+            receive(neighbour.rank);
+            neighbour.mesh.unpack_halo(buffer, m_domain);
+        }
+
+        mpi::wait_all(m_halo_requests.begin(), m_halo_requests.end());
+        m_halo_requests.clear();
+        m_halo_send.clear();
+        m_halo_filtered.clear();
+        m_halo_bands          = {};
+        m_halo_subdomain_band = {};
 #endif
     }
 
+    /**
+     * Bands sent to the neighbours: for each mesh id and each level, the
+     * cells which are not in the subdomain eroded by mpi_halo_width() cells
+     * of the level (the cells partially in the eroded subdomain are kept),
+     * and the band of the subdomain of the coarsest level.
+     *
+     * The erosion is computed once on the level of the subdomain, with a
+     * radius growing from the finest level to the coarsest one.
+     */
+    template <class D, class Config>
+    void Mesh_base<D, Config>::compute_halo_bands()
+    {
+        std::size_t subdomain_level = m_subdomain.level();
+        std::size_t coarsest_level  = subdomain_level;
+        for (std::size_t id = 0; id < mesh_t::size; ++id)
+        {
+            for (std::size_t level = 0; level < coarsest_level; ++level)
+            {
+                if (!m_cells[id][level].empty())
+                {
+                    coarsest_level = level;
+                }
+            }
+        }
+
+        std::array<lca_type, max_refinement_level + 1> eroded;
+        lca_type current   = m_subdomain;
+        std::size_t radius = 0;
+        for (std::size_t level = subdomain_level + 1; level-- > coarsest_level;)
+        {
+            std::size_t level_radius = m_halo_width << (subdomain_level - level);
+            current                  = detail::erode(current, level_radius, radius);
+            radius                   = level_radius;
+            eroded[level]            = current;
+        }
+        for (std::size_t level = subdomain_level + 1; level <= max_refinement_level; ++level)
+        {
+            eroded[level] = eroded[subdomain_level];
+        }
+
+        auto band = [&](const lca_type& lca, const lca_type& eroded_lca) -> lca_type
+        {
+            if (eroded_lca.empty())
+            {
+                return lca;
+            }
+            return difference(lca, eroded_lca).on(lca.level());
+        };
+
+        m_halo_subdomain_band = band(m_subdomain, eroded[coarsest_level]);
+        for (std::size_t id = 0; id < mesh_t::size; ++id)
+        {
+            m_halo_bands[id] = {};
+            for (std::size_t level = 0; level <= max_refinement_level; ++level)
+            {
+                if (!m_cells[id][level].empty())
+                {
+                    m_halo_bands[id][level] = band(m_cells[id][level], eroded[level]);
+                }
+            }
+        }
+    }
+
+    /**
+     * Flat binary halo of the mesh: a HaloHeader, the levels, the band of the
+     * subdomain and, for each mesh id, the number of non-empty levels of the
+     * band followed by their LevelCellArray.
+     *
+     * If neighbour_subdomain is given, the bands are restricted to the cells
+     * which are at most mpi_halo_width() cells of their level away from it:
+     * the neighbour_subdomain is dilated once on its level, with a radius
+     * growing from the finest level to the coarsest one, and its images
+     * through the periodic boundaries are added.
+     */
+    template <class D, class Config>
+    void Mesh_base<D, Config>::pack_halo(std::vector<char>& buffer, const lca_type* neighbour_subdomain) const
+    {
+        std::size_t subdomain_level = m_subdomain.level();
+        std::size_t coarsest_level  = subdomain_level;
+        for (std::size_t id = 0; id < mesh_t::size; ++id)
+        {
+            for (std::size_t level = 0; level < coarsest_level; ++level)
+            {
+                if (!m_halo_bands[id][level].empty())
+                {
+                    coarsest_level = level;
+                }
+            }
+        }
+
+        std::array<lca_type, max_refinement_level + 1> close;
+        if (neighbour_subdomain != nullptr)
+        {
+            // A radius larger than the domain adds no cell of the domain
+            std::size_t domain_level = m_domain.level();
+            auto min_indices         = m_domain.min_indices();
+            auto max_indices         = m_domain.max_indices();
+            xt::xtensor_fixed<value_t, xt::xshape<dim>> length;
+            std::size_t max_radius = 0;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                length[d]  = subdomain_level >= domain_level ? (max_indices[d] - min_indices[d]) << (subdomain_level - domain_level)
+                                                             : (max_indices[d] - min_indices[d]) >> (domain_level - subdomain_level);
+                max_radius = std::max(max_radius, static_cast<std::size_t>(length[d]));
+            }
+
+            lca_type current = *neighbour_subdomain;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                if (m_periodic[d])
+                {
+                    xt::xtensor_fixed<value_t, xt::xshape<dim>> shift;
+                    shift.fill(0);
+                    shift[d] = length[d];
+
+                    lca_type images = union_(current, translate(current, shift), translate(current, -shift));
+                    std::swap(current, images);
+                }
+            }
+
+            std::size_t radius = 0;
+            for (std::size_t level = subdomain_level + 1; level-- > coarsest_level;)
+            {
+                std::size_t level_radius = std::min(m_halo_width << (subdomain_level - level), max_radius);
+                current                  = detail::dilate(current, level_radius - radius);
+                radius                   = level_radius;
+                close[level]             = current;
+            }
+            for (std::size_t level = subdomain_level + 1; level <= max_refinement_level; ++level)
+            {
+                close[level] = close[subdomain_level];
+            }
+        }
+
+        auto restrict_band = [&](const lca_type& lca, const lca_type& close_lca) -> lca_type
+        {
+            if (neighbour_subdomain == nullptr || lca.empty())
+            {
+                return lca;
+            }
+            return intersection(lca, close_lca).on(lca.level());
+        };
+
+        buffer.clear();
+        detail::HaloWriter writer(buffer);
+        writer.write(detail::HaloHeader{m_halo_subdomain_changed, neighbour_subdomain != nullptr});
+        writer.write(m_min_level);
+        writer.write(m_max_level);
+        writer.write(restrict_band(m_halo_subdomain_band, close[coarsest_level]));
+        for (std::size_t id = 0; id < mesh_t::size; ++id)
+        {
+            std::vector<lca_type> bands;
+            for (std::size_t level = 0; level <= max_refinement_level; ++level)
+            {
+                if (!m_halo_bands[id][level].empty())
+                {
+                    lca_type lca = restrict_band(m_halo_bands[id][level], close[level]);
+                    if (!lca.empty())
+                    {
+                        bands.push_back(std::move(lca));
+                    }
+                }
+            }
+            writer.write(bands.size());
+            for (const auto& lca : bands)
+            {
+                writer.write(lca);
+            }
+        }
+    }
+
+    /// Replaces the mesh by the halo of a neighbouring subdomain and returns its header
+    template <class D, class Config>
+    detail::HaloHeader Mesh_base<D, Config>::unpack_halo(const std::vector<char>& buffer, const lca_type& domain)
+    {
+        detail::HaloReader reader(buffer);
+        detail::HaloHeader header;
+        reader.read(header);
+        reader.read(m_min_level);
+        reader.read(m_max_level);
+        reader.read(m_subdomain);
+        for (std::size_t id = 0; id < mesh_t::size; ++id)
+        {
+            m_cells[id] = {};
+
+            std::size_t nb_levels = 0;
+            reader.read(nb_levels);
+            for (std::size_t n = 0; n < nb_levels; ++n)
+            {
+                lca_type lca;
+                reader.read(lca);
+                if (lca.level() > max_refinement_level)
+                {
+                    throw std::runtime_error("Corrupted halo buffer");
+                }
+                m_cells[id][lca.level()] = std::move(lca);
+            }
+        }
+        m_domain  = domain;
+        m_union   = {};
+        m_version = detail::new_mesh_version();
+        return header;
+    }
+
     template <class D, class Config>
     inline void Mesh_base<D, Config>::construct_subdomain()
     {
@@ -590,12 +1046,9 @@ namespace samurai
         sizes[dim - 1] = size / product_of_sizes;
         if (sizes[dim - 1] * product_of_sizes != size)
         {
-            if (rank == 0)
-            {
-                std::cerr << "Impossible to perform a Cartesian partition of the domain in " << size << " subdomains." << std::endl;
-                std::cerr << "Suggested number: " << (sizes[dim - 1] * product_of_sizes) << "." << std::endl;
-            }
-            exit(1);
+            // No Cartesian partition in size subdomains
+            partition_mesh_sfc(start_level, global_box);
+            return;
         }
 
         // Compute the Cartesian coordinates of the subdomain in the topology
@@ -664,80 +1117,62 @@ namespace samurai
 #endif
     }
 
+    /**
+     * Partition of the box along a Hilbert curve, for any number of processes:
+     * each process starts with a slab of the box in the last direction, then
+     * the cells are redistributed along the curve and the neighbourhood is
+     * given by the bounding boxes of the subdomains.
+     */
     template <class D, class Config>
-    void Mesh_base<D, Config>::load_balancing()
+    void Mesh_base<D, Config>::partition_mesh_sfc([[maybe_unused]] std::size_t start_level,
+                                                  [[maybe_unused]] const Box<double, dim>& global_box)
     {
 #ifdef SAMURAI_WITH_MPI
+        using box_t   = Box<value_t, dim>;
+        using point_t = typename box_t::point_t;
+
         mpi::communicator world;
         auto rank = world.rank();
+        auto size = world.size();
 
-        std::size_t load = nb_cells(mesh_id_t::cells);
-        std::vector<std::size_t> loads;
-
-        std::vector<double> load_fluxes(m_mpi_neighbourhood.size(), 0);
-
-        const std::size_t n_iterations = 1;
-
-        for (std::size_t k = 0; k < n_iterations; ++k)
+        // The neighbours across the periodic boundaries would be lost
+        for (std::size_t d = 0; d < dim; ++d)
         {
-            world.barrier();
-            if (rank == 0)
+            if (m_periodic[d])
             {
-                std::cout << "---------------- k = " << k << " ----------------" << std::endl;
+                throw std::runtime_error("The partition along a space-filling curve does not support the periodic meshes");
             }
-            mpi::all_gather(world, load, loads);
-
-            std::vector<std::size_t> nb_neighbours;
-            mpi::all_gather(world, m_mpi_neighbourhood.size(), nb_neighbours);
-
-            double load_np1 = static_cast<double>(load);
-            for (std::size_t i_rank = 0; i_rank < m_mpi_neighbourhood.size(); ++i_rank)
-            {
-                auto neighbour = m_mpi_neighbourhood[i_rank];
-
-                auto neighbour_load = loads[static_cast<std::size_t>(neighbour.rank)];
-                int neighbour_load_minus_my_load;
-                if (load < neighbour_load)
-                {
-                    neighbour_load_minus_my_load = static_cast<int>(neighbour_load - load);
-                }
-                else
-                {
-                    neighbour_load_minus_my_load = -static_cast<int>(load - neighbour_load);
-                }
-                double weight       = 1. / std::max(m_mpi_neighbourhood.size(), nb_neighbours[neighbour.rank]);
-                load_fluxes[i_rank] = weight * neighbour_load_minus_my_load;
-                load_np1 += load_fluxes[i_rank];
-            }
-            load_np1 = floor(load_np1);
-
-            load_transfer(load_fluxes);
+        }
 
-            std::cout << rank << ": load = " << load << ", load_np1 = " << load_np1 << std::endl;
+        double h         = cell_length(start_level);
+        point_t start_pt = global_box.min_corner() / h;
+        point_t end_pt   = global_box.max_corner() / h;
 
-            load = static_cast<std::size_t>(load_np1);
+        auto nb_rows        = static_cast<long>(end_pt[dim - 1] - start_pt[dim - 1]);
+        point_t min_corner  = start_pt;
+        point_t max_corner  = end_pt;
+        min_corner[dim - 1] = start_pt[dim - 1] + static_cast<value_t>(nb_rows * rank / size);
+        max_corner[dim - 1] = start_pt[dim - 1] + static_cast<value_t>(nb_rows * (rank + 1) / size);
+        ca_type slab;
+        if (max_corner[dim - 1] > min_corner[dim - 1])
+        {
+            slab[start_level] = {start_level, box_t{min_corner, max_corner}};
         }
-#endif
-    }
 
-    template <class D, class Config>
-    void Mesh_base<D, Config>::load_transfer([[maybe_unused]] const std::vector<double>& load_fluxes)
-    {
-#ifdef SAMURAI_WITH_MPI
-        mpi::communicator world;
-        std::cout << world.rank() << ": ";
-        for (std::size_t i_rank = 0; i_rank < m_mpi_neighbourhood.size(); ++i_rank)
+        auto runs = sfc_partition(slab,
+                                  SFCType::Hilbert,
+                                  static_cast<std::size_t>(size),
+                                  [](std::size_t, std::size_t)
+                                  {
+                                      return 1.;
+                                  });
+        this->m_cells[mesh_id_t::cells] = {detail::migrate_cells<cl_type>(runs)};
+
+        auto margin = static_cast<value_t>(config::ghost_width);
+        for (int neighbour_rank : detail::neighbour_ranks(m_cells[mesh_id_t::cells], m_min_level, margin))
         {
-            auto neighbour = m_mpi_neighbourhood[i_rank];
-            if (load_fluxes[i_rank] < 0) // must tranfer load to the neighbour
-            {
-            }
-            else if (load_fluxes[i_rank] > 0) // must receive load from the neighbour
-            {
-            }
-            std::cout << "--> " << neighbour.rank << ": " << load_fluxes[i_rank] << ", ";
+            m_mpi_neighbourhood.emplace_back(neighbour_rank);
         }
-        std::cout << std::endl;
 #endif
     }
 
@@ -753,6 +1188,69 @@ namespace samurai
         }
     }
 
+    /**
+     * Writes the complete state of the mesh (all the sub meshes with their
+     * storage indices) through @p ar, see checkpoint.hpp.
+     */
+    template <class D, class Config>
+    template <class Archive>
+    inline void Mesh_base<D, Config>::save_state(Archive& ar) const
+    {
+        for (std::size_t id = 0; id < mesh_t::size; ++id)
+        {
+            ar.write(fmt::format("cells/{}", static_cast<mesh_id_t>(id)), m_cells[id]);
+        }
+        ar.write("domain", m_domain);
+        ar.write("subdomain", m_subdomain);
+        ar.write("union", m_union);
+        ar.write("min_level", m_min_level);
+        ar.write("max_level", m_max_level);
+
+        std::vector<int> periodic(m_periodic.cbegin(), m_periodic.cend());
+        ar.write("periodic", periodic);
+
+        std::vector<int> neighbour_ranks;
+        for (const auto& neighbour : m_mpi_neighbourhood)
+        {
+            neighbour_ranks.push_back(neighbour.rank);
+        }
+        ar.write("neighbour_ranks", neighbour_ranks);
+    }
+
+    /**
+     * Restores the state written by save_state: the sub meshes are read as
+     * they are, without being rebuilt.
+     */
+    template <class D, class Config>
+    template <class Archive>
+    inline void Mesh_base<D, Config>::load_state(Archive& ar)
+    {
+        for (std::size_t id = 0; id < mesh_t::size; ++id)
+        {
+            ar.read(fmt::format("cells/{}", static_cast<mesh_id_t>(id)), m_cells[id]);
+        }
+        ar.read("domain", m_domain);
+        ar.read("subdomain", m_subdomain);
+        ar.read("union", m_union);
+        ar.read("min_level", m_min_level);
+        ar.read("max_level", m_max_level);
+
+        std::vector<int> periodic;
+        ar.read("periodic", periodic);
+        std::copy(periodic.cbegin(), periodic.cend(), m_periodic.begin());
+
+        std::vector<int> neighbour_ranks;
+        ar.read("neighbour_ranks", neighbour_ranks);
+        m_mpi_neighbourhood.clear();
+        for (auto rank : neighbour_ranks)
+        {
+            m_mpi_neighbourhood.emplace_back(rank);
+        }
+        update_mesh_neighbour();
+
+        m_version = detail::new_mesh_version();
+    }
+
     template <class D, class Config>
     inline bool operator==(const Mesh_base<D, Config>& mesh1, const Mesh_base<D, Config>& mesh2)
     {
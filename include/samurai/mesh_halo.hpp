@@ -0,0 +1,261 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <xtensor/xfixed.hpp>
+
+#include "level_cell_array.hpp"
+#include "subset/node_op.hpp"
+#include "subset/subset_op.hpp"
+
+namespace samurai
+{
+    namespace detail
+    {
+        /**
+         * Width, in cells of each level, of the band along the boundary of a
+         * subdomain sent to the neighbouring subdomains: Config::halo_width if
+         * defined, twice the ghost width otherwise.
+         */
+        template <class Config, class = void>
+        struct mesh_halo_width
+        {
+            static constexpr std::size_t value = 2 * static_cast<std::size_t>(Config::ghost_width);
+        };
+
+        template <class Config>
+        struct mesh_halo_width<Config, std::void_t<decltype(Config::halo_width)>>
+        {
+            static constexpr std::size_t value = static_cast<std::size_t>(Config::halo_width);
+        };
+
+        /**
+         * Erosion of a set of cells by a box: the cells whose neighbours up to
+         * radius cells away in each direction are all in the set.
+         *
+         * lca is already eroded by eroded_radius. The erosion by {-a, 0, a} of
+         * a set eroded by [-b, b] is its erosion by [-(a + b), a + b] when
+         * a <= 2b + 1: the radius grows by such steps, direction by direction,
+         * so that the result is exact (the holes of the set are kept) with
+         * O(log(radius)) intersections.
+         */
+        template <std::size_t dim, class TInterval>
+        LevelCellArray<dim, TInterval> erode(const LevelCellArray<dim, TInterval>& lca, std::size_t radius, std::size_t eroded_radius = 0)
+        {
+            using value_t = typename TInterval::value_t;
+
+            LevelCellArray<dim, TInterval> result = lca;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                std::size_t current = eroded_radius;
+                while (current < radius && !result.empty())
+                {
+                    std::size_t step = std::min(2 * current + 1, radius - current);
+                    xt::xtensor_fixed<value_t, xt::xshape<dim>> shift;
+                    shift.fill(0);
+                    shift[d] = static_cast<value_t>(step);
+
+                    LevelCellArray<dim, TInterval> eroded = intersection(result, translate(result, shift), translate(result, -shift));
+                    std::swap(result, eroded);
+                    current += step;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Dilation of a set of cells by a box: the cells which have a cell of
+         * the set up to radius cells away in each direction.
+         *
+         * As for erode(), the radius grows by steps a <= 2b + 1, each step
+         * being the union of the set and of its translations by -a and a.
+         */
+        template <std::size_t dim, class TInterval>
+        LevelCellArray<dim, TInterval> dilate(const LevelCellArray<dim, TInterval>& lca, std::size_t radius)
+        {
+            using value_t = typename TInterval::value_t;
+
+            LevelCellArray<dim, TInterval> result = lca;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                std::size_t current = 0;
+                while (current < radius && !result.empty())
+                {
+                    std::size_t step = std::min(2 * current + 1, radius - current);
+                    xt::xtensor_fixed<value_t, xt::xshape<dim>> shift;
+                    shift.fill(0);
+                    shift[d] = static_cast<value_t>(step);
+
+                    LevelCellArray<dim, TInterval> dilated = union_(result, translate(result, shift), translate(result, -shift));
+                    std::swap(result, dilated);
+                    current += step;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Header of the halo sent to a neighbouring subdomain: whether the
+         * subdomain of the sender changed since the previous exchange, and
+         * whether the halo was restricted to the cells close to the former
+         * subdomain of the receiver.
+         */
+        struct HaloHeader
+        {
+            bool subdomain_changed = false;
+            bool filtered          = false;
+        };
+
+        /// Flat binary buffer of the halos exchanged between the subdomains
+        class HaloWriter
+        {
+          public:
+
+            explicit HaloWriter(std::vector<char>& buffer)
+                : m_buffer(buffer)
+            {
+            }
+
+            template <class T>
+            void write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written in a halo buffer");
+                write_raw(&value, sizeof(T));
+            }
+
+            template <class T>
+            void write(const std::vector<T>& values)
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written in a halo buffer");
+                write(values.size());
+                write_raw(values.data(), values.size() * sizeof(T));
+            }
+
+            /// Raw layout of the LevelCellArray: level, intervals in each direction and offsets
+            template <std::size_t dim, class TInterval>
+            void write(const LevelCellArray<dim, TInterval>& lca)
+            {
+                write(lca.level());
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    write(lca[d]);
+                }
+                for (std::size_t d = 1; d < dim; ++d)
+                {
+                    write(lca.offsets(d));
+                }
+            }
+
+          private:
+
+            void write_raw(const void* data, std::size_t size)
+            {
+                if (size > 0)
+                {
+                    std::size_t position = m_buffer.size();
+                    m_buffer.resize(position + size);
+                    std::memcpy(m_buffer.data() + position, data, size);
+                }
+            }
+
+            std::vector<char>& m_buffer; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+        };
+
+        class HaloReader
+        {
+          public:
+
+            explicit HaloReader(const std::vector<char>& buffer)
+                : m_buffer(buffer)
+            {
+            }
+
+            template <class T>
+            void read(T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read from a halo buffer");
+                read_raw(&value, sizeof(T));
+            }
+
+            template <class T>
+            void read(std::vector<T>& values)
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read from a halo buffer");
+                std::size_t size = 0;
+                read(size);
+                if (size > remaining() / sizeof(T))
+                {
+                    throw std::runtime_error("Corrupted halo buffer");
+                }
+                values.resize(size);
+                read_raw(values.data(), size * sizeof(T));
+            }
+
+            template <std::size_t dim, class TInterval>
+            void read(LevelCellArray<dim, TInterval>& lca)
+            {
+                std::size_t level = 0;
+                read(level);
+                lca = LevelCellArray<dim, TInterval>(level);
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    read(lca[d]);
+                }
+                for (std::size_t d = 1; d < dim; ++d)
+                {
+                    read(lca.offsets(d));
+                }
+            }
+
+            /// Skips a vector written by HaloWriter::write(const std::vector<T>&)
+            template <class T>
+            void skip_vector()
+            {
+                std::size_t size = 0;
+                read(size);
+                if (size > remaining() / sizeof(T))
+                {
+                    throw std::runtime_error("Corrupted halo buffer");
+                }
+                m_position += size * sizeof(T);
+            }
+
+            bool at_end() const
+            {
+                return m_position == m_buffer.size();
+            }
+
+          private:
+
+            std::size_t remaining() const
+            {
+                return m_buffer.size() - m_position;
+            }
+
+            void read_raw(void* data, std::size_t size)
+            {
+                if (size > remaining())
+                {
+                    throw std::runtime_error("Corrupted halo buffer");
+                }
+                if (size > 0)
+                {
+                    std::memcpy(data, m_buffer.data() + m_position, size);
+                    m_position += size;
+                }
+            }
+
+            const std::vector<char>& m_buffer; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+            std::size_t m_position = 0;
+        };
+    }
+}
@@ -8,9 +8,12 @@
 #include "../algorithm/update.hpp"
 #include "../field.hpp"
 #include "../hdf5.hpp"
+#include "../profiling.hpp"
 #include "../static_algorithm.hpp"
 #include "criteria.hpp"
+#include <functional>
 #include <type_traits>
+#include <vector>
 
 namespace samurai
 {
@@ -92,6 +95,9 @@ namespace samurai
         template <class... Fields>
         void operator()(double eps, double regularity, Fields&... other_fields);
 
+        void set_incremental(bool incremental = true);
+        bool incremental() const;
+
       private:
 
         using inner_fields_type = detail::get_fields_type<TField, TFields...>;
@@ -107,13 +113,28 @@ namespace samurai
         using interval_t    = typename mesh_t::interval_t;
         using coord_index_t = typename interval_t::coord_index_t;
         using cl_type       = typename mesh_t::cl_type;
+        using ca_type       = typename mesh_t::ca_type;
+
+        /// Dilation (in cells of each level) of the cells changed by the
+        /// previous pass: prediction/detail stencil, graduation and siblings.
+        static constexpr int active_width = mesh_t::config::ghost_width + mesh_t::config::graduation_width + 1;
 
         template <class... Fields>
         bool harten(std::size_t ite, double eps, double regularity, Fields&... other_fields);
 
+        ca_type changed_cells() const;
+        bool update_active_region(const ca_type& changed);
+
+        template <class Subset, class... Op>
+        void apply_on_active(std::size_t level, Subset&& subset, Op&&... op);
+
         fields_t m_fields; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
         detail_t m_detail;
         tag_t m_tag;
+
+        bool m_incremental = false;
+        bool m_use_active  = false;
+        ca_type m_active; ///< Region where the next pass can change the mesh
     };
 
     template <bool enlarge, class TField, class... TFields>
@@ -128,6 +149,8 @@ namespace samurai
     template <class... Fields>
     void Adapt<enlarge, TField, TFields...>::operator()(double eps, double regularity, Fields&... other_fields)
     {
+        SAMURAI_PROFILE_SCOPE("adapt");
+
         auto& mesh            = m_fields.mesh();
         std::size_t min_level = mesh.min_level();
         std::size_t max_level = mesh.max_level();
@@ -138,6 +161,9 @@ namespace samurai
         }
         update_ghost_mr(m_fields);
 
+        // The first pass is always done on the whole mesh
+        m_use_active = false;
+
         for (std::size_t i = 0; i < max_level - min_level; ++i)
         {
             // std::cout << "MR mesh adaptation " << i << std::endl;
@@ -152,6 +178,208 @@ namespace samurai
         }
     }
 
+    /**
+     * Enable the incremental adaptation.
+     *
+     * After the first pass of operator(), the detail computation, the tagging
+     * and the graduation are only done in a neighbourhood of the cells
+     * changed by the previous pass: elsewhere, the fields and the mesh are the
+     * same as in the previous pass which has not changed them. The loop stops
+     * as soon as a pass changes nothing.
+     *
+     * The mode is ignored on periodic meshes.
+     */
+    template <bool enlarge, class TField, class... TFields>
+    inline void Adapt<enlarge, TField, TFields...>::set_incremental(bool incremental)
+    {
+        m_incremental = incremental;
+    }
+
+    template <bool enlarge, class TField, class... TFields>
+    inline bool Adapt<enlarge, TField, TFields...>::incremental() const
+    {
+        return m_incremental;
+    }
+
+    /**
+     * Apply the operators on the subset, restricted to the active region of
+     * the level if the pass is incremental.
+     *
+     * @param level The level of the active region to use.
+     * @param subset A function building the subset from the additional sets to
+     * intersect with.
+     */
+    template <bool enlarge, class TField, class... TFields>
+    template <class Subset, class... Op>
+    inline void Adapt<enlarge, TField, TFields...>::apply_on_active(std::size_t level, Subset&& subset, Op&&... op)
+    {
+        if (m_use_active)
+        {
+            auto set = subset(m_active[level]);
+            set.apply_op(std::forward<Op>(op)...);
+        }
+        else
+        {
+            auto set = subset();
+            set.apply_op(std::forward<Op>(op)...);
+        }
+    }
+
+    /**
+     * Cells which update_field_mr removes or adds according to the tags: the
+     * refined cells and their children, the coarsened cells and their parent.
+     * They are read on the tags so that the old cells need not be kept.
+     */
+    template <bool enlarge, class TField, class... TFields>
+    inline auto Adapt<enlarge, TField, TFields...>::changed_cells() const -> ca_type
+    {
+        auto& mesh = m_fields.mesh();
+
+        std::size_t min_level = mesh.min_level();
+        std::size_t max_level = mesh.max_level();
+
+        cl_type cl_changed;
+        for_each_interval(mesh[mesh_id_t::cells],
+                          [&](std::size_t level, const auto& interval, const auto& index)
+                          {
+                              auto itag = interval.start + interval.index;
+                              for (auto i = interval.start; i < interval.end; ++i, ++itag)
+                              {
+                                  int tag = m_tag[itag];
+                                  if (tag & static_cast<int>(CellFlag::refine))
+                                  {
+                                      if (level < max_level)
+                                      {
+                                          cl_changed[level][index].add_point(i);
+                                          static_nested_loop<dim - 1, 0, 2>(
+                                              [&](const auto& stencil)
+                                              {
+                                                  cl_changed[level + 1][2 * index + stencil].add_interval({2 * i, 2 * i + 2});
+                                              });
+                                      }
+                                  }
+                                  else if (!(tag & static_cast<int>(CellFlag::keep)) && (tag & static_cast<int>(CellFlag::coarsen))
+                                           && level > min_level)
+                                  {
+                                      cl_changed[level][index].add_point(i);
+                                      cl_changed[level - 1][index >> 1].add_point(i >> 1);
+                                  }
+                              }
+                          });
+        return {cl_changed};
+    }
+
+    /**
+     * Build the active region for the next pass from the cells which have
+     * been added or removed by the current one (see changed_cells).
+     *
+     * A cell changed at level l has an influence on the details and the tags
+     * of its parent at level l-1 and of the coarser levels through the
+     * projection. It is then added to the active region of each level
+     * lower or equal to l+1, dilated by active_width cells.
+     *
+     * @return false if no cell has changed.
+     */
+    template <bool enlarge, class TField, class... TFields>
+    inline bool Adapt<enlarge, TField, TFields...>::update_active_region(const ca_type& changed)
+    {
+        auto& mesh = m_fields.mesh();
+
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            if (mesh.is_periodic(d))
+            {
+                m_use_active = false;
+                return true;
+            }
+        }
+
+        std::size_t min_level = mesh.min_level();
+        std::size_t max_level = mesh.max_level();
+
+        std::vector<ca_type> all_changes{changed};
+#ifdef SAMURAI_WITH_MPI
+        // The changes of the neighbouring subdomains are also taken into
+        // account since they modify the ghosts and the tags near the
+        // interfaces
+        mpi::communicator world;
+        std::vector<mpi::request> req;
+        auto& neighbourhood = mesh.mpi_neighbourhood();
+        all_changes.resize(neighbourhood.size() + 1);
+
+        for (auto& neighbour : neighbourhood)
+        {
+            req.push_back(world.isend(neighbour.rank, neighbour.rank, changed));
+        }
+        for (std::size_t i = 0; i < neighbourhood.size(); ++i)
+        {
+            world.recv(neighbourhood[i].rank, world.rank(), all_changes[i + 1]);
+        }
+        mpi::wait_all(req.begin(), req.end());
+#endif
+
+        std::size_t n_changed = 0;
+        for (const auto& ca : all_changes)
+        {
+            n_changed += ca.nb_cells();
+        }
+#ifdef SAMURAI_WITH_MPI
+        n_changed = mpi::all_reduce(world, n_changed, std::plus<std::size_t>());
+#endif
+        if (n_changed == 0)
+        {
+            m_active     = {};
+            m_use_active = true;
+            return false;
+        }
+
+        constexpr int w = active_width;
+        cl_type cl_active;
+        for (const auto& ca : all_changes)
+        {
+            for_each_interval(ca,
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  // Children of the changed cells
+                                  if (level < max_level)
+                                  {
+                                      static_nested_loop<dim - 1, 0, 2>(
+                                          [&](const auto& child)
+                                          {
+                                              auto child_index = 2 * index + child;
+                                              static_nested_loop<dim - 1>(-w,
+                                                                          w + 1,
+                                                                          1,
+                                                                          [&](const auto& stencil)
+                                                                          {
+                                                                              cl_active[level + 1][child_index + stencil].add_interval(
+                                                                                  {2 * i.start - w, 2 * i.end + w});
+                                                                          });
+                                          });
+                                  }
+
+                                  // Projection of the changed cells on the coarser levels
+                                  for (std::size_t l = ((min_level > 0) ? min_level - 1 : 0); l <= level; ++l)
+                                  {
+                                      std::size_t shift = level - l;
+                                      auto p_index      = index >> shift;
+                                      auto start        = i.start >> shift;
+                                      auto end          = ((i.end - 1) >> shift) + 1;
+                                      static_nested_loop<dim - 1>(-w,
+                                                                  w + 1,
+                                                                  1,
+                                                                  [&](const auto& stencil)
+                                                                  {
+                                                                      cl_active[l][p_index + stencil].add_interval({start - w, end + w});
+                                                                  });
+                                  }
+                              });
+        }
+        m_active     = {cl_active, false};
+        m_use_active = true;
+        return true;
+    }
+
     // TODO: to remove since it is used at several place
     namespace detail
     {
@@ -211,15 +439,24 @@ namespace samurai
         {
             update_tag_subdomains(level, m_tag, true);
         }
+
+        SAMURAI_PROFILE_START(detail_timer, "adapt/detail");
         update_ghost_mr(m_fields);
 
         for (std::size_t level = ((min_level > 0) ? min_level - 1 : 0); level < max_level - ite; ++level)
         {
-            auto subset = intersection(mesh[mesh_id_t::all_cells][level], mesh[mesh_id_t::cells][level + 1]).on(level);
-            subset.apply_op(compute_detail(m_detail, m_fields));
+            apply_on_active(
+                level,
+                [&](const auto&... active)
+                {
+                    return intersection(mesh[mesh_id_t::all_cells][level], mesh[mesh_id_t::cells][level + 1], active...).on(level);
+                },
+                compute_detail(m_detail, m_fields));
         }
         update_ghost_subdomains(m_detail);
+        SAMURAI_PROFILE_STOP(detail_timer);
 
+        SAMURAI_PROFILE_START(tagging_timer, "adapt/tagging");
         for (std::size_t level = min_level; level <= max_level - ite; ++level)
         {
             std::size_t exponent = dim * (max_level - level);
@@ -227,33 +464,47 @@ namespace samurai
 
             double regularity_to_use = regularity + dim;
 
-            auto subset_1 = intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::all_cells][level - 1]).on(level - 1);
+            auto subset_1 = [&](const auto&... active)
+            {
+                return intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::all_cells][level - 1], active...).on(level - 1);
+            };
 
-            subset_1.apply_op(to_coarsen_mr(m_detail, m_tag, eps_l, min_level)); // Derefinement
-            subset_1.apply_op(to_refine_mr(m_detail,
-                                           m_tag,
-                                           (pow(2.0, regularity_to_use)) * eps_l,
-                                           max_level)); // Refinement according to Harten
+            apply_on_active(level - 1, subset_1, to_coarsen_mr(m_detail, m_tag, eps_l, min_level)); // Derefinement
+            apply_on_active(level - 1,
+                            subset_1,
+                            to_refine_mr(m_detail,
+                                         m_tag,
+                                         (pow(2.0, regularity_to_use)) * eps_l,
+                                         max_level)); // Refinement according to Harten
             update_tag_subdomains(level, m_tag, true);
         }
 
         for (std::size_t level = min_level; level <= max_level - ite; ++level)
         {
-            auto subset_2 = intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::cells][level]);
+            auto subset_2 = [&](const auto&... active)
+            {
+                return intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::cells][level], active...);
+            };
 
-            subset_2.apply_op(keep_around_refine(m_tag));
+            apply_on_active(level, subset_2, keep_around_refine(m_tag));
 
             if constexpr (enlarge)
             {
-                auto subset_3 = intersection(mesh[mesh_id_t::cells_and_ghosts][level], mesh[mesh_id_t::cells_and_ghosts][level]);
-                subset_2.apply_op(enlarge(m_tag));
-                subset_3.apply_op(tag_to_keep<0>(m_tag, CellFlag::enlarge));
+                auto subset_3 = [&](const auto&... active)
+                {
+                    return intersection(mesh[mesh_id_t::cells_and_ghosts][level], mesh[mesh_id_t::cells_and_ghosts][level], active...);
+                };
+                apply_on_active(level, subset_2, enlarge(m_tag));
+                apply_on_active(level, subset_3, tag_to_keep<0>(m_tag, CellFlag::enlarge));
             }
 
             update_tag_periodic(level, m_tag);
             update_tag_subdomains(level, m_tag);
         }
 
+        SAMURAI_PROFILE_STOP(tagging_timer);
+
+        SAMURAI_PROFILE_START(graduation_timer, "adapt/graduation");
         // FIXME: this graduation doesn't make the same that the lines below:
         // why? graduation(m_tag,
         // stencil_graduation::call(samurai::Dim<dim>{}));
@@ -261,9 +512,13 @@ namespace samurai
         // COARSENING GRADUATION
         for (std::size_t level = max_level; level > 0; --level)
         {
-            auto keep_subset = intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::all_cells][level - 1]).on(level - 1);
-
-            keep_subset.apply_op(maximum(m_tag));
+            apply_on_active(
+                level - 1,
+                [&](const auto&... active)
+                {
+                    return intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::all_cells][level - 1], active...).on(level - 1);
+                },
+                maximum(m_tag));
 
             int grad_width = static_cast<int>(mesh_t::config::graduation_width);
             auto stencil   = grad_width * detail::box_dir<dim>();
@@ -271,8 +526,14 @@ namespace samurai
             for (std::size_t is = 0; is < stencil.shape(0); ++is)
             {
                 auto s = xt::view(stencil, is);
-                auto subset = intersection(mesh[mesh_id_t::cells][level], translate(mesh[mesh_id_t::all_cells][level - 1], s)).on(level - 1);
-                subset.apply_op(balance_2to1(m_tag, s));
+                apply_on_active(
+                    level - 1,
+                    [&](const auto&... active)
+                    {
+                        return intersection(mesh[mesh_id_t::cells][level], translate(mesh[mesh_id_t::all_cells][level - 1], s), active...)
+                            .on(level - 1);
+                    },
+                    balance_2to1(m_tag, s));
             }
 
             update_tag_periodic(level, m_tag);
@@ -282,9 +543,13 @@ namespace samurai
         // REFINEMENT GRADUATION
         for (std::size_t level = max_level; level > min_level; --level)
         {
-            auto subset_1 = intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::cells][level]);
-
-            subset_1.apply_op(extend(m_tag));
+            apply_on_active(
+                level,
+                [&](const auto&... active)
+                {
+                    return intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::cells][level], active...);
+                },
+                extend(m_tag));
             update_tag_periodic(level, m_tag);
             update_tag_subdomains(level, m_tag);
 
@@ -294,10 +559,17 @@ namespace samurai
             for (std::size_t is = 0; is < stencil.shape(0); ++is)
             {
                 auto s = xt::view(stencil, is);
-                auto subset = intersection(translate(mesh[mesh_id_t::cells][level], s), mesh[mesh_id_t::all_cells][level - 1], mesh.domain())
-                                  .on(level);
-
-                subset.apply_op(make_graduation(m_tag));
+                apply_on_active(
+                    level,
+                    [&](const auto&... active)
+                    {
+                        return intersection(translate(mesh[mesh_id_t::cells][level], s),
+                                            mesh[mesh_id_t::all_cells][level - 1],
+                                            mesh.domain(),
+                                            active...)
+                            .on(level);
+                    },
+                    make_graduation(m_tag));
             }
 
             update_tag_periodic(level, m_tag);
@@ -328,17 +600,33 @@ namespace samurai
 
         for (std::size_t level = max_level; level > 0; --level)
         {
-            auto keep_subset = intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::all_cells][level - 1]).on(level - 1);
-
-            keep_subset.apply_op(maximum(m_tag));
+            apply_on_active(
+                level - 1,
+                [&](const auto&... active)
+                {
+                    return intersection(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::all_cells][level - 1], active...).on(level - 1);
+                },
+                maximum(m_tag));
             update_tag_periodic(level, m_tag);
             update_tag_subdomains(level, m_tag);
         }
 
         update_ghost_mr(other_fields...);
         keep_only_one_coarse_tag(m_tag);
+        SAMURAI_PROFILE_STOP(graduation_timer);
 
-        return update_field_mr(m_tag, m_fields, other_fields...);
+        if (!m_incremental)
+        {
+            return update_field_mr(m_tag, m_fields, other_fields...);
+        }
+
+        ca_type changed = changed_cells();
+        if (update_field_mr(m_tag, m_fields, other_fields...))
+        {
+            return true;
+        }
+        // Early exit if the mesh has been rebuilt without any cell change
+        return !update_active_region(changed);
     }
 
     template <class... TFields>
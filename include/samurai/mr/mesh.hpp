@@ -11,6 +11,7 @@
 
 #include "../box.hpp"
 #include "../mesh.hpp"
+#include "../profiling.hpp"
 #include "../samurai_config.hpp"
 #include "../subset/node_op.hpp"
 #include "../subset/subset_op.hpp"
@@ -114,6 +115,8 @@ namespace samurai
     template <class Config>
     inline void MRMesh<Config>::update_sub_mesh_impl()
     {
+        SAMURAI_PROFILE_SCOPE("update_sub_mesh");
+
 #ifdef SAMURAI_WITH_MPI
         mpi::communicator world;
         // cppcheck-suppress redundantInitialization
@@ -142,18 +145,24 @@ namespace samurai
         //
         // level 0 |.......|-------|.......|       |.......|-------|.......|
         //
-        for_each_interval(
-            this->cells()[mesh_id_t::cells],
-            [&](std::size_t level, const auto& interval, const auto& index_yz)
-            {
-                lcl_type& lcl = cell_list[level];
-                static_nested_loop<dim - 1, -config::max_stencil_width, config::max_stencil_width + 1>(
-                    [&](auto stencil)
-                    {
-                        auto index = xt::eval(index_yz + stencil);
-                        lcl[index].add_interval({interval.start - config::max_stencil_width, interval.end + config::max_stencil_width});
-                    });
-            });
+        // The constructions below are done in parallel by slabs of the outermost
+        // dimension (see parallel_fill) when OpenMP is enabled.
+        for (std::size_t level = min_level; level <= max_level; ++level)
+        {
+            auto cells = intersection(this->cells()[mesh_id_t::cells][level], this->cells()[mesh_id_t::cells][level]);
+            parallel_fill(
+                cells,
+                [&](const auto& interval, const auto& index_yz, lcl_type& lcl)
+                {
+                    static_nested_loop<dim - 1, -config::max_stencil_width, config::max_stencil_width + 1>(
+                        [&](auto stencil)
+                        {
+                            auto index = xt::eval(index_yz + stencil);
+                            lcl[index].add_interval({interval.start - config::max_stencil_width, interval.end + config::max_stencil_width});
+                        });
+                },
+                cell_list[level]);
+        }
         this->cells()[mesh_id_t::cells_and_ghosts] = {cell_list, false};
 
         // Add cells for the MRA
@@ -163,11 +172,10 @@ namespace samurai
             {
                 auto expr = difference(this->cells()[mesh_id_t::cells_and_ghosts][level], this->get_union()[level]).on(level);
 
-                expr(
-                    [&](const auto& interval, const auto& index_yz)
+                parallel_fill(
+                    expr,
+                    [&](const auto& interval, const auto& index_yz, lcl_type& lcl)
                     {
-                        lcl_type& lcl = cell_list[level - 1];
-
                         static_nested_loop<dim - 1, -config::prediction_order, config::prediction_order + 1>(
                             [&](auto stencil)
                             {
@@ -175,17 +183,17 @@ namespace samurai
                                 lcl[(index_yz >> 1) + stencil].add_interval(
                                     {new_interval.start - config::prediction_order, new_interval.end + config::prediction_order});
                             });
-                    });
+                    },
+                    cell_list[level - 1]);
 
-                auto expr_2 = intersection(this->cells()[mesh_id_t::cells][level], this->cells()[mesh_id_t::cells][level]);
+                if (level - 1 > 0)
+                {
+                    auto expr_2 = intersection(this->cells()[mesh_id_t::cells][level], this->cells()[mesh_id_t::cells][level]);
 
-                expr_2(
-                    [&](const auto& interval, const auto& index_yz)
-                    {
-                        if (level - 1 > 0)
+                    parallel_fill(
+                        expr_2,
+                        [&](const auto& interval, const auto& index_yz, lcl_type& lcl)
                         {
-                            lcl_type& lcl = cell_list[level - 2];
-
                             static_nested_loop<dim - 1, -config::prediction_order, config::prediction_order + 1>(
                                 [&](auto stencil)
                                 {
@@ -193,8 +201,9 @@ namespace samurai
                                     lcl[(index_yz >> 2) + stencil].add_interval(
                                         {new_interval.start - config::prediction_order, new_interval.end + config::prediction_order});
                                 });
-                        }
-                    });
+                        },
+                        cell_list[level - 2]);
+                }
             }
             this->cells()[mesh_id_t::all_cells] = {cell_list, false};
 
@@ -221,21 +230,25 @@ namespace samurai
                 lcl_type lcl_proj{level};
                 auto expr = intersection(this->cells()[mesh_id_t::all_cells][level], this->get_union()[level]);
 
-                expr(
-                    [&](const auto& interval, const auto& index_yz)
+                parallel_fill(
+                    expr,
+                    [&](const auto& interval, const auto& index_yz, lcl_type& lcl_children, lcl_type& lcl_parents)
                     {
                         static_nested_loop<dim - 1, 0, 2>(
                             [&](auto s)
                             {
-                                lcl[(index_yz << 1) + s].add_interval(interval << 1);
+                                lcl_children[(index_yz << 1) + s].add_interval(interval << 1);
                             });
-                        lcl_proj[index_yz].add_interval(interval);
-                    });
+                        lcl_parents[index_yz].add_interval(interval);
+                    },
+                    lcl,
+                    lcl_proj);
                 this->cells()[mesh_id_t::all_cells][level + 1] = lcl;
                 this->cells()[mesh_id_t::proj_cells][level]    = lcl_proj;
             }
 
-            this->update_mesh_neighbour();
+            // The periodic ghosts are not needed by the neighbours: they are built during the exchange
+            this->start_mesh_neighbour_exchange();
 
             // add ghosts for periodicity
             xt::xtensor_fixed<typename interval_t::value_t, xt::xshape<dim>> stencil;
@@ -277,11 +290,13 @@ namespace samurai
                         };
 
                         auto set1 = intersection(this->cells()[mesh_id_t::reference][level], lca1);
-                        set1(
-                            [&](const auto& i, const auto& index_yz)
+                        parallel_fill(
+                            set1,
+                            [&](const auto& i, const auto& index_yz, lcl_type& lcl_ghosts)
                             {
-                                lcl[index_yz + xt::view(stencil, xt::range(1, _))].add_interval(i + stencil[0]);
-                            });
+                                lcl_ghosts[index_yz + xt::view(stencil, xt::range(1, _))].add_interval(i + stencil[0]);
+                            },
+                            lcl);
 
                         min_corner[d] = (max_indices[d] >> delta_l) - config::ghost_width;
                         max_corner[d] = (max_indices[d] >> delta_l) + config::ghost_width;
@@ -291,15 +306,19 @@ namespace samurai
                         };
 
                         auto set2 = intersection(this->cells()[mesh_id_t::reference][level], lca2);
-                        set2(
-                            [&](const auto& i, const auto& index_yz)
+                        parallel_fill(
+                            set2,
+                            [&](const auto& i, const auto& index_yz, lcl_type& lcl_ghosts)
                             {
-                                lcl[index_yz - xt::view(stencil, xt::range(1, _))].add_interval(i - stencil[0]);
-                            });
+                                lcl_ghosts[index_yz - xt::view(stencil, xt::range(1, _))].add_interval(i - stencil[0]);
+                            },
+                            lcl);
                         this->cells()[mesh_id_t::all_cells][level] = {lcl};
                     }
                 }
             }
+
+            this->finish_mesh_neighbour_exchange();
         }
         else
         {
@@ -11,6 +11,7 @@
 #include "../cell_flag.hpp"
 #include "../field.hpp"
 #include "../numeric/prediction.hpp"
+#include "../numeric/simd_kernels.hpp"
 #include "../operators_base.hpp"
 
 namespace samurai
@@ -173,6 +174,17 @@ namespace samurai
         template <class T1, class T2, std::size_t order = T2::mesh_t::config::prediction_order>
         inline void operator()(Dim<1>, T1& detail, const T2& field) const
         {
+            if constexpr (simd::use_kernels_v<T1, T2>)
+            {
+                simd::predict_children<order>(detail, field, &field, level, i);
+                if (level >= 1)
+                {
+                    simd::predict_interval<order>(detail, field, cursor);
+                    detail(level, i) = field(level, i) - detail(level, i);
+                }
+                return;
+            }
+
             auto qs_i = xt::eval(Qs_i<order>(field, level, i));
 
             detail(level + 1, 2 * i)     = field(level + 1, 2 * i) - (field(level, i) + qs_i);
@@ -189,6 +201,17 @@ namespace samurai
         template <class T1, class T2, std::size_t order = T2::mesh_t::config::prediction_order>
         inline void operator()(Dim<2>, T1& detail, const T2& field) const
         {
+            if constexpr (simd::use_kernels_v<T1, T2>)
+            {
+                simd::predict_children<order>(detail, field, &field, level, i, j);
+                if (level >= 1)
+                {
+                    simd::predict_interval<order>(detail, field, cursor);
+                    detail(level, i, j) = field(level, i, j) - detail(level, i, j);
+                }
+                return;
+            }
+
             auto qs_i  = Qs_i<order>(field, level, i, j);
             auto qs_j  = Qs_j<order>(field, level, i, j);
             auto qs_ij = Qs_ij<order>(field, level, i, j);
@@ -223,6 +246,17 @@ namespace samurai
         template <class T1, class T2, std::size_t order = T2::mesh_t::config::prediction_order>
         inline void operator()(Dim<3>, T1& detail, const T2& field) const
         {
+            if constexpr (simd::use_kernels_v<T1, T2>)
+            {
+                simd::predict_children<order>(detail, field, &field, level, i, j, k);
+                if (level >= 1)
+                {
+                    simd::predict_interval<order>(detail, field, cursor);
+                    detail(level, i, j, k) = field(level, i, j, k) - detail(level, i, j, k);
+                }
+                return;
+            }
+
             auto qs_i   = Qs_i<order>(field, level, i, j, k);
             auto qs_j   = Qs_j<order>(field, level, i, j, k);
             auto qs_k   = Qs_k<order>(field, level, i, j, k);
@@ -257,6 +291,11 @@ namespace samurai
         }
     };
 
+    template <>
+    struct is_parallel_operator<compute_detail_op> : std::true_type
+    {
+    };
+
     template <class T>
     inline auto compute_detail(T&& detail, T&& field)
     {
@@ -374,6 +413,11 @@ namespace samurai
         }
     };
 
+    template <>
+    struct is_parallel_operator<compute_detail_on_tuple_op> : std::true_type
+    {
+    };
+
     template <class Field, class... T>
     inline auto compute_detail(Field& detail, const Field_tuple<T...>& fields)
     {
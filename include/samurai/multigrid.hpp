@@ -0,0 +1,804 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xfixed.hpp>
+
+#include "algorithm.hpp"
+#include "algorithm/update.hpp"
+#include "bc.hpp"
+#include "field.hpp"
+#include "level_cell_array.hpp"
+#include "level_cell_list.hpp"
+#include "numeric/prediction.hpp"
+#include "numeric/projection.hpp"
+#include "schemes/fv/operators/diffusion.hpp"
+#include "subset/node_op.hpp"
+#include "subset/subset_op.hpp"
+#include "uniform_mesh.hpp"
+
+namespace samurai
+{
+    enum class MultigridCycle
+    {
+        V,
+        W,
+        F
+    };
+
+    enum class MultigridSmoother
+    {
+        RedBlackGaussSeidel,
+        Chebyshev
+    };
+
+    /**
+     * @class GeometricMultigrid
+     * @brief Geometric multigrid for the diffusion operator
+     *     -div(K grad u) + sigma u
+     * of make_diffusion_order2(K), on the levels of an MR mesh.
+     *
+     * The grid of each level coarsest_level()..max_level() of the mesh covers
+     * the leaves of this level or finer, with its own fields: the finest
+     * grids are restricted to the refined zones. Each leaf belongs to the
+     * grid of its level, where its value is computed; the cells of a grid
+     * which are refined are also on the next grid. At the end of a grid,
+     * the ghosts take the value of the coarser grid (prediction of order 0).
+     *
+     * The cycles use the full approximation scheme: the solution of a grid is
+     * restricted by projection on the parents of the next grid, with the
+     * residual (corrected by the coarse operator), and the change of the
+     * coarse solution is prolongated by prediction<prediction_order>. The
+     * boundary conditions of the unknown (Dirichlet or Neumann on each face
+     * of the domain) are applied homogeneously, eliminated from the stencil.
+     *
+     * precondition() applies one cycle to a residual defined on the leaves of
+     * the mesh, from a zero initial guess: it is an approximate inverse of
+     * the diffusion operator on the adapted mesh. solve() uses it for a
+     * defect correction on the scheme of diffusion.hpp.
+     *
+     * Each process builds the grids of its local leaves: the ghosts of the
+     * cells of the other processes are 0.
+     */
+    template <class Field, std::size_t prediction_order = Field::mesh_t::config::prediction_order>
+    class GeometricMultigrid
+    {
+      public:
+
+        using mesh_t                     = typename Field::mesh_t;
+        using mesh_id_t                  = typename mesh_t::mesh_id_t;
+        using interval_t                 = typename mesh_t::interval_t;
+        using value_t                    = typename interval_t::value_t;
+        static constexpr std::size_t dim = mesh_t::dim;
+
+        using level_mesh_t    = UniformMesh<UniformConfig<dim, 1, interval_t>>;
+        using level_mesh_id_t = typename level_mesh_t::mesh_id_t;
+        using level_field_t   = samurai::Field<level_mesh_t, double, 1, false>;
+        using diffusion_t     = decltype(make_diffusion_order2<Field>(std::declval<DiffCoeff<dim>>()));
+
+        static_assert(Field::size == 1, "The geometric multigrid is implemented for scalar fields.");
+        static_assert(prediction_order <= 1, "The geometric multigrid only supports prediction orders 0 and 1.");
+
+        GeometricMultigrid(Field& unknown, const DiffCoeff<dim>& K, double sigma = 0);
+
+        // The fields of each level refer to the mesh of the level
+        GeometricMultigrid(const GeometricMultigrid&)            = delete;
+        GeometricMultigrid& operator=(const GeometricMultigrid&) = delete;
+        GeometricMultigrid(GeometricMultigrid&&)                 = default;
+        GeometricMultigrid& operator=(GeometricMultigrid&&)      = default;
+
+        void set_cycle(MultigridCycle cycle);
+        void set_smoother(MultigridSmoother smoother);
+        void set_smoothing_steps(std::size_t pre, std::size_t post);
+        void set_coarsest_level(std::size_t level);
+        void set_coarse_sweeps(std::size_t nb_sweeps);
+        void set_tolerance(double tolerance);
+        void set_max_iterations(std::size_t max_iterations);
+
+        std::size_t coarsest_level() const;
+        std::size_t nb_level_cells(std::size_t level) const;
+        double residual_norm() const;
+
+        void precondition(Field& z, const Field& r);
+        std::size_t solve(Field& u, const Field& f);
+
+      private:
+
+        struct level_t
+        {
+            level_t(std::size_t level_, const typename level_mesh_t::cl_type& cl)
+                : level(level_)
+                , mesh(cl)
+                , u("mg_u", mesh)
+                , f("mg_f", mesh)
+                , r("mg_r", mesh)
+                , d("mg_d", mesh)
+                , t("mg_t", mesh)
+                , v("mg_v", mesh)
+                , diag("mg_diag", mesh)
+            {
+            }
+
+            std::size_t level;
+            level_mesh_t mesh;
+            level_field_t u;    ///< Solution, its ghosts are 0 outside of the domain
+            level_field_t f;    ///< Right-hand side
+            level_field_t r;    ///< Residual
+            level_field_t d;    ///< Chebyshev direction, its ghosts are always 0
+            level_field_t t;    ///< Work field
+            level_field_t v;    ///< Solution restricted from the finer grid
+            level_field_t diag; ///< Diagonal of the operator, boundary conditions included
+            std::array<double, dim> coeffs;             ///< K_d / h^2
+            LevelCellArray<dim, interval_t> interface; ///< Ghosts in the domain, set from the coarser grid
+        };
+
+        enum class BoundaryType
+        {
+            Dirichlet,
+            Neumann
+        };
+
+        void build_hierarchy(const mesh_t& mesh);
+        void read_boundary_conditions();
+        double boundary_sign(std::size_t d, int side) const;
+
+        level_t& get(std::size_t level);
+
+        void apply(level_t& l, const level_field_t& x, level_field_t& y);
+        void compute_residual(level_t& l);
+        void gauss_seidel_sweep(level_t& l, int color);
+        void chebyshev(level_t& l, std::size_t degree);
+        void smooth(level_t& l, std::size_t nb_steps);
+        void restrict_residual(level_t& fine, level_t& coarse);
+        void prolongate_correction(level_t& coarse, level_t& fine);
+        void cycle(std::size_t level, MultigridCycle cycle);
+
+        void residual(Field& u, const Field& f, Field& r);
+        double norm(const Field& f) const;
+
+        Field* m_unknown;
+        DiffCoeff<dim> m_K;
+        double m_sigma;
+        diffusion_t m_diffusion;
+
+        std::array<BoundaryType, 2 * dim> m_boundary;
+        std::vector<std::unique_ptr<level_t>> m_levels; ///< From the coarsest level to the finest one
+        std::size_t m_coarsest_level;
+        std::size_t m_finest_level;
+        std::size_t m_mesh_version = 0;
+
+        MultigridCycle m_cycle         = MultigridCycle::V;
+        MultigridSmoother m_smoother   = MultigridSmoother::RedBlackGaussSeidel;
+        std::size_t m_pre_smoothing    = 2;
+        std::size_t m_post_smoothing   = 2;
+        std::size_t m_coarse_sweeps    = 50;
+        double m_tolerance             = 1e-10;
+        std::size_t m_max_iterations   = 100;
+        double m_residual_norm         = 0;
+    };
+
+    template <class Field, std::size_t prediction_order>
+    GeometricMultigrid<Field, prediction_order>::GeometricMultigrid(Field& unknown, const DiffCoeff<dim>& K, double sigma)
+        : m_unknown(&unknown)
+        , m_K(K)
+        , m_sigma(sigma)
+        , m_diffusion(make_diffusion_order2<Field>(K))
+        , m_coarsest_level(0)
+        , m_finest_level(unknown.mesh().max_level())
+    {
+        read_boundary_conditions();
+    }
+
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::set_cycle(MultigridCycle cycle)
+    {
+        m_cycle = cycle;
+    }
+
+    /// The Chebyshev smoother of degree n replaces n sweeps of Gauss-Seidel
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::set_smoother(MultigridSmoother smoother)
+    {
+        m_smoother = smoother;
+    }
+
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::set_smoothing_steps(std::size_t pre, std::size_t post)
+    {
+        m_pre_smoothing  = pre;
+        m_post_smoothing = post;
+    }
+
+    /// Level of the coarsest grid (0 by default), at most the minimum level of the mesh
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::set_coarsest_level(std::size_t level)
+    {
+        assert(level <= m_unknown->mesh().min_level() && "The coarsest level must not be above the minimum level of the mesh");
+        if (level != m_coarsest_level)
+        {
+            m_coarsest_level = level;
+            m_levels.clear();
+        }
+    }
+
+    /// Number of Gauss-Seidel sweeps solving the coarsest grid
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::set_coarse_sweeps(std::size_t nb_sweeps)
+    {
+        m_coarse_sweeps = nb_sweeps;
+    }
+
+    /// Tolerance of solve() on the norm of the residual, relative to the norm of the right-hand side
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::set_tolerance(double tolerance)
+    {
+        m_tolerance = tolerance;
+    }
+
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::set_max_iterations(std::size_t max_iterations)
+    {
+        m_max_iterations = max_iterations;
+    }
+
+    template <class Field, std::size_t prediction_order>
+    std::size_t GeometricMultigrid<Field, prediction_order>::coarsest_level() const
+    {
+        return m_coarsest_level;
+    }
+
+    /// Number of cells of the grid of the level, 0 before the first cycle
+    template <class Field, std::size_t prediction_order>
+    std::size_t GeometricMultigrid<Field, prediction_order>::nb_level_cells(std::size_t level) const
+    {
+        if (m_levels.empty() || level < m_coarsest_level || level > m_finest_level)
+        {
+            return 0;
+        }
+        return m_levels[level - m_coarsest_level]->mesh.nb_cells(level_mesh_id_t::cells);
+    }
+
+    /// L2 norm of the residual at the end of the last solve()
+    template <class Field, std::size_t prediction_order>
+    double GeometricMultigrid<Field, prediction_order>::residual_norm() const
+    {
+        return m_residual_norm;
+    }
+
+    /**
+     * One cycle from a zero initial guess: z is an approximate solution of
+     * the diffusion problem with the right-hand side r and homogeneous
+     * boundary conditions.
+     */
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::precondition(Field& z, const Field& r)
+    {
+        const auto& mesh = r.mesh();
+        if (m_levels.empty() || m_mesh_version != detail::mesh_version(mesh))
+        {
+            build_hierarchy(mesh);
+        }
+
+        // Each grid takes the residual of its leaves, the right-hand side of
+        // its refined cells is restricted from the finer grid
+        for (std::size_t level = m_coarsest_level; level <= m_finest_level; ++level)
+        {
+            auto& l = get(level);
+            l.u.fill(0.);
+            l.f.fill(0.);
+            for_each_interval(mesh[mesh_id_t::cells][level],
+                              [&](std::size_t, const auto& i, const auto& index)
+                              {
+                                  l.f(level, i, index) = r(level, i, index);
+                              });
+        }
+
+        cycle(m_finest_level, m_cycle);
+
+        for_each_interval(mesh[mesh_id_t::cells],
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              z(level, i, index) = get(level).u(level, i, index);
+                          });
+    }
+
+    /**
+     * Solves the diffusion problem on the leaves of the mesh of u, with the
+     * boundary conditions of u, by defect correction: the residual is
+     * computed by the scheme make_diffusion_order2(K) and the correction by
+     * precondition(). Returns the number of cycles.
+     */
+    template <class Field, std::size_t prediction_order>
+    std::size_t GeometricMultigrid<Field, prediction_order>::solve(Field& u, const Field& f)
+    {
+        Field r("mg_residual", u.mesh());
+        Field e("mg_correction", u.mesh());
+
+        const double f_norm = norm(f);
+        for (std::size_t iteration = 0; iteration < m_max_iterations; ++iteration)
+        {
+            residual(u, f, r);
+            m_residual_norm = norm(r);
+            if (m_residual_norm <= m_tolerance * f_norm)
+            {
+                return iteration;
+            }
+            precondition(e, r);
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              u[cell] += e[cell];
+                          });
+        }
+        residual(u, f, r);
+        m_residual_norm = norm(r);
+        return m_max_iterations;
+    }
+
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::build_hierarchy(const mesh_t& mesh)
+    {
+        using lca_t        = LevelCellArray<dim, interval_t>;
+        const auto& domain = mesh.domain();
+
+        m_levels.clear();
+        m_finest_level = mesh.max_level();
+        m_mesh_version = detail::mesh_version(mesh);
+
+        // Footprint of the leaves of each level or finer, from the finest level
+        std::vector<lca_t> regions(m_finest_level - m_coarsest_level + 1);
+        regions.back() = mesh[mesh_id_t::cells][m_finest_level];
+        for (std::size_t level = m_finest_level; level-- > m_coarsest_level;)
+        {
+            const auto& finer                 = regions[level + 1 - m_coarsest_level];
+            regions[level - m_coarsest_level] = union_(mesh[mesh_id_t::cells][level], finer).on(level);
+        }
+
+        for (std::size_t level = m_coarsest_level; level <= m_finest_level; ++level)
+        {
+            const auto& region = regions[level - m_coarsest_level];
+            typename level_mesh_t::cl_type cl{level};
+            auto region_set = intersection(region, region);
+            region_set(
+                [&](const auto& i, const auto& index)
+                {
+                    cl[index].add_interval(i);
+                });
+            m_levels.push_back(std::make_unique<level_t>(level, cl));
+
+            auto& l = *m_levels.back();
+            l.u.fill(0.);
+            l.f.fill(0.);
+            l.r.fill(0.);
+            l.d.fill(0.);
+            l.t.fill(0.);
+            l.v.fill(0.);
+
+            double h      = cell_length(level);
+            double diag_0 = m_sigma;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                l.coeffs[d] = m_K(d) / (h * h);
+                diag_0 += 2 * l.coeffs[d];
+            }
+            l.diag.fill(diag_0);
+
+            const auto& cells     = l.mesh[level_mesh_id_t::cells];
+            lca_t domain_on_level = intersection(domain, domain).on(level);
+            l.interface           = intersection(difference(l.mesh[level_mesh_id_t::cells_and_ghosts], cells), domain_on_level);
+
+            // Elimination of the ghosts outside of the domain: u_ghost = sign * u_cell
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                for (int side : {-1, 1})
+                {
+                    xt::xtensor_fixed<value_t, xt::xshape<dim>> shift;
+                    shift.fill(0);
+                    shift[d] = static_cast<value_t>(side);
+
+                    double coeff  = -boundary_sign(d, side) * l.coeffs[d];
+                    auto boundary = difference(cells, translate(domain_on_level, -shift));
+                    boundary(
+                        [&](const auto& i, const auto& index)
+                        {
+                            l.diag(level, i, index) += coeff;
+                        });
+                }
+            }
+        }
+    }
+
+    /**
+     * Type of the boundary condition on each face of the domain, Dirichlet
+     * if none is attached to the unknown.
+     */
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::read_boundary_conditions()
+    {
+        m_boundary.fill(BoundaryType::Dirichlet);
+        for (const auto& bc : m_unknown->get_bc())
+        {
+            BoundaryType type;
+            if (dynamic_cast<const DirichletImpl<1, Field>*>(bc.get()))
+            {
+                type = BoundaryType::Dirichlet;
+            }
+            else if (dynamic_cast<const NeumannImpl<1, Field>*>(bc.get()))
+            {
+                type = BoundaryType::Neumann;
+            }
+            else
+            {
+                continue;
+            }
+            // Only the faces: the corners are not used by the stencil
+            for (const auto& direction : bc->get_region().first)
+            {
+                std::size_t nb_non_zero = 0;
+                std::size_t face        = 0;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    if (direction[d] != 0)
+                    {
+                        ++nb_non_zero;
+                        face = 2 * d + (direction[d] > 0 ? 1 : 0);
+                    }
+                }
+                if (nb_non_zero == 1)
+                {
+                    m_boundary[face] = type;
+                }
+            }
+        }
+    }
+
+    /// The ghost of a cell on a face of the domain is sign * the value of the cell
+    template <class Field, std::size_t prediction_order>
+    double GeometricMultigrid<Field, prediction_order>::boundary_sign(std::size_t d, int side) const
+    {
+        return m_boundary[2 * d + (side > 0 ? 1 : 0)] == BoundaryType::Dirichlet ? -1. : 1.;
+    }
+
+    template <class Field, std::size_t prediction_order>
+    auto GeometricMultigrid<Field, prediction_order>::get(std::size_t level) -> level_t&
+    {
+        return *m_levels[level - m_coarsest_level];
+    }
+
+    /// y = A x on the cells of the level, the ghosts of x being 0
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::apply(level_t& l, const level_field_t& x, level_field_t& y)
+    {
+        for_each_interval(l.mesh[level_mesh_id_t::cells],
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              y(level, i, index) = l.diag(level, i, index) * x(level, i, index)
+                                                 - l.coeffs[0] * (x(level, i - 1, index) + x(level, i + 1, index));
+                              for (std::size_t d = 1; d < dim; ++d)
+                              {
+                                  auto index_m = index;
+                                  auto index_p = index;
+                                  index_m[d - 1] -= 1;
+                                  index_p[d - 1] += 1;
+                                  y(level, i, index) -= l.coeffs[d] * (x(level, i, index_m) + x(level, i, index_p));
+                              }
+                          });
+    }
+
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::compute_residual(level_t& l)
+    {
+        apply(l, l.u, l.r);
+        for_each_interval(l.mesh[level_mesh_id_t::cells],
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              l.r(level, i, index) = l.f(level, i, index) - l.r(level, i, index);
+                          });
+    }
+
+    /// Update of the cells whose sum of the indices has the parity of color
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::gauss_seidel_sweep(level_t& l, int color)
+    {
+        for_each_interval(l.mesh[level_mesh_id_t::cells],
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              value_t parity = color;
+                              for (std::size_t d = 0; d < dim - 1; ++d)
+                              {
+                                  parity += index[d];
+                              }
+                              auto ic = (parity & 1) ? i.odd_elements() : i.even_elements();
+                              if (!ic.is_valid())
+                              {
+                                  return;
+                              }
+
+                              // The neighbours have the other color
+                              l.u(level, ic, index) = l.f(level, ic, index)
+                                                    + l.coeffs[0] * (l.u(level, ic - 1, index) + l.u(level, ic + 1, index));
+                              for (std::size_t d = 1; d < dim; ++d)
+                              {
+                                  auto index_m = index;
+                                  auto index_p = index;
+                                  index_m[d - 1] -= 1;
+                                  index_p[d - 1] += 1;
+                                  l.u(level, ic, index) += l.coeffs[d] * (l.u(level, ic, index_m) + l.u(level, ic, index_p));
+                              }
+                              l.u(level, ic, index) /= l.diag(level, ic, index);
+                          });
+    }
+
+    /**
+     * Chebyshev iteration of the given degree on the Jacobi-preconditioned
+     * operator, damping its eigenvalues in [beta / (2 dim), beta], where
+     * beta = 2 bounds the spectrum (Gershgorin): this interval holds the
+     * high frequencies of the Laplacian.
+     */
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::chebyshev(level_t& l, std::size_t degree)
+    {
+        const double beta  = 2.;
+        const double alpha = beta / (2. * dim);
+        const double theta = (beta + alpha) / 2;
+        const double delta = (beta - alpha) / 2;
+        const double sigma = theta / delta;
+
+        const auto& cells = l.mesh[level_mesh_id_t::cells];
+        compute_residual(l);
+        for_each_interval(cells,
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              l.d(level, i, index) = l.r(level, i, index) / (theta * l.diag(level, i, index));
+                          });
+
+        double rho = 1 / sigma;
+        for (std::size_t k = 0; k < degree; ++k)
+        {
+            for_each_interval(cells,
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  l.u(level, i, index) += l.d(level, i, index);
+                              });
+            if (k + 1 == degree)
+            {
+                break;
+            }
+
+            apply(l, l.d, l.t);
+            double rho_new = 1 / (2 * sigma - rho);
+            for_each_interval(cells,
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  l.r(level, i, index) -= l.t(level, i, index);
+                                  l.d(level, i, index) = rho_new * rho * l.d(level, i, index)
+                                                       + (2 * rho_new / delta) * l.r(level, i, index) / l.diag(level, i, index);
+                              });
+            rho = rho_new;
+        }
+    }
+
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::smooth(level_t& l, std::size_t nb_steps)
+    {
+        if (nb_steps == 0)
+        {
+            return;
+        }
+        if (m_smoother == MultigridSmoother::Chebyshev)
+        {
+            chebyshev(l, nb_steps);
+        }
+        else
+        {
+            for (std::size_t step = 0; step < nb_steps; ++step)
+            {
+                gauss_seidel_sweep(l, 0);
+                gauss_seidel_sweep(l, 1);
+            }
+        }
+    }
+
+    /**
+     * On the parents of the cells of the fine grid: coarse.u is the
+     * projection of fine.u and coarse.f the projection of the residual plus
+     * the coarse operator applied to coarse.u. coarse.v keeps coarse.u.
+     */
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::restrict_residual(level_t& fine, level_t& coarse)
+    {
+        const std::size_t level = coarse.level;
+
+        compute_residual(fine);
+        auto parents = intersection(coarse.mesh[level_mesh_id_t::cells], fine.mesh[level_mesh_id_t::cells]).on(level);
+        parents.apply_op(projection(coarse.u, fine.u));
+        parents.apply_op(projection(coarse.f, fine.r));
+
+        apply(coarse, coarse.u, coarse.t);
+        parents(
+            [&](const auto& i, const auto& index)
+            {
+                coarse.f(level, i, index) += coarse.t(level, i, index);
+            });
+        for_each_interval(coarse.mesh[level_mesh_id_t::cells],
+                          [&](std::size_t, const auto& i, const auto& index)
+                          {
+                              coarse.v(level, i, index) = coarse.u(level, i, index);
+                          });
+    }
+
+    /**
+     * fine.u += prediction of coarse.u - coarse.v, the change of the coarse
+     * solution. Its ghosts used by the prediction are set from the boundary
+     * conditions, direction by direction so that the corners are set too,
+     * then reset to 0. The ghosts of fine.u in the domain take the value of
+     * their parent.
+     */
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::prolongate_correction(level_t& coarse, level_t& fine)
+    {
+        const std::size_t level = coarse.level;
+
+        for_each_interval(coarse.mesh[level_mesh_id_t::cells],
+                          [&](std::size_t, const auto& i, const auto& index)
+                          {
+                              coarse.t(level, i, index) = coarse.u(level, i, index) - coarse.v(level, i, index);
+                          });
+
+        if constexpr (prediction_order > 0)
+        {
+            LevelCellArray<dim, interval_t> region = coarse.mesh[level_mesh_id_t::cells];
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                xt::xtensor_fixed<value_t, xt::xshape<dim>> shift;
+                for (int side : {-1, 1})
+                {
+                    shift.fill(0);
+                    shift[d] = static_cast<value_t>(side);
+
+                    double sign = boundary_sign(d, side);
+                    auto ghosts = difference(translate(region, shift), region);
+                    ghosts(
+                        [&](const auto& i, const auto& index)
+                        {
+                            if (d == 0)
+                            {
+                                coarse.t(level, i, index) = sign * coarse.t(level, i - side, index);
+                            }
+                            else
+                            {
+                                auto inner = index;
+                                inner[d - 1] -= side;
+                                coarse.t(level, i, index) = sign * coarse.t(level, i, inner);
+                            }
+                        });
+                }
+                shift.fill(0);
+                shift[d] = 1;
+                LevelCellArray<dim, interval_t> extended = union_(region, translate(region, shift), translate(region, -shift));
+                std::swap(region, extended);
+            }
+        }
+
+        auto parents = intersection(coarse.mesh[level_mesh_id_t::cells], fine.mesh[level_mesh_id_t::cells]).on(level);
+        parents.apply_op(prediction<prediction_order, true>(fine.t, coarse.t));
+        for_each_interval(fine.mesh[level_mesh_id_t::cells],
+                          [&](std::size_t fine_level, const auto& i, const auto& index)
+                          {
+                              fine.u(fine_level, i, index) += fine.t(fine_level, i, index);
+                          });
+
+        if constexpr (prediction_order > 0)
+        {
+            auto ghosts = difference(coarse.mesh[level_mesh_id_t::cells_and_ghosts], coarse.mesh[level_mesh_id_t::cells]);
+            ghosts(
+                [&](const auto& i, const auto& index)
+                {
+                    coarse.t(level, i, index) = 0.;
+                });
+        }
+
+        // The ghosts of the cells of the other processes are 0 on the coarse grid
+        for_each_interval(fine.interface,
+                          [&](std::size_t fine_level, const auto& i, const auto& index)
+                          {
+                              auto parent_index = index;
+                              for (std::size_t d = 0; d < dim - 1; ++d)
+                              {
+                                  parent_index[d] >>= 1;
+                              }
+                              for (value_t ii = i.start; ii < i.end; ++ii)
+                              {
+                                  fine.u(fine_level, interval_t{ii, ii + 1}, index) = coarse.u(level,
+                                                                                               interval_t{ii >> 1, (ii >> 1) + 1},
+                                                                                               parent_index);
+                              }
+                          });
+    }
+
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::cycle(std::size_t level, MultigridCycle cycle_type)
+    {
+        auto& l = get(level);
+        if (level == m_coarsest_level)
+        {
+            for (std::size_t sweep = 0; sweep < m_coarse_sweeps; ++sweep)
+            {
+                gauss_seidel_sweep(l, 0);
+                gauss_seidel_sweep(l, 1);
+            }
+            return;
+        }
+
+        auto& coarse = get(level - 1);
+        smooth(l, m_pre_smoothing);
+        restrict_residual(l, coarse);
+        switch (cycle_type)
+        {
+            case MultigridCycle::V:
+                cycle(level - 1, MultigridCycle::V);
+                break;
+            case MultigridCycle::W:
+                cycle(level - 1, MultigridCycle::W);
+                cycle(level - 1, MultigridCycle::W);
+                break;
+            case MultigridCycle::F:
+                cycle(level - 1, MultigridCycle::F);
+                cycle(level - 1, MultigridCycle::V);
+                break;
+        }
+        prolongate_correction(coarse, l);
+        smooth(l, m_post_smoothing);
+    }
+
+    /// r = f - (A u + sigma u) on the leaves, with the boundary conditions of u
+    template <class Field, std::size_t prediction_order>
+    void GeometricMultigrid<Field, prediction_order>::residual(Field& u, const Field& f, Field& r)
+    {
+        update_ghost_mr(u);
+        auto Au = m_diffusion(u);
+        for_each_cell(u.mesh(),
+                      [&](const auto& cell)
+                      {
+                          r[cell] = f[cell] - Au[cell] - m_sigma * u[cell];
+                      });
+    }
+
+    template <class Field, std::size_t prediction_order>
+    double GeometricMultigrid<Field, prediction_order>::norm(const Field& f) const
+    {
+        double norm_2 = 0;
+        for_each_cell(f.mesh(),
+                      [&](const auto& cell)
+                      {
+                          norm_2 += f[cell] * f[cell] * std::pow(cell.length, dim);
+                      });
+        return std::sqrt(norm_2);
+    }
+
+    template <class Field>
+    auto make_multigrid(Field& unknown, const DiffCoeff<Field::dim>& K, double sigma = 0)
+    {
+        return GeometricMultigrid<Field>(unknown, K, sigma);
+    }
+
+    template <class Field>
+    auto make_multigrid(Field& unknown, double k = 1, double sigma = 0)
+    {
+        DiffCoeff<Field::dim> K;
+        K.fill(k);
+        return make_multigrid(unknown, K, sigma);
+    }
+}
@@ -0,0 +1,367 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include "simd_kernels.hpp"
+
+namespace samurai
+{
+    /// Default number of systems solved together: one register of doubles, at least 4
+    inline constexpr std::size_t newton_batch_width = std::max<std::size_t>(simd::detail::arch_t::width, 4);
+
+    /**
+     * Batch of independent nonlinear systems F(x) = b of size n, stored
+     * lane by lane ([component][lane]) so that the Newton updates of the
+     * systems are vectorized.
+     */
+    template <std::size_t n, std::size_t width = newton_batch_width>
+    struct NewtonBatch
+    {
+        using lanes_t = std::array<double, width>;
+
+        std::array<lanes_t, n> x;                  ///< Initial guesses, then solutions
+        std::array<lanes_t, n> b;                  ///< Right-hand sides
+        std::array<std::size_t, width> iterations; ///< Newton iterations of each system
+        std::size_t size = width;                  ///< Number of systems (the first lanes)
+    };
+
+    enum class NewtonStatus
+    {
+        Converged,
+        Diverged, ///< Non finite residual or singular Jacobian matrix
+        MaxIterations
+    };
+
+    /**
+     * @class BatchedNewton
+     * Newton's method on the systems of a NewtonBatch.
+     *
+     * The function and the Jacobian matrix are evaluated system by system:
+     *     function(lane, x, fx) with x, fx std::array<double, n>,
+     *     jacobian(lane, x, J)  with J[i][j] = dF_i/dx_j.
+     * The linear systems are solved together by a Gaussian elimination
+     * whose innermost loop runs over the lanes. A system with a vanishing
+     * pivot is solved again with partial pivoting.
+     *
+     * Each system stops when ||F(x) - b|| <= max(atol, rtol ||F(x0) - b||)
+     * or when the update is below stol ||x|| (2-norms, as in SNES): it is
+     * then masked and its function and Jacobian are no longer evaluated.
+     * Full Newton steps are taken, without line search.
+     */
+    template <std::size_t n, std::size_t width = newton_batch_width>
+    class BatchedNewton
+    {
+      public:
+
+        using batch_t  = NewtonBatch<n, width>;
+        using lanes_t  = typename batch_t::lanes_t;
+        using vector_t = std::array<double, n>;
+        using matrix_t = std::array<std::array<double, n>, n>;
+
+        double atol                = 1e-50;
+        double rtol                = 1e-8;
+        double stol                = 1e-8;
+        std::size_t max_iterations = 50;
+
+        template <class Function, class Jacobian>
+        NewtonStatus solve(batch_t& batch, Function&& function, Jacobian&& jacobian)
+        {
+            assert(batch.size <= width);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                std::fill(batch.x[i].begin() + static_cast<std::ptrdiff_t>(batch.size), batch.x[i].end(), 0.);
+                std::fill(batch.b[i].begin() + static_cast<std::ptrdiff_t>(batch.size), batch.b[i].end(), 0.);
+            }
+
+            lanes_t tolerance;
+            evaluate_residual(batch, function, all_lanes(batch));
+            auto norm = norm2(m_residual);
+            for (std::size_t l = 0; l < width; ++l)
+            {
+                batch.iterations[l] = 0;
+                tolerance[l]        = std::max(atol, rtol * norm[l]);
+                m_active[l]         = l < batch.size && norm[l] > tolerance[l];
+                if (l < batch.size && !std::isfinite(norm[l]))
+                {
+                    return NewtonStatus::Diverged;
+                }
+            }
+
+            for (std::size_t it = 0; it < max_iterations; ++it)
+            {
+                if (!any_active())
+                {
+                    return NewtonStatus::Converged;
+                }
+
+                evaluate_jacobian(batch, jacobian);
+                if (!solve_linear_systems())
+                {
+                    return NewtonStatus::Diverged;
+                }
+
+                // x <- x - dx on the active lanes
+                lanes_t mask;
+                for (std::size_t l = 0; l < width; ++l)
+                {
+                    mask[l] = m_active[l] ? 1. : 0.;
+                }
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    for (std::size_t l = 0; l < width; ++l)
+                    {
+                        batch.x[i][l] -= mask[l] * m_residual[i][l];
+                    }
+                }
+                auto step   = norm2(m_residual);
+                auto x_norm = norm2(batch.x);
+
+                evaluate_residual(batch, function, m_active);
+                norm = norm2(m_residual);
+                for (std::size_t l = 0; l < width; ++l)
+                {
+                    if (m_active[l])
+                    {
+                        ++batch.iterations[l];
+                        if (!std::isfinite(norm[l]))
+                        {
+                            return NewtonStatus::Diverged;
+                        }
+                        m_active[l] = norm[l] > tolerance[l] && step[l] > stol * x_norm[l];
+                    }
+                }
+            }
+            return any_active() ? NewtonStatus::MaxIterations : NewtonStatus::Converged;
+        }
+
+        /// Systems which have not converged after solve()
+        const std::array<bool, width>& not_converged() const
+        {
+            return m_active;
+        }
+
+      private:
+
+        bool any_active() const
+        {
+            return std::find(m_active.begin(), m_active.end(), true) != m_active.end();
+        }
+
+        static std::array<bool, width> all_lanes(const batch_t& batch)
+        {
+            std::array<bool, width> lanes;
+            for (std::size_t l = 0; l < width; ++l)
+            {
+                lanes[l] = l < batch.size;
+            }
+            return lanes;
+        }
+
+        static lanes_t norm2(const std::array<lanes_t, n>& v)
+        {
+            lanes_t norm{};
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                for (std::size_t l = 0; l < width; ++l)
+                {
+                    norm[l] += v[i][l] * v[i][l];
+                }
+            }
+            for (std::size_t l = 0; l < width; ++l)
+            {
+                norm[l] = std::sqrt(norm[l]);
+            }
+            return norm;
+        }
+
+        /// m_residual = F(x) - b on the given lanes, 0 on the others
+        template <class Function>
+        void evaluate_residual(const batch_t& batch, Function& function, const std::array<bool, width>& lanes)
+        {
+            vector_t x;
+            vector_t fx;
+            for (std::size_t l = 0; l < width; ++l)
+            {
+                if (lanes[l])
+                {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        x[i] = batch.x[i][l];
+                    }
+                    function(l, x, fx);
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        m_residual[i][l] = fx[i] - batch.b[i][l];
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        m_residual[i][l] = 0;
+                    }
+                }
+            }
+        }
+
+        /// Jacobian matrices of the active lanes, identity on the others
+        template <class Jacobian>
+        void evaluate_jacobian(const batch_t& batch, Jacobian& jacobian)
+        {
+            vector_t x;
+            matrix_t jac;
+            for (std::size_t l = 0; l < width; ++l)
+            {
+                if (m_active[l])
+                {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        x[i] = batch.x[i][l];
+                    }
+                    jacobian(l, x, jac);
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        jac[i].fill(0);
+                        jac[i][i] = 1;
+                    }
+                }
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        m_jacobian[i][j][l] = jac[i][j];
+                    }
+                }
+            }
+        }
+
+        /// Replaces m_residual by the solutions of the linear systems
+        bool solve_linear_systems()
+        {
+            auto jacobian = m_jacobian;
+            auto residual = m_residual;
+
+            // Elimination without pivoting, lane by lane
+            std::array<bool, width> needs_pivoting{};
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                lanes_t inv_pivot;
+                for (std::size_t l = 0; l < width; ++l)
+                {
+                    double pivot = m_jacobian[k][k][l];
+                    // A small pivot is tested against the magnitude of its row
+                    double scale = 0;
+                    for (std::size_t j = k; j < n; ++j)
+                    {
+                        scale = std::max(scale, std::abs(m_jacobian[k][j][l]));
+                    }
+                    needs_pivoting[l] = needs_pivoting[l] || !(std::abs(pivot) > 1e-12 * scale);
+                    inv_pivot[l]      = needs_pivoting[l] ? 0. : 1. / pivot;
+                }
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    lanes_t factor;
+                    for (std::size_t l = 0; l < width; ++l)
+                    {
+                        factor[l] = m_jacobian[i][k][l] * inv_pivot[l];
+                    }
+                    for (std::size_t j = k; j < n; ++j)
+                    {
+                        for (std::size_t l = 0; l < width; ++l)
+                        {
+                            m_jacobian[i][j][l] -= factor[l] * m_jacobian[k][j][l];
+                        }
+                    }
+                    for (std::size_t l = 0; l < width; ++l)
+                    {
+                        m_residual[i][l] -= factor[l] * m_residual[k][l];
+                    }
+                }
+            }
+            for (std::size_t k = n; k-- > 0;)
+            {
+                for (std::size_t j = k + 1; j < n; ++j)
+                {
+                    for (std::size_t l = 0; l < width; ++l)
+                    {
+                        m_residual[k][l] -= m_jacobian[k][j][l] * m_residual[j][l];
+                    }
+                }
+                for (std::size_t l = 0; l < width; ++l)
+                {
+                    m_residual[k][l] = needs_pivoting[l] ? 0. : m_residual[k][l] / m_jacobian[k][k][l];
+                }
+            }
+
+            for (std::size_t l = 0; l < width; ++l)
+            {
+                if (needs_pivoting[l] && !solve_with_pivoting(jacobian, residual, l))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool solve_with_pivoting(std::array<std::array<lanes_t, n>, n>& jacobian, std::array<lanes_t, n>& residual, std::size_t l)
+        {
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                std::size_t p = k;
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    if (std::abs(jacobian[i][k][l]) > std::abs(jacobian[p][k][l]))
+                    {
+                        p = i;
+                    }
+                }
+                if (jacobian[p][k][l] == 0)
+                {
+                    return false;
+                }
+                if (p != k)
+                {
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        std::swap(jacobian[p][j][l], jacobian[k][j][l]);
+                    }
+                    std::swap(residual[p][l], residual[k][l]);
+                }
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    double factor = jacobian[i][k][l] / jacobian[k][k][l];
+                    for (std::size_t j = k; j < n; ++j)
+                    {
+                        jacobian[i][j][l] -= factor * jacobian[k][j][l];
+                    }
+                    residual[i][l] -= factor * residual[k][l];
+                }
+            }
+            for (std::size_t k = n; k-- > 0;)
+            {
+                double value = residual[k][l];
+                for (std::size_t j = k + 1; j < n; ++j)
+                {
+                    value -= jacobian[k][j][l] * m_residual[j][l];
+                }
+                m_residual[k][l] = value / jacobian[k][k][l];
+            }
+            return true;
+        }
+
+        std::array<lanes_t, n> m_residual;
+        std::array<std::array<lanes_t, n>, n> m_jacobian;
+        std::array<bool, width> m_active;
+    };
+}
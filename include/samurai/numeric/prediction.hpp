@@ -11,6 +11,7 @@
 #include <xtensor/xview.hpp>
 
 #include "../operators_base.hpp"
+#include "simd_kernels.hpp"
 
 namespace samurai
 {
@@ -363,6 +364,11 @@ namespace samurai
         operator()(Dim<3>, T1& dest, const T2& src, std::integral_constant<std::size_t, order>, std::integral_constant<bool, false>) const;
     };
 
+    template <>
+    struct is_parallel_operator<prediction_op> : std::true_type
+    {
+    };
+
     template <std::size_t dim, class TInterval>
     template <class T1, class T2>
     inline void prediction_op<dim, TInterval>::operator()(Dim<1>,
@@ -389,15 +395,15 @@ namespace samurai
         auto even_i = i.even_elements();
         if (even_i.is_valid())
         {
-            auto coarse_even_i  = even_i >> 1;
-            dest(level, even_i) = src(level - 1, coarse_even_i);
+            auto coarse_even_i         = even_i >> 1;
+            dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i);
         }
 
         auto odd_i = i.odd_elements();
         if (odd_i.is_valid())
         {
-            auto coarse_odd_i  = odd_i >> 1;
-            dest(level, odd_i) = src(level - 1, coarse_odd_i);
+            auto coarse_odd_i         = odd_i >> 1;
+            dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i);
         }
     }
 
@@ -409,6 +415,12 @@ namespace samurai
                                                           std::integral_constant<std::size_t, order>,
                                                           std::integral_constant<bool, true>) const
     {
+        if constexpr (simd::use_kernels_v<T1, T2>)
+        {
+            simd::predict_children<order>(dest, src, static_cast<const T2*>(nullptr), level, i);
+            return;
+        }
+
         auto ii = i << 1;
         ii.step = 2;
 
@@ -426,22 +438,29 @@ namespace samurai
                                                           std::integral_constant<std::size_t, order>,
                                                           std::integral_constant<bool, false>) const
     {
+        if constexpr (simd::use_kernels_v<T1, T2>)
+        {
+            simd::predict_interval<order>(dest, src, cursor);
+            return;
+        }
+
         auto qs_i = Qs_i<order>(src, level - 1, i >> 1);
 
         auto even_i = i.even_elements();
         if (even_i.is_valid())
         {
-            auto coarse_even_i  = even_i >> 1;
-            auto dec_even       = (i.start & 1) ? 1 : 0;
-            dest(level, even_i) = src(level - 1, coarse_even_i) + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]));
+            auto coarse_even_i         = even_i >> 1;
+            auto dec_even              = (i.start & 1) ? 1 : 0;
+            dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i) + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]));
         }
 
         auto odd_i = i.odd_elements();
         if (odd_i.is_valid())
         {
-            auto coarse_odd_i  = odd_i >> 1;
-            auto dec_odd       = (i.end & 1) ? 1 : 0;
-            dest(level, odd_i) = src(level - 1, coarse_odd_i) - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)));
+            auto coarse_odd_i         = odd_i >> 1;
+            auto dec_odd              = (i.end & 1) ? 1 : 0;
+            dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i)
+                                      - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)));
         }
     }
 
@@ -477,15 +496,15 @@ namespace samurai
             auto even_i = i.even_elements();
             if (even_i.is_valid())
             {
-                auto coarse_even_i     = even_i >> 1;
-                dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1);
+                auto coarse_even_i         = even_i >> 1;
+                dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1);
             }
 
             auto odd_i = i.odd_elements();
             if (odd_i.is_valid())
             {
-                auto coarse_odd_i     = odd_i >> 1;
-                dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1);
+                auto coarse_odd_i         = odd_i >> 1;
+                dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1);
             }
         }
         else
@@ -493,15 +512,15 @@ namespace samurai
             auto even_i = i.even_elements();
             if (even_i.is_valid())
             {
-                auto coarse_even_i     = even_i >> 1;
-                dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1);
+                auto coarse_even_i         = even_i >> 1;
+                dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1);
             }
 
             auto odd_i = i.odd_elements();
             if (odd_i.is_valid())
             {
-                auto coarse_odd_i     = odd_i >> 1;
-                dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1);
+                auto coarse_odd_i         = odd_i >> 1;
+                dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1);
             }
         }
     }
@@ -514,6 +533,12 @@ namespace samurai
                                                           std::integral_constant<std::size_t, order>,
                                                           std::integral_constant<bool, true>) const
     {
+        if constexpr (simd::use_kernels_v<T1, T2>)
+        {
+            simd::predict_children<order>(dest, src, static_cast<const T2*>(nullptr), level, i, j);
+            return;
+        }
+
         auto ii = i << 1;
         ii.step = 2;
 
@@ -537,6 +562,12 @@ namespace samurai
                                                           std::integral_constant<std::size_t, order>,
                                                           std::integral_constant<bool, false>) const
     {
+        if constexpr (simd::use_kernels_v<T1, T2>)
+        {
+            simd::predict_interval<order>(dest, src, cursor);
+            return;
+        }
+
         auto qs_i  = Qs_i<order>(src, level - 1, i >> 1, j >> 1);
         auto qs_j  = Qs_j<order>(src, level - 1, i >> 1, j >> 1);
         auto qs_ij = Qs_ij<order>(src, level - 1, i >> 1, j >> 1);
@@ -550,16 +581,17 @@ namespace samurai
                 auto dec_even      = (i.start & 1) ? 1 : 0;
                 if constexpr (T1::is_soa && T1::size > 1)
                 {
-                    dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1)
-                                           + xt::view(qs_i, xt::all(), xt::range(dec_even, qs_i.shape()[1]))
-                                           - xt::view(qs_j, xt::all(), xt::range(dec_even, qs_j.shape()[1]))
-                                           + xt::view(qs_ij, xt::all(), xt::range(dec_even, qs_ij.shape()[1]));
+                    dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1)
+                                               + xt::view(qs_i, xt::all(), xt::range(dec_even, qs_i.shape()[1]))
+                                               - xt::view(qs_j, xt::all(), xt::range(dec_even, qs_j.shape()[1]))
+                                               + xt::view(qs_ij, xt::all(), xt::range(dec_even, qs_ij.shape()[1]));
                 }
                 else
                 {
-                    dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1) + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                           - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                           + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]));
+                    dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1)
+                                               + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
+                                               - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
+                                               + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]));
                 }
             }
 
@@ -570,17 +602,17 @@ namespace samurai
                 auto dec_odd      = (i.end & 1) ? 1 : 0;
                 if constexpr (T1::is_soa && T1::size > 1)
                 {
-                    dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1)
-                                          - xt::view(qs_i, xt::all(), xt::range(0, safe_subs<int>(qs_i.shape()[1], dec_odd)))
-                                          - xt::view(qs_j, xt::all(), xt::range(0, safe_subs<int>(qs_j.shape()[1], dec_odd)))
-                                          - xt::view(qs_ij, xt::all(), xt::range(0, safe_subs<int>(qs_ij.shape()[1], dec_odd)));
+                    dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1)
+                                              - xt::view(qs_i, xt::all(), xt::range(0, safe_subs<int>(qs_i.shape()[1], dec_odd)))
+                                              - xt::view(qs_j, xt::all(), xt::range(0, safe_subs<int>(qs_j.shape()[1], dec_odd)))
+                                              - xt::view(qs_ij, xt::all(), xt::range(0, safe_subs<int>(qs_ij.shape()[1], dec_odd)));
                 }
                 else
                 {
-                    dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1)
-                                          - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                          - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                          - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
+                    dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1)
+                                              - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
+                                              - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
+                                              - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
                 }
             }
         }
@@ -593,16 +625,17 @@ namespace samurai
                 auto dec_even      = (i.start & 1) ? 1 : 0;
                 if constexpr (T1::is_soa && T1::size > 1)
                 {
-                    dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1)
-                                           + xt::view(qs_i, xt::all(), xt::range(dec_even, qs_i.shape()[1]))
-                                           + xt::view(qs_j, xt::all(), xt::range(dec_even, qs_j.shape()[1]))
-                                           - xt::view(qs_ij, xt::all(), xt::range(dec_even, qs_ij.shape()[1]));
+                    dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1)
+                                               + xt::view(qs_i, xt::all(), xt::range(dec_even, qs_i.shape()[1]))
+                                               + xt::view(qs_j, xt::all(), xt::range(dec_even, qs_j.shape()[1]))
+                                               - xt::view(qs_ij, xt::all(), xt::range(dec_even, qs_ij.shape()[1]));
                 }
                 else
                 {
-                    dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1) + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                           + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                           - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]));
+                    dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1)
+                                               + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
+                                               + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
+                                               - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]));
                 }
             }
 
@@ -613,17 +646,17 @@ namespace samurai
                 auto dec_odd      = (i.end & 1) ? 1 : 0;
                 if constexpr (T1::is_soa && T1::size > 1)
                 {
-                    dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1)
-                                          - xt::view(qs_i, xt::all(), xt::range(0, safe_subs<int>(qs_i.shape()[1], dec_odd)))
-                                          + xt::view(qs_j, xt::all(), xt::range(0, safe_subs<int>(qs_j.shape()[1], dec_odd)))
-                                          + xt::view(qs_ij, xt::all(), xt::range(0, safe_subs<int>(qs_ij.shape()[1], dec_odd)));
+                    dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1)
+                                              - xt::view(qs_i, xt::all(), xt::range(0, safe_subs<int>(qs_i.shape()[1], dec_odd)))
+                                              + xt::view(qs_j, xt::all(), xt::range(0, safe_subs<int>(qs_j.shape()[1], dec_odd)))
+                                              + xt::view(qs_ij, xt::all(), xt::range(0, safe_subs<int>(qs_ij.shape()[1], dec_odd)));
                 }
                 else
                 {
-                    dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1)
-                                          - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                          + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                          + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
+                    dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1)
+                                              - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
+                                              + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
+                                              + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
                 }
             }
         }
@@ -664,15 +697,15 @@ namespace samurai
         auto even_i = i.even_elements();
         if (even_i.is_valid())
         {
-            auto coarse_even_i        = even_i >> 1;
-            dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1);
+            auto coarse_even_i         = even_i >> 1;
+            dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1, k >> 1);
         }
 
         auto odd_i = i.odd_elements();
         if (odd_i.is_valid())
         {
-            auto coarse_odd_i        = odd_i >> 1;
-            dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1);
+            auto coarse_odd_i         = odd_i >> 1;
+            dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1, k >> 1);
         }
     }
 
@@ -684,6 +717,12 @@ namespace samurai
                                                           std::integral_constant<std::size_t, order>,
                                                           std::integral_constant<bool, true>) const
     {
+        if constexpr (simd::use_kernels_v<T1, T2>)
+        {
+            simd::predict_children<order>(dest, src, static_cast<const T2*>(nullptr), level, i, j, k);
+            return;
+        }
+
         auto ii = i << 1;
         ii.step = 2;
 
@@ -716,6 +755,12 @@ namespace samurai
                                                           std::integral_constant<std::size_t, order>,
                                                           std::integral_constant<bool, false>) const
     {
+        if constexpr (simd::use_kernels_v<T1, T2>)
+        {
+            simd::predict_interval<order>(dest, src, cursor);
+            return;
+        }
+
         auto qs_i   = Qs_i<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
         auto qs_j   = Qs_j<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
         auto qs_k   = Qs_k<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
@@ -731,31 +776,31 @@ namespace samurai
                 auto even_i = i.even_elements();
                 if (even_i.is_valid())
                 {
-                    auto coarse_even_i        = even_i >> 1;
-                    auto dec_even             = (i.start & 1) ? 1 : 0;
-                    dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
-                                              + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                              - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                              - xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
-                                              + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
-                                              + xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
-                                              - xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
-                                              + xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
+                    auto coarse_even_i         = even_i >> 1;
+                    auto dec_even              = (i.start & 1) ? 1 : 0;
+                    dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
+                                               + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
+                                               - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
+                                               - xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
+                                               + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
+                                               + xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
+                                               - xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
+                                               + xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
                 }
 
                 auto odd_i = i.odd_elements();
                 if (odd_i.is_valid())
                 {
-                    auto coarse_odd_i        = odd_i >> 1;
-                    auto dec_odd             = (i.end & 1) ? 1 : 0;
-                    dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
-                                             - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                             - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                             - xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
-                                             - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)))
-                                             - xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)))
-                                             - xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)))
-                                             - xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
+                    auto coarse_odd_i         = odd_i >> 1;
+                    auto dec_odd              = (i.end & 1) ? 1 : 0;
+                    dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
+                                              - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
+                                              - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
+                                              - xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
+                                              - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)))
+                                              - xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)))
+                                              - xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)))
+                                              - xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
                 }
             }
             else
@@ -763,31 +808,31 @@ namespace samurai
                 auto even_i = i.even_elements();
                 if (even_i.is_valid())
                 {
-                    auto coarse_even_i        = even_i >> 1;
-                    auto dec_even             = (i.start & 1) ? 1 : 0;
-                    dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
-                                              + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                              + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                              - xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
-                                              - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
-                                              + xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
-                                              + xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
-                                              - xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
+                    auto coarse_even_i         = even_i >> 1;
+                    auto dec_even              = (i.start & 1) ? 1 : 0;
+                    dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
+                                               + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
+                                               + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
+                                               - xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
+                                               - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
+                                               + xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
+                                               + xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
+                                               - xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
                 }
 
                 auto odd_i = i.odd_elements();
                 if (odd_i.is_valid())
                 {
-                    auto coarse_odd_i        = odd_i >> 1;
-                    auto dec_odd             = (i.end & 1) ? 1 : 0;
-                    dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
-                                             - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                             + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                             - xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
-                                             + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)))
-                                             - xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)))
-                                             + xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)))
-                                             + xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
+                    auto coarse_odd_i         = odd_i >> 1;
+                    auto dec_odd              = (i.end & 1) ? 1 : 0;
+                    dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
+                                              - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
+                                              + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
+                                              - xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
+                                              + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)))
+                                              - xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)))
+                                              + xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)))
+                                              + xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
                 }
             }
         }
@@ -798,31 +843,31 @@ namespace samurai
                 auto even_i = i.even_elements();
                 if (even_i.is_valid())
                 {
-                    auto coarse_even_i        = even_i >> 1;
-                    auto dec_even             = (i.start & 1) ? 1 : 0;
-                    dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
-                                              + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                              - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                              + xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
-                                              + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
-                                              - xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
-                                              + xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
-                                              - xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
+                    auto coarse_even_i         = even_i >> 1;
+                    auto dec_even              = (i.start & 1) ? 1 : 0;
+                    dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
+                                               + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
+                                               - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
+                                               + xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
+                                               + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
+                                               - xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
+                                               + xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
+                                               - xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
                 }
 
                 auto odd_i = i.odd_elements();
                 if (odd_i.is_valid())
                 {
-                    auto coarse_odd_i        = odd_i >> 1;
-                    auto dec_odd             = (i.end & 1) ? 1 : 0;
-                    dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
-                                             - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                             - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                             + xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
-                                             - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)))
-                                             + xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)))
-                                             + xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)))
-                                             + xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
+                    auto coarse_odd_i         = odd_i >> 1;
+                    auto dec_odd              = (i.end & 1) ? 1 : 0;
+                    dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
+                                              - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
+                                              - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
+                                              + xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
+                                              - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)))
+                                              + xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)))
+                                              + xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)))
+                                              + xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
                 }
             }
             else
@@ -830,31 +875,31 @@ namespace samurai
                 auto even_i = i.even_elements();
                 if (even_i.is_valid())
                 {
-                    auto coarse_even_i        = even_i >> 1;
-                    auto dec_even             = (i.start & 1) ? 1 : 0;
-                    dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
-                                              + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                              + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                              + xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
-                                              - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
-                                              - xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
-                                              - xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
-                                              + xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
+                    auto coarse_even_i         = even_i >> 1;
+                    auto dec_even              = (i.start & 1) ? 1 : 0;
+                    dest(cursor.slice(even_i)) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
+                                               + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
+                                               + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
+                                               + xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
+                                               - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
+                                               - xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
+                                               - xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
+                                               + xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
                 }
 
                 auto odd_i = i.odd_elements();
                 if (odd_i.is_valid())
                 {
-                    auto coarse_odd_i        = odd_i >> 1;
-                    auto dec_odd             = (i.end & 1) ? 1 : 0;
-                    dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
-                                             - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                             + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                             + xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
-                                             + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)))
-                                             + xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)))
-                                             - xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)))
-                                             - xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
+                    auto coarse_odd_i         = odd_i >> 1;
+                    auto dec_odd              = (i.end & 1) ? 1 : 0;
+                    dest(cursor.slice(odd_i)) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
+                                              - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
+                                              + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
+                                              + xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
+                                              + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)))
+                                              + xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)))
+                                              - xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)))
+                                              - xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
                 }
             }
         }
@@ -879,7 +924,7 @@ namespace samurai
                                Head& source,
                                Tail&... sources) const
         {
-            prediction_op<dim, interval_t>(level, i)(Dim<1>{}, source, source, o, dest);
+            prediction_op<dim, interval_t>(cursor)(Dim<1>{}, source, source, o, dest);
             this->operator()(Dim<1>{}, o, dest, sources...);
         }
 
@@ -890,7 +935,7 @@ namespace samurai
                                Head& source,
                                Tail&... sources) const
         {
-            prediction_op<dim, interval_t>(level, i, j)(Dim<2>{}, source, source, o, dest);
+            prediction_op<dim, interval_t>(cursor)(Dim<2>{}, source, source, o, dest);
             this->operator()(Dim<2>{}, o, dest, sources...);
         }
 
@@ -901,11 +946,16 @@ namespace samurai
                                Head& source,
                                Tail&... sources) const
         {
-            prediction_op<dim, interval_t>(level, i, j, k)(Dim<3>{}, source, source, o, dest);
+            prediction_op<dim, interval_t>(cursor)(Dim<3>{}, source, source, o, dest);
             this->operator()(Dim<3>{}, o, dest, sources...);
         }
     };
 
+    template <>
+    struct is_parallel_operator<variadic_prediction_op> : std::true_type
+    {
+    };
+
     template <std::size_t order, bool dest_on_level, class... T>
     inline auto variadic_prediction(T&&... fields)
     {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../operators_base.hpp"
+#include "simd_kernels.hpp"
 
 namespace samurai
 {
@@ -22,28 +23,54 @@ namespace samurai
         template <class T1, class T2>
         inline void operator()(Dim<1>, T1& dest, const T2& src) const
         {
-            dest(level, i) = .5 * (src(level + 1, 2 * i) + src(level + 1, 2 * i + 1));
+            if constexpr (simd::use_kernels_v<T1, T2>)
+            {
+                simd::project_interval(dest, src, cursor);
+            }
+            else
+            {
+                dest(cursor) = .5 * (src(level + 1, 2 * i) + src(level + 1, 2 * i + 1));
+            }
         }
 
         template <class T1, class T2>
         inline void operator()(Dim<2>, T1& dest, const T2& src) const
         {
-            dest(level, i, j) = .25
-                              * (src(level + 1, 2 * i, 2 * j) + src(level + 1, 2 * i, 2 * j + 1) + src(level + 1, 2 * i + 1, 2 * j)
-                                 + src(level + 1, 2 * i + 1, 2 * j + 1));
+            if constexpr (simd::use_kernels_v<T1, T2>)
+            {
+                simd::project_interval(dest, src, cursor);
+            }
+            else
+            {
+                dest(cursor) = .25
+                             * (src(level + 1, 2 * i, 2 * j) + src(level + 1, 2 * i, 2 * j + 1) + src(level + 1, 2 * i + 1, 2 * j)
+                                + src(level + 1, 2 * i + 1, 2 * j + 1));
+            }
         }
 
         template <class T1, class T2>
         inline void operator()(Dim<3>, T1& dest, const T2& src) const
         {
-            dest(level, i, j, k) = .125
-                                 * (src(level + 1, 2 * i, 2 * j, 2 * k) + src(level + 1, 2 * i + 1, 2 * j, 2 * k)
-                                    + src(level + 1, 2 * i, 2 * j + 1, 2 * k) + src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k)
-                                    + src(level + 1, 2 * i, 2 * j, 2 * k + 1) + src(level + 1, 2 * i + 1, 2 * j, 2 * k + 1)
-                                    + src(level + 1, 2 * i, 2 * j + 1, 2 * k + 1) + src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k + 1));
+            if constexpr (simd::use_kernels_v<T1, T2>)
+            {
+                simd::project_interval(dest, src, cursor);
+            }
+            else
+            {
+                dest(cursor) = .125
+                             * (src(level + 1, 2 * i, 2 * j, 2 * k) + src(level + 1, 2 * i + 1, 2 * j, 2 * k)
+                                + src(level + 1, 2 * i, 2 * j + 1, 2 * k) + src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k)
+                                + src(level + 1, 2 * i, 2 * j, 2 * k + 1) + src(level + 1, 2 * i + 1, 2 * j, 2 * k + 1)
+                                + src(level + 1, 2 * i, 2 * j + 1, 2 * k + 1) + src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k + 1));
+            }
         }
     };
 
+    template <>
+    struct is_parallel_operator<projection_op_> : std::true_type
+    {
+    };
+
     template <std::size_t dim, class TInterval>
     class variadic_projection_op_ : public field_operator_base<dim, TInterval>
     {
@@ -59,25 +86,30 @@ namespace samurai
         template <class Head, class... Tail>
         inline void operator()(Dim<1>, Head& source, Tail&... sources) const
         {
-            projection_op_<dim, interval_t>(level, i)(Dim<1>{}, source, source);
+            projection_op_<dim, interval_t>(cursor)(Dim<1>{}, source, source);
             this->operator()(Dim<1>{}, sources...);
         }
 
         template <class Head, class... Tail>
         inline void operator()(Dim<2>, Head& source, Tail&... sources) const
         {
-            projection_op_<dim, interval_t>(level, i, j)(Dim<2>{}, source, source);
+            projection_op_<dim, interval_t>(cursor)(Dim<2>{}, source, source);
             this->operator()(Dim<2>{}, sources...);
         }
 
         template <class Head, class... Tail>
         inline void operator()(Dim<3>, Head& source, Tail&... sources) const
         {
-            projection_op_<dim, interval_t>(level, i, j, k)(Dim<3>{}, source, source);
+            projection_op_<dim, interval_t>(cursor)(Dim<3>{}, source, source);
             this->operator()(Dim<3>{}, sources...);
         }
     };
 
+    template <>
+    struct is_parallel_operator<variadic_projection_op_> : std::true_type
+    {
+    };
+
     template <class T>
     inline auto projection(T&& field)
     {
@@ -0,0 +1,916 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <fmt/format.h>
+
+#include <xtensor/xfixed.hpp>
+
+#include "../storage_cursor.hpp"
+
+namespace samurai
+{
+    template <class mesh_t, class value_t, std::size_t size, bool SOA>
+    class Field;
+
+    template <std::size_t s>
+    inline std::array<double, s> prediction_coeffs();
+
+    /**
+     * Vectorized kernels of the multiresolution operators.
+     *
+     * The projection, the prediction and the details are computed here on the
+     * contiguous storage of the intervals: the even and odd cells of the fine
+     * level are split (or merged) in registers instead of going through
+     * strided views. The instruction set is selected at compile time
+     * (AVX-512, AVX2 or a scalar fallback) and the operations are done in the
+     * same order as the xtensor expressions of the operators.
+     */
+    namespace simd
+    {
+        namespace detail
+        {
+            /// One value per register: used for the tails and as fallback.
+            struct scalar_arch
+            {
+                using reg_t                        = double;
+                static constexpr std::size_t width = 1;
+
+                static inline reg_t load(const double* p)
+                {
+                    return *p;
+                }
+
+                static inline void store(double* p, reg_t v)
+                {
+                    *p = v;
+                }
+
+                static inline reg_t set1(double v)
+                {
+                    return v;
+                }
+
+                static inline reg_t add(reg_t a, reg_t b)
+                {
+                    return a + b;
+                }
+
+                static inline reg_t sub(reg_t a, reg_t b)
+                {
+                    return a - b;
+                }
+
+                static inline reg_t mul(reg_t a, reg_t b)
+                {
+                    return a * b;
+                }
+
+                /// Split p[0, 2 * width) into its even and odd elements
+                static inline void deinterleave(const double* p, reg_t& even, reg_t& odd)
+                {
+                    even = p[0];
+                    odd  = p[1];
+                }
+
+                /// Inverse of deinterleave
+                static inline void interleave(double* p, reg_t even, reg_t odd)
+                {
+                    p[0] = even;
+                    p[1] = odd;
+                }
+            };
+
+#if defined(__AVX2__)
+            struct avx2_arch
+            {
+                using reg_t                        = __m256d;
+                static constexpr std::size_t width = 4;
+
+                static inline reg_t load(const double* p)
+                {
+                    return _mm256_loadu_pd(p);
+                }
+
+                static inline void store(double* p, reg_t v)
+                {
+                    _mm256_storeu_pd(p, v);
+                }
+
+                static inline reg_t set1(double v)
+                {
+                    return _mm256_set1_pd(v);
+                }
+
+                static inline reg_t add(reg_t a, reg_t b)
+                {
+                    return _mm256_add_pd(a, b);
+                }
+
+                static inline reg_t sub(reg_t a, reg_t b)
+                {
+                    return _mm256_sub_pd(a, b);
+                }
+
+                static inline reg_t mul(reg_t a, reg_t b)
+                {
+                    return _mm256_mul_pd(a, b);
+                }
+
+                static inline void deinterleave(const double* p, reg_t& even, reg_t& odd)
+                {
+                    reg_t a  = _mm256_loadu_pd(p);
+                    reg_t b  = _mm256_loadu_pd(p + 4);
+                    reg_t lo = _mm256_unpacklo_pd(a, b); // a0 b0 a2 b2
+                    reg_t hi = _mm256_unpackhi_pd(a, b); // a1 b1 a3 b3
+                    even     = _mm256_permute4x64_pd(lo, _MM_SHUFFLE(3, 1, 2, 0));
+                    odd      = _mm256_permute4x64_pd(hi, _MM_SHUFFLE(3, 1, 2, 0));
+                }
+
+                static inline void interleave(double* p, reg_t even, reg_t odd)
+                {
+                    reg_t lo = _mm256_unpacklo_pd(even, odd); // e0 o0 e2 o2
+                    reg_t hi = _mm256_unpackhi_pd(even, odd); // e1 o1 e3 o3
+                    _mm256_storeu_pd(p, _mm256_permute2f128_pd(lo, hi, 0x20));
+                    _mm256_storeu_pd(p + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+                }
+            };
+#endif
+
+#if defined(__AVX512F__)
+            struct avx512_arch
+            {
+                using reg_t                        = __m512d;
+                static constexpr std::size_t width = 8;
+
+                static inline reg_t load(const double* p)
+                {
+                    return _mm512_loadu_pd(p);
+                }
+
+                static inline void store(double* p, reg_t v)
+                {
+                    _mm512_storeu_pd(p, v);
+                }
+
+                static inline reg_t set1(double v)
+                {
+                    return _mm512_set1_pd(v);
+                }
+
+                static inline reg_t add(reg_t a, reg_t b)
+                {
+                    return _mm512_add_pd(a, b);
+                }
+
+                static inline reg_t sub(reg_t a, reg_t b)
+                {
+                    return _mm512_sub_pd(a, b);
+                }
+
+                static inline reg_t mul(reg_t a, reg_t b)
+                {
+                    return _mm512_mul_pd(a, b);
+                }
+
+                static inline void deinterleave(const double* p, reg_t& even, reg_t& odd)
+                {
+                    reg_t a = _mm512_loadu_pd(p);
+                    reg_t b = _mm512_loadu_pd(p + 8);
+                    even    = _mm512_permutex2var_pd(a, _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0), b);
+                    odd     = _mm512_permutex2var_pd(a, _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1), b);
+                }
+
+                static inline void interleave(double* p, reg_t even, reg_t odd)
+                {
+                    _mm512_storeu_pd(p, _mm512_permutex2var_pd(even, _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0), odd));
+                    _mm512_storeu_pd(p + 8, _mm512_permutex2var_pd(even, _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4), odd));
+                }
+            };
+
+            using arch_t = avx512_arch;
+#elif defined(__AVX2__)
+            using arch_t = avx2_arch;
+#else
+            using arch_t = scalar_arch;
+#endif
+
+            /// Thread local storage reused by the kernels between two calls
+            inline std::vector<double>& scratch()
+            {
+                static thread_local std::vector<double> buffer;
+                return buffer;
+            }
+        } // namespace detail
+
+        /// True if the operators go through the kernels of this file
+#if defined(SAMURAI_WITH_SIMD_KERNELS) && !defined(SAMURAI_CHECK_NAN)
+        inline constexpr bool enabled = true;
+#else
+        inline constexpr bool enabled = false;
+#endif
+
+        /// Name of the instruction set selected at compile time
+        inline constexpr const char* instruction_set()
+        {
+#if defined(__AVX512F__)
+            return "avx512";
+#elif defined(__AVX2__)
+            return "avx2";
+#else
+            return "scalar";
+#endif
+        }
+
+        /////////////////
+        // Raw kernels //
+        /////////////////
+
+        namespace detail
+        {
+            template <class Arch, std::size_t dim>
+            inline std::size_t projection_block(double* dest,
+                                                const std::array<const double*, (1 << (dim - 1))>& fine,
+                                                std::size_t n,
+                                                std::size_t size)
+            {
+                constexpr std::size_t w = Arch::width;
+                constexpr double scale  = 1. / (1 << dim);
+
+                for (; n + w <= size; n += w)
+                {
+                    typename Arch::reg_t e0;
+                    typename Arch::reg_t o0;
+                    typename Arch::reg_t sum;
+                    Arch::deinterleave(fine[0] + 2 * n, e0, o0);
+                    if constexpr (dim == 1)
+                    {
+                        sum = Arch::add(e0, o0);
+                    }
+                    else if constexpr (dim == 2)
+                    {
+                        typename Arch::reg_t e1;
+                        typename Arch::reg_t o1;
+                        Arch::deinterleave(fine[1] + 2 * n, e1, o1);
+                        sum = Arch::add(Arch::add(Arch::add(e0, e1), o0), o1);
+                    }
+                    else
+                    {
+                        sum = Arch::add(e0, o0);
+                        for (std::size_t r = 1; r < 4; ++r)
+                        {
+                            typename Arch::reg_t e;
+                            typename Arch::reg_t o;
+                            Arch::deinterleave(fine[r] + 2 * n, e, o);
+                            sum = Arch::add(Arch::add(sum, e), o);
+                        }
+                    }
+                    Arch::store(dest + n, Arch::mul(Arch::set1(scale), sum));
+                }
+                return n;
+            }
+
+            template <class Arch, std::size_t order>
+            inline std::size_t prediction_difference_block(double* q,
+                                                           const std::array<const double*, order>& plus,
+                                                           const std::array<const double*, order>& minus,
+                                                           const std::array<double, order>& c,
+                                                           std::size_t first,
+                                                           std::size_t n,
+                                                           std::size_t size)
+            {
+                for (; n + Arch::width <= size; n += Arch::width)
+                {
+                    auto term = [&](std::size_t s)
+                    {
+                        return Arch::mul(Arch::set1(c[s]), Arch::sub(Arch::load(plus[s] + n), Arch::load(minus[s] + n)));
+                    };
+
+                    auto acc = term(order - 1);
+                    for (std::size_t s = order - 1; s-- > first;)
+                    {
+                        acc = Arch::add(term(s), acc);
+                    }
+                    Arch::store(q + n, acc);
+                }
+                return n;
+            }
+
+            /// Predicted values of the two children of the coarse cells [c, c + width)
+            template <class Arch, std::size_t n_terms>
+            inline void prediction_pair(const double* u,
+                                        const std::array<const double*, n_terms>& q,
+                                        const std::array<double, n_terms>& sign,
+                                        const std::array<bool, n_terms>& along_x,
+                                        std::size_t c,
+                                        typename Arch::reg_t& even,
+                                        typename Arch::reg_t& odd)
+            {
+                even = Arch::load(u + c);
+                odd  = even;
+                for (std::size_t t = 0; t < n_terms; ++t)
+                {
+                    auto sq = Arch::mul(Arch::set1(sign[t]), Arch::load(q[t] + c));
+                    even    = Arch::add(even, sq);
+                    odd     = along_x[t] ? Arch::sub(odd, sq) : Arch::add(odd, sq);
+                }
+            }
+
+            template <class Arch, std::size_t n_terms>
+            inline std::size_t prediction_block(double* out,
+                                                const double* fine,
+                                                const double* u,
+                                                const std::array<const double*, n_terms>& q,
+                                                const std::array<double, n_terms>& sign,
+                                                const std::array<bool, n_terms>& along_x,
+                                                std::size_t c,
+                                                std::size_t n_pairs)
+            {
+                for (; c + Arch::width <= n_pairs; c += Arch::width)
+                {
+                    typename Arch::reg_t even;
+                    typename Arch::reg_t odd;
+                    prediction_pair<Arch>(u, q, sign, along_x, c, even, odd);
+                    if (fine != nullptr)
+                    {
+                        typename Arch::reg_t fine_even;
+                        typename Arch::reg_t fine_odd;
+                        Arch::deinterleave(fine + 2 * c, fine_even, fine_odd);
+                        even = Arch::sub(fine_even, even);
+                        odd  = Arch::sub(fine_odd, odd);
+                    }
+                    Arch::interleave(out + 2 * c, even, odd);
+                }
+                return c;
+            }
+        } // namespace detail
+
+        /**
+         * Projection of a row of fine cells onto the coarse level.
+         *
+         * dest[n] is the mean of the values 2n and 2n + 1 of each fine row,
+         * n in [0, size). The fine rows are ordered by increasing y then z.
+         */
+        template <std::size_t dim>
+        inline void projection(double* dest, const std::array<const double*, (1 << (dim - 1))>& fine, std::size_t size)
+        {
+            std::size_t n = detail::projection_block<detail::arch_t, dim>(dest, fine, 0, size);
+            detail::projection_block<detail::scalar_arch, dim>(dest, fine, n, size);
+        }
+
+        /**
+         * Prediction correction along one direction:
+         * q[n] = sum_{s >= first} c[s] * (plus[s][n] - minus[s][n]) for n in
+         * [0, size), where plus[s] and minus[s] are the inputs shifted by
+         * +/- (s + 1) cells. The sum is evaluated from the last term as in
+         * Qs_i_impl.
+         */
+        template <std::size_t order>
+        inline void prediction_difference(double* q,
+                                          const std::array<const double*, order>& plus,
+                                          const std::array<const double*, order>& minus,
+                                          const std::array<double, order>& c,
+                                          std::size_t size,
+                                          std::size_t first = 0)
+        {
+            std::size_t n = detail::prediction_difference_block<detail::arch_t>(q, plus, minus, c, first, 0, size);
+            detail::prediction_difference_block<detail::scalar_arch>(q, plus, minus, c, first, n, size);
+        }
+
+        /**
+         * Prediction of the fine cells [start, end) of a row.
+         *
+         * The coarse value u and the corrections q are given from the coarse
+         * cell start >> 1. The prediction of a fine cell of coarse parent c is
+         * u[c] + sum_t sign[t] * q[t][c], where the sign of the corrections
+         * along x is flipped for the odd cells. If fine is not null, out is
+         * the detail fine - prediction.
+         *
+         * @param out the values of the fine cells [start, end)
+         * @param fine the field on the fine cells [start, end) or nullptr
+         */
+        template <std::size_t n_terms, class value_t>
+        inline void prediction(double* out,
+                               const double* fine,
+                               const double* u,
+                               const std::array<const double*, n_terms>& q,
+                               const std::array<double, n_terms>& sign,
+                               const std::array<bool, n_terms>& along_x,
+                               value_t start,
+                               value_t end)
+        {
+            using scalar = detail::scalar_arch;
+
+            if (end <= start)
+            {
+                return;
+            }
+
+            // Odd first cell: the even one is not in the interval
+            std::size_t first = 0;
+            if (start & 1)
+            {
+                double even;
+                double odd;
+                detail::prediction_pair<scalar>(u, q, sign, along_x, 0, even, odd);
+                out[0] = (fine != nullptr) ? fine[0] - odd : odd;
+                first  = 1;
+            }
+
+            // Shift the arrays so that the pairs start at 0
+            const double* uu = u + first;
+            std::array<const double*, n_terms> qq;
+            for (std::size_t t = 0; t < n_terms; ++t)
+            {
+                qq[t] = q[t] + first;
+            }
+            double* out_pairs        = out + first;
+            const double* fine_pairs = (fine != nullptr) ? fine + first : nullptr;
+            auto n_pairs             = static_cast<std::size_t>(end - start - static_cast<value_t>(first)) / 2;
+
+            std::size_t c = detail::prediction_block<detail::arch_t>(out_pairs, fine_pairs, uu, qq, sign, along_x, 0, n_pairs);
+            detail::prediction_block<scalar>(out_pairs, fine_pairs, uu, qq, sign, along_x, c, n_pairs);
+
+            // Even last cell: the odd one is not in the interval
+            if (end & 1)
+            {
+                double even;
+                double odd;
+                detail::prediction_pair<scalar>(uu, qq, sign, along_x, n_pairs, even, odd);
+                out_pairs[2 * n_pairs] = (fine_pairs != nullptr) ? fine_pairs[2 * n_pairs] - even : even;
+            }
+        }
+
+        ///////////////////////////////////
+        // prediction_stencil definition //
+        ///////////////////////////////////
+
+        /**
+         * @class prediction_stencil
+         * @brief Corrections of the prediction of a coarse row.
+         *
+         * The corrections Q_i, Q_j, Q_ij, ... of the coarse interval are
+         * computed once with their halo, which avoids the temporaries of the
+         * recursive Qs_* expressions, and then reused for all the fine rows
+         * of the interval.
+         *
+         * @tparam dim    The dimension.
+         * @tparam order  The prediction order.
+         */
+        template <std::size_t dim, std::size_t order>
+        class prediction_stencil
+        {
+          public:
+
+            static constexpr std::size_t n_terms = (order == 0) ? 0 : (1 << dim) - 1;
+
+            template <class Rows, class value_t>
+            void build(Rows&& rows, value_t start, value_t end);
+
+            template <class value_t>
+            void apply(double* out, const double* fine, value_t start, value_t end, const std::array<bool, dim - 1>& odd_yz) const;
+
+          private:
+
+            const double* m_u = nullptr;
+            std::array<const double*, n_terms> m_q;
+        };
+
+        ///////////////////////////////////////
+        // prediction_stencil implementation //
+        ///////////////////////////////////////
+
+        /**
+         * Compute the corrections on the coarse cells [start, end).
+         * @param rows function (start, end, offset) returning a pointer on
+         * the coarse cell start of the row shifted by offset along y and z
+         */
+        template <std::size_t dim, std::size_t order>
+        template <class Rows, class value_t>
+        inline void prediction_stencil<dim, order>::build(Rows&& rows, value_t start, value_t end)
+        {
+            using offset_t = std::array<value_t, dim - 1>;
+
+            if constexpr (order == 0)
+            {
+                m_u = rows(start, end, offset_t{});
+            }
+            else
+            {
+                constexpr auto o        = static_cast<value_t>(order);
+                constexpr std::size_t w = 2 * order + 1;
+                const auto c            = prediction_coeffs<order>();
+                const auto size         = static_cast<std::size_t>(end - start);
+                const auto ext_size     = size + 2 * order;
+
+                // As in the Qs_*_impl, the term s of an outer correction
+                // evaluates the inner one from the term min(s + 1, order).
+                auto inner = [](std::size_t s)
+                {
+                    return std::min(s + 1, order);
+                };
+
+                // q = sum_{s >= first} c[s - 1] * (x(s, s) - x(s, -s)) where
+                // x(s, m) is the input of the term s shifted by m cells
+                auto difference = [&](double* q, std::size_t first, std::size_t n, auto&& x)
+                {
+                    std::array<const double*, order> plus{};
+                    std::array<const double*, order> minus{};
+                    for (std::size_t s = first; s <= order; ++s)
+                    {
+                        plus[s - 1]  = x(s, static_cast<value_t>(s));
+                        minus[s - 1] = x(s, -static_cast<value_t>(s));
+                    }
+                    prediction_difference<order>(q, plus, minus, c, n, first - 1);
+                };
+
+                auto& buffer = detail::scratch();
+
+                if constexpr (dim == 1)
+                {
+                    buffer.resize(size);
+                    const double* u = rows(start - o, end + o, offset_t{}) + order;
+                    m_u             = u;
+
+                    m_q[0] = buffer.data();
+                    difference(buffer.data(),
+                               1,
+                               size,
+                               [&](std::size_t, value_t m)
+                               {
+                                   return u + m;
+                               });
+                }
+                else if constexpr (dim == 2)
+                {
+                    // Q_j of the tags 1 to order on the extended rows, then Q_i and Q_ij
+                    buffer.resize(order * ext_size + 2 * size);
+                    auto qj = [&](std::size_t tag)
+                    {
+                        return buffer.data() + (tag - 1) * ext_size;
+                    };
+                    double* qi  = buffer.data() + order * ext_size;
+                    double* qij = qi + size;
+
+                    std::array<const double*, w> u;
+                    for (std::size_t m = 0; m < w; ++m)
+                    {
+                        u[m] = rows(start - o, end + o, offset_t{static_cast<value_t>(m) - o});
+                    }
+                    m_u = u[order] + order;
+
+                    for (std::size_t tag = 1; tag <= order; ++tag)
+                    {
+                        difference(qj(tag),
+                                   tag,
+                                   ext_size,
+                                   [&](std::size_t, value_t m)
+                                   {
+                                       return u[static_cast<std::size_t>(o + m)];
+                                   });
+                    }
+                    difference(qi,
+                               1,
+                               size,
+                               [&](std::size_t, value_t m)
+                               {
+                                   return m_u + m;
+                               });
+                    difference(qij,
+                               1,
+                               size,
+                               [&](std::size_t s, value_t m)
+                               {
+                                   return qj(inner(s)) + o + m;
+                               });
+
+                    m_q = {qi, qj(1) + order, qij};
+                }
+                else
+                {
+                    // Q_k of the tags 1 to order on the extended rows j - order to
+                    // j + order, Q_j and Q_jk on the extended row, then the
+                    // corrections along x
+                    buffer.resize(order * (w + 2) * ext_size + 4 * size);
+                    auto qk = [&](std::size_t tag, std::size_t mj)
+                    {
+                        return buffer.data() + ((tag - 1) * w + mj) * ext_size;
+                    };
+                    auto qj = [&](std::size_t tag)
+                    {
+                        return buffer.data() + (order * w + tag - 1) * ext_size;
+                    };
+                    auto qjk = [&](std::size_t tag)
+                    {
+                        return buffer.data() + (order * (w + 1) + tag - 1) * ext_size;
+                    };
+                    double* qi   = buffer.data() + order * (w + 2) * ext_size;
+                    double* qij  = qi + size;
+                    double* qik  = qij + size;
+                    double* qijk = qik + size;
+
+                    std::array<std::array<const double*, w>, w> u;
+                    for (std::size_t mj = 0; mj < w; ++mj)
+                    {
+                        for (std::size_t mk = 0; mk < w; ++mk)
+                        {
+                            u[mj][mk] = rows(start - o, end + o, offset_t{static_cast<value_t>(mj) - o, static_cast<value_t>(mk) - o});
+                        }
+                    }
+                    m_u = u[order][order] + order;
+
+                    for (std::size_t tag = 1; tag <= order; ++tag)
+                    {
+                        for (std::size_t mj = 0; mj < w; ++mj)
+                        {
+                            difference(qk(tag, mj),
+                                       tag,
+                                       ext_size,
+                                       [&](std::size_t, value_t m)
+                                       {
+                                           return u[mj][static_cast<std::size_t>(o + m)];
+                                       });
+                        }
+                        difference(qj(tag),
+                                   tag,
+                                   ext_size,
+                                   [&](std::size_t, value_t m)
+                                   {
+                                       return u[static_cast<std::size_t>(o + m)][order];
+                                   });
+                    }
+                    for (std::size_t tag = 1; tag <= order; ++tag)
+                    {
+                        difference(qjk(tag),
+                                   tag,
+                                   ext_size,
+                                   [&](std::size_t s, value_t m)
+                                   {
+                                       return static_cast<const double*>(qk(inner(s), static_cast<std::size_t>(o + m)));
+                                   });
+                    }
+                    difference(qi,
+                               1,
+                               size,
+                               [&](std::size_t, value_t m)
+                               {
+                                   return m_u + m;
+                               });
+                    difference(qij,
+                               1,
+                               size,
+                               [&](std::size_t s, value_t m)
+                               {
+                                   return qj(inner(s)) + o + m;
+                               });
+                    difference(qik,
+                               1,
+                               size,
+                               [&](std::size_t s, value_t m)
+                               {
+                                   return qk(inner(s), order) + o + m;
+                               });
+                    difference(qijk,
+                               1,
+                               size,
+                               [&](std::size_t s, value_t m)
+                               {
+                                   return qjk(inner(s)) + o + m;
+                               });
+
+                    m_q = {qi, qj(1) + order, qk(1, order) + order, qij, qik, qjk(1) + order, qijk};
+                }
+            }
+        }
+
+        /**
+         * Predict the fine cells [start, end) of the row of parity odd_yz
+         * along y and z, where [start >> 1, ((end - 1) >> 1) + 1) is the
+         * coarse interval given to build.
+         */
+        template <std::size_t dim, std::size_t order>
+        template <class value_t>
+        inline void prediction_stencil<dim, order>::apply(double* out,
+                                                          const double* fine,
+                                                          value_t start,
+                                                          value_t end,
+                                                          const std::array<bool, dim - 1>& odd_yz) const
+        {
+            std::array<double, n_terms> sign;
+            std::array<bool, n_terms> along_x;
+            if constexpr (n_terms > 0)
+            {
+                if constexpr (dim == 1)
+                {
+                    sign    = {1.};
+                    along_x = {true};
+                }
+                else if constexpr (dim == 2)
+                {
+                    const double sj = odd_yz[0] ? -1. : 1.;
+                    sign            = {1., sj, -sj};
+                    along_x         = {true, false, true};
+                }
+                else
+                {
+                    const double sj = odd_yz[0] ? -1. : 1.;
+                    const double sk = odd_yz[1] ? -1. : 1.;
+                    sign            = {1., sj, sk, -sj, -sk, -sj * sk, sj * sk};
+                    along_x         = {true, false, false, true, true, false, true};
+                }
+            }
+            prediction<n_terms>(out, fine, m_u, m_q, sign, along_x, start, end);
+        }
+
+        ////////////////
+        // Field glue //
+        ////////////////
+
+        template <class T>
+        struct has_simd_storage : std::false_type
+        {
+        };
+
+        template <class mesh_t, bool SOA>
+        struct has_simd_storage<Field<mesh_t, double, 1, SOA>> : std::true_type
+        {
+        };
+
+        /// True if the kernels can be used on the given fields
+        template <class... T>
+        inline constexpr bool use_kernels_v = enabled && (has_simd_storage<std::decay_t<T>>::value && ...);
+
+        namespace detail
+        {
+            /**
+             * Pointer on the cell interval.start of the row index of field,
+             * with the same check as the access operator of the field.
+             */
+            template <class TField, class interval_t, std::size_t N>
+            inline auto row_data(TField& field,
+                                 const char* rw,
+                                 std::size_t level,
+                                 const interval_t& interval,
+                                 const std::array<typename interval_t::value_t, N>& index)
+            {
+                using mesh_id_t     = typename std::decay_t<TField>::mesh_t::mesh_id_t;
+                using coord_index_t = typename interval_t::value_t;
+
+                const auto& lca = field.mesh()[mesh_id_t::reference][level];
+
+                xt::xtensor_fixed<coord_index_t, xt::xshape<N + 1>> coord;
+                coord[0] = interval.start;
+                for (std::size_t d = 0; d < N; ++d)
+                {
+                    coord[d + 1] = index[d];
+                }
+                auto row = find(lca, coord);
+                if (row == -1 || lca[0][static_cast<std::size_t>(row)].end < interval.end)
+                {
+                    throw std::out_of_range(fmt::format("{} FIELD ERROR on level {}: try to find interval {}", rw, level, interval));
+                }
+                return field.array().data() + lca[0][static_cast<std::size_t>(row)].index + interval.start;
+            }
+
+            /// Pointer on the cell cursor.interval.start of field
+            template <class TField, std::size_t dim, class interval_t>
+            inline auto row_data(TField& field, const StorageCursor<dim, interval_t>& cursor)
+            {
+                return field.array().data() + field.storage_offset(cursor);
+            }
+
+            template <std::size_t dim, class interval_t>
+            inline auto yz_coordinates(const StorageCursor<dim, interval_t>& cursor)
+            {
+                std::array<typename interval_t::value_t, dim - 1> yz;
+                for (std::size_t d = 0; d < dim - 1; ++d)
+                {
+                    yz[d] = cursor.index[d];
+                }
+                return yz;
+            }
+        } // namespace detail
+
+        /// Projection of src on the interval of the cursor of dest
+        template <class T1, class T2, std::size_t dim, class interval_t>
+        inline void project_interval(T1& dest, const T2& src, const StorageCursor<dim, interval_t>& cursor)
+        {
+            using value_t           = typename interval_t::value_t;
+            constexpr std::size_t N = dim - 1;
+            constexpr std::size_t n = 1 << N;
+
+            const std::size_t level = cursor.level;
+            const auto& i           = cursor.interval;
+            const auto yz           = detail::yz_coordinates(cursor);
+            interval_t fine_i{2 * i.start, 2 * i.end};
+
+            std::array<const double*, n> fine;
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                std::array<value_t, N> fine_yz;
+                for (std::size_t d = 0; d < N; ++d)
+                {
+                    fine_yz[d] = 2 * yz[d] + static_cast<value_t>((r >> d) & 1);
+                }
+                fine[r] = detail::row_data(src, "READ", level + 1, fine_i, fine_yz);
+            }
+            projection<N + 1>(detail::row_data(dest, cursor), fine, i.size());
+        }
+
+        /**
+         * Prediction of the interval of the cursor of dest from the level
+         * below (prediction_op with dest_on_level = false).
+         */
+        template <std::size_t order, class T1, class T2, std::size_t dim, class interval_t>
+        inline void predict_interval(T1& dest, const T2& src, const StorageCursor<dim, interval_t>& cursor)
+        {
+            using value_t           = typename interval_t::value_t;
+            constexpr std::size_t N = dim - 1;
+
+            const std::size_t level = cursor.level;
+            const auto& i           = cursor.interval;
+            const auto yz           = detail::yz_coordinates(cursor);
+            std::array<value_t, N> coarse_yz;
+            std::array<bool, N> odd_yz;
+            for (std::size_t d = 0; d < N; ++d)
+            {
+                coarse_yz[d] = yz[d] >> 1;
+                odd_yz[d]    = yz[d] & 1;
+            }
+
+            auto coarse_i = i >> 1;
+            prediction_stencil<N + 1, order> stencil;
+            stencil.build(
+                [&](value_t start, value_t end, const std::array<value_t, N>& offset)
+                {
+                    std::array<value_t, N> row_yz;
+                    for (std::size_t d = 0; d < N; ++d)
+                    {
+                        row_yz[d] = coarse_yz[d] + offset[d];
+                    }
+                    return detail::row_data(src, "READ", level - 1, interval_t{start, end}, row_yz);
+                },
+                coarse_i.start,
+                coarse_i.end);
+            stencil.apply(detail::row_data(dest, cursor), static_cast<const double*>(nullptr), i.start, i.end, odd_yz);
+        }
+
+        /**
+         * Prediction of the children at level + 1 of the interval i at level
+         * (prediction_op with dest_on_level = true), or details of the
+         * children if fine is not null.
+         */
+        template <std::size_t order, class T1, class T2, class T3, class interval_t, class... index_t>
+        inline void
+        predict_children(T1& dest, const T2& src, const T3* fine, std::size_t level, const interval_t& i, const index_t... index)
+        {
+            using value_t           = typename interval_t::value_t;
+            constexpr std::size_t N = sizeof...(index_t);
+            constexpr std::size_t n = 1 << N;
+
+            const std::array<value_t, N> yz{index...};
+            interval_t fine_i{2 * i.start, 2 * i.end};
+
+            prediction_stencil<N + 1, order> stencil;
+            stencil.build(
+                [&](value_t start, value_t end, const std::array<value_t, N>& offset)
+                {
+                    std::array<value_t, N> row_yz;
+                    for (std::size_t d = 0; d < N; ++d)
+                    {
+                        row_yz[d] = yz[d] + offset[d];
+                    }
+                    return detail::row_data(src, "READ", level, interval_t{start, end}, row_yz);
+                },
+                i.start,
+                i.end);
+
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                std::array<value_t, N> fine_yz;
+                std::array<bool, N> odd_yz;
+                for (std::size_t d = 0; d < N; ++d)
+                {
+                    odd_yz[d]  = (r >> d) & 1;
+                    fine_yz[d] = 2 * yz[d] + static_cast<value_t>(odd_yz[d]);
+                }
+                const double* fine_data = (fine != nullptr) ? detail::row_data(*fine, "READ", level + 1, fine_i, fine_yz) : nullptr;
+                stencil.apply(detail::row_data(dest, "WRITE", level + 1, fine_i, fine_yz), fine_data, fine_i.start, fine_i.end, odd_yz);
+            }
+        }
+    } // namespace simd
+} // namespace samurai
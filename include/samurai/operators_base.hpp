@@ -4,19 +4,35 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include <xtensor/xfixed.hpp>
 
 #include "field_expression.hpp"
+#include "storage_cursor.hpp"
 #include "utils.hpp"
 
 namespace samurai
 {
+    /**
+     * Operators which only write on the cells of the current interval (or on
+     * their parents or children) and only read values that they don't
+     * modify can be applied in parallel on the rows of a subset (see
+     * subset_operator::apply_op). They must specialize this trait to
+     * std::true_type.
+     */
+    template <template <std::size_t dim, class T> class OP>
+    struct is_parallel_operator : std::false_type
+    {
+    };
+
     template <template <std::size_t dim, class T> class OP, class... CT>
     class field_operator_function : public field_expression<field_operator_function<OP, CT...>>
     {
       public:
 
         static constexpr std::size_t dim = detail::compute_dim<CT...>();
+        static constexpr bool is_parallel = is_parallel_operator<OP>::value;
 
         inline field_operator_function(CT&&... e)
             : m_e{std::forward<CT>(e)...}
@@ -37,6 +53,14 @@ namespace samurai
             return apply(op);
         }
 
+        template <class interval_t,
+                  std::enable_if_t<std::is_constructible_v<OP<dim, interval_t>, const StorageCursor<dim, interval_t>&>, int> = 0>
+        inline auto operator()(const StorageCursor<dim, interval_t>& cursor) const
+        {
+            OP<dim, interval_t> op(cursor);
+            return apply(op);
+        }
+
         const auto& arguments() const
         {
             return m_e;
@@ -73,12 +97,14 @@ namespace samurai
         using interval_t    = TInterval;
         using coord_index_t = typename interval_t::coord_index_t;
         using array_index_t = xt::xtensor_fixed<coord_index_t, xt::xshape<dim - 1>>;
+        using cursor_t      = StorageCursor<dim, interval_t>;
 
         // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes,misc-non-private-member-variables-in-classes)
         std::size_t level = 0;
         interval_t i;
         coord_index_t j = 0, k = 0;
         array_index_t index;
+        cursor_t cursor; ///< The interval with its position in the storage if the traversal knows it
 
         // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes,misc-non-private-member-variables-in-classes)
 
@@ -89,10 +115,17 @@ namespace samurai
 
       protected:
 
+        explicit inline field_operator_base(const cursor_t& cursor_)
+            : field_operator_base(cursor_.level, cursor_.interval, cursor_.index)
+        {
+            cursor = cursor_;
+        }
+
         inline field_operator_base(std::size_t level_, const interval_t& interval, const array_index_t& index_)
             : level{level_}
             , i{interval}
             , index{index_}
+            , cursor{level_, interval, index_}
             , m_dx{cell_length(level)}
         {
             if constexpr (dim > 1)
@@ -109,6 +142,7 @@ namespace samurai
             : level{level_}
             , i{interval}
             , index{}
+            , cursor{level_, interval, {}}
             , m_dx{cell_length(level)}
         {
         }
@@ -118,6 +152,7 @@ namespace samurai
             , i{interval}
             , j{j_}
             , index{j_}
+            , cursor{level_, interval, {j_}}
             , m_dx{cell_length(level)}
         {
         }
@@ -128,6 +163,7 @@ namespace samurai
             , j{j_}
             , k{k_}
             , index{j_, k_}
+            , cursor{level_, interval, {j_, k_}}
             , m_dx{cell_length(level)}
         {
         }
@@ -150,6 +186,12 @@ namespace samurai
     using base::level;                                                                       \
     using base::dx;                                                                          \
     using base::index;                                                                       \
+    using base::cursor;                                                                      \
+                                                                                             \
+    explicit inline NAME(const typename base::cursor_t& cursor_)                             \
+        : base(cursor_)                                                                      \
+    {                                                                                        \
+    }                                                                                        \
                                                                                              \
     inline NAME(std::size_t level_, const interval_t& interval, const array_index_t& index_) \
         : base(level_, interval, index_)                                                     \
@@ -39,6 +39,8 @@ namespace samurai
                         op.set_1_on_diag_for_useless_ghosts_if(diagonal_block);
                         op.include_bc_if(diagonal_block);
                         op.assemble_proj_pred_if(diagonal_block);
+                        // The block matrices and vectors are sequential
+                        op.distribute_if(false);
                     });
             }
 
@@ -345,6 +347,8 @@ namespace samurai
                 : base_class(block_op)
             {
                 this->set_name("(unnamed monolithic block operator)");
+                // The monolithic block matrix is sequential
+                this->distribute_if(false);
 
                 for_each_assembly_op(
                     [&](auto& op, auto, auto)
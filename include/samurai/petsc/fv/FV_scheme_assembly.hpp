@@ -1,4 +1,7 @@
 #pragma once
+#include <numeric>
+
+#include "../../algorithm/update.hpp"
 #include "../../boundary.hpp"
 #include "../../numeric/prediction.hpp"
 #include "../../schemes/fv/FV_scheme.hpp"
@@ -51,8 +54,6 @@ namespace samurai
 
             using directional_bdry_config_t = DirectionalBoundaryConfig<field_t, output_field_size, bdry_stencil_size, nb_bdry_ghosts>;
 
-            static constexpr bool ghost_elimination_enabled = true;
-
           protected:
 
             const Scheme* m_scheme;
@@ -93,10 +94,111 @@ namespace samurai
                 m_is_row_empty.resize(static_cast<std::size_t>(matrix_rows()));
                 std::fill(m_is_row_empty.begin(), m_is_row_empty.end(), true);
 
-                if constexpr (ghost_elimination_enabled)
+                build_global_numbering();
+                if (ghost_elimination_enabled())
                 {
                     m_ghost_recursion = ghost_recursion();
                 }
+                else
+                {
+                    m_ghost_recursion.clear();
+                }
+            }
+
+            /**
+             * The projection and prediction ghosts are eliminated from the
+             * matrix, except if it is distributed: the ghosts of a subdomain
+             * may be computed from the cells of its neighbours, so their rows
+             * are assembled.
+             */
+            bool ghost_elimination_enabled() const
+            {
+                return !this->is_distributed();
+            }
+
+            /**
+             * Numbers the rows of the processes one after the other. The rows
+             * of the ghosts which are cells of a neighbouring subdomain are
+             * mapped to the rows of their owner by a ghost exchange of the
+             * global indices.
+             */
+            void build_global_numbering()
+            {
+                this->m_is_distributed   = false;
+                this->m_first_global_row = 0;
+                this->m_owner_rows.clear();
+#ifdef SAMURAI_WITH_MPI
+                if (!this->must_distribute())
+                {
+                    if (is_mesh_partitioned())
+                    {
+                        // The system of each process ignores the cells of its neighbours
+                        std::cerr << "Warning: the matrix of operator '" << this->name()
+                                  << "' is assembled on each subdomain of a partitioned mesh without distribution (see "
+                                     "MatrixAssembly::distribute_if)."
+                                  << std::endl;
+                    }
+                    return;
+                }
+                this->m_is_distributed = true;
+
+                PetscInt n_rows = matrix_rows();
+                MPI_Exscan(&n_rows, &this->m_first_global_row, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD);
+                int rank = 0;
+                MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+                if (rank == 0)
+                {
+                    this->m_first_global_row = 0;
+                }
+
+                // The data of a field with the layout of the unknown are in the order of the rows
+                Field<mesh_t, PetscInt, field_size, field_t::is_soa> global_rows("global_rows", mesh());
+                auto* data = global_rows.array().data();
+                std::iota(data, data + n_rows, this->m_first_global_row);
+                update_ghost_subdomains(global_rows);
+                this->m_owner_rows.assign(data, data + n_rows);
+#endif
+            }
+
+            void sparsity_pattern_off_process(const std::vector<PetscInt>& nnz, std::vector<PetscInt>& o_nnz) const override
+            {
+                // The rows of the cells along the neighbouring subdomains and
+                // of the ghosts computed from them may have columns of other
+                // processes: they are bounded by the number of non-zeros.
+                std::fill(o_nnz.begin(), o_nnz.end(), 0);
+                std::vector<bool> is_cell(o_nnz.size(), false);
+                for_each_cell(mesh(),
+                              [&](const auto& cell)
+                              {
+                                  for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                                  {
+                                      is_cell[static_cast<std::size_t>(row_index(cell, field_i) - m_row_shift)] = true;
+                                  }
+                              });
+                for (std::size_t level = mesh().min_level(); level <= mesh().max_level(); ++level)
+                {
+                    const auto& boundary = unknown().ghost_exchange().boundary(mesh(), level, mesh_t::config::ghost_width);
+                    boundary(
+                        [&](const auto& i, const auto& index, const auto&)
+                        {
+                            for (auto ii = i.start; ii < i.end; ++ii)
+                            {
+                                auto cell_index = static_cast<PetscInt>(mesh().get_index(level, ii, index));
+                                for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                                {
+                                    auto row   = static_cast<std::size_t>(row_index(cell_index, field_i) - m_row_shift);
+                                    o_nnz[row] = nnz[row];
+                                }
+                            }
+                        });
+                }
+                for (std::size_t row = 0; row < o_nnz.size(); ++row)
+                {
+                    if (!is_cell[row] && !this->is_foreign_row(static_cast<PetscInt>(row) + m_row_shift))
+                    {
+                        o_nnz[row] = nnz[row];
+                    }
+                }
             }
 
             auto ghost_recursion()
@@ -160,6 +262,16 @@ namespace samurai
                 return recursion;
             }
 
+            /**
+             * Linear combinations of cells eliminated from the matrix for the
+             * projection and prediction ghosts (empty if the elimination is
+             * disabled).
+             */
+            const auto& ghost_linear_combinations() const
+            {
+                return m_ghost_recursion;
+            }
+
             void set_unknown(field_t& unknown)
             {
                 m_unknown = &unknown;
@@ -186,6 +298,17 @@ namespace samurai
                 return unknown().mesh();
             }
 
+            bool is_mesh_partitioned() const override
+            {
+                return !undefined_unknown() && !mesh().mpi_neighbourhood().empty();
+            }
+
+            /// The rows of the ghosts are identified with the rows of their owner: the system must be square
+            bool supports_distribution() const override
+            {
+                return output_field_size == field_size;
+            }
+
             PetscInt matrix_rows() const override
             {
                 return static_cast<PetscInt>(m_n_cells * output_field_size);
@@ -495,7 +618,7 @@ namespace samurai
                                 }
                                 else
                                 {
-                                    MatSetValue(A, equation_row, col, coeff, INSERT_VALUES);
+                                    this->set_value(A, equation_row, col, coeff, INSERT_VALUES);
                                 }
                                 set_is_row_not_empty(equation_row);
                             }
@@ -613,7 +736,7 @@ namespace samurai
                         }
                         else
                         {
-                            VecSetValue(b, equation_row, coeff * bc_value, INSERT_VALUES);
+                            this->set_value(b, equation_row, coeff * bc_value);
                         }
                     }
                 }
@@ -637,11 +760,13 @@ namespace samurai
                 // std::cout << "set_1_on_diag_for_useless_ghosts of " << this->name() << std::endl;
                 for (std::size_t i = 0; i < m_is_row_empty.size(); i++)
                 {
-                    if (m_is_row_empty[i])
+                    // The rows of the ghosts owned by another process are also set to the identity
+                    PetscInt row = m_row_shift + static_cast<PetscInt>(i);
+                    if (m_is_row_empty[i] || this->is_foreign_row(row))
                     {
                         auto error = MatSetValue(A,
-                                                 m_row_shift + static_cast<PetscInt>(i),
-                                                 m_col_shift + static_cast<PetscInt>(i),
+                                                 this->global_index(row),
+                                                 this->global_index(m_col_shift + static_cast<PetscInt>(i)),
                                                  1,
                                                  INSERT_VALUES);
                         if (error)
@@ -653,13 +778,26 @@ namespace samurai
                 }
             }
 
+            void set_scheme_rows_not_empty() override
+            {
+                for_each_cell(mesh(),
+                              [&](const auto& cell)
+                              {
+                                  for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                                  {
+                                      set_is_row_not_empty(row_index(cell, field_i));
+                                  }
+                              });
+            }
+
             void set_0_for_useless_ghosts(Vec& b) const
             {
                 for (std::size_t i = 0; i < m_is_row_empty.size(); i++)
                 {
-                    if (m_is_row_empty[i])
+                    PetscInt row = m_row_shift + static_cast<PetscInt>(i);
+                    if (m_is_row_empty[i] || this->is_foreign_row(row))
                     {
-                        VecSetValue(b, m_row_shift + static_cast<PetscInt>(i), 0, INSERT_VALUES);
+                        this->set_value(b, row, 0);
                     }
                 }
             }
@@ -676,7 +814,7 @@ namespace samurai
                                   {
                                       for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                                       {
-                                          VecSetValue(b, row_index(ghost, field_i), 0, INSERT_VALUES);
+                                          this->set_value(b, row_index(ghost, field_i), 0);
                                       }
                                   });
                 }
@@ -693,7 +831,7 @@ namespace samurai
                                           {
                                               for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                                               {
-                                                  if constexpr (ghost_elimination_enabled)
+                                                  if (ghost_elimination_enabled())
                                                   {
                                                       nnz[static_cast<std::size_t>(row_index(ghost, field_i))] = static_cast<PetscInt>(
                                                           m_ghost_recursion.at(ghost.index).size());
@@ -719,7 +857,7 @@ namespace samurai
                     {
                         for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                         {
-                            if constexpr (ghost_elimination_enabled)
+                            if (ghost_elimination_enabled())
                             {
                                 nnz[static_cast<std::size_t>(row_index(ghost, field_i))] = static_cast<PetscInt>(
                                     m_ghost_recursion.at(ghost.index).size());
@@ -747,7 +885,7 @@ namespace samurai
                                           {
                                               for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                                               {
-                                                  VecSetValue(b, row_index(ghost, field_i), 0, INSERT_VALUES);
+                                                  this->set_value(b, row_index(ghost, field_i), 0);
                                               }
                                           });
 
@@ -757,7 +895,7 @@ namespace samurai
                                           {
                                               for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                                               {
-                                                  VecSetValue(b, row_index(ghost, field_i), 0, INSERT_VALUES);
+                                                  this->set_value(b, row_index(ghost, field_i), 0);
                                               }
                                           });
             }
@@ -766,7 +904,7 @@ namespace samurai
 
             void assemble_projection([[maybe_unused]] Mat& A) override
             {
-                if constexpr (!ghost_elimination_enabled)
+                if (!ghost_elimination_enabled())
                 {
                     static constexpr PetscInt number_of_children = (1 << dim);
 
@@ -779,10 +917,14 @@ namespace samurai
                             for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                             {
                                 PetscInt ghost_index = row_index(ghost, field_i);
-                                MatSetValue(A, ghost_index, ghost_index, scaling, INSERT_VALUES);
+                                this->set_value(A, ghost_index, ghost_index, scaling, INSERT_VALUES);
                                 for (unsigned int i = 0; i < number_of_children; ++i)
                                 {
-                                    MatSetValue(A, ghost_index, col_index(children[i], field_i), -scaling / number_of_children, INSERT_VALUES);
+                                    this->set_value(A,
+                                                    ghost_index,
+                                                    col_index(children[i], field_i),
+                                                    -scaling / number_of_children,
+                                                    INSERT_VALUES);
                                 }
                                 set_is_row_not_empty(ghost_index);
                             }
@@ -792,7 +934,7 @@ namespace samurai
 
             void assemble_prediction([[maybe_unused]] Mat& A) override
             {
-                if constexpr (!ghost_elimination_enabled)
+                if (!ghost_elimination_enabled())
                 {
                     static_assert(dim >= 1 && dim <= 3, "assemble_prediction() is not implemented for this dimension.");
                     if constexpr (dim == 1)
@@ -847,7 +989,7 @@ namespace samurai
                         for (unsigned int field_i = 0; field_i < field_size; ++field_i)
                         {
                             PetscInt ghost_index = this->row_index(ghost, field_i);
-                            MatSetValue(A, ghost_index, ghost_index, scaling, INSERT_VALUES);
+                            this->set_value(A, ghost_index, ghost_index, scaling, INSERT_VALUES);
 
                             auto ii      = ghost.indices(0);
                             auto ig      = ii >> 1;
@@ -856,7 +998,7 @@ namespace samurai
                             auto interpx = samurai::interp_coeffs<2 * prediction_order + 1>(isign);
 
                             auto parent_index = this->col_index(static_cast<PetscInt>(this->mesh().get_index(ghost.level - 1, ig)), field_i);
-                            MatSetValue(A, ghost_index, parent_index, -scaling, INSERT_VALUES);
+                            this->set_value(A, ghost_index, parent_index, -scaling, INSERT_VALUES);
 
                             for (std::size_t ci = 0; ci < interpx.size(); ++ci)
                             {
@@ -867,7 +1009,7 @@ namespace samurai
                                         static_cast<PetscInt>(
                                             this->mesh().get_index(ghost.level - 1, ig + static_cast<coord_index_t>(ci - prediction_order))),
                                         field_i);
-                                    MatSetValue(A, ghost_index, coarse_cell_index, scaling * value, INSERT_VALUES);
+                                    this->set_value(A, ghost_index, coarse_cell_index, scaling * value, INSERT_VALUES);
                                 }
                             }
                             set_is_row_not_empty(ghost_index);
@@ -912,7 +1054,7 @@ namespace samurai
                         for (unsigned int field_i = 0; field_i < field_size; ++field_i)
                         {
                             PetscInt ghost_index = this->row_index(ghost, field_i);
-                            MatSetValue(A, ghost_index, ghost_index, scaling, INSERT_VALUES);
+                            this->set_value(A, ghost_index, ghost_index, scaling, INSERT_VALUES);
 
                             auto ii      = ghost.indices(0);
                             auto ig      = ii >> 1;
@@ -926,7 +1068,7 @@ namespace samurai
 
                             auto parent_index = this->col_index(static_cast<PetscInt>(this->mesh().get_index(ghost.level - 1, ig, jg)),
                                                                 field_i);
-                            MatSetValue(A, ghost_index, parent_index, -scaling, INSERT_VALUES);
+                            this->set_value(A, ghost_index, parent_index, -scaling, INSERT_VALUES);
 
                             for (std::size_t ci = 0; ci < interpx.size(); ++ci)
                             {
@@ -940,7 +1082,7 @@ namespace samurai
                                                                                      ig + static_cast<coord_index_t>(ci - prediction_order),
                                                                                      jg + static_cast<coord_index_t>(cj - prediction_order))),
                                                                                  field_i);
-                                        MatSetValue(A, ghost_index, coarse_cell_index, scaling * value, INSERT_VALUES);
+                                        this->set_value(A, ghost_index, coarse_cell_index, scaling * value, INSERT_VALUES);
                                     }
                                 }
                             }
@@ -994,7 +1136,7 @@ namespace samurai
                         for (unsigned int field_i = 0; field_i < field_size; ++field_i)
                         {
                             PetscInt ghost_index = this->row_index(ghost, field_i);
-                            MatSetValue(A, ghost_index, ghost_index, scaling, INSERT_VALUES);
+                            this->set_value(A, ghost_index, ghost_index, scaling, INSERT_VALUES);
 
                             auto ii      = ghost.indices(0);
                             auto ig      = ii >> 1;
@@ -1012,7 +1154,7 @@ namespace samurai
 
                             auto parent_index = this->col_index(static_cast<PetscInt>(this->mesh().get_index(ghost.level - 1, ig, jg, kg)),
                                                                 field_i);
-                            MatSetValue(A, ghost_index, parent_index, -scaling, INSERT_VALUES);
+                            this->set_value(A, ghost_index, parent_index, -scaling, INSERT_VALUES);
 
                             for (std::size_t ci = 0; ci < interpx.size(); ++ci)
                             {
@@ -1030,7 +1172,7 @@ namespace samurai
                                                                            jg + static_cast<coord_index_t>(cj - prediction_order),
                                                                            kg + static_cast<coord_index_t>(ck - prediction_order))),
                                                 field_i);
-                                            MatSetValue(A, ghost_index, coarse_cell_index, scaling * value, INSERT_VALUES);
+                                            this->set_value(A, ghost_index, coarse_cell_index, scaling * value, INSERT_VALUES);
                                         }
                                     }
                                 }
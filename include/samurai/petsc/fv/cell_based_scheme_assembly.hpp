@@ -181,13 +181,13 @@ namespace samurai
                         // for (std::size_t i=0; i<scheme_stencil_size; i++)
                         //     std::cout << i << ": " << coeffs[i] << std::endl;
 
-                        // Global rows and columns
+                        // Global rows and columns (over the processes if the matrix is distributed)
                         std::array<PetscInt, cfg_t::scheme_stencil_size * output_field_size> rows;
                         for (unsigned int c = 0; c < cfg_t::scheme_stencil_size; ++c)
                         {
                             for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                             {
-                                rows[local_row_index(c, field_i)] = static_cast<PetscInt>(row_index(cells[c], field_i));
+                                rows[local_row_index(c, field_i)] = this->global_row(row_index(cells[c], field_i));
                             }
                         }
                         std::array<PetscInt, cfg_t::scheme_stencil_size * field_size> cols;
@@ -195,7 +195,7 @@ namespace samurai
                         {
                             for (unsigned int field_j = 0; field_j < field_size; ++field_j)
                             {
-                                cols[local_col_index(c, field_j)] = static_cast<PetscInt>(col_index(cells[c], field_j));
+                                cols[local_col_index(c, field_j)] = this->global_col(col_index(cells[c], field_j));
                             }
                         }
 
@@ -237,7 +237,8 @@ namespace samurai
                             //
                             for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                             {
-                                auto stencil_center_row = static_cast<PetscInt>(row_index(cells[cfg_t::center_index], field_i));
+                                auto local_center_row   = static_cast<PetscInt>(row_index(cells[cfg_t::center_index], field_i));
+                                auto stencil_center_row = this->global_row(local_center_row);
                                 for (unsigned int field_j = 0; field_j < field_size; ++field_j)
                                 {
                                     if constexpr (cfg_t::contiguous_indices_start > 0)
@@ -292,7 +293,7 @@ namespace samurai
                                         }
                                     }
 
-                                    set_is_row_not_empty(stencil_center_row);
+                                    set_is_row_not_empty(local_center_row);
                                 }
                             }
                         }
@@ -322,8 +323,7 @@ namespace samurai
 
                             for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                             {
-                                auto row = rows[local_row_index(cfg_t::center_index, field_i)];
-                                set_is_row_not_empty(row);
+                                set_is_row_not_empty(row_index(cells[cfg_t::center_index], field_i));
                             }
                         }
                     });
@@ -56,48 +56,50 @@ namespace samurai
                 auto& flux_def = scheme().flux_definition();
                 for (std::size_t d = 0; d < dim; ++d)
                 {
-                    for_each_interior_interface(
-                        mesh(),
-                        flux_def[d].direction,
-                        flux_def[d].stencil,
-                        [&](auto& interface_cells, auto& comput_cells)
+                    auto count_interface = [&](auto& interface_cells, auto& comput_cells)
+                    {
+                        for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                         {
-                            for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                            for (unsigned int field_j = 0; field_j < field_size; ++field_j)
                             {
-                                for (unsigned int field_j = 0; field_j < field_size; ++field_j)
+                                if (ghost_elimination_enabled())
                                 {
-                                    if constexpr (ghost_elimination_enabled)
+                                    for (std::size_t c = 0; c < stencil_size; ++c)
                                     {
-                                        for (std::size_t c = 0; c < stencil_size; ++c)
+                                        auto it_ghost = this->m_ghost_recursion.find(comput_cells[c].index);
+                                        if (it_ghost == this->m_ghost_recursion.end())
                                         {
-                                            auto it_ghost = this->m_ghost_recursion.find(comput_cells[c].index);
-                                            if (it_ghost == this->m_ghost_recursion.end())
-                                            {
-                                                nnz[static_cast<std::size_t>(
-                                                    this->row_index(interface_cells[0], field_i))] += static_cast<PetscInt>(field_size);
-                                                nnz[static_cast<std::size_t>(
-                                                    this->row_index(interface_cells[1], field_i))] += static_cast<PetscInt>(field_size);
-                                            }
-                                            else
-                                            {
-                                                auto& linear_comb = it_ghost->second;
-                                                nnz[static_cast<std::size_t>(this->row_index(interface_cells[0], field_i))] += static_cast<PetscInt>(
-                                                    linear_comb.size() * field_size);
-                                                nnz[static_cast<std::size_t>(this->row_index(interface_cells[1], field_i))] += static_cast<PetscInt>(
-                                                    linear_comb.size() * field_size);
-                                            }
+                                            nnz[static_cast<std::size_t>(
+                                                this->row_index(interface_cells[0], field_i))] += static_cast<PetscInt>(field_size);
+                                            nnz[static_cast<std::size_t>(
+                                                this->row_index(interface_cells[1], field_i))] += static_cast<PetscInt>(field_size);
+                                        }
+                                        else
+                                        {
+                                            auto& linear_comb = it_ghost->second;
+                                            nnz[static_cast<std::size_t>(this->row_index(interface_cells[0], field_i))] +=
+                                                static_cast<PetscInt>(linear_comb.size() * field_size);
+                                            nnz[static_cast<std::size_t>(this->row_index(interface_cells[1], field_i))] +=
+                                                static_cast<PetscInt>(linear_comb.size() * field_size);
                                         }
                                     }
-                                    else
-                                    {
-                                        nnz[static_cast<std::size_t>(this->row_index(interface_cells[0], field_i))] += static_cast<PetscInt>(
-                                            stencil_size * field_size);
-                                        nnz[static_cast<std::size_t>(this->row_index(interface_cells[1], field_i))] += static_cast<PetscInt>(
-                                            stencil_size * field_size);
-                                    }
+                                }
+                                else
+                                {
+                                    nnz[static_cast<std::size_t>(this->row_index(interface_cells[0], field_i))] += static_cast<PetscInt>(
+                                        stencil_size * field_size);
+                                    nnz[static_cast<std::size_t>(this->row_index(interface_cells[1], field_i))] += static_cast<PetscInt>(
+                                        stencil_size * field_size);
                                 }
                             }
-                        });
+                        }
+                    };
+                    for_each_interior_interface(mesh(), flux_def[d].direction, flux_def[d].stencil, count_interface);
+                    if (this->is_distributed())
+                    {
+                        // Fluxes between the cells and the cells of the neighbouring subdomains
+                        for_each_subdomain_interface(mesh(), flux_def[d].direction, flux_def[d].stencil, count_interface);
+                    }
 
                     for_each_boundary_interface(
                         mesh(),
@@ -134,69 +136,73 @@ namespace samurai
                 }
 
                 // Interior interfaces
-                scheme().for_each_interior_interface(
-                    mesh(),
-                    [&](auto& interface_cells, auto& comput_cells, auto& left_cell_coeffs, auto& right_cell_coeffs)
+                auto assemble_interface = [&](auto& interface_cells, auto& comput_cells, auto& left_cell_coeffs, auto& right_cell_coeffs)
+                {
+                    for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                     {
-                        for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                        auto left_cell_row  = this->row_index(interface_cells[0], field_i);
+                        auto right_cell_row = this->row_index(interface_cells[1], field_i);
+                        for (unsigned int field_j = 0; field_j < field_size; ++field_j)
                         {
-                            auto left_cell_row  = this->row_index(interface_cells[0], field_i);
-                            auto right_cell_row = this->row_index(interface_cells[1], field_i);
-                            for (unsigned int field_j = 0; field_j < field_size; ++field_j)
+                            for (std::size_t c = 0; c < stencil_size; ++c)
                             {
-                                for (std::size_t c = 0; c < stencil_size; ++c)
-                                {
-                                    double left_cell_coeff  = scheme().cell_coeff(left_cell_coeffs, c, field_i, field_j);
-                                    double right_cell_coeff = scheme().cell_coeff(right_cell_coeffs, c, field_i, field_j);
+                                double left_cell_coeff  = scheme().cell_coeff(left_cell_coeffs, c, field_i, field_j);
+                                double right_cell_coeff = scheme().cell_coeff(right_cell_coeffs, c, field_i, field_j);
 
-                                    if constexpr (ghost_elimination_enabled)
-                                    {
-                                        auto it_ghost = this->m_ghost_recursion.find(comput_cells[c].index);
-                                        if (it_ghost == this->m_ghost_recursion.end())
-                                        {
-                                            auto comput_cell_col = col_index(comput_cells[c], field_j);
-                                            // if (left_cell_coeff != 0)
-                                            // {
-                                            MatSetValue(A, left_cell_row, comput_cell_col, left_cell_coeff, ADD_VALUES);
-                                            // }
-                                            // if (right_cell_coeff != 0)
-                                            // {
-                                            MatSetValue(A, right_cell_row, comput_cell_col, right_cell_coeff, ADD_VALUES);
-                                            // }
-                                            // MatSetValue(A, left_cell_row, left_cell_row, 0, ADD_VALUES);
-                                            // MatSetValue(A, right_cell_row, right_cell_row, 0, ADD_VALUES);
-                                        }
-                                        else
-                                        {
-                                            auto& linear_comb = it_ghost->second;
-                                            for (auto& [cell, coeff] : linear_comb)
-                                            {
-                                                auto comput_cell_col = col_index(static_cast<PetscInt>(cell), field_j);
-                                                MatSetValue(A, left_cell_row, comput_cell_col, left_cell_coeff * coeff, ADD_VALUES);
-                                                MatSetValue(A, right_cell_row, comput_cell_col, right_cell_coeff * coeff, ADD_VALUES);
-                                            }
-                                        }
-                                    }
-                                    else
+                                if (ghost_elimination_enabled())
+                                {
+                                    auto it_ghost = this->m_ghost_recursion.find(comput_cells[c].index);
+                                    if (it_ghost == this->m_ghost_recursion.end())
                                     {
                                         auto comput_cell_col = col_index(comput_cells[c], field_j);
                                         // if (left_cell_coeff != 0)
                                         // {
-                                        MatSetValue(A, left_cell_row, comput_cell_col, left_cell_coeff, ADD_VALUES);
+                                        this->set_value(A, left_cell_row, comput_cell_col, left_cell_coeff, ADD_VALUES);
                                         // }
                                         // if (right_cell_coeff != 0)
                                         // {
-                                        MatSetValue(A, right_cell_row, comput_cell_col, right_cell_coeff, ADD_VALUES);
+                                        this->set_value(A, right_cell_row, comput_cell_col, right_cell_coeff, ADD_VALUES);
                                         // }
                                         // MatSetValue(A, left_cell_row, left_cell_row, 0, ADD_VALUES);
                                         // MatSetValue(A, right_cell_row, right_cell_row, 0, ADD_VALUES);
                                     }
+                                    else
+                                    {
+                                        auto& linear_comb = it_ghost->second;
+                                        for (auto& [cell, coeff] : linear_comb)
+                                        {
+                                            auto comput_cell_col = col_index(static_cast<PetscInt>(cell), field_j);
+                                            this->set_value(A, left_cell_row, comput_cell_col, left_cell_coeff * coeff, ADD_VALUES);
+                                            this->set_value(A, right_cell_row, comput_cell_col, right_cell_coeff * coeff, ADD_VALUES);
+                                        }
+                                    }
+                                }
+                                else
+                                {
+                                    auto comput_cell_col = col_index(comput_cells[c], field_j);
+                                    // if (left_cell_coeff != 0)
+                                    // {
+                                    this->set_value(A, left_cell_row, comput_cell_col, left_cell_coeff, ADD_VALUES);
+                                    // }
+                                    // if (right_cell_coeff != 0)
+                                    // {
+                                    this->set_value(A, right_cell_row, comput_cell_col, right_cell_coeff, ADD_VALUES);
+                                    // }
+                                    // MatSetValue(A, left_cell_row, left_cell_row, 0, ADD_VALUES);
+                                    // MatSetValue(A, right_cell_row, right_cell_row, 0, ADD_VALUES);
                                 }
                             }
-                            set_is_row_not_empty(left_cell_row);
-                            set_is_row_not_empty(right_cell_row);
                         }
-                    });
+                        set_is_row_not_empty(left_cell_row);
+                        set_is_row_not_empty(right_cell_row);
+                    }
+                };
+                scheme().for_each_interior_interface(mesh(), assemble_interface);
+                if (this->is_distributed())
+                {
+                    // The rows of the ghosts are owned by the neighbours: only the rows of the cells are set
+                    scheme().for_each_subdomain_interface(mesh(), assemble_interface);
+                }
 
                 // Boundary interfaces
                 scheme().for_each_boundary_interface(mesh(),
@@ -213,7 +219,7 @@ namespace samurai
                                                                      if (coeff != 0)
                                                                      {
                                                                          auto comput_cell_col = col_index(comput_cells[c], field_j);
-                                                                         MatSetValue(A, cell_row, comput_cell_col, coeff, ADD_VALUES);
+                                                                         this->set_value(A, cell_row, comput_cell_col, coeff, ADD_VALUES);
                                                                      }
                                                                  }
                                                              }
@@ -63,6 +63,11 @@ namespace samurai
                 return *m_sum_scheme;
             }
 
+            auto& mesh() const
+            {
+                return unknown().mesh();
+            }
+
             InsertMode current_insert_mode() const
             {
                 return std::get<0>(m_assembly_ops).current_insert_mode();
@@ -88,6 +93,33 @@ namespace samurai
                          });
             }
 
+            void distribute_if(bool distribute) override
+            {
+                MatrixAssembly::distribute_if(distribute);
+
+                for_each(m_assembly_ops,
+                         [&](auto& op)
+                         {
+                             op.distribute_if(distribute);
+                         });
+            }
+
+            bool is_mesh_partitioned() const override
+            {
+                return std::get<0>(m_assembly_ops).is_mesh_partitioned();
+            }
+
+            bool supports_distribution() const override
+            {
+                bool supports = true;
+                for_each(m_assembly_ops,
+                         [&](const auto& op)
+                         {
+                             supports = supports && op.supports_distribution();
+                         });
+                return supports;
+            }
+
             PetscInt matrix_rows() const override
             {
                 auto rows = std::get<0>(m_assembly_ops).matrix_rows();
@@ -151,6 +183,11 @@ namespace samurai
                 std::get<0>(m_assembly_ops).sparsity_pattern_prediction(nnz);
             }
 
+            void sparsity_pattern_off_process(const std::vector<PetscInt>& nnz, std::vector<PetscInt>& o_nnz) const override
+            {
+                std::get<0>(m_assembly_ops).sparsity_pattern_off_process(nnz, o_nnz);
+            }
+
             void assemble_scheme(Mat& A) override
             {
                 for_each(m_assembly_ops,
@@ -187,6 +224,16 @@ namespace samurai
                 std::get<0>(m_assembly_ops).set_1_on_diag_for_useless_ghosts(A);
             }
 
+            void set_scheme_rows_not_empty() override
+            {
+                std::get<0>(m_assembly_ops).set_scheme_rows_not_empty();
+            }
+
+            const auto& ghost_linear_combinations() const
+            {
+                return std::get<0>(m_assembly_ops).ghost_linear_combinations();
+            }
+
             void set_0_for_all_ghosts(Vec& b) const
             {
                 std::get<0>(m_assembly_ops).set_0_for_all_ghosts(b);
@@ -236,6 +283,8 @@ namespace samurai
                          {
                              op.reset();
                          });
+                // All the schemes share the unknown, hence the global numbering
+                copy_global_numbering(std::get<0>(m_assembly_ops));
             }
         };
 
@@ -4,6 +4,7 @@
 #include "fv/cell_based_scheme_assembly.hpp"
 #include "fv/flux_based_scheme_assembly.hpp"
 #include "fv/operator_sum_assembly.hpp"
+#include "matrix_free.hpp"
 #ifdef ENABLE_MG
 #include "multigrid/petsc/GeometricMultigrid.hpp"
 #else
@@ -158,6 +159,25 @@ namespace samurai
 
           protected:
 
+            /**
+             * Creates the solver again if the assembly is not distributed as
+             * the solver (see MatrixAssembly::distribute_if): the solver is
+             * created before the unknown, hence the mesh, is known.
+             */
+            void update_communicator()
+            {
+                MPI_Comm comm;
+                PetscObjectGetComm(reinterpret_cast<PetscObject>(m_ksp), &comm);
+                int size          = 1;
+                int assembly_size = 1;
+                MPI_Comm_size(comm, &size);
+                MPI_Comm_size(assembly().communicator(), &assembly_size);
+                if (size != assembly_size)
+                {
+                    reset();
+                }
+            }
+
             void prepare_rhs_and_solve(Vec& b, Vec& x)
             {
                 // Update the right-hand side with the boundary conditions stored in the solution field
@@ -166,6 +186,9 @@ namespace samurai
                 assembly().enforce_projection_prediction(b);
                 // Set to zero the right-hand side of the useless ghosts' equations
                 assembly().set_0_for_useless_ghosts(b);
+                // The values of the rows owned by other processes are sent to them
+                VecAssemblyBegin(b);
+                VecAssemblyEnd(b);
                 // VecView(b, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout << std::endl;
                 // assert(check_nan_or_inf(b));
 
@@ -226,7 +249,13 @@ namespace samurai
 
           private:
 
-            bool m_use_samurai_mg = false;
+            bool m_use_samurai_mg      = false;
+            std::size_t m_mesh_version = 0; ///< Version of the mesh of the matrix
+            bool m_refresh_matrix      = false;
+            std::size_t m_pc_reuse     = 0; ///< Number of refreshed matrices solved with the same preconditioner
+            std::size_t m_pc_age       = 0;
+            bool m_matrix_free         = false;
+            std::unique_ptr<MatrixFreeOperator<Scheme>> m_matrix_free_op; ///< Heap-allocated: context of the shell matrix
 #ifdef ENABLE_MG
             GeometricMultigrid<Assembly<Scheme>> _samurai_mg;
 #endif
@@ -239,20 +268,22 @@ namespace samurai
                 _configure_solver();
             }
 
-#ifdef ENABLE_MG
             void destroy_petsc_objects() override
             {
                 base_class::destroy_petsc_objects();
+                // The context of the shell matrix holds PETSc objects too
+                m_matrix_free_op.reset();
+#ifdef ENABLE_MG
                 _samurai_mg.destroy_petsc_objects();
-            }
 #endif
+            }
 
           private:
 
             void _configure_solver()
             {
                 KSP user_ksp;
-                KSPCreate(PETSC_COMM_SELF, &user_ksp);
+                KSPCreate(assembly().communicator(), &user_ksp);
                 KSPSetFromOptions(user_ksp);
                 PC user_pc;
                 KSPGetPC(user_ksp, &user_pc);
@@ -260,10 +291,15 @@ namespace samurai
                 PCGetType(user_pc, &user_pc_type);
 #ifdef ENABLE_MG
                 m_use_samurai_mg = strcmp(user_pc_type, PCMG) == 0;
+                if (m_use_samurai_mg)
+                {
+                    // The multigrid is sequential
+                    assembly().distribute_if(false);
+                }
 #endif
                 KSPDestroy(&user_ksp);
 
-                KSPCreate(PETSC_COMM_SELF, &m_ksp);
+                KSPCreate(assembly().communicator(), &m_ksp);
                 KSPSetFromOptions(m_ksp);
 #ifdef ENABLE_MG
                 if (m_use_samurai_mg)
@@ -310,8 +346,22 @@ namespace samurai
                     assert(false && "Undefined unknown");
                     exit(EXIT_FAILURE);
                 }
-                if (!m_use_samurai_mg)
+                this->update_communicator();
+                if (m_matrix_free)
                 {
+                    assembly().include_scheme_if(false);
+                    if (!m_matrix_free_op)
+                    {
+                        m_matrix_free_op = std::make_unique<MatrixFreeOperator<Scheme>>();
+                    }
+                    m_matrix_free_op->create_matrix(assembly(), m_A);
+                    m_matrix_free_op->assemble_matrix();
+                    PetscObjectSetName(reinterpret_cast<PetscObject>(m_A), "A");
+                    KSPSetOperators(m_ksp, m_A, m_A);
+                }
+                else if (!m_use_samurai_mg)
+                {
+                    assembly().include_scheme_if(true);
                     assembly().create_matrix(m_A);
                     assembly().assemble_matrix(m_A);
                     PetscObjectSetName(reinterpret_cast<PetscObject>(m_A), "A");
@@ -322,18 +372,101 @@ namespace samurai
                     KSPSetOperators(m_ksp, m_A, m_A);
                 }
                 KSPSetUp(m_ksp);
-                m_is_set_up = true;
+                m_is_set_up    = true;
+                m_mesh_version = detail::mesh_version(assembly().mesh());
+                m_pc_age       = 0;
             }
 
-            void solve(const Field& rhs)
+            /**
+             * The values of the matrix are assembled again before each solve
+             * on the same mesh (for a scheme depending on the time step, for
+             * instance). The sparsity pattern is kept: the stencil of the
+             * scheme must not change.
+             */
+            void refresh_matrix_if(bool refresh)
+            {
+                m_refresh_matrix = refresh;
+            }
+
+            /**
+             * The scheme is applied matrix-free (see MatrixFreeOperator): only
+             * the rows of the ghosts are assembled. The preconditioner must
+             * not need the matrix coefficients, except for the diagonal
+             * (e.g. -pc_type jacobi, or -pc_type none). The matrix-free
+             * operator is sequential: the system is not distributed over the
+             * processes. Takes effect at the next setup.
+             */
+            void matrix_free_if(bool matrix_free)
+            {
+                if (matrix_free != m_matrix_free)
+                {
+                    m_matrix_free = matrix_free;
+                    if (matrix_free)
+                    {
+                        assembly().distribute_if(false);
+                    }
+                    // The solver is created again on the communicator of the assembly
+                    this->reset();
+                }
+            }
+
+            bool is_matrix_free() const
+            {
+                return m_matrix_free;
+            }
+
+            /**
+             * The preconditioner is set up again only every nb_solves + 1
+             * refreshed matrices (see refresh_matrix_if()). It is always set
+             * up again when the mesh changes.
+             */
+            void reuse_preconditioner(std::size_t nb_solves)
+            {
+                m_pc_reuse = nb_solves;
+            }
+
+            bool mesh_has_changed()
+            {
+                return detail::mesh_version(assembly().mesh()) != m_mesh_version;
+            }
+
+            /**
+             * Brings the matrix up to date with the mesh of the unknown: the
+             * solver is set up again if the mesh has changed since the last
+             * setup, otherwise only the values are assembled again, if
+             * requested.
+             */
+            void update_matrix()
             {
                 if (!m_is_set_up)
                 {
                     setup();
                 }
-                Vec b = create_petsc_vector_from(rhs);
+                else if (mesh_has_changed())
+                {
+                    this->reset();
+                    setup();
+                }
+                else
+                {
+                    if (m_matrix_free_op)
+                    {
+                        // The assembly of the solver is copied when the solver is moved
+                        m_matrix_free_op->set_assembly(assembly());
+                    }
+                    if (m_refresh_matrix && !m_use_samurai_mg)
+                    {
+                        refresh_matrix_values();
+                    }
+                }
+            }
+
+            void solve(const Field& rhs)
+            {
+                update_matrix();
+                Vec b = create_petsc_vector_from(rhs, assembly().communicator());
                 PetscObjectSetName(reinterpret_cast<PetscObject>(b), "b");
-                Vec x = create_petsc_vector_from(assembly().unknown());
+                Vec x = create_petsc_vector_from(assembly().unknown(), assembly().communicator());
                 this->prepare_rhs_and_solve(b, x);
 
                 VecDestroy(&b);
@@ -345,6 +478,29 @@ namespace samurai
                 set_unknown(unknown);
                 solve(rhs);
             }
+
+          private:
+
+            /// Assembles the values of the matrix in its current sparsity pattern
+            void refresh_matrix_values()
+            {
+                if (m_matrix_free)
+                {
+                    m_matrix_free_op->assemble_matrix();
+                    // The shell matrix is unchanged: tell the preconditioner that its operator has changed
+                    PetscObjectStateIncrease(reinterpret_cast<PetscObject>(m_A));
+                }
+                else
+                {
+                    MatZeroEntries(m_A);
+                    assembly().assemble_matrix(m_A);
+                }
+                KSPSetOperators(m_ksp, m_A, m_A);
+
+                bool reuse_pc = m_pc_age < m_pc_reuse;
+                KSPSetReusePreconditioner(m_ksp, reuse_pc ? PETSC_TRUE : PETSC_FALSE);
+                m_pc_age = reuse_pc ? m_pc_age + 1 : 0;
+            }
         };
 
     } // end namespace petsc
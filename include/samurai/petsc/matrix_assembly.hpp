@@ -1,5 +1,7 @@
 #pragma once
+#include <algorithm>
 #include <petsc.h>
+#include <vector>
 
 namespace samurai
 {
@@ -12,9 +14,11 @@ namespace samurai
             bool m_is_deleted  = false;
             std::string m_name = "(unnamed)";
 
+            bool m_include_scheme                   = true;
             bool m_include_bc                       = true;
             bool m_assemble_proj_pred               = true;
             bool m_set_1_on_diag_for_useless_ghosts = true;
+            bool m_distribute                       = true;
 
           protected:
 
@@ -22,6 +26,11 @@ namespace samurai
             PetscInt m_row_shift = 0;
             PetscInt m_col_shift = 0;
 
+            // Global numbering of the rows over the subdomains (see distribute_if)
+            bool m_is_distributed       = false;
+            PetscInt m_first_global_row = 0;
+            std::vector<PetscInt> m_owner_rows; ///< For each local row, its global index in the process owning its cell
+
           public:
 
             std::string name() const
@@ -34,6 +43,21 @@ namespace samurai
                 m_name = name;
             }
 
+            bool include_scheme() const
+            {
+                return m_include_scheme;
+            }
+
+            /**
+             * If false, the rows of the scheme (cells) are left empty and only
+             * the rows of the ghosts are assembled: the scheme is then applied
+             * matrix-free (see MatrixFreeOperator).
+             */
+            void include_scheme_if(bool include)
+            {
+                m_include_scheme = include;
+            }
+
             bool include_bc() const
             {
                 return m_include_bc;
@@ -64,6 +88,115 @@ namespace samurai
                 m_set_1_on_diag_for_useless_ghosts = value;
             }
 
+            bool distribute() const
+            {
+                return m_distribute;
+            }
+
+            /**
+             * If true (default) and the mesh is partitioned over several
+             * processes (SAMURAI_WITH_MPI), the matrix and the vectors are
+             * distributed over PETSC_COMM_WORLD, provided that the assembly
+             * supports it (see supports_distribution()): each process owns
+             * the rows of its local mesh, cells and ghosts. The ghosts which
+             * are cells of the neighbouring subdomains are identified with
+             * the rows of their owner in the columns, and their own rows are
+             * set to the identity; the fluxes through the interfaces with the
+             * neighbouring subdomains are assembled in the rows of the cells.
+             * Otherwise, each process assembles its own system. The solvers
+             * are created again on communicator() at their setup.
+             */
+            virtual void distribute_if(bool distribute)
+            {
+                m_distribute = distribute;
+            }
+
+            /// True if the mesh of the unknown is partitioned over several processes
+            virtual bool is_mesh_partitioned() const
+            {
+                return false;
+            }
+
+            /// True if the matrix can be distributed over the processes (see distribute_if)
+            virtual bool supports_distribution() const
+            {
+                return false;
+            }
+
+            bool is_distributed() const
+            {
+                return m_is_distributed;
+            }
+
+            /**
+             * True if the matrix will be distributed. Unlike is_distributed(),
+             * it is known before the assembly: the solvers are created on
+             * communicator().
+             */
+            bool must_distribute() const
+            {
+#ifdef SAMURAI_WITH_MPI
+                int size = 1;
+                MPI_Comm_size(PETSC_COMM_WORLD, &size);
+                return size > 1 && m_distribute && !m_is_block && is_mesh_partitioned() && supports_distribution();
+#else
+                return false;
+#endif
+            }
+
+            MPI_Comm communicator() const
+            {
+                return must_distribute() ? PETSC_COMM_WORLD : PETSC_COMM_SELF;
+            }
+
+            /// Global index of a local row in the vectors
+            PetscInt global_index(PetscInt row) const
+            {
+                return m_first_global_row + row;
+            }
+
+            /// Global index of a local row in the matrix, -1 (ignored by PETSc) if it is owned by another process
+            PetscInt global_row(PetscInt row) const
+            {
+                if (!m_is_distributed)
+                {
+                    return row;
+                }
+                auto owner_row = m_owner_rows[static_cast<std::size_t>(row)];
+                return owner_row == global_index(row) ? owner_row : -1;
+            }
+
+            /// Global index of a local column in the matrix, in the process owning its cell
+            PetscInt global_col(PetscInt col) const
+            {
+                return m_is_distributed ? m_owner_rows[static_cast<std::size_t>(col)] : col;
+            }
+
+            bool is_foreign_row(PetscInt row) const
+            {
+                return m_is_distributed && m_owner_rows[static_cast<std::size_t>(row)] != global_index(row);
+            }
+
+            /// Adds or inserts a coefficient at a local row and column of the matrix
+            void set_value(Mat& A, PetscInt row, PetscInt col, PetscScalar value, InsertMode mode) const
+            {
+                MatSetValue(A, global_row(row), global_col(col), value, mode);
+            }
+
+            /// Inserts a value at a local row of a vector
+            void set_value(Vec& v, PetscInt row, PetscScalar value) const
+            {
+                VecSetValue(v, global_index(row), value, INSERT_VALUES);
+            }
+
+            /// Global numbering of the rows computed by another assembly on the same unknown
+            void copy_global_numbering(const MatrixAssembly& other)
+            {
+                m_is_distributed   = other.m_is_distributed;
+                m_first_global_row = other.m_first_global_row;
+                m_owner_rows       = other.m_owner_rows;
+            }
+
             virtual void set_is_block(bool is_block)
             {
                 m_is_block = is_block;
@@ -106,15 +239,18 @@ namespace samurai
                 auto m = matrix_rows();
                 auto n = matrix_cols();
 
-                MatCreate(PETSC_COMM_SELF, &A);
-                MatSetSizes(A, m, n, m, n);
+                MatCreate(communicator(), &A);
+                MatSetSizes(A, m, n, PETSC_DETERMINE, PETSC_DETERMINE);
                 MatSetFromOptions(A);
                 PetscObjectSetName(reinterpret_cast<PetscObject>(A), m_name.c_str());
 
                 // Number of non-zeros per row. 0 by default.
                 std::vector<PetscInt> nnz(static_cast<std::size_t>(m), 0);
 
-                sparsity_pattern_scheme(nnz);
+                if (m_include_scheme)
+                {
+                    sparsity_pattern_scheme(nnz);
+                }
                 if (m_include_bc)
                 {
                     sparsity_pattern_boundary(nnz);
@@ -135,7 +271,25 @@ namespace samurai
                 // }
                 if (!m_is_block)
                 {
-                    MatSeqAIJSetPreallocation(A, PETSC_DEFAULT, nnz.data());
+                    if (m_is_distributed)
+                    {
+                        // nnz is an upper bound of the coefficients in the columns of the process
+                        std::vector<PetscInt> o_nnz(nnz.size(), 0);
+                        sparsity_pattern_off_process(nnz, o_nnz);
+                        // PETSc rejects more non-zeros than columns in each part
+                        PetscInt n_global = 0;
+                        MPI_Allreduce(&n, &n_global, 1, MPIU_INT, MPI_SUM, communicator());
+                        for (std::size_t row = 0; row < nnz.size(); ++row)
+                        {
+                            nnz[row]   = std::min(nnz[row], n);
+                            o_nnz[row] = std::min(o_nnz[row], n_global - n);
+                        }
+                        MatMPIAIJSetPreallocation(A, PETSC_DEFAULT, nnz.data(), PETSC_DEFAULT, o_nnz.data());
+                    }
+                    else
+                    {
+                        MatSeqAIJSetPreallocation(A, PETSC_DEFAULT, nnz.data());
+                    }
                 }
                 // MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
             }
@@ -146,7 +300,14 @@ namespace samurai
              */
             virtual void assemble_matrix(Mat& A)
             {
-                assemble_scheme(A);
+                if (m_include_scheme)
+                {
+                    assemble_scheme(A);
+                }
+                else
+                {
+                    set_scheme_rows_not_empty();
+                }
                 if (m_include_bc)
                 {
                     assemble_boundary_conditions(A);
@@ -236,6 +397,24 @@ namespace samurai
 
             virtual void set_1_on_diag_for_useless_ghosts(Mat& A) = 0;
 
+            /**
+             * @brief Marks the rows of the scheme as used when the scheme is
+             * not assembled, so that they are not taken for useless ghosts.
+             */
+            virtual void set_scheme_rows_not_empty()
+            {
+            }
+
+            /**
+             * @brief Sets, in a distributed matrix, the number of non-zero
+             * coefficients of each row in the columns owned by the other
+             * processes.
+             * @param nnz number of non-zero coefficients of each row.
+             */
+            virtual void sparsity_pattern_off_process(const std::vector<PetscInt>& /*nnz*/, std::vector<PetscInt>& /*o_nnz*/) const
+            {
+            }
+
             virtual void sparsity_pattern_useless_ghosts(std::vector<PetscInt>& nnz)
             {
                 for (std::size_t row = static_cast<std::size_t>(m_row_shift); row < static_cast<std::size_t>(m_row_shift + matrix_rows());
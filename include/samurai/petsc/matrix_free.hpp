@@ -0,0 +1,301 @@
+#pragma once
+#include <memory>
+#include <petsc.h>
+#include <stdexcept>
+
+#include "../algorithm.hpp"
+#include "../static_algorithm.hpp"
+#include "fv/cell_based_scheme_assembly.hpp"
+#include "fv/flux_based_scheme_assembly.hpp"
+#include "fv/operator_sum_assembly.hpp"
+#include "utils.hpp"
+
+namespace samurai
+{
+    namespace petsc
+    {
+        /// True if the Dirichlet conditions of the scheme are eliminated from the system
+        template <class Scheme>
+        struct eliminates_dirichlet
+        {
+            static constexpr bool value = Scheme::bdry_cfg::dirichlet_enfcmt == DirichletEnforcement::Elimination;
+        };
+
+        template <class... Operators>
+        struct eliminates_dirichlet<OperatorSum<Operators...>>
+        {
+            static constexpr bool value = (eliminates_dirichlet<Operators>::value || ...);
+        };
+
+        /**
+         * @class MatrixFreeOperator
+         * Matrix of a linear scheme which is applied without being assembled,
+         * as a PETSc shell matrix.
+         *
+         * The rows of the cells are computed by the explicit scheme applied to
+         * the vector seen as a field: the projection and prediction ghosts are
+         * first computed from the cells, as they are eliminated in the
+         * assembled matrix, the other ghosts are read from the vector. Only the
+         * rows of the ghosts (boundary conditions, useless ghosts) are
+         * assembled, in a matrix without the stencil of the scheme.
+         *
+         * The diagonal (Jacobi, Chebyshev...) is computed by probing: the cells
+         * whose indices are equal modulo 2 * ghost_width + 1 in each direction
+         * do not see each other through the stencil, so that one application
+         * of the scheme gives the diagonal coefficients of all of them. It is
+         * exact on a uniform mesh and approximate where the stencil crosses a
+         * level jump. It costs (2 * ghost_width + 1)^dim * field_size
+         * applications of the scheme and is computed once per matrix.
+         *
+         * The Dirichlet conditions must be enforced by equations (default):
+         * their elimination modifies the rows of the cells, which the scheme
+         * does not see. The operator is sequential.
+         */
+        template <class Scheme>
+        class MatrixFreeOperator
+        {
+          public:
+
+            using assembly_t                        = Assembly<Scheme>;
+            using field_t                           = typename Scheme::field_t;
+            using mesh_t                            = typename field_t::mesh_t;
+            static constexpr std::size_t dim        = field_t::dim;
+            static constexpr std::size_t field_size = field_t::size;
+
+            static_assert(Scheme::cfg_t::output_field_size == field_size,
+                          "The matrix-free operator requires a square system (output_field_size == field_size).");
+            static_assert(Scheme::cfg_t::scheme_type != SchemeType::NonLinear, "The matrix-free operator requires a linear scheme.");
+            static_assert(!eliminates_dirichlet<Scheme>::value,
+                          "The matrix-free operator requires the Dirichlet conditions to be enforced by equations (DirichletEnforcement::Equation).");
+
+          private:
+
+            assembly_t* m_assembly = nullptr;
+            Mat m_ghost_rows       = nullptr; ///< Rows of the ghosts, the rows of the cells are empty
+            Vec m_diagonal         = nullptr;
+            bool m_diagonal_is_set = false;
+            std::unique_ptr<field_t> m_input;
+            std::unique_ptr<field_t> m_output;
+
+          public:
+
+            MatrixFreeOperator() = default;
+
+            // The shell matrix refers to this object
+            MatrixFreeOperator(const MatrixFreeOperator&)            = delete;
+            MatrixFreeOperator& operator=(const MatrixFreeOperator&) = delete;
+            MatrixFreeOperator(MatrixFreeOperator&&)                 = delete;
+            MatrixFreeOperator& operator=(MatrixFreeOperator&&)      = delete;
+
+            ~MatrixFreeOperator()
+            {
+                destroy_petsc_objects();
+            }
+
+            void destroy_petsc_objects()
+            {
+                if (m_ghost_rows)
+                {
+                    MatDestroy(&m_ghost_rows);
+                    m_ghost_rows = nullptr;
+                }
+                if (m_diagonal)
+                {
+                    VecDestroy(&m_diagonal);
+                    m_diagonal = nullptr;
+                }
+                m_diagonal_is_set = false;
+            }
+
+            /**
+             * @brief Creates the shell matrix A on the mesh of the unknown of
+             * the assembly, which must not include the scheme (see
+             * MatrixAssembly::include_scheme_if).
+             */
+            void create_matrix(assembly_t& assembly, Mat& A)
+            {
+                assert(!assembly.include_scheme() && "The scheme must not be assembled in a matrix-free operator");
+                if (assembly.must_distribute())
+                {
+                    throw std::runtime_error("The matrix-free operator is sequential: the assembly must not be distributed (see "
+                                             "MatrixAssembly::distribute_if).");
+                }
+
+                destroy_petsc_objects();
+                m_assembly = &assembly;
+                assembly.create_matrix(m_ghost_rows);
+                m_input  = std::make_unique<field_t>("matrix_free_input", assembly.mesh());
+                m_output = std::make_unique<field_t>("matrix_free_output", assembly.mesh());
+
+                auto n = assembly.matrix_rows();
+                MatCreateShell(PETSC_COMM_SELF, n, n, n, n, this, &A);
+                MatShellSetOperation(A, MATOP_MULT, reinterpret_cast<void (*)(void)>(mult));
+                MatShellSetOperation(A, MATOP_GET_DIAGONAL, reinterpret_cast<void (*)(void)>(get_diagonal));
+            }
+
+            /**
+             * @brief Assembles the rows of the ghosts. The coefficients of the
+             * scheme may have changed: the diagonal is computed again.
+             */
+            void assemble_matrix()
+            {
+                MatZeroEntries(m_ghost_rows);
+                m_assembly->assemble_matrix(m_ghost_rows);
+                m_diagonal_is_set = false;
+            }
+
+            void set_assembly(assembly_t& assembly)
+            {
+                m_assembly = &assembly;
+            }
+
+          private:
+
+            static PetscErrorCode mult(Mat A, Vec x, Vec y)
+            {
+                MatrixFreeOperator* self;
+                MatShellGetContext(A, &self);
+                self->apply(x, y);
+                return 0;
+            }
+
+            static PetscErrorCode get_diagonal(Mat A, Vec d)
+            {
+                MatrixFreeOperator* self;
+                MatShellGetContext(A, &self);
+                if (!self->m_diagonal_is_set)
+                {
+                    self->compute_diagonal();
+                }
+                VecCopy(self->m_diagonal, d);
+                return 0;
+            }
+
+            inline std::size_t data_index(std::size_t cell_index, std::size_t field_i) const
+            {
+                if constexpr (field_t::is_soa)
+                {
+                    return field_i * m_assembly->mesh().nb_cells() + cell_index;
+                }
+                else
+                {
+                    return cell_index * field_size + field_i;
+                }
+            }
+
+            /// Values of the eliminated ghosts computed from the cells
+            void update_ghosts(field_t& f) const
+            {
+                auto* data = f.array().data();
+                for (const auto& [ghost, linear_comb] : m_assembly->ghost_linear_combinations())
+                {
+                    for (std::size_t field_i = 0; field_i < field_size; ++field_i)
+                    {
+                        double value = 0;
+                        for (const auto& [cell, coeff] : linear_comb)
+                        {
+                            value += coeff * data[data_index(static_cast<std::size_t>(cell), field_i)];
+                        }
+                        data[data_index(static_cast<std::size_t>(ghost), field_i)] = value;
+                    }
+                }
+            }
+
+            /// Applies the scheme to m_input (ghosts included) into m_output
+            void apply_scheme()
+            {
+                update_ghosts(*m_input);
+                m_output->fill(0);
+                m_assembly->scheme().apply(*m_output, *m_input);
+            }
+
+            void apply(Vec x, Vec y)
+            {
+                // Rows of the ghosts
+                MatMult(m_ghost_rows, x, y);
+
+                // Rows of the cells
+                copy(x, *m_input);
+                apply_scheme();
+
+                double* y_data;
+                VecGetArray(y, &y_data);
+                const auto* output = m_output->array().data();
+                for_each_cell(m_assembly->mesh(),
+                              [&](const auto& cell)
+                              {
+                                  for (std::size_t field_i = 0; field_i < field_size; ++field_i)
+                                  {
+                                      auto row    = data_index(static_cast<std::size_t>(cell.index), field_i);
+                                      y_data[row] = output[row];
+                                  }
+                              });
+                VecRestoreArray(y, &y_data);
+            }
+
+            template <class CellT>
+            static std::size_t color(const CellT& cell)
+            {
+                constexpr auto n_colors_1d = static_cast<long long>(2 * mesh_t::config::ghost_width + 1);
+
+                std::size_t c = 0;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    auto i       = static_cast<long long>(cell.indices[d]);
+                    auto color_d = ((i % n_colors_1d) + n_colors_1d) % n_colors_1d;
+                    c            = c * static_cast<std::size_t>(n_colors_1d) + static_cast<std::size_t>(color_d);
+                }
+                return c;
+            }
+
+            void compute_diagonal()
+            {
+                constexpr std::size_t n_colors_1d = 2 * static_cast<std::size_t>(mesh_t::config::ghost_width) + 1;
+                constexpr std::size_t n_colors    = ce_pow(n_colors_1d, dim);
+
+                if (!m_diagonal)
+                {
+                    MatCreateVecs(m_ghost_rows, &m_diagonal, nullptr);
+                }
+                // Rows of the ghosts
+                MatGetDiagonal(m_ghost_rows, m_diagonal);
+
+                // Rows of the cells
+                double* diag;
+                VecGetArray(m_diagonal, &diag);
+                auto& mesh  = m_assembly->mesh();
+                auto* input = m_input->array().data();
+                for (std::size_t field_j = 0; field_j < field_size; ++field_j)
+                {
+                    for (std::size_t c = 0; c < n_colors; ++c)
+                    {
+                        m_input->fill(0);
+                        for_each_cell(mesh,
+                                      [&](const auto& cell)
+                                      {
+                                          if (color(cell) == c)
+                                          {
+                                              input[data_index(static_cast<std::size_t>(cell.index), field_j)] = 1;
+                                          }
+                                      });
+                        apply_scheme();
+
+                        const auto* output = m_output->array().data();
+                        for_each_cell(mesh,
+                                      [&](const auto& cell)
+                                      {
+                                          if (color(cell) == c)
+                                          {
+                                              auto row  = data_index(static_cast<std::size_t>(cell.index), field_j);
+                                              diag[row] = output[row];
+                                          }
+                                      });
+                    }
+                }
+                VecRestoreArray(m_diagonal, &diag);
+                m_diagonal_is_set = true;
+            }
+        };
+
+    } // end namespace petsc
+} // end namespace samurai
@@ -1,28 +1,46 @@
 #pragma once
+#include "../numeric/batched_newton.hpp"
 #include "fv/cell_based_scheme_assembly.hpp"
 #include "fv/flux_based_scheme_assembly.hpp"
 #include "fv/operator_sum_assembly.hpp"
 #include "utils.hpp"
 #include <petsc.h>
+#include <vector>
 
 namespace samurai
 {
     namespace petsc
     {
+        /**
+         * Independent local non-linear systems (one per cell) of a
+         * cell-based scheme of stencil size 1, defined by its functions
+         * 'local_scheme_function' and 'local_jacobian_function'.
+         *
+         * The systems are solved by Newton's method, by batches of
+         * newton_batch_width consecutive cells of an interval (see
+         * BatchedNewton), the intervals being shared between the OpenMP
+         * threads: the local functions must be thread safe. The tolerances
+         * are read from the options -snes_atol, -snes_rtol, -snes_stol and
+         * -snes_max_it.
+         */
         template <class Scheme>
         class NonLinearLocalSolvers
         {
-            using scheme_t = Scheme;
-            using field_t  = typename scheme_t::field_t;
-            using mesh_t   = typename field_t::mesh_t;
-            using cell_t   = Cell<mesh_t::dim, typename mesh_t::interval_t>;
+            using scheme_t                          = Scheme;
+            using field_t                           = typename scheme_t::field_t;
+            using mesh_t                            = typename field_t::mesh_t;
+            using mesh_id_t                         = typename mesh_t::mesh_id_t;
+            using cell_t                            = Cell<mesh_t::dim, typename mesh_t::interval_t>;
+            static constexpr std::size_t field_size = field_t::size;
+            static constexpr std::size_t width      = newton_batch_width;
+            using newton_t                          = BatchedNewton<field_size, width>;
 
           protected:
 
             field_t* m_unknown = nullptr;
             scheme_t m_scheme;
-            SNES m_snes = nullptr;
-            Mat m_J     = nullptr;
+            newton_t m_newton;
+            std::size_t m_iterations = 0;
 
             bool m_is_set_up = false;
 
@@ -46,72 +64,15 @@ namespace samurai
                     exit(EXIT_FAILURE);
                 }
 
-                _configure_solver(m_snes);
+                _configure_solver();
             }
 
-            virtual ~NonLinearLocalSolvers()
-            {
-                _destroy_petsc_objects();
-            }
-
-          private:
-
-            void _destroy_petsc_objects()
-            {
-                if (m_J)
-                {
-                    MatDestroy(&m_J);
-                    m_J = nullptr;
-                }
-                if (m_snes)
-                {
-                    SNESDestroy(&m_snes);
-                    m_snes = nullptr;
-                }
-            }
-
-          public:
+            virtual ~NonLinearLocalSolvers() = default;
 
             virtual void destroy_petsc_objects()
             {
-                _destroy_petsc_objects();
-            }
-
-            NonLinearLocalSolvers& operator=(const NonLinearLocalSolvers& other)
-            {
-                if (this != &other)
-                {
-                    this->destroy_petsc_objects();
-                    this->m_unknown   = other.m_unknown;
-                    this->m_snes      = other.m_snes;
-                    this->m_J         = other.m_J;
-                    this->m_is_set_up = other.m_is_set_up;
-                }
-                return *this;
-            }
-
-            NonLinearLocalSolvers& operator=(NonLinearLocalSolvers&& other)
-            {
-                if (this != &other)
-                {
-                    this->destroy_petsc_objects();
-                    this->m_unknown   = other.m_unknown;
-                    this->m_snes      = other.m_snes;
-                    this->m_J         = other.m_J;
-                    this->m_is_set_up = other.m_is_set_up;
-                    other.m_unknown   = nullptr;
-                    other.m_snes      = nullptr; // Prevent SNES destruction when 'other' object is destroyed
-                    other.m_J         = nullptr;
-                    other.m_is_set_up = false;
-                }
-                return *this;
             }
 
-            // SNES& Snes()
-            // {
-            //     return m_snes;
-            // }
-
             bool is_set_up()
             {
                 return m_is_set_up;
@@ -132,30 +93,72 @@ namespace samurai
                 return *m_unknown;
             }
 
-          private:
-
-            static void _configure_solver(SNES& snes)
+            /// Tolerances of the Newton iterations of each cell (see BatchedNewton)
+            void set_tolerances(double atol, double rtol, double stol, std::size_t max_iterations)
             {
-                SNESCreate(PETSC_COMM_SELF, &snes);
-                SNESSetType(snes, SNESNEWTONLS);
-                SNESSetFromOptions(snes);
+                m_newton.atol           = atol;
+                m_newton.rtol           = rtol;
+                m_newton.stol           = stol;
+                m_newton.max_iterations = max_iterations;
             }
 
-          protected:
-
-            // virtual void configure_solver()
-            // {
-            //     _configure_solver();
-            // }
-
           private:
 
-            struct CellContextForPETSc
+            void _configure_solver()
             {
-                scheme_t* scheme;
-                cell_t* cell;
+                PetscReal value;
+                PetscBool is_set;
+                PetscOptionsGetReal(nullptr, nullptr, "-snes_atol", &value, &is_set);
+                if (is_set)
+                {
+                    m_newton.atol = value;
+                }
+                PetscOptionsGetReal(nullptr, nullptr, "-snes_rtol", &value, &is_set);
+                if (is_set)
+                {
+                    m_newton.rtol = value;
+                }
+                PetscOptionsGetReal(nullptr, nullptr, "-snes_stol", &value, &is_set);
+                if (is_set)
+                {
+                    m_newton.stol = value;
+                }
+                PetscInt max_it;
+                PetscOptionsGetInt(nullptr, nullptr, "-snes_max_it", &max_it, &is_set);
+                if (is_set)
+                {
+                    m_newton.max_iterations = static_cast<std::size_t>(max_it);
+                }
+            }
+
+            /// Cells of an interval of the mesh, from the first one
+            struct row_t
+            {
+                cell_t first;
+                std::size_t size;
             };
 
+            std::vector<row_t> rows()
+            {
+                std::vector<row_t> rows;
+                const auto& cells = unknown().mesh()[mesh_id_t::cells];
+                for (std::size_t level = cells.min_level(); level <= cells.max_level(); ++level)
+                {
+                    const auto& lca = cells[level];
+                    typename cell_t::indices_t index;
+                    for (auto it = lca.cbegin(); it != lca.cend(); ++it)
+                    {
+                        for (std::size_t d = 0; d < mesh_t::dim - 1; ++d)
+                        {
+                            index[d + 1] = it.index()[d];
+                        }
+                        index[0] = it->start;
+                        rows.push_back({cell_t{level, index, it->index + it->start}, static_cast<std::size_t>(it->size())});
+                    }
+                }
+                return rows;
+            }
+
           public:
 
             void solve(field_t& rhs)
@@ -168,134 +171,143 @@ namespace samurai
                     exit(EXIT_FAILURE);
                 }
                 static_assert(scheme_t::cfg_t::output_field_size == field_t::size);
-                PetscInt n = field_t::size;
-                MatCreateSeqDense(PETSC_COMM_SELF, n, n, NULL, &m_J);
-
-                Vec b;
-                VecCreateSeq(PETSC_COMM_SELF, n, &b);
-                Vec x;
-                VecCreateSeq(PETSC_COMM_SELF, n, &x);
-
-                for_each_cell(unknown().mesh(),
-                              [&](auto& cell)
-                              {
-                                  CellContextForPETSc ctx = {&m_scheme, &cell};
-
-                                  // Non-linear function
-                                  SNESSetFunction(m_snes, nullptr, PETSC_nonlinear_function, &ctx);
 
-                                  // Jacobian matrix
-                                  SNESSetJacobian(m_snes, m_J, m_J, PETSC_jacobian_function, &ctx);
+                auto& u                = unknown();
+                auto all_rows          = rows();
+                auto n_rows            = static_cast<std::ptrdiff_t>(all_rows.size());
+                bool has_failed        = false;
+                std::size_t iterations = 0;
+                cell_t failed_cell;
 
-                                  copy(rhs, cell, b);
-                                  copy(unknown(), cell, x);
-
-                                  solve_system(m_snes, b, x);
-
-                                  copy(x, unknown(), cell);
-                              });
+#ifdef SAMURAI_WITH_OPENMP
+#pragma omp parallel
+#endif
+                {
+                    // Each thread has its own Newton workspace
+                    newton_t newton = m_newton;
+                    typename newton_t::batch_t batch;
+                    std::array<cell_t, width> cells;
+
+#ifdef SAMURAI_WITH_OPENMP
+#pragma omp for schedule(dynamic) reduction(max : iterations)
+#endif
+                    for (std::ptrdiff_t r = 0; r < n_rows; ++r)
+                    {
+                        const auto& row = all_rows[static_cast<std::size_t>(r)];
+                        for (std::size_t start = 0; start < row.size; start += width)
+                        {
+                            batch.size = std::min(width, row.size - start);
+                            for (std::size_t l = 0; l < batch.size; ++l)
+                            {
+                                cells[l] = row.first;
+                                cells[l].indices[0] += static_cast<typename cell_t::value_t>(start + l);
+                                cells[l].index += static_cast<typename cell_t::index_t>(start + l);
+                                for (std::size_t i = 0; i < field_size; ++i)
+                                {
+                                    batch.x[i][l] = value(u, cells[l], i);
+                                    batch.b[i][l] = value(rhs, cells[l], i);
+                                }
+                            }
+
+                            auto status = newton.solve(
+                                batch,
+                                [&](std::size_t l, const auto& x, auto& fx)
+                                {
+                                    LocalField<field_t> x_field(cells[l], x.data());
+                                    auto f = m_scheme.scheme_definition().local_scheme_function(cells[l], x_field);
+                                    for (std::size_t i = 0; i < field_size; ++i)
+                                    {
+                                        fx[i] = component(f, i);
+                                    }
+                                },
+                                [&](std::size_t l, const auto& x, auto& jac)
+                                {
+                                    LocalField<field_t> x_field(cells[l], x.data());
+                                    auto jac_stencil_coeffs = m_scheme.scheme_definition().local_jacobian_function(cells[l], x_field);
+                                    auto& jac_coeffs        = jac_stencil_coeffs[0]; // local stencil (of size 1)
+                                    for (std::size_t i = 0; i < field_size; ++i)
+                                    {
+                                        for (std::size_t j = 0; j < field_size; ++j)
+                                        {
+                                            jac[i][j] = component(jac_coeffs, i, j);
+                                        }
+                                    }
+                                });
+
+                            if (status != NewtonStatus::Converged)
+                            {
+#ifdef SAMURAI_WITH_OPENMP
+#pragma omp critical
+#endif
+                                {
+                                    has_failed = true;
+                                    auto lane  = static_cast<std::size_t>(
+                                        std::find(newton.not_converged().begin(), newton.not_converged().end(), true)
+                                        - newton.not_converged().begin());
+                                    failed_cell = cells[std::min(lane, batch.size - 1)];
+                                }
+                                break;
+                            }
+                            for (std::size_t l = 0; l < batch.size; ++l)
+                            {
+                                for (std::size_t i = 0; i < field_size; ++i)
+                                {
+                                    value(u, cells[l], i) = batch.x[i][l];
+                                }
+                                iterations = std::max(iterations, batch.iterations[l]);
+                            }
+                        }
+                    }
+                }
+                m_iterations = iterations;
 
-                VecDestroy(&b);
-                VecDestroy(&x);
+                if (has_failed)
+                {
+                    std::cerr << "Divergence of the local non-linear solver in the cell " << failed_cell << std::endl;
+                    assert(false && "Divergence of the solver");
+                    exit(EXIT_FAILURE);
+                }
             }
 
           private:
 
-            static PetscErrorCode PETSC_nonlinear_function(SNES /*snes*/, Vec x, Vec f, void* ctx)
+            template <class Field>
+            static decltype(auto) value(Field& f, const cell_t& cell, [[maybe_unused]] std::size_t i)
             {
-                auto petsc_ctx = reinterpret_cast<CellContextForPETSc*>(ctx);
-                auto& scheme   = *petsc_ctx->scheme;
-                auto& cell     = *petsc_ctx->cell;
-
-                // Wrap a LocalField structure around the data of the Petsc vector x
-                const PetscScalar* x_data;
-                VecGetArrayRead(x, &x_data);
-                LocalField<field_t> x_field(cell, x_data);
-
-                // PetscScalar* f_data;
-                // VecGetArray(f, &f_data);
-                // LocalField<field_t> f_field(cell, f_data);
-
-                // Apply explicit scheme
-                auto f_field = scheme.scheme_definition().local_scheme_function(cell, x_field);
-
-                copy(f_field, f);
-
-                VecRestoreArrayRead(x, &x_data);
-                // VecRestoreArray(f, &f_data);
-                return 0; // PETSC_SUCCESS
+                if constexpr (field_size == 1)
+                {
+                    return f[cell];
+                }
+                else
+                {
+                    return f[cell][i];
+                }
             }
 
-            static PetscErrorCode PETSC_jacobian_function(SNES /*snes*/, Vec x, Mat jac, Mat B, void* ctx)
+            template <class T>
+            static double component(const T& v, [[maybe_unused]] std::size_t i)
             {
-                // Here, jac = B = this.m_J
-
-                auto petsc_ctx = reinterpret_cast<CellContextForPETSc*>(ctx);
-                auto& scheme   = *petsc_ctx->scheme;
-                auto& cell     = *petsc_ctx->cell;
-
-                // Wrap a LocalField structure around the data of the Petsc vector x
-                const PetscScalar* x_data;
-                VecGetArrayRead(x, &x_data);
-                LocalField<field_t> x_field(cell, x_data);
-
-                // Assembly of the Jacobian matrix.
-                // In this case, jac = B, but Petsc recommends we assemble B for more general cases.
-                auto jac_stencil_coeffs = scheme.scheme_definition().local_jacobian_function(cell, x_field);
-                auto& jac_coeffs        = jac_stencil_coeffs[0]; // local stencil (of size 1)
-                if constexpr (field_t::size == 1)
+                if constexpr (field_size == 1)
                 {
-                    MatSetValue(B, 0, 0, jac_coeffs, INSERT_VALUES);
+                    return v;
                 }
                 else
                 {
-                    for (PetscInt i = 0; i < static_cast<PetscInt>(field_t::size); ++i)
-                    {
-                        for (PetscInt j = 0; j < static_cast<PetscInt>(field_t::size); ++j)
-                        {
-                            MatSetValue(B, i, j, jac_coeffs(i, j), INSERT_VALUES);
-                        }
-                    }
-                }
-                PetscObjectSetName(reinterpret_cast<PetscObject>(B), "Jacobian");
-                MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY);
-                MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY);
-                if (jac != B)
-                {
-                    MatAssemblyBegin(jac, MAT_FINAL_ASSEMBLY);
-                    MatAssemblyEnd(jac, MAT_FINAL_ASSEMBLY);
+                    return v(i);
                 }
-
-                // MatView(B, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF));
-                // std::cout << std::endl;
-
-                VecRestoreArrayRead(x, &x_data);
-
-                return 0; // PETSC_SUCCESS
             }
 
-          protected:
-
-            void solve_system(SNES snes, Vec& b, Vec& x)
+            template <class T>
+            static double component(const T& m, [[maybe_unused]] std::size_t i, [[maybe_unused]] std::size_t j)
             {
-                // Solve the system
-                SNESSolve(snes, b, x);
-
-                SNESConvergedReason reason_code;
-                SNESGetConvergedReason(snes, &reason_code);
-                if (reason_code < 0)
+                if constexpr (field_size == 1)
                 {
-                    using namespace std::string_literals;
-                    const char* reason_text;
-                    SNESGetConvergedReasonString(snes, &reason_text);
-                    std::cerr << "Divergence of the non-linear solver ("s + reason_text + ")" << std::endl;
-                    // VecView(b, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF));
-                    // std::cout << std::endl;
-                    // assert(check_nan_or_inf(b));
-                    assert(false && "Divergence of the solver");
-                    exit(EXIT_FAILURE);
+                    return m;
+                }
+                else
+                {
+                    return m(i, j);
                 }
-                // VecView(x, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout << std::endl;
             }
 
           public:
@@ -306,18 +318,16 @@ namespace samurai
                 solve(rhs);
             }
 
+            /// Largest number of Newton iterations over the cells in the last solve
             int iterations()
             {
-                PetscInt n_iterations;
-                SNESGetIterationNumber(m_snes, &n_iterations);
-                return n_iterations;
+                return static_cast<int>(m_iterations);
             }
 
             virtual void reset()
             {
-                destroy_petsc_objects();
                 m_is_set_up = false;
-                _configure_solver(m_snes);
+                _configure_solver();
             }
         };
 
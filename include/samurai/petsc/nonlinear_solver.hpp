@@ -111,7 +111,7 @@ namespace samurai
 
             void _configure_solver()
             {
-                SNESCreate(PETSC_COMM_SELF, &m_snes);
+                SNESCreate(assembly().communicator(), &m_snes);
                 SNESSetType(m_snes, SNESNEWTONLS);
                 SNESSetFromOptions(m_snes);
             }
@@ -139,6 +139,7 @@ namespace samurai
                     assert(false && "Undefined unknown(s)");
                     exit(EXIT_FAILURE);
                 }
+                update_communicator();
 
                 // Non-linear function
                 SNESSetFunction(m_snes, nullptr, PETSC_nonlinear_function, this);
@@ -153,6 +154,21 @@ namespace samurai
 
           private:
 
+            /// Creates the solver again if the assembly is not distributed as the solver (see MatrixAssembly::distribute_if)
+            void update_communicator()
+            {
+                MPI_Comm comm;
+                PetscObjectGetComm(reinterpret_cast<PetscObject>(m_snes), &comm);
+                int size          = 1;
+                int assembly_size = 1;
+                MPI_Comm_size(comm, &size);
+                MPI_Comm_size(assembly().communicator(), &assembly_size);
+                if (size != assembly_size)
+                {
+                    reset();
+                }
+            }
+
             static PetscErrorCode PETSC_nonlinear_function(SNES /*snes*/, Vec x, Vec f, void* ctx)
             {
                 // const char* x_name;
@@ -232,6 +248,9 @@ namespace samurai
                 // assembly().enforce_projection_prediction(b);
                 // Set to zero the right-hand side of the useless ghosts' equations
                 // assembly().set_0_for_useless_ghosts(b);
+                // The values of the rows owned by other processes are sent to them
+                VecAssemblyBegin(b);
+                VecAssemblyEnd(b);
 
                 // VecView(b, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF));
                 // std::cout << std::endl;
@@ -314,8 +333,8 @@ namespace samurai
                 {
                     this->setup();
                 }
-                Vec b = create_petsc_vector_from(rhs);
-                Vec x = create_petsc_vector_from(assembly().unknown());
+                Vec b = create_petsc_vector_from(rhs, assembly().communicator());
+                Vec x = create_petsc_vector_from(assembly().unknown(), assembly().communicator());
                 this->prepare_rhs_and_solve(b, x);
 
                 VecDestroy(&b);
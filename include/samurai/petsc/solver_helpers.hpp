@@ -50,6 +50,10 @@ namespace samurai
 
         /**
          * Solve
+         *
+         * The solver is built for this call only: to solve several times
+         * with the same scheme, keep the solver given by make_solver(), which
+         * only rebuilds its matrix when the mesh changes.
          */
 
         template <class Scheme>
@@ -6,12 +6,26 @@ namespace samurai
 {
     namespace petsc
     {
+        /**
+         * Vector sharing the array of the field, without copy. On a parallel
+         * communicator, the local part of the vector is the local mesh of the
+         * process (see MatrixAssembly::distribute_if).
+         */
         template <class Field>
-        Vec create_petsc_vector_from(Field& f)
+        Vec create_petsc_vector_from(Field& f, MPI_Comm comm = PETSC_COMM_SELF)
         {
             Vec v;
-            auto n = static_cast<PetscInt>(f.mesh().nb_cells() * Field::size);
-            VecCreateSeqWithArray(MPI_COMM_SELF, 1, n, f.array().data(), &v);
+            auto n   = static_cast<PetscInt>(f.mesh().nb_cells() * Field::size);
+            int size = 1;
+            MPI_Comm_size(comm, &size);
+            if (size > 1)
+            {
+                VecCreateMPIWithArray(comm, 1, n, PETSC_DECIDE, f.array().data(), &v);
+            }
+            else
+            {
+                VecCreateSeqWithArray(comm, 1, n, f.array().data(), &v);
+            }
             PetscObjectSetName(reinterpret_cast<PetscObject>(v), f.name().data());
             return v;
         }
@@ -20,7 +34,7 @@ namespace samurai
         void copy(Field& f, Vec& v)
         {
             PetscInt n_vec;
-            VecGetSize(v, &n_vec);
+            VecGetLocalSize(v, &n_vec);
             assert(static_cast<PetscInt>(f.mesh().nb_cells() * Field::size) == n_vec);
 
             double* v_data;
@@ -51,7 +65,7 @@ namespace samurai
             std::size_t n = f.mesh().nb_cells() * Field::size;
 
             PetscInt n_vec;
-            VecGetSize(v, &n_vec);
+            VecGetLocalSize(v, &n_vec);
             assert(static_cast<PetscInt>(n) == n_vec);
 
             const double* arr;
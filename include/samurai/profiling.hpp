@@ -0,0 +1,462 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <string>
+
+#ifdef SAMURAI_WITH_PROFILING
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#ifdef SAMURAI_WITH_MPI
+#include <boost/mpi.hpp>
+#endif
+#endif
+
+/**
+ * Profiling layer of samurai
+ *
+ * When samurai is compiled with SAMURAI_WITH_PROFILING, the scopes marked by
+ * SAMURAI_PROFILE_SCOPE (or between SAMURAI_PROFILE_START and
+ * SAMURAI_PROFILE_STOP) are timed and the SAMURAI_PROFILE_COUNT counters are
+ * accumulated, by name and by level, in each thread. The results of all the
+ * threads (and of all the MPI ranks) are exported by
+ * samurai::profiling::save_json and samurai::profiling::save_chrome_trace.
+ * The names must be string literals: they are recorded without any copy.
+ *
+ * Otherwise, the macros expand to nothing and the export functions do
+ * nothing.
+ */
+#ifdef SAMURAI_WITH_PROFILING
+#define SAMURAI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SAMURAI_PROFILE_CONCAT(a, b)      SAMURAI_PROFILE_CONCAT_IMPL(a, b)
+#define SAMURAI_PROFILE_SCOPE(name)       samurai::profiling::ScopedTimer SAMURAI_PROFILE_CONCAT(samurai_profile_timer_, __LINE__)(name)
+#define SAMURAI_PROFILE_SCOPE_LEVEL(name, level) \
+    samurai::profiling::ScopedTimer SAMURAI_PROFILE_CONCAT(samurai_profile_timer_, __LINE__)(name, level)
+#define SAMURAI_PROFILE_START(timer, name)    samurai::profiling::ScopedTimer timer(name)
+#define SAMURAI_PROFILE_STOP(timer)           timer.stop()
+#define SAMURAI_PROFILE_COUNT(name, level, n) samurai::profiling::Profiler::instance().add_count(name, level, n)
+#else
+#define SAMURAI_PROFILE_SCOPE(name)
+#define SAMURAI_PROFILE_SCOPE_LEVEL(name, level)
+#define SAMURAI_PROFILE_START(timer, name)
+#define SAMURAI_PROFILE_STOP(timer)
+#define SAMURAI_PROFILE_COUNT(name, level, n)
+#endif
+
+namespace samurai::profiling
+{
+    /// Level of the timers and counters which are not attached to a level
+    static constexpr std::size_t no_level = std::numeric_limits<std::size_t>::max();
+
+#ifdef SAMURAI_WITH_PROFILING
+    struct TimerStats
+    {
+        std::size_t count = 0;
+        double total      = 0; ///< In seconds
+        double min        = std::numeric_limits<double>::max();
+        double max        = 0;
+    };
+
+    /// Timed scope kept for the Chrome trace
+    struct TraceEvent
+    {
+        const char* name;
+        std::size_t level;
+        double start;    ///< In microseconds since the creation of the profiler
+        double duration; ///< In microseconds
+    };
+
+    class Profiler
+    {
+      public:
+
+        using key_t = std::pair<std::string, std::size_t>;
+        /// Key of the data of a thread: the names are string literals which
+        /// are compared by address, so that recording does not allocate
+        using raw_key_t = std::pair<const char*, std::size_t>;
+
+        static Profiler& instance();
+
+        Profiler(const Profiler&)            = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        double now() const;
+
+        void add_time(const char* name, std::size_t level, double start, double duration);
+        void add_count(const char* name, std::size_t level, std::size_t n);
+
+        void enable_trace(bool enable = true);
+        void reset();
+
+        std::map<key_t, TimerStats> timers() const;
+        std::map<key_t, std::size_t> counters() const;
+
+        std::string to_json() const;
+        std::string to_chrome_trace() const;
+
+      private:
+
+        /// Data recorded by one thread: no lock is needed to fill it
+        struct ThreadData
+        {
+            std::size_t tid;
+            std::map<raw_key_t, TimerStats> timers;
+            std::map<raw_key_t, std::size_t> counters;
+            std::vector<TraceEvent> events;
+        };
+
+        Profiler();
+
+        ThreadData& thread_data();
+
+        std::chrono::steady_clock::time_point m_origin;
+        std::atomic<bool> m_trace = false;
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<ThreadData>> m_threads;
+    };
+
+    class ScopedTimer
+    {
+      public:
+
+        explicit ScopedTimer(const char* name, std::size_t level = no_level);
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&)            = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        void stop();
+
+      private:
+
+        const char* m_name;
+        std::size_t m_level;
+        double m_start;
+        bool m_running = true;
+    };
+
+    namespace detail
+    {
+        inline int mpi_rank()
+        {
+#ifdef SAMURAI_WITH_MPI
+            boost::mpi::communicator world;
+            return world.rank();
+#else
+            return 0;
+#endif
+        }
+
+        inline std::string level_to_json(std::size_t level)
+        {
+            return level == no_level ? std::string("null") : std::to_string(level);
+        }
+
+        /// Concatenation on the rank 0 of the strings of all the ranks
+        inline std::vector<std::string> gather(const std::string& local)
+        {
+#ifdef SAMURAI_WITH_MPI
+            boost::mpi::communicator world;
+            std::vector<std::string> all;
+            boost::mpi::gather(world, local, all, 0);
+            return all;
+#else
+            return {local};
+#endif
+        }
+
+        inline void write(const std::string& filename, const std::string& content)
+        {
+            if (mpi_rank() == 0)
+            {
+                std::ofstream file(filename);
+                file << content;
+            }
+        }
+
+        /// Add the data of a thread, the same name may have several addresses
+        template <class Stats>
+        inline void merge(std::map<Profiler::key_t, Stats>& dst, const std::map<Profiler::raw_key_t, Stats>& src)
+        {
+            for (const auto& [raw_key, value] : src)
+            {
+                Profiler::key_t key{raw_key.first, raw_key.second};
+                if constexpr (std::is_same_v<Stats, TimerStats>)
+                {
+                    auto& stats = dst[key];
+                    stats.count += value.count;
+                    stats.total += value.total;
+                    stats.min = std::min(stats.min, value.min);
+                    stats.max = std::max(stats.max, value.max);
+                }
+                else
+                {
+                    dst[key] += value;
+                }
+            }
+        }
+    } // namespace detail
+
+    /////////////////////////////
+    // Profiler implementation //
+    /////////////////////////////
+    inline Profiler::Profiler()
+        : m_origin(std::chrono::steady_clock::now())
+    {
+    }
+
+    inline Profiler& Profiler::instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    /// Time in microseconds since the creation of the profiler
+    inline double Profiler::now() const
+    {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_origin).count();
+    }
+
+    inline auto Profiler::thread_data() -> ThreadData&
+    {
+        thread_local ThreadData* data = nullptr;
+        if (data == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_threads.push_back(std::make_unique<ThreadData>());
+            data      = m_threads.back().get();
+            data->tid = m_threads.size() - 1;
+        }
+        return *data;
+    }
+
+    inline void Profiler::add_time(const char* name, std::size_t level, double start, double duration)
+    {
+        auto& data  = thread_data();
+        auto& stats = data.timers[{name, level}];
+        double time = duration * 1e-6;
+        stats.count++;
+        stats.total += time;
+        stats.min = std::min(stats.min, time);
+        stats.max = std::max(stats.max, time);
+        if (m_trace.load(std::memory_order_relaxed))
+        {
+            data.events.push_back({name, level, start, duration});
+        }
+    }
+
+    inline void Profiler::add_count(const char* name, std::size_t level, std::size_t n)
+    {
+        thread_data().counters[{name, level}] += n;
+    }
+
+    /// Keep each timed scope for the Chrome trace (disabled by default since the number of events can be large)
+    inline void Profiler::enable_trace(bool enable)
+    {
+        m_trace.store(enable, std::memory_order_relaxed);
+    }
+
+    /// Clear the recorded data (must not be called in a parallel region)
+    inline void Profiler::reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& data : m_threads)
+        {
+            data->timers.clear();
+            data->counters.clear();
+            data->events.clear();
+        }
+    }
+
+    /// Timers of all the threads of the current rank (must not be called in a parallel region, see to_chrome_trace)
+    inline auto Profiler::timers() const -> std::map<key_t, TimerStats>
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::map<key_t, TimerStats> all;
+        for (const auto& data : m_threads)
+        {
+            detail::merge(all, data->timers);
+        }
+        return all;
+    }
+
+    /// Counters of all the threads of the current rank (must not be called in a parallel region, see to_chrome_trace)
+    inline auto Profiler::counters() const -> std::map<key_t, std::size_t>
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::map<key_t, std::size_t> all;
+        for (const auto& data : m_threads)
+        {
+            detail::merge(all, data->counters);
+        }
+        return all;
+    }
+
+    /// Timers and counters of the current rank as a JSON object (must not be called in a parallel region)
+    inline std::string Profiler::to_json() const
+    {
+        std::ostringstream out;
+        out << fmt::format("{{\"rank\": {}, \"timers\": [", detail::mpi_rank());
+        bool first = true;
+        for (const auto& [key, stats] : timers())
+        {
+            out << (first ? "\n" : ",\n");
+            out << fmt::format(R"(    {{"name": "{}", "level": {}, "count": {}, "total": {}, "min": {}, "max": {}}})",
+                               key.first,
+                               detail::level_to_json(key.second),
+                               stats.count,
+                               stats.total,
+                               stats.min,
+                               stats.max);
+            first = false;
+        }
+        out << "], \"counters\": [";
+        first = true;
+        for (const auto& [key, count] : counters())
+        {
+            out << (first ? "\n" : ",\n");
+            out << fmt::format(R"(    {{"name": "{}", "level": {}, "count": {}}})", key.first, detail::level_to_json(key.second), count);
+            first = false;
+        }
+        out << "]}";
+        return out.str();
+    }
+
+    /**
+     * Timed scopes of the current rank as Chrome trace events (the process is
+     * the MPI rank).
+     *
+     * Must not be called in a parallel region: the mutex only protects the
+     * list of the threads, the data of each thread is recorded without lock.
+     * No timer or counter may be recording in another thread.
+     */
+    inline std::string Profiler::to_chrome_trace() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::ostringstream out;
+        int rank   = detail::mpi_rank();
+        bool first = true;
+        for (const auto& data : m_threads)
+        {
+            for (const auto& event : data->events)
+            {
+                out << (first ? "" : ",\n");
+                out << fmt::format(R"({{"name": "{}", "cat": "samurai", "ph": "X", "ts": {}, "dur": {}, )"
+                                   R"("pid": {}, "tid": {}, "args": {{"level": {}}}}})",
+                                   event.name,
+                                   event.start,
+                                   event.duration,
+                                   rank,
+                                   data->tid,
+                                   detail::level_to_json(event.level));
+                first = false;
+            }
+        }
+        return out.str();
+    }
+
+    ////////////////////////////////
+    // ScopedTimer implementation //
+    ////////////////////////////////
+    inline ScopedTimer::ScopedTimer(const char* name, std::size_t level)
+        : m_name(name)
+        , m_level(level)
+        , m_start(Profiler::instance().now())
+    {
+    }
+
+    inline ScopedTimer::~ScopedTimer()
+    {
+        stop();
+    }
+
+    /// Record the time elapsed since the construction (only once)
+    inline void ScopedTimer::stop()
+    {
+        if (m_running)
+        {
+            auto& profiler = Profiler::instance();
+            profiler.add_time(m_name, m_level, m_start, profiler.now() - m_start);
+            m_running = false;
+        }
+    }
+#endif
+
+    /// Record the events of the timed scopes for save_chrome_trace
+    inline void enable_trace([[maybe_unused]] bool enable = true)
+    {
+#ifdef SAMURAI_WITH_PROFILING
+        Profiler::instance().enable_trace(enable);
+#endif
+    }
+
+    inline void reset()
+    {
+#ifdef SAMURAI_WITH_PROFILING
+        Profiler::instance().reset();
+#endif
+    }
+
+    /**
+     * Save the timers and the counters aggregated by name and by level for
+     * each MPI rank.
+     *
+     * Must be called by all the ranks, outside of any parallel region.
+     */
+    inline void save_json([[maybe_unused]] const std::string& filename)
+    {
+#ifdef SAMURAI_WITH_PROFILING
+        auto all = detail::gather(Profiler::instance().to_json());
+        std::string content = "{\"ranks\": [\n";
+        for (std::size_t r = 0; r < all.size(); ++r)
+        {
+            content += all[r] + (r + 1 < all.size() ? ",\n" : "\n");
+        }
+        content += "]}\n";
+        detail::write(filename, content);
+#endif
+    }
+
+    /**
+     * Save the timed scopes in the Chrome trace event format (to be opened in
+     * chrome://tracing or Perfetto). The trace must have been enabled by
+     * enable_trace.
+     *
+     * Must be called by all the ranks, outside of any parallel region.
+     */
+    inline void save_chrome_trace([[maybe_unused]] const std::string& filename)
+    {
+#ifdef SAMURAI_WITH_PROFILING
+        auto all = detail::gather(Profiler::instance().to_chrome_trace());
+        std::string content = "{\"traceEvents\": [\n";
+        bool first          = true;
+        for (const auto& events : all)
+        {
+            if (!events.empty())
+            {
+                content += (first ? "" : ",\n") + events;
+                first = false;
+            }
+        }
+        content += "\n]}\n";
+        detail::write(filename, content);
+#endif
+    }
+} // namespace samurai::profiling
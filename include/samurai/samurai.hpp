@@ -4,31 +4,94 @@
 #pragma once
 
 #ifdef SAMURAI_WITH_MPI
+#include <stdexcept>
+
 #include <boost/mpi.hpp>
 namespace mpi = boost::mpi;
 #endif
 
 namespace samurai
 {
+#ifdef SAMURAI_WITH_MPI
+    namespace detail
+    {
+        /// MPI resources owned by samurai between initialize() and finalize()
+        struct MPIState
+        {
+            int nb_initializations = 0;
+            bool owns_mpi          = false; ///< MPI was initialized by samurai::initialize
+            MPI_Comm ghost_comm    = MPI_COMM_NULL;
+        };
 
+        inline MPIState& mpi_state()
+        {
+            static MPIState state;
+            return state;
+        }
+
+        /**
+         * Communicator of the ghost exchanges, duplicated from MPI_COMM_WORLD
+         * by samurai::initialize: their messages never match the ones of the
+         * other exchanges, tagged with the ranks, whatever the number of
+         * processes.
+         */
+        inline MPI_Comm ghost_exchange_comm()
+        {
+            MPI_Comm comm = mpi_state().ghost_comm;
+            if (comm == MPI_COMM_NULL)
+            {
+                throw std::runtime_error("samurai::initialize must be called before the ghost exchanges");
+            }
+            return comm;
+        }
+    }
+#endif
+
+    /**
+     * Initializes MPI if it is not already, and creates the communicators of
+     * samurai (collective operation). The calls can be nested: the resources
+     * are released by the matching call to finalize().
+     */
     inline void initialize([[maybe_unused]] int& argc, [[maybe_unused]] char**& argv)
     {
 #ifdef SAMURAI_WITH_MPI
-        MPI_Init(&argc, &argv);
+        auto& state = detail::mpi_state();
+        if (state.nb_initializations++ > 0)
+        {
+            return;
+        }
+        int initialized = 0;
+        MPI_Initialized(&initialized);
+        if (!initialized)
+        {
+            MPI_Init(&argc, &argv);
+            state.owns_mpi = true;
+        }
+        MPI_Comm_dup(MPI_COMM_WORLD, &state.ghost_comm);
 #endif
     }
 
     inline void initialize()
     {
-#ifdef SAMURAI_WITH_MPI
-        MPI_Init(nullptr, nullptr);
-#endif
+        int argc    = 0;
+        char** argv = nullptr;
+        initialize(argc, argv);
     }
 
     inline void finalize()
     {
 #ifdef SAMURAI_WITH_MPI
-        MPI_Finalize();
+        auto& state = detail::mpi_state();
+        if (state.nb_initializations == 0 || --state.nb_initializations > 0)
+        {
+            return;
+        }
+        MPI_Comm_free(&state.ghost_comm);
+        if (state.owns_mpi)
+        {
+            MPI_Finalize();
+            state.owns_mpi = false;
+        }
 #endif
     }
 
@@ -9,7 +9,9 @@
 #include "fv/cell_based/explicit_cell_based_scheme.hpp"
 #include "fv/explicit_operator_sum.hpp"
 #include "fv/flux_based/explicit_flux_based_scheme.hpp"
+#include "fv/local_time_stepping.hpp"
 #include "fv/scheme_operators.hpp"
+#include "runge_kutta.hpp"
 
 #include "fv/operators/convection_lin.hpp"
 #include "fv/operators/convection_nonlin.hpp"
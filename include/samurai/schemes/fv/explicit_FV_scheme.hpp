@@ -1,4 +1,5 @@
 #pragma once
+#include "../../profiling.hpp"
 #include "../explicit_scheme.hpp"
 #include "FV_scheme.hpp"
 
@@ -38,6 +39,8 @@ namespace samurai
 
         auto apply_to(input_field_t& input_field) const
         {
+            SAMURAI_PROFILE_SCOPE("explicit_scheme");
+
             output_field_t output_field(scheme().name() + "(" + input_field.name() + ")", input_field.mesh());
             output_field.fill(0);
 
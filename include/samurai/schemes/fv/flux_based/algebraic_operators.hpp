@@ -3,7 +3,70 @@
 
 namespace samurai
 {
-    template <class cfg, class bdry_cfg>
+    namespace detail
+    {
+        /**
+         * Static flux functor multiplied by a scalar.
+         */
+        template <class Flux, std::size_t output_field_size>
+        struct ScaledFlux
+        {
+            double scalar;
+            Flux flux;
+
+            template <class Cells, class Field>
+            auto operator()(Cells& cells, const Field& field) const -> decltype(flux(cells, field))
+            {
+                auto flux_value = flux(cells, field);
+                flux_value *= scalar;
+                return flux_value;
+            }
+
+            template <class Values, class value_t>
+            auto operator()(const Values& values, std::size_t n, value_t* fluxes) const -> decltype(flux(values, n, fluxes))
+            {
+                flux(values, n, fluxes);
+                for (std::size_t i = 0; i < n * output_field_size; ++i)
+                {
+                    fluxes[i] *= scalar;
+                }
+            }
+        };
+
+        /**
+         * Sum of two static flux functors.
+         */
+        template <class Flux1, class Flux2, std::size_t output_field_size>
+        struct SumFlux
+        {
+            Flux1 flux1;
+            Flux2 flux2;
+
+            template <class Cells, class Field>
+            auto operator()(Cells& cells, const Field& field) const -> decltype(flux1(cells, field))
+            {
+                auto flux_value = flux1(cells, field);
+                flux_value += flux2(cells, field);
+                return flux_value;
+            }
+
+            template <class Values, class value_t>
+            auto operator()(const Values& values, std::size_t n, value_t* fluxes) const
+                -> decltype(flux1(values, n, fluxes), flux2(values, n, fluxes))
+            {
+                thread_local std::vector<value_t> fluxes2;
+                fluxes2.resize(n * output_field_size);
+                flux1(values, n, fluxes);
+                flux2(values, n, fluxes2.data());
+                for (std::size_t i = 0; i < n * output_field_size; ++i)
+                {
+                    fluxes[i] += fluxes2[i];
+                }
+            }
+        };
+    }
+
+    template <class cfg, class bdry_cfg, std::enable_if_t<!has_static_flux_v<cfg>, bool> = true>
     auto operator*(double scalar, const FluxBasedScheme<cfg, bdry_cfg>& scheme)
     {
         static constexpr std::size_t dim = cfg::dim;
@@ -58,10 +121,36 @@ namespace samurai
         return multiplied_scheme;
     }
 
+    /**
+     * Static flux functors: the scalar is stored in the functor of the new scheme.
+     */
+    template <class cfg, class bdry_cfg, std::enable_if_t<has_static_flux_v<cfg>, bool> = true>
+    auto operator*(double scalar, const FluxBasedScheme<cfg, bdry_cfg>& scheme)
+    {
+        using flux_t     = detail::ScaledFlux<typename cfg::flux_t, cfg::output_field_size>;
+        using scaled_cfg = StaticFluxConfig<cfg, flux_t>;
+
+        FluxDefinition<scaled_cfg> flux_definition(
+            [&](std::size_t d)
+            {
+                return flux_t{scalar, scheme.flux_definition()[d].cons_flux_function};
+            });
+        for (std::size_t d = 0; d < cfg::dim; ++d)
+        {
+            flux_definition[d].direction = scheme.flux_definition()[d].direction;
+            flux_definition[d].stencil   = scheme.flux_definition()[d].stencil;
+        }
+
+        FluxBasedScheme<scaled_cfg, bdry_cfg> multiplied_scheme(flux_definition);
+        multiplied_scheme.is_spd(scheme.is_spd() && scalar != 0);
+        multiplied_scheme.set_name(std::to_string(scalar) + " * " + scheme.name());
+        return multiplied_scheme;
+    }
+
     /**
      * Binary '+' operator if same config
      */
-    template <class cfg, class bdry_cfg>
+    template <class cfg, class bdry_cfg, std::enable_if_t<!has_static_flux_v<cfg>, bool> = true>
     FluxBasedScheme<cfg, bdry_cfg> operator+(const FluxBasedScheme<cfg, bdry_cfg>& scheme1, const FluxBasedScheme<cfg, bdry_cfg>& scheme2)
     {
         FluxBasedScheme<cfg, bdry_cfg> sum_scheme(scheme1); // copy
@@ -116,6 +205,32 @@ namespace samurai
         return sum_scheme;
     }
 
+    /**
+     * Binary '+' operator for static flux functors, if same config.
+     * The functors of both schemes are stored in the functor of the new scheme.
+     */
+    template <class cfg, class bdry_cfg, std::enable_if_t<has_static_flux_v<cfg>, bool> = true>
+    auto operator+(const FluxBasedScheme<cfg, bdry_cfg>& scheme1, const FluxBasedScheme<cfg, bdry_cfg>& scheme2)
+    {
+        using flux_t  = detail::SumFlux<typename cfg::flux_t, typename cfg::flux_t, cfg::output_field_size>;
+        using sum_cfg = StaticFluxConfig<cfg, flux_t>;
+
+        FluxDefinition<sum_cfg> flux_definition(
+            [&](std::size_t d)
+            {
+                return flux_t{scheme1.flux_definition()[d].cons_flux_function, scheme2.flux_definition()[d].cons_flux_function};
+            });
+        for (std::size_t d = 0; d < cfg::dim; ++d)
+        {
+            flux_definition[d].direction = scheme1.flux_definition()[d].direction;
+            flux_definition[d].stencil   = scheme1.flux_definition()[d].stencil;
+        }
+
+        FluxBasedScheme<sum_cfg, bdry_cfg> sum_scheme(flux_definition);
+        sum_scheme.set_name(scheme1.name() + " + " + scheme2.name());
+        return sum_scheme;
+    }
+
     template <class cfg, class bdry_cfg>
     auto operator-(const FluxBasedScheme<cfg, bdry_cfg>& scheme)
     {
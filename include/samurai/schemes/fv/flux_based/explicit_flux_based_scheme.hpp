@@ -129,6 +129,8 @@ namespace samurai
 
         void apply(output_field_t& output_field, input_field_t& input_field) const override
         {
+            // The contributions on both sides of the interfaces do not race:
+            // see for_each_interior_interface___same_level___by_interval()
             static constexpr bool parallel = true;
 
             // Interior interfaces
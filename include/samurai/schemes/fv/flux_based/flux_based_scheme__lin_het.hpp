@@ -77,8 +77,27 @@ namespace samurai
         template <class Func>
         void for_each_interior_interface(const mesh_t& mesh, Func&& apply_coeffs) const
         {
-            auto min_level = mesh[mesh_id_t::cells].min_level();
-            auto max_level = mesh[mesh_id_t::cells].max_level();
+            for_each_interface<false>(mesh, std::forward<Func>(apply_coeffs));
+        }
+
+        /**
+         * Iterates for each interface between the cells and the cells of the neighbouring subdomains
+         * (see samurai::for_each_subdomain_interface()) and returns (in lambda parameters) the scheme coefficients.
+         */
+        template <class Func>
+        void for_each_subdomain_interface(const mesh_t& mesh, Func&& apply_coeffs) const
+        {
+            for_each_interface<true>(mesh, std::forward<Func>(apply_coeffs));
+        }
+
+      private:
+
+        template <bool across_subdomains, class Func>
+        void for_each_interface(const mesh_t& mesh, Func&& apply_coeffs) const
+        {
+            // The neighbouring subdomains may have levels that the subdomain does not have
+            auto min_level = across_subdomains ? mesh.min_level() : mesh[mesh_id_t::cells].min_level();
+            auto max_level = across_subdomains ? mesh.max_level() : mesh[mesh_id_t::cells].max_level();
 
             for (std::size_t d = 0; d < dim; ++d)
             {
@@ -89,18 +108,21 @@ namespace samurai
                 {
                     auto h = cell_length(level);
 
-                    for_each_interior_interface___same_level(
-                        mesh,
-                        level,
-                        flux_def.direction,
-                        flux_def.stencil,
-                        [&](auto& interface_cells, auto& comput_cells)
-                        {
-                            auto flux_coeffs                               = flux_def.cons_flux_function(comput_cells);
-                            auto left_cell_contrib                         = contribution(flux_coeffs, h, h);
-                            decltype(left_cell_contrib) right_cell_contrib = -left_cell_contrib;
-                            apply_coeffs(interface_cells, comput_cells, left_cell_contrib, right_cell_contrib);
-                        });
+                    auto apply = [&](auto& interface_cells, auto& comput_cells)
+                    {
+                        auto flux_coeffs                               = flux_def.cons_flux_function(comput_cells);
+                        auto left_cell_contrib                         = contribution(flux_coeffs, h, h);
+                        decltype(left_cell_contrib) right_cell_contrib = -left_cell_contrib;
+                        apply_coeffs(interface_cells, comput_cells, left_cell_contrib, right_cell_contrib);
+                    };
+                    if constexpr (across_subdomains)
+                    {
+                        for_each_subdomain_interface___same_level(mesh, level, flux_def.direction, flux_def.stencil, apply);
+                    }
+                    else
+                    {
+                        for_each_interior_interface___same_level(mesh, level, flux_def.direction, flux_def.stencil, apply);
+                    }
                 }
 
                 // Level jumps (level -- level+1)
@@ -114,43 +136,59 @@ namespace samurai
                     //    --------->
                     //    direction
                     {
-                        for_each_interior_interface___level_jump_direction(
-                            mesh,
-                            level,
-                            flux_def.direction,
-                            flux_def.stencil,
-                            [&](auto& interface_cells, auto& comput_cells)
-                            {
-                                auto flux_coeffs                        = flux_def.cons_flux_function(comput_cells);
-                                decltype(flux_coeffs) minus_flux_coeffs = -flux_coeffs;
-                                auto left_cell_contrib                  = contribution(flux_coeffs, h_lp1, h_l);
-                                auto right_cell_contrib                 = contribution(minus_flux_coeffs, h_lp1, h_lp1);
-                                apply_coeffs(interface_cells, comput_cells, left_cell_contrib, right_cell_contrib);
-                            });
+                        auto apply = [&](auto& interface_cells, auto& comput_cells)
+                        {
+                            auto flux_coeffs                        = flux_def.cons_flux_function(comput_cells);
+                            decltype(flux_coeffs) minus_flux_coeffs = -flux_coeffs;
+                            auto left_cell_contrib                  = contribution(flux_coeffs, h_lp1, h_l);
+                            auto right_cell_contrib                 = contribution(minus_flux_coeffs, h_lp1, h_lp1);
+                            apply_coeffs(interface_cells, comput_cells, left_cell_contrib, right_cell_contrib);
+                        };
+                        if constexpr (across_subdomains)
+                        {
+                            for_each_subdomain_interface___level_jump_direction(mesh, level, flux_def.direction, flux_def.stencil, apply);
+                        }
+                        else
+                        {
+                            for_each_interior_interface___level_jump_direction(mesh, level, flux_def.direction, flux_def.stencil, apply);
+                        }
                     }
                     //    |__|        l+1
                     //       |____|   l
                     //    --------->
                     //    direction
                     {
-                        for_each_interior_interface___level_jump_opposite_direction(
-                            mesh,
-                            level,
-                            flux_def.direction,
-                            flux_def.stencil,
-                            [&](auto& interface_cells, auto& comput_cells)
-                            {
-                                auto flux_coeffs                        = flux_def.cons_flux_function(comput_cells);
-                                decltype(flux_coeffs) minus_flux_coeffs = -flux_coeffs;
-                                auto left_cell_contrib                  = contribution(flux_coeffs, h_lp1, h_lp1);
-                                auto right_cell_contrib                 = contribution(minus_flux_coeffs, h_lp1, h_l);
-                                apply_coeffs(interface_cells, comput_cells, left_cell_contrib, right_cell_contrib);
-                            });
+                        auto apply = [&](auto& interface_cells, auto& comput_cells)
+                        {
+                            auto flux_coeffs                        = flux_def.cons_flux_function(comput_cells);
+                            decltype(flux_coeffs) minus_flux_coeffs = -flux_coeffs;
+                            auto left_cell_contrib                  = contribution(flux_coeffs, h_lp1, h_lp1);
+                            auto right_cell_contrib                 = contribution(minus_flux_coeffs, h_lp1, h_l);
+                            apply_coeffs(interface_cells, comput_cells, left_cell_contrib, right_cell_contrib);
+                        };
+                        if constexpr (across_subdomains)
+                        {
+                            for_each_subdomain_interface___level_jump_opposite_direction(mesh,
+                                                                                         level,
+                                                                                         flux_def.direction,
+                                                                                         flux_def.stencil,
+                                                                                         apply);
+                        }
+                        else
+                        {
+                            for_each_interior_interface___level_jump_opposite_direction(mesh,
+                                                                                        level,
+                                                                                        flux_def.direction,
+                                                                                        flux_def.stencil,
+                                                                                        apply);
+                        }
                     }
                 }
             }
         }
 
+      public:
+
         /**
          * Iterates for each boundary interface and returns (in lambda parameters) the scheme coefficients.
          */
@@ -77,8 +77,27 @@ namespace samurai
         template <class Func>
         void for_each_interior_interface(const mesh_t& mesh, Func&& apply_coeffs) const
         {
-            auto min_level = mesh[mesh_id_t::cells].min_level();
-            auto max_level = mesh[mesh_id_t::cells].max_level();
+            for_each_interface<false>(mesh, std::forward<Func>(apply_coeffs));
+        }
+
+        /**
+         * Iterates for each interface between the cells and the cells of the neighbouring subdomains
+         * (see samurai::for_each_subdomain_interface()) and returns (in lambda parameters) the scheme coefficients.
+         */
+        template <class Func>
+        void for_each_subdomain_interface(const mesh_t& mesh, Func&& apply_coeffs) const
+        {
+            for_each_interface<true>(mesh, std::forward<Func>(apply_coeffs));
+        }
+
+      private:
+
+        template <bool across_subdomains, class Func>
+        void for_each_interface(const mesh_t& mesh, Func&& apply_coeffs) const
+        {
+            // The neighbouring subdomains may have levels that the subdomain does not have
+            auto min_level = across_subdomains ? mesh.min_level() : mesh[mesh_id_t::cells].min_level();
+            auto max_level = across_subdomains ? mesh.max_level() : mesh[mesh_id_t::cells].max_level();
 
             for (std::size_t d = 0; d < dim; ++d)
             {
@@ -93,15 +112,18 @@ namespace samurai
                     auto left_cell_coeffs                        = contribution(flux_coeffs, h, h);
                     decltype(left_cell_coeffs) right_cell_coeffs = -left_cell_coeffs;
 
-                    for_each_interior_interface___same_level(
-                        mesh,
-                        level,
-                        flux_def.direction,
-                        flux_def.stencil,
-                        [&](auto& interface_cells, auto& comput_cells)
-                        {
-                            apply_coeffs(interface_cells, comput_cells, left_cell_coeffs, right_cell_coeffs);
-                        });
+                    auto apply = [&](auto& interface_cells, auto& comput_cells)
+                    {
+                        apply_coeffs(interface_cells, comput_cells, left_cell_coeffs, right_cell_coeffs);
+                    };
+                    if constexpr (across_subdomains)
+                    {
+                        for_each_subdomain_interface___same_level(mesh, level, flux_def.direction, flux_def.stencil, apply);
+                    }
+                    else
+                    {
+                        for_each_interior_interface___same_level(mesh, level, flux_def.direction, flux_def.stencil, apply);
+                    }
                 }
 
                 // Level jumps (level -- level+1)
@@ -120,15 +142,18 @@ namespace samurai
                         auto left_cell_coeffs  = contribution(flux_coeffs, h_lp1, h_l);
                         auto right_cell_coeffs = contribution(minus_flux_coeffs, h_lp1, h_lp1);
 
-                        for_each_interior_interface___level_jump_direction(
-                            mesh,
-                            level,
-                            flux_def.direction,
-                            flux_def.stencil,
-                            [&](auto& interface_cells, auto& comput_cells)
-                            {
-                                apply_coeffs(interface_cells, comput_cells, left_cell_coeffs, right_cell_coeffs);
-                            });
+                        auto apply = [&](auto& interface_cells, auto& comput_cells)
+                        {
+                            apply_coeffs(interface_cells, comput_cells, left_cell_coeffs, right_cell_coeffs);
+                        };
+                        if constexpr (across_subdomains)
+                        {
+                            for_each_subdomain_interface___level_jump_direction(mesh, level, flux_def.direction, flux_def.stencil, apply);
+                        }
+                        else
+                        {
+                            for_each_interior_interface___level_jump_direction(mesh, level, flux_def.direction, flux_def.stencil, apply);
+                        }
                     }
                     //    |__|        l+1
                     //       |____|   l
@@ -138,20 +163,33 @@ namespace samurai
                         auto left_cell_coeffs  = contribution(flux_coeffs, h_lp1, h_lp1);
                         auto right_cell_coeffs = contribution(minus_flux_coeffs, h_lp1, h_l);
 
-                        for_each_interior_interface___level_jump_opposite_direction(
-                            mesh,
-                            level,
-                            flux_def.direction,
-                            flux_def.stencil,
-                            [&](auto& interface_cells, auto& comput_cells)
-                            {
-                                apply_coeffs(interface_cells, comput_cells, left_cell_coeffs, right_cell_coeffs);
-                            });
+                        auto apply = [&](auto& interface_cells, auto& comput_cells)
+                        {
+                            apply_coeffs(interface_cells, comput_cells, left_cell_coeffs, right_cell_coeffs);
+                        };
+                        if constexpr (across_subdomains)
+                        {
+                            for_each_subdomain_interface___level_jump_opposite_direction(mesh,
+                                                                                         level,
+                                                                                         flux_def.direction,
+                                                                                         flux_def.stencil,
+                                                                                         apply);
+                        }
+                        else
+                        {
+                            for_each_interior_interface___level_jump_opposite_direction(mesh,
+                                                                                        level,
+                                                                                        flux_def.direction,
+                                                                                        flux_def.stencil,
+                                                                                        apply);
+                        }
                     }
                 }
             }
         }
 
+      public:
+
         /**
          * Iterates for each boundary interface and returns (in lambda parameters) the scheme coefficients.
          */
@@ -52,13 +52,84 @@ namespace samurai
             return m_flux_definition;
         }
 
-        flux_value_t contribution(const flux_value_t& flux_value, double h_face, double h_cell) const
+        static double contribution_factor(double h_face, double h_cell)
         {
             double face_measure = pow(h_face, dim - 1);
             double cell_measure = pow(h_cell, dim);
-            return (face_measure / cell_measure) * flux_value;
+            return face_measure / cell_measure;
         }
 
+        flux_value_t contribution(const flux_value_t& flux_value, double h_face, double h_cell) const
+        {
+            return contribution_factor(h_face, h_cell) * flux_value;
+        }
+
+      private:
+
+        /**
+         * @returns the function computing the fluxes in the positive and negative directions.
+         */
+        static auto get_flux_function(const flux_computation_t& flux_def)
+        {
+            if constexpr (has_static_flux_v<cfg>)
+            {
+                return [&flux_def](auto& cells, const auto& field)
+                {
+                    return flux_def.flux_values(cells, field);
+                };
+            }
+            else
+            {
+                return flux_def.flux_function ? flux_def.flux_function : flux_def.flux_function_as_conservative();
+            }
+        }
+
+        /**
+         * Same-level interfaces with a static flux functor:
+         * the flux is evaluated on whole intervals of interfaces (see NormalFluxDefinition::cons_flux_on_interval).
+         */
+        template <bool parallel, class Func>
+        void for_each_interior_interface___same_level___static(input_field_t& field,
+                                                               const flux_computation_t& flux_def,
+                                                               std::size_t level,
+                                                               Func&& apply_contrib) const
+        {
+            double factor = contribution_factor(cell_length(level), cell_length(level));
+
+            for_each_interior_interface___same_level___by_interval<parallel>(
+                field.mesh(),
+                level,
+                flux_def.direction,
+                flux_def.stencil,
+                [&](auto& interface_cells, auto& comput_cells, std::size_t n)
+                {
+                    thread_local std::vector<field_value_type> fluxes;
+                    fluxes.resize(n * output_field_size);
+                    flux_def.cons_flux_on_interval(comput_cells, n, field, fluxes.data());
+
+                    for (std::size_t ii = 0; ii < n; ++ii)
+                    {
+                        flux_value_t left_cell_contrib;
+                        if constexpr (output_field_size == 1)
+                        {
+                            left_cell_contrib = factor * fluxes[ii];
+                        }
+                        else
+                        {
+                            for (std::size_t field_i = 0; field_i < output_field_size; ++field_i)
+                            {
+                                left_cell_contrib(field_i) = factor * fluxes[ii * output_field_size + field_i];
+                            }
+                        }
+                        flux_value_t right_cell_contrib = -left_cell_contrib;
+                        apply_contrib(interface_cells, left_cell_contrib, right_cell_contrib);
+                        move_next(interface_cells);
+                    }
+                });
+        }
+
+      public:
+
         inline field_value_type flux_value_cmpnent(const flux_value_t& flux_value, [[maybe_unused]] std::size_t field_i) const
         {
             if constexpr (output_field_size == 1)
@@ -86,69 +157,40 @@ namespace samurai
             {
                 auto& flux_def = flux_definition()[d];
 
-                auto flux_function = flux_def.flux_function ? flux_def.flux_function : flux_def.flux_function_as_conservative();
+                auto flux_function = get_flux_function(flux_def);
 
                 // Same level
                 for (std::size_t level = min_level; level <= max_level; ++level)
                 {
-                    auto h = cell_length(level);
-
-                    for_each_interior_interface___same_level<parallel>(
-                        mesh,
-                        level,
-                        flux_def.direction,
-                        flux_def.stencil,
-                        [&](auto& interface_cells, auto& comput_cells)
-                        {
-                            auto flux_values        = flux_function(comput_cells, field);
-                            auto left_cell_contrib  = contribution(flux_values[0], h, h);
-                            auto right_cell_contrib = contribution(flux_values[1], h, h);
-                            apply_contrib(interface_cells, left_cell_contrib, right_cell_contrib);
-                        });
+                    interior_interfaces___same_level<parallel>(field, flux_def, flux_function, level, apply_contrib);
                 }
 
                 // Level jumps (level -- level+1)
                 for (std::size_t level = min_level; level < max_level; ++level)
                 {
-                    auto h_l   = cell_length(level);
-                    auto h_lp1 = cell_length(level + 1);
+                    interior_interfaces___level_jump(field, flux_def, flux_function, level, apply_contrib);
+                }
+            }
+        }
 
-                    //         |__|   l+1
-                    //    |____|      l
-                    //    --------->
-                    //    direction
-                    {
-                        for_each_interior_interface___level_jump_direction(
-                            mesh,
-                            level,
-                            flux_def.direction,
-                            flux_def.stencil,
-                            [&](auto& interface_cells, auto& comput_cells)
-                            {
-                                auto flux_values        = flux_function(comput_cells, field);
-                                auto left_cell_contrib  = contribution(flux_values[0], h_lp1, h_l);
-                                auto right_cell_contrib = contribution(flux_values[1], h_lp1, h_lp1);
-                                apply_contrib(interface_cells, left_cell_contrib, right_cell_contrib);
-                            });
-                    }
-                    //    |__|        l+1
-                    //       |____|   l
-                    //    --------->
-                    //    direction
-                    {
-                        for_each_interior_interface___level_jump_opposite_direction(
-                            mesh,
-                            level,
-                            flux_def.direction,
-                            flux_def.stencil,
-                            [&](auto& interface_cells, auto& comput_cells)
-                            {
-                                auto flux_values        = flux_function(comput_cells, field);
-                                auto left_cell_contrib  = contribution(flux_values[0], h_lp1, h_lp1);
-                                auto right_cell_contrib = contribution(flux_values[1], h_lp1, h_l);
-                                apply_contrib(interface_cells, left_cell_contrib, right_cell_contrib);
-                            });
-                    }
+        /**
+         * Same as the preceding function, restricted to the interfaces whose
+         * finest cell is at @p level: the interfaces of same level and the
+         * level jumps (level-1 -- level).
+         */
+        template <bool parallel = false, class Func>
+        void for_each_interior_interface(input_field_t& field, std::size_t level, Func&& apply_contrib) const
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                auto& flux_def = flux_definition()[d];
+
+                auto flux_function = get_flux_function(flux_def);
+
+                interior_interfaces___same_level<parallel>(field, flux_def, flux_function, level, apply_contrib);
+                if (level > 0)
+                {
+                    interior_interfaces___level_jump(field, flux_def, flux_function, level - 1, apply_contrib);
                 }
             }
         }
@@ -164,40 +206,150 @@ namespace samurai
             {
                 auto& flux_def = flux_definition()[d];
 
-                auto flux_function = flux_def.flux_function ? flux_def.flux_function : flux_def.flux_function_as_conservative();
+                auto flux_function = get_flux_function(flux_def);
+
+                for_each_level(mesh,
+                               [&](auto level)
+                               {
+                                   boundary_interfaces<parallel>(field, flux_def, flux_function, level, apply_contrib);
+                               });
+            }
+        }
 
-                for_each_level(
+        /**
+         * Same as the preceding function, restricted to the cells of @p level.
+         */
+        template <bool parallel = false, class Func>
+        void for_each_boundary_interface(input_field_t& field, std::size_t level, Func&& apply_contrib) const
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                auto& flux_def = flux_definition()[d];
+
+                auto flux_function = get_flux_function(flux_def);
+
+                boundary_interfaces<parallel>(field, flux_def, flux_function, level, apply_contrib);
+            }
+        }
+
+      private:
+
+        template <bool parallel, class FluxFunction, class Func>
+        void interior_interfaces___same_level(input_field_t& field,
+                                              const flux_computation_t& flux_def,
+                                              [[maybe_unused]] FluxFunction& flux_function,
+                                              std::size_t level,
+                                              Func&& apply_contrib) const
+        {
+            if constexpr (has_static_flux_v<cfg>)
+            {
+                for_each_interior_interface___same_level___static<parallel>(field, flux_def, level, apply_contrib);
+            }
+            else
+            {
+                auto h = cell_length(level);
+
+                for_each_interior_interface___same_level<parallel>(
+                    field.mesh(),
+                    level,
+                    flux_def.direction,
+                    flux_def.stencil,
+                    [&](auto& interface_cells, auto& comput_cells)
+                    {
+                        auto flux_values        = flux_function(comput_cells, field);
+                        auto left_cell_contrib  = contribution(flux_values[0], h, h);
+                        auto right_cell_contrib = contribution(flux_values[1], h, h);
+                        apply_contrib(interface_cells, left_cell_contrib, right_cell_contrib);
+                    });
+            }
+        }
+
+        /**
+         * Level jumps between @p level and level+1.
+         */
+        template <class FluxFunction, class Func>
+        void interior_interfaces___level_jump(input_field_t& field,
+                                              const flux_computation_t& flux_def,
+                                              FluxFunction& flux_function,
+                                              std::size_t level,
+                                              Func&& apply_contrib) const
+        {
+            auto& mesh = field.mesh();
+            auto h_l   = cell_length(level);
+            auto h_lp1 = cell_length(level + 1);
+
+            //         |__|   l+1
+            //    |____|      l
+            //    --------->
+            //    direction
+            {
+                for_each_interior_interface___level_jump_direction(
+                    mesh,
+                    level,
+                    flux_def.direction,
+                    flux_def.stencil,
+                    [&](auto& interface_cells, auto& comput_cells)
+                    {
+                        auto flux_values        = flux_function(comput_cells, field);
+                        auto left_cell_contrib  = contribution(flux_values[0], h_lp1, h_l);
+                        auto right_cell_contrib = contribution(flux_values[1], h_lp1, h_lp1);
+                        apply_contrib(interface_cells, left_cell_contrib, right_cell_contrib);
+                    });
+            }
+            //    |__|        l+1
+            //       |____|   l
+            //    --------->
+            //    direction
+            {
+                for_each_interior_interface___level_jump_opposite_direction(
                     mesh,
-                    [&](auto level)
+                    level,
+                    flux_def.direction,
+                    flux_def.stencil,
+                    [&](auto& interface_cells, auto& comput_cells)
                     {
-                        auto h = cell_length(level);
-
-                        // Boundary in direction
-                        for_each_boundary_interface___direction<parallel>(mesh,
-                                                                          level,
-                                                                          flux_def.direction,
-                                                                          flux_def.stencil,
-                                                                          [&](auto& cell, auto& comput_cells)
-                                                                          {
-                                                                              auto flux_values  = flux_function(comput_cells, field);
-                                                                              auto cell_contrib = contribution(flux_values[0], h, h);
-                                                                              apply_contrib(cell, cell_contrib);
-                                                                          });
-
-                        // Boundary in opposite direction
-                        for_each_boundary_interface___opposite_direction<parallel>(mesh,
-                                                                                   level,
-                                                                                   flux_def.direction,
-                                                                                   flux_def.stencil,
-                                                                                   [&](auto& cell, auto& comput_cells)
-                                                                                   {
-                                                                                       auto flux_values = flux_function(comput_cells, field);
-                                                                                       auto cell_contrib = contribution(flux_values[1], h, h);
-                                                                                       apply_contrib(cell, cell_contrib);
-                                                                                   });
+                        auto flux_values        = flux_function(comput_cells, field);
+                        auto left_cell_contrib  = contribution(flux_values[0], h_lp1, h_lp1);
+                        auto right_cell_contrib = contribution(flux_values[1], h_lp1, h_l);
+                        apply_contrib(interface_cells, left_cell_contrib, right_cell_contrib);
                     });
             }
         }
+
+        template <bool parallel, class FluxFunction, class Func>
+        void boundary_interfaces(input_field_t& field,
+                                 const flux_computation_t& flux_def,
+                                 FluxFunction& flux_function,
+                                 std::size_t level,
+                                 Func&& apply_contrib) const
+        {
+            auto& mesh = field.mesh();
+            auto h     = cell_length(level);
+
+            // Boundary in direction
+            for_each_boundary_interface___direction<parallel>(mesh,
+                                                              level,
+                                                              flux_def.direction,
+                                                              flux_def.stencil,
+                                                              [&](auto& cell, auto& comput_cells)
+                                                              {
+                                                                  auto flux_values  = flux_function(comput_cells, field);
+                                                                  auto cell_contrib = contribution(flux_values[0], h, h);
+                                                                  apply_contrib(cell, cell_contrib);
+                                                              });
+
+            // Boundary in opposite direction
+            for_each_boundary_interface___opposite_direction<parallel>(mesh,
+                                                                       level,
+                                                                       flux_def.direction,
+                                                                       flux_def.stencil,
+                                                                       [&](auto& cell, auto& comput_cells)
+                                                                       {
+                                                                           auto flux_values  = flux_function(comput_cells, field);
+                                                                           auto cell_contrib = contribution(flux_values[1], h, h);
+                                                                           apply_contrib(cell, cell_contrib);
+                                                                       });
+        }
     };
 
 } // end namespace samurai
@@ -1,10 +1,19 @@
 #pragma once
 #include "../utils.hpp"
+#include <algorithm>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace samurai
 {
-    template <SchemeType scheme_type_, std::size_t output_field_size_, std::size_t stencil_size_, class InputField_>
+    /**
+     * @param Flux_: type of the flux functor of a NON-LINEAR scheme.
+     *               If void (default), the flux function is stored as a std::function.
+     *               Otherwise, the functor is stored as is, so that it can be inlined
+     *               (see the specialization of NormalFluxDefinition below).
+     */
+    template <SchemeType scheme_type_, std::size_t output_field_size_, std::size_t stencil_size_, class InputField_, class Flux_ = void>
     struct FluxConfig
     {
         static constexpr SchemeType scheme_type        = scheme_type_;
@@ -12,8 +21,28 @@ namespace samurai
         static constexpr std::size_t stencil_size      = stencil_size_;
         using input_field_t                            = std::decay_t<InputField_>;
         static constexpr std::size_t dim               = input_field_t::dim;
+        using flux_t                                   = Flux_;
+    };
+
+    /**
+     * Same configuration as @param cfg, with the flux functor type @param Flux.
+     */
+    template <class cfg, class Flux>
+    using StaticFluxConfig = FluxConfig<cfg::scheme_type, cfg::output_field_size, cfg::stencil_size, typename cfg::input_field_t, Flux>;
+
+    template <class cfg, class = void>
+    struct has_static_flux : std::false_type
+    {
     };
 
+    template <class cfg>
+    struct has_static_flux<cfg, std::enable_if_t<!std::is_void_v<typename cfg::flux_t>>> : std::true_type
+    {
+    };
+
+    template <class cfg>
+    inline constexpr bool has_static_flux_v = has_static_flux<cfg>::value;
+
     template <class cfg>
     struct NormalFluxDefinitionBase
     {
@@ -61,7 +90,8 @@ namespace samurai
      * Defines how to compute a NON-LINEAR normal flux.
      */
     template <class cfg>
-    struct NormalFluxDefinition<cfg, std::enable_if_t<cfg::scheme_type == SchemeType::NonLinear>> : NormalFluxDefinitionBase<cfg>
+    struct NormalFluxDefinition<cfg, std::enable_if_t<cfg::scheme_type == SchemeType::NonLinear && !has_static_flux_v<cfg>>>
+        : NormalFluxDefinitionBase<cfg>
     {
         using field_t          = typename cfg::input_field_t;
         using field_value_type = typename field_t::value_type;
@@ -115,6 +145,103 @@ namespace samurai
         }
     };
 
+    /**
+     * Specialization of @class NormalFluxDefinition.
+     * Defines how to compute a NON-LINEAR normal flux with a flux functor known at compile time (cfg::flux_t),
+     * instead of a std::function. The functor must implement the conservative flux
+     *
+     *            flux_value_t operator()(stencil_cells_t& cells, const field_t& field) const;
+     *
+     * It can also implement the evaluation of the flux on n consecutive interfaces of same level:
+     *
+     *            void operator()(const std::array<const field_value_type*, stencil_size>& values,
+     *                            std::size_t n,
+     *                            field_value_type* fluxes) const;
+     *
+     * where values[c][ii * field_size + j] is the component j of the stencil cell c of the interface ii,
+     * and fluxes[ii * output_field_size + i] receives the component i of the flux through the interface ii.
+     */
+    template <class cfg>
+    struct NormalFluxDefinition<cfg, std::enable_if_t<cfg::scheme_type == SchemeType::NonLinear && has_static_flux_v<cfg>>>
+        : NormalFluxDefinitionBase<cfg>
+    {
+        using field_t                                  = typename cfg::input_field_t;
+        using field_value_type                         = typename field_t::value_type;
+        using cell_t                                   = typename field_t::cell_t;
+        static constexpr std::size_t field_size        = field_t::size;
+        static constexpr std::size_t output_field_size = cfg::output_field_size;
+        static constexpr std::size_t stencil_size      = cfg::stencil_size;
+
+        using stencil_cells_t   = std::array<cell_t, stencil_size>;
+        using stencil_values_t  = std::array<const field_value_type*, stencil_size>;
+        using flux_value_t      = CollapsVector<field_value_type, output_field_size>;
+        using flux_value_pair_t = std::array<flux_value_t, 2>;
+        using cons_flux_func    = typename cfg::flux_t; // conservative
+
+        /**
+         * True if the flux functor evaluates the flux on an interval of interfaces.
+         * The cell values are contiguous only if the field components are stored by cell (AOS).
+         */
+        static constexpr bool has_batched_flux = (field_size == 1 || !field_t::is_soa)
+                                              && std::is_invocable_v<const cons_flux_func&,
+                                                                     const stencil_values_t&,
+                                                                     std::size_t,
+                                                                     field_value_type*>;
+
+        cons_flux_func cons_flux_function;
+
+        explicit NormalFluxDefinition(const cons_flux_func& flux)
+            : cons_flux_function(flux)
+        {
+        }
+
+        /**
+         * @returns the flux in the positive direction and in the negative direction.
+         */
+        flux_value_pair_t flux_values(stencil_cells_t& cells, const field_t& field) const
+        {
+            flux_value_pair_t fluxes;
+            fluxes[0] = cons_flux_function(cells, field);
+            fluxes[1] = -fluxes[0];
+            return fluxes;
+        }
+
+        /**
+         * Computes the conservative flux on the n consecutive interfaces of same level starting at @param cells,
+         * i.e. the interface ii is computed from the cells translated by ii in the x-direction.
+         * @param fluxes receives n * output_field_size values.
+         */
+        void cons_flux_on_interval(const stencil_cells_t& cells, std::size_t n, const field_t& field, field_value_type* fluxes) const
+        {
+            if constexpr (has_batched_flux)
+            {
+                stencil_values_t values;
+                for (std::size_t c = 0; c < stencil_size; ++c)
+                {
+                    values[c] = field.array().data() + static_cast<std::size_t>(cells[c].index) * field_size;
+                }
+                cons_flux_function(values, n, fluxes);
+            }
+            else
+            {
+                stencil_cells_t interface_cells = cells;
+                for (std::size_t ii = 0; ii < n; ++ii)
+                {
+                    flux_value_t flux = cons_flux_function(interface_cells, field);
+                    if constexpr (output_field_size == 1)
+                    {
+                        fluxes[ii] = flux;
+                    }
+                    else
+                    {
+                        std::copy(flux.cbegin(), flux.cend(), fluxes + ii * output_field_size);
+                    }
+                    move_next(interface_cells);
+                }
+            }
+        }
+    };
+
     /**
      * Specialization of @class NormalFluxDefinition.
      * Defines how to compute a LINEAR and HETEROGENEOUS normal flux.
@@ -193,6 +320,7 @@ namespace samurai
         static constexpr std::size_t dim          = cfg::dim;
         static constexpr std::size_t stencil_size = cfg::stencil_size;
         using flux_computation_t                  = NormalFluxDefinition<cfg>;
+        using cons_flux_func                      = typename flux_computation_t::cons_flux_func;
 
       private:
 
@@ -202,20 +330,67 @@ namespace samurai
 
         FluxDefinition()
         {
+            static_assert(!has_static_flux_v<cfg>, "A flux definition with a static flux functor must be constructed from that functor.");
             set_default(nullptr);
         }
 
         /**
          * This constructor sets the same flux function for all directions
          */
-        explicit FluxDefinition(typename flux_computation_t::cons_flux_func flux_implem)
+        explicit FluxDefinition(cons_flux_func flux_implem)
+            : m_normal_fluxes(make_normal_fluxes(
+                  [&](std::size_t)
+                  {
+                      return flux_implem;
+                  },
+                  std::make_index_sequence<dim>{}))
+        {
+            set_default_stencils();
+        }
+
+        /**
+         * This constructor sets the flux function flux_of_direction(d) in the direction d.
+         * Useful with static flux functors, which cannot be assigned afterwards if they are lambdas.
+         */
+        template <class FluxOfDirection, std::enable_if_t<std::is_invocable_r_v<cons_flux_func, FluxOfDirection, std::size_t>, bool> = true>
+        explicit FluxDefinition(FluxOfDirection&& flux_of_direction)
+            : m_normal_fluxes(make_normal_fluxes(flux_of_direction, std::make_index_sequence<dim>{}))
         {
-            set_default(flux_implem);
+            set_default_stencils();
         }
 
       private:
 
-        void set_default(typename flux_computation_t::cons_flux_func flux_implem)
+        template <class FluxOfDirection, std::size_t... d>
+        static std::array<flux_computation_t, dim> make_normal_fluxes(FluxOfDirection&& flux_of_direction, std::index_sequence<d...>)
+        {
+            return {make_normal_flux(flux_of_direction(d))...};
+        }
+
+        static flux_computation_t make_normal_flux(const cons_flux_func& flux_implem)
+        {
+            if constexpr (has_static_flux_v<cfg>)
+            {
+                return flux_computation_t(flux_implem);
+            }
+            else
+            {
+                flux_computation_t normal_flux;
+                normal_flux.cons_flux_function = flux_implem;
+                return normal_flux;
+            }
+        }
+
+        void set_default(cons_flux_func flux_implem)
+        {
+            set_default_stencils();
+            for (auto& normal_flux : m_normal_fluxes)
+            {
+                normal_flux.cons_flux_function = flux_implem;
+            }
+        }
+
+        void set_default_stencils()
         {
             auto directions = positive_cartesian_directions<dim>();
             static_for<0, dim>::apply( // for each positive Cartesian direction 'd'
@@ -225,7 +400,6 @@ namespace samurai
                     DirectionVector<dim> direction = xt::view(directions, d);
                     m_normal_fluxes[d].direction   = direction;
                     m_normal_fluxes[d].stencil     = line_stencil_from<dim, d, stencil_size>(-static_cast<int>(stencil_size) / 2 + 1);
-                    m_normal_fluxes[d].cons_flux_function = flux_implem;
                 });
         }
 
@@ -244,6 +418,17 @@ namespace samurai
         }
     };
 
+    /**
+     * Flux definition with static flux functors (see NormalFluxDefinition).
+     * @param flux_of_direction: function of the direction d returning the flux functor of that direction.
+     */
+    template <class cfg, class FluxOfDirection>
+    auto make_flux_definition(FluxOfDirection&& flux_of_direction)
+    {
+        using flux_t = std::decay_t<std::invoke_result_t<FluxOfDirection, std::size_t>>;
+        return FluxDefinition<StaticFluxConfig<cfg, flux_t>>(flux_of_direction);
+    }
+
     template <class cfg>
     using FluxValue = typename NormalFluxDefinition<cfg>::flux_value_t;
 
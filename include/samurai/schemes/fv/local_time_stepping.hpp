@@ -0,0 +1,275 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#ifdef SAMURAI_WITH_MPI
+#include <boost/mpi.hpp>
+namespace mpi = boost::mpi;
+#endif
+
+#include "../../algorithm.hpp"
+#include "../../algorithm/update.hpp"
+#include "../../profiling.hpp"
+#include "../../storage_cursor.hpp"
+#include "../../utils.hpp"
+
+namespace samurai
+{
+    /**
+     * @class LocalTimeStepping
+     * @brief Explicit Euler time integration of du/dt + F(u) = 0 on a
+     * multiresolution mesh, where the cells of each level are advanced with
+     * their own time step.
+     *
+     * The cells of level l are advanced with dt_l = dt * 2^(max_level - l),
+     * dt being the time step of the finest level: one call to step() does
+     * 2^(max_level - min_level) substeps of the finest level and advances
+     * the whole mesh of the time step of the coarsest level. At each substep,
+     * only the interfaces whose finest cell starts a new time step are
+     * evaluated, so that the coarse cells cost 2^(max_level - level) times
+     * less than with a global time step.
+     *
+     * - The fluxes are synchronized at the level jumps: such an interface is
+     *   evaluated with the time step of its fine cell, and the coarse cell
+     *   receives the sum of the fluxes of the fine substeps, so that the
+     *   scheme stays conservative. The coarse flux at the start of its time
+     *   step only gives a provisional value at the end of the step.
+     * - During the time step of a coarse cell, its value is interpolated in
+     *   time between its value at the start of the step and this provisional
+     *   value, and the ghosts computed by update_ghost_mr follow.
+     * - At a substep, only the levels which start a time step (the active
+     *   levels, the finest ones) and the level below them, whose values are
+     *   predicted in the ghosts of the active levels, are interpolated and
+     *   have their ghosts updated (update_ghost_mr_from). The ghosts of this
+     *   level predicted from the coarser levels keep the values of the last
+     *   substep at which they were updated.
+     *
+     * F is a flux-based scheme iterating its interfaces level by level
+     * (for_each_interior_interface(field, level, f) and
+     * for_each_boundary_interface(field, level, f): the non-linear
+     * flux-based schemes).
+     */
+    template <class Field>
+    class LocalTimeStepping
+    {
+      public:
+
+        using field_t   = Field;
+        using mesh_t    = typename Field::mesh_t;
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+        using cursor_t  = typename Field::cursor_t;
+
+        template <class Scheme>
+        double step(const Scheme& scheme, Field& u, double dt);
+
+        std::size_t nb_substeps(const mesh_t& mesh) const;
+
+      private:
+
+        void prepare(Field& u);
+
+        template <class Func>
+        void for_each_level_interval(const mesh_t& mesh, std::size_t level, Func&& func) const;
+
+        const mesh_t* m_mesh       = nullptr;
+        std::size_t m_mesh_version = 0;
+        Field m_start;     ///< Value at the start of the time step of each cell
+        Field m_end;       ///< Provisional value at the end of the time step of each cell
+        Field m_increment; ///< Sum of the dt * F contributions received since the start of the time step of each cell
+    };
+
+    //////////////////////////////////////
+    // LocalTimeStepping implementation //
+    //////////////////////////////////////
+
+    namespace detail
+    {
+        template <class Mesh>
+        inline std::pair<std::size_t, std::size_t> lts_levels(const Mesh& mesh)
+        {
+            using mesh_id_t = typename Mesh::mesh_id_t;
+
+#ifdef SAMURAI_WITH_MPI
+            mpi::communicator world;
+            auto min_level = mpi::all_reduce(world, mesh[mesh_id_t::cells].min_level(), mpi::minimum<std::size_t>());
+            auto max_level = mpi::all_reduce(world, mesh[mesh_id_t::cells].max_level(), mpi::maximum<std::size_t>());
+#else
+            auto min_level = mesh[mesh_id_t::cells].min_level();
+            auto max_level = mesh[mesh_id_t::cells].max_level();
+#endif
+            return {min_level, max_level};
+        }
+    }
+
+    /// Number of substeps of the finest level done by step()
+    template <class Field>
+    inline std::size_t LocalTimeStepping<Field>::nb_substeps(const mesh_t& mesh) const
+    {
+        auto [min_level, max_level] = detail::lts_levels(mesh);
+        return std::size_t{1} << (max_level - min_level);
+    }
+
+    /**
+     * Advances u with the time step dt on the finest level, and with the
+     * time step dt * 2^(max_level - level) on the other levels.
+     * @returns the time step of the coarsest level, by which the whole mesh has been advanced.
+     */
+    template <class Field>
+    template <class Scheme>
+    double LocalTimeStepping<Field>::step(const Scheme& scheme, Field& u, double dt)
+    {
+        SAMURAI_PROFILE_SCOPE("local_time_stepping");
+
+        // The contributions on both sides of the interfaces do not race:
+        // see for_each_interior_interface___same_level___by_interval()
+        static constexpr bool parallel = true;
+
+        auto& mesh              = u.mesh();
+        auto levels             = detail::lts_levels(mesh);
+        std::size_t min_level   = levels.first;
+        std::size_t max_level   = levels.second;
+        std::size_t nb_substeps = std::size_t{1} << (max_level - min_level);
+
+        prepare(u);
+        m_start.array() = u.array();
+        m_increment.fill(0);
+
+        auto window = [&](std::size_t level)
+        {
+            return std::size_t{1} << (max_level - level);
+        };
+
+        for (std::size_t k = 0; k < nb_substeps; ++k)
+        {
+            // The active levels are the ones from first_active, the values of the level below are read in their ghosts
+            std::size_t first_active = max_level;
+            while (first_active > min_level && k % window(first_active - 1) == 0)
+            {
+                --first_active;
+            }
+            std::size_t first_read = first_active > min_level ? first_active - 1 : min_level;
+
+            // Values of the cells at the time of the substep: the value at the start of their
+            // time step, or its interpolation in time with the provisional end value
+            for (std::size_t level = first_read; level <= max_level; ++level)
+            {
+                std::size_t position = k % window(level);
+                if (position == 0)
+                {
+                    for_each_level_interval(mesh,
+                                            level,
+                                            [&](const auto& cursor)
+                                            {
+                                                m_start(cursor) -= m_increment(cursor);
+                                                m_increment(cursor) = 0;
+                                                u(cursor)           = m_start(cursor);
+                                                m_end(cursor)       = m_start(cursor);
+                                            });
+                }
+                else
+                {
+                    double theta = static_cast<double>(position) / static_cast<double>(window(level));
+                    for_each_level_interval(mesh,
+                                            level,
+                                            [&](const auto& cursor)
+                                            {
+                                                u(cursor) = (1 - theta) * m_start(cursor) + theta * m_end(cursor);
+                                            });
+                }
+            }
+            update_ghost_mr_from(first_read, u);
+
+            // Interfaces whose finest cell starts a new time step
+            for (std::size_t level = first_active; level <= max_level; ++level)
+            {
+                double dt_level = dt * static_cast<double>(window(level));
+
+                auto add_contrib = [&](const auto& cell, const auto& contrib)
+                {
+                    bool cell_starts = k % window(cell.level) == 0;
+                    double dt_cell   = dt * static_cast<double>(window(cell.level));
+                    for (std::size_t field_i = 0; field_i < Field::size; ++field_i)
+                    {
+                        auto value = scheme.flux_value_cmpnent(contrib, field_i);
+                        field_value(m_increment, cell, field_i) += dt_level * value;
+                        if (cell_starts)
+                        {
+                            field_value(m_end, cell, field_i) -= dt_cell * value;
+                        }
+                    }
+                };
+
+                scheme.template for_each_interior_interface<parallel>(
+                    u,
+                    level,
+                    [&](const auto& interface_cells, auto& left_contrib, auto& right_contrib)
+                    {
+                        add_contrib(interface_cells[0], left_contrib);
+                        add_contrib(interface_cells[1], right_contrib);
+                    });
+                scheme.template for_each_boundary_interface<parallel>(u,
+                                                                      level,
+                                                                      [&](const auto& cell, auto& contrib)
+                                                                      {
+                                                                          add_contrib(cell, contrib);
+                                                                      });
+            }
+        }
+
+        // All the cells end their time step
+        for (std::size_t level = min_level; level <= max_level; ++level)
+        {
+            for_each_level_interval(mesh,
+                                    level,
+                                    [&](const auto& cursor)
+                                    {
+                                        u(cursor) = m_start(cursor) - m_increment(cursor);
+                                    });
+        }
+
+        return dt * static_cast<double>(nb_substeps);
+    }
+
+    /**
+     * Allocates the buffers on the mesh of u, or resizes them if the mesh has
+     * changed since the last step.
+     */
+    template <class Field>
+    void LocalTimeStepping<Field>::prepare(Field& u)
+    {
+        const std::size_t version = detail::mesh_version(u.mesh());
+        if (m_mesh != &u.mesh())
+        {
+            m_start     = Field("lts_start", u.mesh());
+            m_end       = Field("lts_end", u.mesh());
+            m_increment = Field("lts_increment", u.mesh());
+        }
+        else if (version == 0 || version != m_mesh_version)
+        {
+            m_start.resize();
+            m_end.resize();
+            m_increment.resize();
+        }
+        m_mesh         = &u.mesh();
+        m_mesh_version = version;
+    }
+
+    /// Calls func with a cursor on each interval of the cells of level
+    template <class Field>
+    template <class Func>
+    inline void LocalTimeStepping<Field>::for_each_level_interval(const mesh_t& mesh, std::size_t level, Func&& func) const
+    {
+        const std::size_t version = detail::mesh_version(mesh);
+        for_each_interval(mesh[mesh_id_t::cells][level],
+                          [&](std::size_t l, const auto& i, const auto& index)
+                          {
+                              // The intervals of the cells hold the position of their start in the storage
+                              func(cursor_t(l, i, index, i.index + i.start, version));
+                          });
+    }
+}
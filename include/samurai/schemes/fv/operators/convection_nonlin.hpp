@@ -4,6 +4,145 @@
 
 namespace samurai
 {
+    namespace detail
+    {
+        /**
+         * Upwind flux of the convection term in the direction d (see make_convection_upwind() below).
+         */
+        template <class Field>
+        struct ConvectionUpwindFlux
+        {
+            using field_value_t                     = typename Field::value_type;
+            static constexpr std::size_t field_size = Field::size;
+            using flux_value_t                      = CollapsVector<field_value_t, field_size>;
+
+            std::size_t d;
+
+            template <class Value>
+            flux_value_t f(const Value& u) const
+            {
+                if constexpr (field_size == 1)
+                {
+                    return u * u;
+                }
+                else
+                {
+                    return u(d) * u;
+                }
+            }
+
+            template <class Cells>
+            flux_value_t operator()(Cells& cells, const Field& field) const
+            {
+                auto& left  = cells[0];
+                auto& right = cells[1];
+
+                field_value_t v;
+                if constexpr (field_size == 1)
+                {
+                    v = field[left];
+                }
+                else
+                {
+                    v = field[left](d);
+                }
+
+                return v >= 0 ? f(field[left]) : f(field[right]);
+            }
+
+            // Interval of interfaces: values[c][ii * field_size + j] is the component j of the stencil cell c of the interface ii
+            void operator()(const std::array<const field_value_t*, 2>& values, std::size_t n, field_value_t* fluxes) const
+            {
+                const std::size_t v = field_size == 1 ? 0 : d;
+                for (std::size_t ii = 0; ii < n; ++ii)
+                {
+                    const field_value_t* left  = values[0] + ii * field_size;
+                    const field_value_t* right = values[1] + ii * field_size;
+                    const field_value_t* u     = left[v] >= 0 ? left : right;
+                    for (std::size_t j = 0; j < field_size; ++j)
+                    {
+                        fluxes[ii * field_size + j] = u[v] * u[j];
+                    }
+                }
+            }
+        };
+
+        /**
+         * WENO5 flux of the convection term in the direction d (see make_convection_weno5() below).
+         */
+        template <class Field>
+        struct ConvectionWeno5Flux
+        {
+            using field_value_t                     = typename Field::value_type;
+            static constexpr std::size_t field_size = Field::size;
+            using flux_value_t                      = CollapsVector<field_value_t, field_size>;
+
+            static constexpr std::size_t stencil_center = 2;
+
+            std::size_t d;
+
+            template <class Value>
+            flux_value_t f(const Value& u) const
+            {
+                if constexpr (field_size == 1)
+                {
+                    return u * u;
+                }
+                else
+                {
+                    return u(d) * u;
+                }
+            }
+
+            template <class Cells>
+            flux_value_t operator()(Cells& cells, const Field& u) const
+            {
+                field_value_t v;
+                if constexpr (field_size == 1)
+                {
+                    v = u[cells[stencil_center]];
+                }
+                else
+                {
+                    v = u[cells[stencil_center]](d);
+                }
+
+                xt::xtensor_fixed<flux_value_t, xt::xshape<5>> f_u;
+                if (v >= 0)
+                {
+                    f_u = {f(u[cells[0]]), f(u[cells[1]]), f(u[cells[2]]), f(u[cells[3]]), f(u[cells[4]])};
+                }
+                else
+                {
+                    f_u = {f(u[cells[5]]), f(u[cells[4]]), f(u[cells[3]]), f(u[cells[2]]), f(u[cells[1]])};
+                }
+
+                return compute_weno5_flux(f_u);
+            }
+
+            // Interval of interfaces: values[c][ii * field_size + j] is the component j of the stencil cell c of the interface ii
+            void operator()(const std::array<const field_value_t*, 6>& values, std::size_t n, field_value_t* fluxes) const
+            {
+                const std::size_t v = field_size == 1 ? 0 : d;
+                xt::xtensor_fixed<field_value_t, xt::xshape<5>> f_u;
+                for (std::size_t ii = 0; ii < n; ++ii)
+                {
+                    const std::size_t offset = ii * field_size;
+                    bool upwind_left         = values[stencil_center][offset + v] >= 0;
+                    for (std::size_t j = 0; j < field_size; ++j)
+                    {
+                        for (std::size_t c = 0; c < 5; ++c)
+                        {
+                            const field_value_t* u = values[upwind_left ? c : 5 - c] + offset;
+                            f_u(c)                 = u[v] * u[j];
+                        }
+                        fluxes[offset + j] = compute_weno5_flux(f_u);
+                    }
+                }
+            }
+        };
+    }
+
     /**
      * Convection term where the velocity field is compressible.
      *
@@ -22,8 +161,6 @@ namespace samurai
     template <class Field>
     auto make_convection_upwind()
     {
-        using field_value_t = typename Field::value_type;
-
         static constexpr std::size_t dim               = Field::dim;
         static constexpr std::size_t field_size        = Field::size;
         static constexpr std::size_t output_field_size = field_size;
@@ -136,42 +273,11 @@ namespace samurai
         }
         else
         {*/
-        FluxDefinition<cfg> upwind;
-
-        static_for<0, dim>::apply( // for each positive Cartesian direction 'd'
-            [&](auto integral_constant_d)
+        // Static flux functors, evaluated by intervals of interfaces
+        auto upwind = make_flux_definition<cfg>(
+            [](std::size_t d)
             {
-                static constexpr std::size_t d = decltype(integral_constant_d)::value;
-
-                auto f = [](auto u) -> FluxValue<cfg>
-                {
-                    if constexpr (field_size == 1)
-                    {
-                        return u * u;
-                    }
-                    else
-                    {
-                        return u(d) * u;
-                    }
-                };
-
-                upwind[d].cons_flux_function = [f](auto& cells, const Field& field)
-                {
-                    auto& left  = cells[0];
-                    auto& right = cells[1];
-
-                    field_value_t v;
-                    if constexpr (field_size == 1)
-                    {
-                        v = field[left];
-                    }
-                    else
-                    {
-                        v = field[left](d);
-                    }
-
-                    return v >= 0 ? f(field[left]) : f(field[right]);
-                };
+                return detail::ConvectionUpwindFlux<Field>{d};
             });
 
         return make_flux_based_scheme(upwind);
@@ -180,8 +286,6 @@ namespace samurai
     template <class Field>
     auto make_convection_weno5()
     {
-        using field_value_t = typename Field::value_type;
-
         static_assert(Field::mesh_t::config::ghost_width >= 3, "WENO5 requires at least 3 ghosts.");
 
         static constexpr std::size_t dim               = Field::dim;
@@ -194,53 +298,19 @@ namespace samurai
 
         using cfg = FluxConfig<SchemeType::NonLinear, output_field_size, stencil_size, Field>;
 
-        FluxDefinition<cfg> weno5;
+        // Static flux functors, evaluated by intervals of interfaces
+        auto weno5 = make_flux_definition<cfg>(
+            [](std::size_t d)
+            {
+                return detail::ConvectionWeno5Flux<Field>{d};
+            });
 
         static_for<0, dim>::apply( // for each positive Cartesian direction 'd'
             [&](auto integral_constant_d)
             {
                 static constexpr std::size_t d = decltype(integral_constant_d)::value;
 
-                auto f = [](auto u) -> FluxValue<cfg>
-                {
-                    if constexpr (field_size == 1)
-                    {
-                        return u * u;
-                    }
-                    else
-                    {
-                        return u(d) * u;
-                    }
-                };
-
                 weno5[d].stencil = line_stencil<dim, d>(-2, -1, 0, 1, 2, 3);
-
-                weno5[d].cons_flux_function = [f](auto& cells, const Field& u) -> FluxValue<cfg>
-                {
-                    static constexpr std::size_t stencil_center = 2;
-
-                    field_value_t v;
-                    if constexpr (field_size == 1)
-                    {
-                        v = u[cells[stencil_center]];
-                    }
-                    else
-                    {
-                        v = u[cells[stencil_center]](d);
-                    }
-
-                    xt::xtensor_fixed<FluxValue<cfg>, xt::xshape<5>> f_u;
-                    if (v >= 0)
-                    {
-                        f_u = {f(u[cells[0]]), f(u[cells[1]]), f(u[cells[2]]), f(u[cells[3]]), f(u[cells[4]])};
-                    }
-                    else
-                    {
-                        f_u = {f(u[cells[5]]), f(u[cells[4]]), f(u[cells[3]]), f(u[cells[2]]), f(u[cells[1]])};
-                    }
-
-                    return compute_weno5_flux(f_u);
-                };
             });
 
         return make_flux_based_scheme(weno5);
@@ -0,0 +1,333 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "../algorithm/update.hpp"
+#include "../profiling.hpp"
+#include "../storage_cursor.hpp"
+
+namespace samurai
+{
+    enum class RungeKuttaMethod
+    {
+        Euler,         ///< Forward Euler
+        SSPRK2,        ///< Strong stability preserving RK of order 2 (Heun)
+        SSPRK3,        ///< Strong stability preserving RK of order 3 (Shu-Osher)
+        RK4,           ///< Classical RK of order 4
+        LowStorageRK4, ///< Low-storage (2N) RK of order 4 with 5 stages (Carpenter-Kennedy)
+    };
+
+    namespace detail
+    {
+        /// Coefficients of the 2N form du_i = A_i du_{i-1} + dt L(u_{i-1}), u_i = u_{i-1} + B_i du_i
+        struct LowStorageRK4Coefficients
+        {
+            static constexpr std::size_t nb_stages = 5;
+
+            static constexpr std::array<double, nb_stages> A{0.,
+                                                             -567301805773. / 1357537059087.,
+                                                             -2404267990393. / 2016746695238.,
+                                                             -3550918686646. / 2091501179385.,
+                                                             -1275806237668. / 842570457699.};
+            static constexpr std::array<double, nb_stages> B{1432997174477. / 9575080441755.,
+                                                             5161836677717. / 13612068292357.,
+                                                             1720146321549. / 2090206949498.,
+                                                             3134564353537. / 4481467310338.,
+                                                             2277821191437. / 14882151754819.};
+        };
+    }
+
+    /**
+     * @class ExplicitRungeKutta
+     * @brief Explicit time integrator of du/dt + F(u) = 0, with the sign
+     * convention of the explicit schemes (u^{n+1} = u^n - dt * F(u^n) for
+     * Euler).
+     *
+     * F is any scheme with apply(output_field, input_field) adding F(input)
+     * to output (the FV schemes and their sums). The stage buffers are owned
+     * by the integrator: they are allocated on the first step and resized
+     * only when the mesh changes (adaptation). Before each evaluation of F,
+     * the ghosts of the stage are updated with update_ghost_mr, and each
+     * linear combination of the stages is done in a single pass over the
+     * data, which also zeroes the buffer of F for the next evaluation.
+     */
+    template <class Field>
+    class ExplicitRungeKutta
+    {
+      public:
+
+        using field_t = Field;
+        using mesh_t  = typename Field::mesh_t;
+        using value_t = typename Field::value_type;
+
+        explicit ExplicitRungeKutta(RungeKuttaMethod method = RungeKuttaMethod::SSPRK3);
+
+        RungeKuttaMethod method() const;
+        std::size_t nb_stages() const;
+
+        template <class Scheme>
+        void step(const Scheme& scheme, Field& u, double dt);
+
+      private:
+
+        void prepare(Field& u);
+
+        template <class Scheme>
+        void evaluate(const Scheme& scheme, Field& input);
+
+        template <class Func>
+        void for_each_value(Func&& func);
+
+        RungeKuttaMethod m_method;
+        const mesh_t* m_mesh       = nullptr;
+        std::size_t m_mesh_version = 0;
+        Field m_stage;    ///< Intermediate stage (du for the low-storage scheme), unused by Euler
+        Field m_rhs;      ///< F(stage), zero between two evaluations
+        Field m_solution; ///< Partial sum of the solution, only used by RK4
+    };
+
+    ///////////////////////////////////////
+    // ExplicitRungeKutta implementation //
+    ///////////////////////////////////////
+
+    template <class Field>
+    inline ExplicitRungeKutta<Field>::ExplicitRungeKutta(RungeKuttaMethod method)
+        : m_method(method)
+    {
+    }
+
+    template <class Field>
+    inline RungeKuttaMethod ExplicitRungeKutta<Field>::method() const
+    {
+        return m_method;
+    }
+
+    template <class Field>
+    inline std::size_t ExplicitRungeKutta<Field>::nb_stages() const
+    {
+        switch (m_method)
+        {
+            case RungeKuttaMethod::Euler:
+                return 1;
+            case RungeKuttaMethod::SSPRK2:
+                return 2;
+            case RungeKuttaMethod::SSPRK3:
+                return 3;
+            case RungeKuttaMethod::RK4:
+                return 4;
+            case RungeKuttaMethod::LowStorageRK4:
+                return detail::LowStorageRK4Coefficients::nb_stages;
+        }
+        return 0;
+    }
+
+    /**
+     * Advances u of one time step dt. The boundary conditions of u are used
+     * for the intermediate stages.
+     */
+    template <class Field>
+    template <class Scheme>
+    void ExplicitRungeKutta<Field>::step(const Scheme& scheme, Field& u, double dt)
+    {
+        SAMURAI_PROFILE_SCOPE("runge_kutta");
+
+        prepare(u);
+
+        value_t* un       = u.array().data();
+        value_t* stage    = m_stage.array().data();
+        value_t* rhs      = m_rhs.array().data();
+        value_t* solution = m_solution.array().data();
+
+        switch (m_method)
+        {
+            case RungeKuttaMethod::Euler:
+            {
+                evaluate(scheme, u);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        un[n] -= dt * rhs[n];
+                        rhs[n] = 0;
+                    });
+                break;
+            }
+            case RungeKuttaMethod::SSPRK2:
+            {
+                evaluate(scheme, u);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        stage[n] = un[n] - dt * rhs[n];
+                        rhs[n]   = 0;
+                    });
+                evaluate(scheme, m_stage);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        un[n]  = 0.5 * (un[n] + stage[n] - dt * rhs[n]);
+                        rhs[n] = 0;
+                    });
+                break;
+            }
+            case RungeKuttaMethod::SSPRK3:
+            {
+                evaluate(scheme, u);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        stage[n] = un[n] - dt * rhs[n];
+                        rhs[n]   = 0;
+                    });
+                evaluate(scheme, m_stage);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        stage[n] = 0.75 * un[n] + 0.25 * (stage[n] - dt * rhs[n]);
+                        rhs[n]   = 0;
+                    });
+                evaluate(scheme, m_stage);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        un[n]  = (un[n] + 2. * (stage[n] - dt * rhs[n])) / 3.;
+                        rhs[n] = 0;
+                    });
+                break;
+            }
+            case RungeKuttaMethod::RK4:
+            {
+                evaluate(scheme, u);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        stage[n]    = un[n] - 0.5 * dt * rhs[n];
+                        solution[n] = un[n] - dt / 6. * rhs[n];
+                        rhs[n]      = 0;
+                    });
+                evaluate(scheme, m_stage);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        stage[n] = un[n] - 0.5 * dt * rhs[n];
+                        solution[n] -= dt / 3. * rhs[n];
+                        rhs[n] = 0;
+                    });
+                evaluate(scheme, m_stage);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        stage[n] = un[n] - dt * rhs[n];
+                        solution[n] -= dt / 3. * rhs[n];
+                        rhs[n] = 0;
+                    });
+                evaluate(scheme, m_stage);
+                for_each_value(
+                    [&](std::size_t n)
+                    {
+                        un[n]  = solution[n] - dt / 6. * rhs[n];
+                        rhs[n] = 0;
+                    });
+                break;
+            }
+            case RungeKuttaMethod::LowStorageRK4:
+            {
+                using coefficients = detail::LowStorageRK4Coefficients;
+
+                // The stages are computed in place in u, m_stage holding du
+                for (std::size_t i = 0; i < coefficients::nb_stages; ++i)
+                {
+                    const double a = coefficients::A[i];
+                    const double b = coefficients::B[i];
+                    evaluate(scheme, u);
+                    for_each_value(
+                        [&](std::size_t n)
+                        {
+                            stage[n] = (i == 0 ? 0. : a * stage[n]) - dt * rhs[n];
+                            un[n] += b * stage[n];
+                            rhs[n] = 0;
+                        });
+                }
+                break;
+            }
+        }
+    }
+
+    /**
+     * Allocates the buffers used by the method on the mesh of u, or resizes
+     * them if the mesh has changed since the last step, and copies the
+     * boundary conditions of u on the stage.
+     */
+    template <class Field>
+    void ExplicitRungeKutta<Field>::prepare(Field& u)
+    {
+        const std::size_t version = detail::mesh_version(u.mesh());
+        const bool with_stage     = m_method != RungeKuttaMethod::Euler;
+        const bool with_solution  = m_method == RungeKuttaMethod::RK4;
+        const bool mesh_changed   = m_mesh != &u.mesh() || version == 0 || version != m_mesh_version;
+
+        auto update = [&](Field& buffer, const char* name)
+        {
+            if (m_mesh != &u.mesh() || buffer.array().size() == 0)
+            {
+                buffer = Field(name, u.mesh());
+            }
+            else if (mesh_changed)
+            {
+                buffer.resize();
+            }
+        };
+        if (with_stage)
+        {
+            update(m_stage, "rk_stage");
+        }
+        if (with_solution)
+        {
+            update(m_solution, "rk_solution");
+        }
+        if (mesh_changed)
+        {
+            update(m_rhs, "rk_rhs");
+            m_rhs.fill(0);
+        }
+        m_mesh         = &u.mesh();
+        m_mesh_version = version;
+
+        if (with_stage && m_method != RungeKuttaMethod::LowStorageRK4)
+        {
+            m_stage.get_bc().clear();
+            m_stage.copy_bc_from(u);
+        }
+    }
+
+    /// Adds F(input) to m_rhs, after the update of the ghosts of input
+    template <class Field>
+    template <class Scheme>
+    void ExplicitRungeKutta<Field>::evaluate(const Scheme& scheme, Field& input)
+    {
+        update_ghost_mr(input);
+        scheme.apply(m_rhs, input);
+    }
+
+    template <class Field>
+    template <class Func>
+    inline void ExplicitRungeKutta<Field>::for_each_value(Func&& func)
+    {
+        const std::size_t size = m_rhs.array().size();
+        for (std::size_t n = 0; n < size; ++n)
+        {
+            func(n);
+        }
+    }
+
+    template <class Field>
+    auto make_runge_kutta(const Field&, RungeKuttaMethod method = RungeKuttaMethod::SSPRK3)
+    {
+        return ExplicitRungeKutta<Field>(method);
+    }
+}
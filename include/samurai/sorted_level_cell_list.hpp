@@ -0,0 +1,346 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <xtensor/xfixed.hpp>
+#include <xtensor/xview.hpp>
+
+#include "cell.hpp"
+#include "samurai_config.hpp"
+
+namespace samurai
+{
+    namespace detail
+    {
+        /// Interval along x stored with its dim-1 coordinates.
+        template <class TValue, std::size_t N>
+        struct yz_interval_record
+        {
+            std::array<TValue, N> yz;
+            TValue start;
+            TValue end;
+        };
+
+        /// Order preserving map from a signed integer to an unsigned key.
+        template <class TValue>
+        inline auto radix_key(TValue value)
+        {
+            using key_t = std::make_unsigned_t<TValue>;
+            return static_cast<key_t>(static_cast<key_t>(value) ^ (key_t(1) << (8 * sizeof(TValue) - 1)));
+        }
+
+        /** Stable LSD radix sort of the records on one key (8 bits per pass).
+         *
+         * The passes where all the records share the same digit are skipped,
+         * which is the common case for the high bytes of the coordinates.
+         */
+        template <class Record, class Key>
+        inline void radix_sort_by_key(std::vector<Record>& records, std::vector<Record>& buffer, Key&& key)
+        {
+            using key_t                  = decltype(key(records.front()));
+            constexpr std::size_t n_pass = sizeof(key_t);
+
+            buffer.resize(records.size());
+            for (std::size_t pass = 0; pass < n_pass; ++pass)
+            {
+                const std::size_t shift = 8 * pass;
+                std::array<std::size_t, 256> count{};
+                for (const auto& r : records)
+                {
+                    ++count[(key(r) >> shift) & 0xFF];
+                }
+                if (std::any_of(count.begin(),
+                                count.end(),
+                                [&](std::size_t c)
+                                {
+                                    return c == records.size();
+                                }))
+                {
+                    continue;
+                }
+
+                std::size_t sum = 0;
+                for (auto& c : count)
+                {
+                    std::size_t tmp = c;
+                    c               = sum;
+                    sum += tmp;
+                }
+                for (const auto& r : records)
+                {
+                    buffer[count[(key(r) >> shift) & 0xFF]++] = r;
+                }
+                std::swap(records, buffer);
+            }
+        }
+    } // namespace detail
+
+    ////////////////////////////////////
+    // SortedLevelCellList definition //
+    ////////////////////////////////////
+
+    /** @class SortedLevelCellList
+     *  @brief Flat alternative to LevelCellList.
+     *
+     * The intervals are appended without any search in a single vector and
+     * are only sorted (radix sort on the coordinates) and merged when the list
+     * is read, typically when a LevelCellArray is built from it.
+     *
+     * @tparam Dim        The dimension.
+     * @tparam TInterval  The interval type.
+     */
+    template <std::size_t Dim, class TInterval = default_config::interval_t>
+    class SortedLevelCellList
+    {
+      public:
+
+        static constexpr auto dim = Dim;
+        using interval_t          = TInterval;
+        using index_t             = typename interval_t::index_t;
+        using coord_index_t       = typename interval_t::coord_index_t;
+        using index_yz_t          = xt::xtensor_fixed<coord_index_t, xt::xshape<dim - 1>>;
+        using record_t            = detail::yz_interval_record<coord_index_t, dim - 1>;
+
+        /// Row of the list at given dim-1 coordinates: only insertion is
+        /// allowed.
+        class row_type
+        {
+          public:
+
+            row_type(SortedLevelCellList& lcl, const index_yz_t& index);
+
+            void add_point(coord_index_t point);
+            void add_interval(const interval_t& interval);
+
+          private:
+
+            SortedLevelCellList* p_lcl;
+            std::array<coord_index_t, dim - 1> m_yz;
+        };
+
+        SortedLevelCellList();
+        SortedLevelCellList(std::size_t level);
+
+        row_type operator[](const index_yz_t& index);
+
+        const std::vector<record_t>& records() const;
+
+        std::size_t level() const;
+
+        bool empty() const;
+
+        void reserve(std::size_t n);
+
+        void to_stream(std::ostream& os) const;
+
+        void add_cell(const Cell<dim, interval_t>& cell);
+
+        void merge(SortedLevelCellList&& other);
+
+      private:
+
+        void push_back(const std::array<coord_index_t, dim - 1>& yz, const interval_t& interval);
+        void normalize() const;
+
+        // Sorted on the first read, which is therefore not thread-safe even
+        // through a const reference: the list must be read by one thread first.
+        mutable std::vector<record_t> m_records; ///< Intervals with their dim-1
+                                                 ///< coordinates.
+        mutable bool m_sorted = true;
+        std::size_t m_level;
+    };
+
+    ////////////////////////////////////////
+    // SortedLevelCellList implementation //
+    ////////////////////////////////////////
+    template <std::size_t Dim, class TInterval>
+    inline SortedLevelCellList<Dim, TInterval>::row_type::row_type(SortedLevelCellList& lcl, const index_yz_t& index)
+        : p_lcl(&lcl)
+    {
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            m_yz[d] = index[d];
+        }
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void SortedLevelCellList<Dim, TInterval>::row_type::add_point(coord_index_t point)
+    {
+        add_interval({point, point + 1});
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void SortedLevelCellList<Dim, TInterval>::row_type::add_interval(const interval_t& interval)
+    {
+        if (!interval.is_valid())
+        {
+            return;
+        }
+        p_lcl->push_back(m_yz, interval);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline SortedLevelCellList<Dim, TInterval>::SortedLevelCellList()
+        : m_level{0}
+    {
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline SortedLevelCellList<Dim, TInterval>::SortedLevelCellList(std::size_t level)
+        : m_level{level}
+    {
+    }
+
+    /// Insertion access to the row at given dim-1 coordinates
+    template <std::size_t Dim, class TInterval>
+    inline auto SortedLevelCellList<Dim, TInterval>::operator[](const index_yz_t& index) -> row_type
+    {
+        return {*this, index};
+    }
+
+    /// Sorted records without overlapping or touching intervals in a row.
+    /// The first call after an insertion sorts the list: it must not be
+    /// concurrent with another call.
+    template <std::size_t Dim, class TInterval>
+    inline auto SortedLevelCellList<Dim, TInterval>::records() const -> const std::vector<record_t>&
+    {
+        normalize();
+        return m_records;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t SortedLevelCellList<Dim, TInterval>::level() const
+    {
+        return m_level;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline bool SortedLevelCellList<Dim, TInterval>::empty() const
+    {
+        return m_records.empty();
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void SortedLevelCellList<Dim, TInterval>::reserve(std::size_t n)
+    {
+        m_records.reserve(n);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void SortedLevelCellList<Dim, TInterval>::to_stream(std::ostream& os) const
+    {
+        os << "SortedLevelCellList\n";
+        os << "===================\n";
+        for (const auto& r : records())
+        {
+            os << "(";
+            for (std::size_t d = 0; d < dim - 1; ++d)
+            {
+                os << r.yz[d] << (d + 2 < dim ? ", " : "");
+            }
+            os << ") [" << r.start << ", " << r.end << "[\n";
+        }
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void SortedLevelCellList<Dim, TInterval>::add_cell(const Cell<dim, interval_t>& cell)
+    {
+        using namespace xt::placeholders;
+
+        (*this)[xt::view(cell.indices, xt::range(1, _))].add_point(cell.indices[0]);
+    }
+
+    /**
+     * Add the intervals of another list: they are appended and sorted with
+     * the others when the list is read.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline void SortedLevelCellList<Dim, TInterval>::merge(SortedLevelCellList&& other)
+    {
+        if (other.m_records.empty())
+        {
+            return;
+        }
+        if (m_records.empty())
+        {
+            m_records = std::move(other.m_records);
+            m_sorted  = other.m_sorted;
+        }
+        else
+        {
+            m_records.insert(m_records.end(), other.m_records.begin(), other.m_records.end());
+            m_sorted = false;
+        }
+        other.m_records.clear();
+        other.m_sorted = true;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void SortedLevelCellList<Dim, TInterval>::push_back(const std::array<coord_index_t, dim - 1>& yz, const interval_t& interval)
+    {
+        m_records.push_back({yz, interval.start, interval.end});
+        m_sorted = false;
+    }
+
+    /**
+     * Sort the records along (start, y, z, ...) from the least to the most
+     * significant key and merge the overlapping or touching intervals of a
+     * same row, as ListOfIntervals::add_interval does.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline void SortedLevelCellList<Dim, TInterval>::normalize() const
+    {
+        if (m_sorted)
+        {
+            return;
+        }
+
+        std::vector<record_t> buffer;
+        detail::radix_sort_by_key(m_records,
+                                  buffer,
+                                  [](const record_t& r)
+                                  {
+                                      return detail::radix_key(r.start);
+                                  });
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            detail::radix_sort_by_key(m_records,
+                                      buffer,
+                                      [d](const record_t& r)
+                                      {
+                                          return detail::radix_key(r.yz[d]);
+                                      });
+        }
+
+        std::size_t out = 0;
+        for (std::size_t r = 1; r < m_records.size(); ++r)
+        {
+            if (m_records[r].yz == m_records[out].yz && m_records[r].start <= m_records[out].end)
+            {
+                m_records[out].end = std::max(m_records[out].end, m_records[r].end);
+            }
+            else
+            {
+                m_records[++out] = m_records[r];
+            }
+        }
+        m_records.resize(std::min(out + 1, m_records.size()));
+        m_sorted = true;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::ostream& operator<<(std::ostream& out, const SortedLevelCellList<Dim, TInterval>& level_cell_list)
+    {
+        level_cell_list.to_stream(out);
+        return out;
+    }
+
+} // namespace samurai
@@ -0,0 +1,375 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xfixed.hpp>
+
+#ifdef SAMURAI_WITH_MPI
+#include <boost/mpi.hpp>
+namespace mpi = boost::mpi;
+#endif
+
+#include "cell_array.hpp"
+
+namespace samurai
+{
+    enum class SFCType
+    {
+        Morton,  ///< Z-order curve: bits of the coordinates interleaved
+        Hilbert, ///< Hilbert curve: consecutive cells are neighbours
+    };
+
+    namespace detail
+    {
+        template <std::size_t dim>
+        std::uint64_t morton_key(const std::array<std::uint64_t, dim>& coords, std::size_t bits)
+        {
+            std::uint64_t key = 0;
+            for (std::size_t b = bits; b-- > 0;)
+            {
+                for (std::size_t d = dim; d-- > 0;)
+                {
+                    key = (key << 1) | ((coords[d] >> b) & 1);
+                }
+            }
+            return key;
+        }
+
+        /// Position on the Hilbert curve (J. Skilling, Programming the Hilbert curve, 2004)
+        template <std::size_t dim>
+        std::uint64_t hilbert_key(std::array<std::uint64_t, dim> x, std::size_t bits)
+        {
+            if (bits == 0)
+            {
+                return 0;
+            }
+            const std::uint64_t m = std::uint64_t{1} << (bits - 1);
+
+            // Inverse undo
+            for (std::uint64_t q = m; q > 1; q >>= 1)
+            {
+                const std::uint64_t p = q - 1;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    if (x[d] & q)
+                    {
+                        x[0] ^= p;
+                    }
+                    else
+                    {
+                        const std::uint64_t t = (x[0] ^ x[d]) & p;
+                        x[0] ^= t;
+                        x[d] ^= t;
+                    }
+                }
+            }
+
+            // Gray encode
+            for (std::size_t d = 1; d < dim; ++d)
+            {
+                x[d] ^= x[d - 1];
+            }
+            std::uint64_t t = 0;
+            for (std::uint64_t q = m; q > 1; q >>= 1)
+            {
+                if (x[dim - 1] & q)
+                {
+                    t ^= q - 1;
+                }
+            }
+            for (auto& xd : x)
+            {
+                xd ^= t;
+            }
+
+            // The key is made of the transposed bits
+            std::uint64_t key = 0;
+            for (std::size_t b = bits; b-- > 0;)
+            {
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    key = (key << 1) | ((x[d] >> b) & 1);
+                }
+            }
+            return key;
+        }
+
+        inline void sfc_sum(std::vector<double>& values)
+        {
+#ifdef SAMURAI_WITH_MPI
+            mpi::communicator world;
+            std::vector<double> sum(values.size());
+            mpi::all_reduce(world, values.data(), static_cast<int>(values.size()), sum.data(), std::plus<double>());
+            std::swap(values, sum);
+#else
+            (void)values;
+#endif
+        }
+    }
+
+    /**
+     * Position along the curve of the cell of the given coordinates, given
+     * with bits bits in each direction (dim * bits < 64).
+     */
+    template <std::size_t dim>
+    std::uint64_t sfc_key(SFCType curve, const std::array<std::uint64_t, dim>& coords, std::size_t bits)
+    {
+        return curve == SFCType::Morton ? detail::morton_key<dim>(coords, bits) : detail::hilbert_key<dim>(coords, bits);
+    }
+
+    /**
+     * Keys of the cells of a CellArray: the cells of all the levels are
+     * placed on the curve of the finest level, a cell of level l covering
+     * the keys of its descendants.
+     */
+    template <std::size_t dim, class value_t>
+    struct SFCMapping
+    {
+        SFCType curve;
+        std::size_t level; ///< Level of the curve
+        std::array<value_t, dim> origin;
+        std::size_t bits;
+
+        template <class Index>
+        std::uint64_t key(std::size_t cell_level, value_t i, const Index& index) const
+        {
+            const std::size_t shift = level - cell_level;
+            std::array<std::uint64_t, dim> coords;
+            coords[0] = static_cast<std::uint64_t>((i << shift) - origin[0]);
+            for (std::size_t d = 1; d < dim; ++d)
+            {
+                coords[d] = static_cast<std::uint64_t>((index[d - 1] << shift) - origin[d]);
+            }
+            return sfc_key<dim>(curve, coords, bits);
+        }
+
+        /// All the keys are lower than key_end()
+        std::uint64_t key_end() const
+        {
+            return std::uint64_t{1} << (dim * bits);
+        }
+    };
+
+    /**
+     * Curve covering the bounding box of the cells of all the processes, on
+     * the finest level of the cells.
+     */
+    template <std::size_t dim, class TInterval, std::size_t max_size>
+    auto make_sfc_mapping(const CellArray<dim, TInterval, max_size>& cells, SFCType curve)
+    {
+        using value_t = typename TInterval::value_t;
+
+        std::size_t level = 0;
+        for (std::size_t l = 0; l <= max_size; ++l)
+        {
+            if (!cells[l].empty())
+            {
+                level = l;
+            }
+        }
+#ifdef SAMURAI_WITH_MPI
+        mpi::communicator world;
+        level = mpi::all_reduce(world, level, mpi::maximum<std::size_t>());
+#endif
+
+        std::array<value_t, dim> min_corner;
+        std::array<value_t, dim> max_corner; // included
+        min_corner.fill(std::numeric_limits<value_t>::max());
+        max_corner.fill(std::numeric_limits<value_t>::min());
+        for_each_interval(cells,
+                          [&](std::size_t l, const auto& i, const auto& index)
+                          {
+                              const std::size_t shift = level - l;
+                              min_corner[0]           = std::min(min_corner[0], i.start << shift);
+                              max_corner[0]           = std::max(max_corner[0], (i.end << shift) - 1);
+                              for (std::size_t d = 1; d < dim; ++d)
+                              {
+                                  min_corner[d] = std::min(min_corner[d], index[d - 1] << shift);
+                                  max_corner[d] = std::max(max_corner[d], ((index[d - 1] + 1) << shift) - 1);
+                              }
+                          });
+#ifdef SAMURAI_WITH_MPI
+        std::array<value_t, dim> global_min;
+        std::array<value_t, dim> global_max;
+        mpi::all_reduce(world, min_corner.data(), static_cast<int>(dim), global_min.data(), mpi::minimum<value_t>());
+        mpi::all_reduce(world, max_corner.data(), static_cast<int>(dim), global_max.data(), mpi::maximum<value_t>());
+        min_corner = global_min;
+        max_corner = global_max;
+#endif
+
+        std::size_t bits = 0;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            if (max_corner[d] >= min_corner[d])
+            {
+                auto extent = static_cast<std::uint64_t>(max_corner[d] - min_corner[d]);
+                while ((extent >> bits) != 0)
+                {
+                    ++bits;
+                }
+            }
+        }
+        if (dim * bits >= 64)
+        {
+            throw std::runtime_error("The mesh is too fine for a space-filling curve on 64 bits");
+        }
+        return SFCMapping<dim, value_t>{curve, level, min_corner, bits};
+    }
+
+    namespace detail
+    {
+        /**
+         * Keys splitting the cells of all the processes in nb_parts parts of
+         * equal weight: the part r holds the keys k such that
+         * splitters[r - 1] <= k < splitters[r].
+         *
+         * The splitters are found together by bisection on the keys, with a
+         * reduction of the weights below the candidates at each iteration.
+         *
+         * @param cells (key, weight) of the local cells, sorted by key
+         */
+        inline std::vector<std::uint64_t>
+        sfc_splitters(const std::vector<std::pair<std::uint64_t, double>>& cells, std::size_t nb_parts, std::uint64_t key_end)
+        {
+            std::vector<double> prefix(cells.size() + 1, 0.);
+            for (std::size_t n = 0; n < cells.size(); ++n)
+            {
+                prefix[n + 1] = prefix[n] + cells[n].second;
+            }
+            auto weight_below = [&](std::uint64_t key)
+            {
+                auto it = std::lower_bound(cells.cbegin(),
+                                           cells.cend(),
+                                           key,
+                                           [](const auto& cell, std::uint64_t k)
+                                           {
+                                               return cell.first < k;
+                                           });
+                return prefix[static_cast<std::size_t>(it - cells.cbegin())];
+            };
+
+            std::vector<double> total{prefix.back()};
+            sfc_sum(total);
+
+            const std::size_t nb_splitters = nb_parts > 0 ? nb_parts - 1 : 0;
+            std::vector<std::uint64_t> lower(nb_splitters, 0);
+            std::vector<std::uint64_t> upper(nb_splitters, key_end);
+            std::vector<std::uint64_t> middle(nb_splitters);
+            std::vector<double> below(nb_splitters);
+
+            // The bounds only depend on reduced values: all the processes do the same iterations
+            auto converged = [&]()
+            {
+                for (std::size_t r = 0; r < nb_splitters; ++r)
+                {
+                    if (upper[r] - lower[r] > 1)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            while (!converged())
+            {
+                for (std::size_t r = 0; r < nb_splitters; ++r)
+                {
+                    middle[r] = lower[r] + (upper[r] - lower[r]) / 2;
+                    below[r]  = weight_below(middle[r]);
+                }
+                sfc_sum(below);
+                for (std::size_t r = 0; r < nb_splitters; ++r)
+                {
+                    const double target = total[0] * static_cast<double>(r + 1) / static_cast<double>(nb_parts);
+                    if (below[r] >= target)
+                    {
+                        upper[r] = middle[r];
+                    }
+                    else
+                    {
+                        lower[r] = middle[r];
+                    }
+                }
+            }
+            return upper;
+        }
+    }
+
+    /// Cells [start, end) of a row sent to the part rank
+    template <std::size_t dim, class TInterval>
+    struct SFCRun
+    {
+        using value_t = typename TInterval::value_t;
+        using index_t = typename TInterval::index_t;
+
+        std::size_t level;
+        value_t start;
+        value_t end;
+        xt::xtensor_fixed<value_t, xt::xshape<dim - 1>> index;
+        index_t storage; ///< Storage index of the cell start in the CellArray
+        int rank;
+    };
+
+    /**
+     * Splits the cells of all the processes in nb_parts parts of equal weight
+     * along the curve, and returns the runs of consecutive cells of the local
+     * intervals going to the same part.
+     *
+     * @param weight cost of a cell given by weight(level, storage index)
+     */
+    template <std::size_t dim, class TInterval, std::size_t max_size, class Weight>
+    auto sfc_partition(const CellArray<dim, TInterval, max_size>& cells, SFCType curve, std::size_t nb_parts, Weight&& weight)
+    {
+        using value_t = typename TInterval::value_t;
+        using index_t = typename TInterval::index_t;
+
+        auto mapping = make_sfc_mapping(cells, curve);
+
+        std::vector<std::uint64_t> keys;
+        std::vector<std::pair<std::uint64_t, double>> sorted_keys;
+        for_each_interval(cells,
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              for (value_t x = i.start; x < i.end; ++x)
+                              {
+                                  auto key = mapping.key(level, x, index);
+                                  keys.push_back(key);
+                                  sorted_keys.emplace_back(key, weight(level, static_cast<std::size_t>(x + i.index)));
+                              }
+                          });
+        std::sort(sorted_keys.begin(), sorted_keys.end());
+        auto splitters = detail::sfc_splitters(sorted_keys, nb_parts, mapping.key_end());
+
+        std::vector<SFCRun<dim, TInterval>> runs;
+        std::size_t n = 0;
+        for_each_interval(cells,
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              for (value_t x = i.start; x < i.end; ++x)
+                              {
+                                  auto rank = static_cast<int>(std::upper_bound(splitters.cbegin(), splitters.cend(), keys[n++])
+                                                               - splitters.cbegin());
+                                  if (x != i.start && runs.back().rank == rank)
+                                  {
+                                      runs.back().end = x + 1;
+                                  }
+                                  else
+                                  {
+                                      runs.push_back({level, x, x + 1, index, static_cast<index_t>(x + i.index), rank});
+                                  }
+                              }
+                          });
+        return runs;
+    }
+}
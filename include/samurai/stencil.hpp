@@ -82,6 +82,19 @@ namespace samurai
         return 0;
     }
 
+    /**
+     * Moves the cells of a stencil to the next position in the x-direction.
+     */
+    template <class cell_t, std::size_t stencil_size>
+    inline void move_next(std::array<cell_t, stencil_size>& cells)
+    {
+        for (cell_t& cell : cells)
+        {
+            cell.index++;      // increment cell index
+            cell.indices[0]++; // increment x-coordinate
+        }
+    }
+
     template <class Mesh, std::size_t stencil_size>
     class IteratorStencil
     {
@@ -178,11 +191,7 @@ namespace samurai
 
         void move_next()
         {
-            for (cell_t& cell : m_cells)
-            {
-                cell.index++;      // increment cell index
-                cell.indices[0]++; // increment x-coordinate
-            }
+            samurai::move_next(m_cells);
         }
 
         std::array<cell_t, stencil_size>& cells()
@@ -0,0 +1,101 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <xtensor/xfixed.hpp>
+
+namespace samurai
+{
+    namespace detail
+    {
+        template <class Mesh, class = void>
+        struct has_mesh_version : std::false_type
+        {
+        };
+
+        template <class Mesh>
+        struct has_mesh_version<Mesh, std::void_t<decltype(std::declval<const Mesh&>().version())>> : std::true_type
+        {
+        };
+
+        /// Version of the mesh, 0 if the mesh has no version
+        template <class Mesh>
+        inline std::size_t mesh_version(const Mesh& mesh)
+        {
+            if constexpr (has_mesh_version<Mesh>::value)
+            {
+                return mesh.version();
+            }
+            else
+            {
+                return 0;
+            }
+        }
+    }
+
+    /**
+     * @class StorageCursor
+     * @brief An interval of a subset with its position in the storage of the
+     * fields.
+     *
+     * The cursor is given by the traversals which already know where the
+     * interval is stored (see MaterializedSubset): a field defined on the mesh
+     * of the given version uses the offset without looking for the interval.
+     * Otherwise (offset == npos or other mesh), the interval is looked for as
+     * with the coordinates.
+     */
+    template <std::size_t Dim, class TInterval>
+    struct StorageCursor
+    {
+        static constexpr auto dim = Dim;
+        using interval_t          = TInterval;
+        using index_t             = typename interval_t::index_t;
+        using coord_index_t       = typename interval_t::coord_index_t;
+        using index_yz_t          = xt::xtensor_fixed<coord_index_t, xt::xshape<dim - 1>>;
+
+        /// Offset of an interval which is not in the storage
+        static constexpr index_t npos = std::numeric_limits<index_t>::max();
+
+        std::size_t level = 0;
+        interval_t interval;
+        index_yz_t index;
+        index_t offset      = npos; ///< Position of interval.start in the storage
+        std::size_t version = 0;    ///< Version of the mesh of the storage
+
+        StorageCursor() = default;
+
+        StorageCursor(std::size_t level_,
+                      const interval_t& interval_,
+                      const index_yz_t& index_,
+                      index_t offset_      = npos,
+                      std::size_t version_ = 0)
+            : level(level_)
+            , interval(interval_)
+            , index(index_)
+            , offset(offset_)
+            , version(version_)
+        {
+        }
+
+        /// True if the offset can be used for a field defined on a mesh of the given version
+        bool is_stored_in(std::size_t mesh_version) const
+        {
+            return offset != npos && version != 0 && version == mesh_version;
+        }
+
+        /**
+         * Cursor on a part of the interval (the even or the odd cells for
+         * example), with the same storage.
+         */
+        StorageCursor slice(const interval_t& part) const
+        {
+            return {level, part, index, offset == npos ? npos : offset + (part.start - interval.start), version};
+        }
+    };
+} // namespace samurai
@@ -0,0 +1,501 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef SAMURAI_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include <xtensor/xfixed.hpp>
+
+#include "../level_cell_array.hpp"
+#include "../profiling.hpp"
+#include "../storage_cursor.hpp"
+#include "subset_op_base.hpp"
+
+namespace samurai
+{
+    ///////////////////////////////////
+    // MaterializedSubset definition //
+    ///////////////////////////////////
+
+    /**
+     * @class MaterializedSubset
+     * @brief Flat evaluation of a subset at a given level.
+     *
+     * The sweep-line algorithm of the subset is run once and the resulting
+     * intervals are stored with their dim-1 coordinates and their offset in the
+     * storage of a LevelCellArray (the reference mesh of the level in
+     * general). The traversal is then a plain loop over these records, with
+     * the same interface as a subset: operator(), parallel_apply and apply_op.
+     * The functions and the operators which take a StorageCursor receive the
+     * offsets, so that the fields of the mesh do not look for the intervals.
+     *
+     * @tparam Dim        The dimension.
+     * @tparam TInterval  The interval type.
+     */
+    template <std::size_t Dim, class TInterval>
+    class MaterializedSubset
+    {
+      public:
+
+        static constexpr auto dim = Dim;
+        using interval_t          = TInterval;
+        using index_t             = typename interval_t::index_t;
+        using coord_index_t       = typename interval_t::coord_index_t;
+        using index_yz_t          = xt::xtensor_fixed<coord_index_t, xt::xshape<dim - 1>>;
+        using lca_type            = LevelCellArray<dim, interval_t>;
+        using cursor_t            = StorageCursor<dim, interval_t>;
+
+        /// Offset of an interval which is not in the storage
+        static constexpr index_t npos = cursor_t::npos;
+
+        struct record_t
+        {
+            interval_t interval;
+            index_yz_t index;
+            index_t offset; ///< Position of interval.start in the storage
+        };
+
+        MaterializedSubset() = default;
+
+        template <class Subset>
+        MaterializedSubset(Subset& set, const lca_type& storage, std::size_t version = 0);
+
+        template <class Subset>
+        void assign(Subset& set, const lca_type& storage, std::size_t version = 0);
+
+        void clear();
+
+        template <class Func>
+        void operator()(Func&& func) const;
+
+        template <class Func>
+        void parallel_apply(Func&& func) const;
+
+        template <class Func>
+        void colored_parallel_apply(std::size_t direction, Func&& func) const;
+
+        template <class... Op>
+        void apply_op(Op&&... op) const;
+
+        std::size_t level() const;
+        std::size_t version() const;
+        bool empty() const;
+        std::size_t nb_intervals() const;
+        std::size_t nb_cells() const;
+
+        const std::vector<record_t>& records() const;
+        cursor_t cursor(const record_t& record) const;
+
+      private:
+
+        template <class Func>
+        void call(Func&& func, const record_t& record) const;
+
+        std::vector<record_t> m_records;
+        std::size_t m_level   = 0;
+        std::size_t m_version = 0;
+    };
+
+    ////////////////////////////////
+    // SubsetPlanCache definition //
+    ////////////////////////////////
+
+    /**
+     * @class SubsetPlanCache
+     * @brief Materialized subsets identified by a name, an index, a level and
+     * a direction.
+     *
+     * The names are not copied: they must be string literals (or outlive the
+     * cache), so that a lookup does not allocate. The index distinguishes the
+     * subsets built at a same place of the code (e.g. for each direction of a
+     * region or each stencil size).
+     *
+     * All the plans are bound to a version of the mesh: they are dropped as
+     * soon as a plan is requested for another version. The cache is not
+     * thread-safe.
+     */
+    template <std::size_t Dim, class TInterval>
+    class SubsetPlanCache
+    {
+      public:
+
+        static constexpr auto dim = Dim;
+        using plan_t              = MaterializedSubset<dim, TInterval>;
+        using lca_type            = typename plan_t::lca_type;
+        using direction_t         = std::array<int, dim>;
+        using key_t               = std::tuple<std::string_view, std::size_t, std::size_t, direction_t>;
+
+        template <class Func>
+        const plan_t& get(std::string_view name, std::size_t level, const lca_type& storage, std::size_t version, Func&& make_subset);
+
+        template <class Vector, class Func>
+        const plan_t& get(std::string_view name,
+                          std::size_t level,
+                          const Vector& direction,
+                          const lca_type& storage,
+                          std::size_t version,
+                          Func&& make_subset);
+
+        template <class Vector, class Func>
+        const plan_t& get(std::string_view name,
+                          std::size_t index,
+                          std::size_t level,
+                          const Vector& direction,
+                          const lca_type& storage,
+                          std::size_t version,
+                          Func&& make_subset);
+
+        void clear();
+        std::size_t size() const;
+
+      private:
+
+        std::map<key_t, plan_t> m_plans;
+        std::size_t m_version = 0;
+    };
+
+    ///////////////////////////////////////
+    // MaterializedSubset implementation //
+    ///////////////////////////////////////
+
+    template <std::size_t Dim, class TInterval>
+    template <class Subset>
+    inline MaterializedSubset<Dim, TInterval>::MaterializedSubset(Subset& set, const lca_type& storage, std::size_t version)
+    {
+        assign(set, storage, version);
+    }
+
+    /**
+     * Evaluate the subset and store its intervals.
+     * @param set the subset to evaluate
+     * @param storage the cells where the offsets of the intervals are looked
+     * for (npos if an interval is not found or only partly)
+     * @param version the version of the mesh the subset is built on
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Subset>
+    inline void MaterializedSubset<Dim, TInterval>::assign(Subset& set, const lca_type& storage, std::size_t version)
+    {
+        SAMURAI_PROFILE_SCOPE_LEVEL("subset_plan/evaluation", set.level());
+
+        m_records.clear();
+        m_level   = set.level();
+        m_version = version;
+
+        xt::xtensor_fixed<coord_index_t, xt::xshape<dim>> coord;
+        set(
+            [&](const auto& interval, const auto& index)
+            {
+                coord[0] = interval.start;
+                for (std::size_t d = 0; d < dim - 1; ++d)
+                {
+                    coord[d + 1] = index[d];
+                }
+
+                index_t offset = npos;
+                if (!storage.empty())
+                {
+                    auto row = find(storage, coord);
+                    if (row != -1 && storage[0][static_cast<std::size_t>(row)].end >= interval.end)
+                    {
+                        offset = storage[0][static_cast<std::size_t>(row)].index + interval.start;
+                    }
+                }
+                m_records.push_back({interval, index, offset});
+            });
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void MaterializedSubset<Dim, TInterval>::clear()
+    {
+        m_records.clear();
+        m_version = 0;
+    }
+
+    /**
+     * Apply a function on each interval of the subset
+     * @param func function taking the interval and its dim-1 coordinates, and
+     * optionally the cursor of the interval
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Func>
+    inline void MaterializedSubset<Dim, TInterval>::operator()(Func&& func) const
+    {
+        for (const auto& r : m_records)
+        {
+            call(func, r);
+        }
+    }
+
+    /**
+     * Apply a function on each interval of the subset in parallel
+     * @param func thread-safe function taking the interval and its dim-1
+     * coordinates, and optionally the cursor of the interval
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Func>
+    inline void MaterializedSubset<Dim, TInterval>::parallel_apply(Func&& func) const
+    {
+#pragma omp parallel for schedule(static)
+        for (std::size_t r = 0; r < m_records.size(); ++r)
+        {
+            call(func, m_records[r]);
+        }
+    }
+
+    /**
+     * Apply a function on each interval of the subset in parallel, when
+     * the function writes on the cells of the interval and on their
+     * neighbours in the given direction.
+     *
+     * For a direction d > 0, the intervals of even coordinate in d are
+     * traversed first, then the ones of odd coordinate: the concurrent
+     * intervals never share a cell. Along x, two intervals of a row are
+     * separated by at least one cell. Each cell then receives its
+     * contributions in an order which does not depend on the number of
+     * threads.
+     * @param direction the Cartesian direction of the neighbours
+     * @param func function taking the interval and its dim-1 coordinates, and
+     * optionally the cursor of the interval
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Func>
+    inline void MaterializedSubset<Dim, TInterval>::colored_parallel_apply(std::size_t direction, Func&& func) const
+    {
+        assert(direction < dim);
+        const std::size_t nb_colors = direction == 0 ? 1 : 2;
+
+        auto color_of = [&](const record_t& r) -> std::size_t
+        {
+            if constexpr (dim > 1)
+            {
+                return direction == 0 ? 0 : static_cast<std::size_t>(r.index[direction - 1] & 1);
+            }
+            else
+            {
+                return 0;
+            }
+        };
+
+#pragma omp parallel
+        for (std::size_t color = 0; color < nb_colors; ++color)
+        {
+#pragma omp for schedule(static)
+            for (std::size_t r = 0; r < m_records.size(); ++r)
+            {
+                if (color_of(m_records[r]) == color)
+                {
+                    call(func, m_records[r]);
+                }
+            }
+        }
+    }
+
+    /**
+     * Apply one or more operators on the subset
+     *
+     * As for subset_operator, the records are traversed in parallel if
+     * OpenMP is enabled and all the operators are parallel. The operators
+     * which take a StorageCursor (see field_operator_function) receive the
+     * cursor of each interval.
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class... Op>
+    inline void MaterializedSubset<Dim, TInterval>::apply_op(Op&&... op) const
+    {
+        SAMURAI_PROFILE_SCOPE_LEVEL("subset_plan/apply_op", m_level);
+        auto apply = [&](auto& o, const cursor_t& cursor)
+        {
+            if constexpr (std::is_invocable_v<decltype(o), const cursor_t&>)
+            {
+                o(cursor);
+            }
+            else
+            {
+                o(m_level, cursor.interval, cursor.index);
+            }
+        };
+        auto func = [&](const interval_t&, const index_yz_t&, const cursor_t& cursor)
+        {
+            (void)std::initializer_list<int>{(apply(op, cursor), 0)...};
+        };
+
+#ifdef SAMURAI_WITH_OPENMP
+        if constexpr ((detail::is_parallel_op<std::decay_t<Op>>::value && ...))
+        {
+            if (omp_get_max_threads() > 1)
+            {
+                parallel_apply(func);
+                return;
+            }
+        }
+#endif
+        (*this)(func);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t MaterializedSubset<Dim, TInterval>::level() const
+    {
+        return m_level;
+    }
+
+    /// Version of the mesh on which the subset has been evaluated
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t MaterializedSubset<Dim, TInterval>::version() const
+    {
+        return m_version;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline bool MaterializedSubset<Dim, TInterval>::empty() const
+    {
+        return m_records.empty();
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t MaterializedSubset<Dim, TInterval>::nb_intervals() const
+    {
+        return m_records.size();
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t MaterializedSubset<Dim, TInterval>::nb_cells() const
+    {
+        std::size_t n = 0;
+        for (const auto& r : m_records)
+        {
+            n += r.interval.size();
+        }
+        return n;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto MaterializedSubset<Dim, TInterval>::records() const -> const std::vector<record_t>&
+    {
+        return m_records;
+    }
+
+    /// Cursor on the interval of the record, bound to the version of the plan
+    template <std::size_t Dim, class TInterval>
+    inline auto MaterializedSubset<Dim, TInterval>::cursor(const record_t& record) const -> cursor_t
+    {
+        return {m_level, record.interval, record.index, record.offset, m_version};
+    }
+
+    template <std::size_t Dim, class TInterval>
+    template <class Func>
+    inline void MaterializedSubset<Dim, TInterval>::call(Func&& func, const record_t& record) const
+    {
+        if constexpr (std::is_invocable_v<Func&, const interval_t&, const index_yz_t&, const cursor_t&>)
+        {
+            func(record.interval, record.index, cursor(record));
+        }
+        else
+        {
+            func(record.interval, record.index);
+        }
+    }
+
+    ////////////////////////////////////
+    // SubsetPlanCache implementation //
+    ////////////////////////////////////
+
+    /**
+     * Return the plan of the given name at the given level, evaluated from
+     * make_subset() if it is not in the cache for this version of the mesh.
+     * @param name the name of the subset (a string literal)
+     * @param level the level of the subset
+     * @param storage the reference cells of the level
+     * @param version the current version of the mesh
+     * @param make_subset function returning the subset at level
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Func>
+    inline auto SubsetPlanCache<Dim, TInterval>::get(std::string_view name,
+                                                     std::size_t level,
+                                                     const lca_type& storage,
+                                                     std::size_t version,
+                                                     Func&& make_subset) -> const plan_t&
+    {
+        return get(name, level, direction_t{}, storage, version, std::forward<Func>(make_subset));
+    }
+
+    /**
+     * Same as the preceding function for a subset that also depends on a
+     * direction.
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Vector, class Func>
+    inline auto SubsetPlanCache<Dim, TInterval>::get(std::string_view name,
+                                                     std::size_t level,
+                                                     const Vector& direction,
+                                                     const lca_type& storage,
+                                                     std::size_t version,
+                                                     Func&& make_subset) -> const plan_t&
+    {
+        return get(name, 0, level, direction, storage, version, std::forward<Func>(make_subset));
+    }
+
+    /**
+     * Same as the preceding function for one of several subsets of the same
+     * name, identified by index.
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Vector, class Func>
+    inline auto SubsetPlanCache<Dim, TInterval>::get(std::string_view name,
+                                                     std::size_t index,
+                                                     std::size_t level,
+                                                     const Vector& direction,
+                                                     const lca_type& storage,
+                                                     std::size_t version,
+                                                     Func&& make_subset) -> const plan_t&
+    {
+        if (version != m_version)
+        {
+            m_plans.clear();
+            m_version = version;
+        }
+
+        key_t key{name, index, level, {}};
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            std::get<3>(key)[d] = static_cast<int>(direction[d]);
+        }
+
+        auto [it, inserted] = m_plans.try_emplace(std::move(key));
+        if (inserted)
+        {
+            auto set = make_subset();
+            assert(set.level() == level);
+            it->second.assign(set, storage, version);
+        }
+        return it->second;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void SubsetPlanCache<Dim, TInterval>::clear()
+    {
+        m_plans.clear();
+        m_version = 0;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t SubsetPlanCache<Dim, TInterval>::size() const
+    {
+        return m_plans.size();
+    }
+} // namespace samurai
@@ -13,6 +13,7 @@
 // #include <spdlog/spdlog.h>
 // #include <spdlog/fwd.h>
 
+#include "../storage_cursor.hpp"
 #include "../utils.hpp"
 #include "node_op.hpp"
 
@@ -51,6 +52,7 @@ namespace samurai
 
         bool is_valid() const;
         bool is_empty() const;
+        std::size_t nb_intervals() const;
 
         void decrement_dim(coord_index_t i);
         void increment_dim();
@@ -63,6 +65,7 @@ namespace samurai
 
         const node_type& get_node() const;
         void get_interval_index(std::vector<std::size_t>& index) const;
+        void get_interval_storage(interval_t* storage, const interval_t& result) const;
 
       private:
 
@@ -130,6 +133,15 @@ namespace samurai
         return m_node.is_empty();
     }
 
+    /**
+     * Number of intervals to look for the current dimension
+     */
+    template <class T>
+    inline std::size_t subset_node<T>::nb_intervals() const
+    {
+        return m_end[m_d] - m_start[m_d];
+    }
+
     /**
      * Reset the internal data structures to replay
      * the subset algorithm
@@ -521,4 +533,30 @@ namespace samurai
     {
         index.push_back(m_index[m_d] + m_ipos[m_d] - 1);
     }
+
+    /**
+     * Store into storage the result with the position of its start in the
+     * storage of the node, if the current interval of the node holds the
+     * whole result. The node must be at the reference level and be the
+     * translation of a set (npos otherwise).
+     */
+    template <class T>
+    inline void subset_node<T>::get_interval_storage(interval_t* storage, const interval_t& result) const
+    {
+        *storage       = result;
+        storage->index = StorageCursor<dim, interval_t>::npos;
+
+        if (m_shift_ref != 0 || m_shift != 0 || m_ipos[m_d] != 1 || m_index[m_d] >= m_end[m_d])
+        {
+            return;
+        }
+        const auto interval = m_node.interval(m_d, m_index[m_d]);
+        const auto start    = m_node.start(m_d, m_index[m_d]);
+        const auto end      = m_node.end(m_d, m_index[m_d]);
+        const auto shift    = start - interval.start;
+        if (end - interval.end == shift && start <= result.start && result.end <= end)
+        {
+            storage->index = interval.index - shift;
+        }
+    }
 } // namespace samurai
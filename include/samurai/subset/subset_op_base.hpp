@@ -5,17 +5,57 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef SAMURAI_WITH_OPENMP
+#include <omp.h>
+#endif
 
 #include "../level_cell_array.hpp"
+#include "../profiling.hpp"
 #include "../static_algorithm.hpp"
+#include "../storage_cursor.hpp"
 #include "../utils.hpp"
 #include "subset_node.hpp"
 
 namespace samurai
 {
+    namespace detail
+    {
+        /// Number of chunks per thread used by the parallel traversal of a
+        /// subset (greater than 1 to smooth the load with a dynamic
+        /// schedule).
+        static constexpr std::size_t subset_chunks_per_thread = 4;
+
+        /// An operator can be applied in parallel on the rows of a subset if it
+        /// defines is_parallel to true (see field_operator_function).
+        template <class Op, class = void>
+        struct is_parallel_op : std::false_type
+        {
+        };
+
+        template <class Op>
+        struct is_parallel_op<Op, std::void_t<decltype(Op::is_parallel)>> : std::bool_constant<Op::is_parallel>
+        {
+        };
+
+        /// Number of sets (subset_node) of a subset, the ones of the nested subsets included
+        template <class T, class = void>
+        struct nb_leaves : std::integral_constant<std::size_t, 1>
+        {
+        };
+
+        template <class T>
+        struct nb_leaves<T, std::void_t<decltype(T::nb_leaves)>> : std::integral_constant<std::size_t, T::nb_leaves>
+        {
+        };
+    } // namespace detail
+
     ////////////////////////////////
     // subset_operator definition //
     ////////////////////////////////
@@ -38,6 +78,11 @@ namespace samurai
         static constexpr std::size_t dim = detail::compute_dim<CT...>();
         using interval_t                 = typename detail::interval_type<CT...>::type;
         using coord_index_t              = typename interval_t::coord_index_t;
+        using index_yz_t                 = xt::xtensor_fixed<coord_index_t, xt::xshape<dim - 1>>;
+
+        static constexpr std::size_t nb_leaves = (detail::nb_leaves<std::decay_t<CT>>::value + ...);
+        /// For each set, the interval of the result with the position of its start in the storage of the set
+        using storage_t = std::array<interval_t, nb_leaves>;
 
         subset_operator(F&& f, CT&&... e);
         auto on(std::size_t ref_level) const;
@@ -48,6 +93,9 @@ namespace samurai
         template <class Func>
         void apply_interval_index(Func&& func);
 
+        template <class Func>
+        void parallel_apply(Func&& func);
+
         template <class... Op>
         void apply_op(Op&&... op);
 
@@ -68,8 +116,12 @@ namespace samurai
         std::size_t level() const;
 
         bool is_empty() const;
+        std::size_t nb_intervals() const;
 
         void get_interval_index(std::vector<std::size_t>& index) const;
+        void get_interval_storage(interval_t* storage, const interval_t& result) const;
+
+        std::vector<std::pair<coord_index_t, coord_index_t>> chunks(std::size_t n_chunks);
 
       private:
 
@@ -103,6 +155,9 @@ namespace samurai
         template <std::size_t... I>
         bool is_empty_impl(std::index_sequence<I...>) const;
 
+        template <std::size_t... I>
+        std::size_t nb_intervals_impl(std::index_sequence<I...>) const;
+
         template <std::size_t... I>
         void set_shift_impl(std::index_sequence<I...>, std::size_t ref_level, std::size_t common_level);
 
@@ -115,9 +170,21 @@ namespace samurai
         template <class Func, std::size_t d>
         void apply(Func&& func, std::integral_constant<std::size_t, d>);
 
+        template <class Func>
+        void sweep(std::size_t d, Func&& on_result);
+
+        template <class Func>
+        void apply_by_chunks(Func&& func);
+
         template <std::size_t... I>
         void get_interval_index_impl(std::vector<std::size_t>& index, std::index_sequence<I...>) const;
 
+        template <std::size_t... I>
+        void get_interval_storage_impl(interval_t* storage, const interval_t& result, std::index_sequence<I...>) const;
+
+        template <class Func, class Set>
+        static void call(Func&& func, const interval_t& interval, const index_yz_t& index, const Set& set);
+
         //! The sets of the function defining the subset.
         tuple_type m_e;
         //! The function defining the subset (intersection, difference, union,
@@ -129,6 +196,10 @@ namespace samurai
         xt::xtensor_fixed<coord_index_t, xt::xshape<dim - 1>> m_index_yz;
         //! Intervals found for each dimension
         xt::xtensor_fixed<interval_t, xt::xshape<dim>> m_result;
+        //! Range of the outermost dimension to traverse (used by the parallel
+        //! traversal)
+        coord_index_t m_chunk_start = std::numeric_limits<coord_index_t>::min();
+        coord_index_t m_chunk_end   = std::numeric_limits<coord_index_t>::max();
     };
 
     ////////////////////////////////////
@@ -151,16 +222,18 @@ namespace samurai
 
     /**
      * Apply a function on the subset
-     * @param func function to apply on each element of the subset
+     * @param func function to apply on each element of the subset, taking
+     * the interval and its dim-1 coordinates, and optionally the storage_t of
+     * the interval
      */
     template <class F, class... CT>
     template <class Func>
     inline void subset_operator<F, CT...>::operator()(Func&& func)
     {
         reset();
-        auto func_hack = [&](auto& interval, auto& index, auto&)
+        auto func_hack = [&](auto& interval, auto& index, const auto& set)
         {
-            std::forward<Func>(func)(interval, index);
+            call(func, interval, index, set);
         };
 
         apply(func_hack, std::integral_constant<std::size_t, dim - 1>{});
@@ -175,16 +248,50 @@ namespace samurai
     inline void subset_operator<F, CT...>::apply_interval_index(Func&& func)
     {
         reset();
-        auto func_hack = [&](auto&, auto&, auto& interval_index)
+        auto func_hack = [&](auto&, auto&, const auto& set)
         {
+            std::vector<std::size_t> interval_index;
+            // Store into interval_index the intervals of each node that are
+            // in the subset.
+            set.get_interval_index(interval_index);
             std::forward<Func>(func)(interval_index);
         };
 
         apply(func_hack, std::integral_constant<std::size_t, dim - 1>{});
     }
 
+    /**
+     * Apply a function on the subset in parallel
+     *
+     * The outermost dimension is split in chunks with the same number of
+     * intervals which are traversed independently by the OpenMP threads.
+     * @param func thread-safe function to apply on each element of the subset
+     */
+    template <class F, class... CT>
+    template <class Func>
+    inline void subset_operator<F, CT...>::parallel_apply(Func&& func)
+    {
+        auto func_hack = [&](auto& interval, auto& index, const auto& set)
+        {
+            call(func, interval, index, set);
+        };
+
+        if constexpr (dim > 1)
+        {
+            apply_by_chunks(func_hack);
+        }
+        else
+        {
+            reset();
+            apply(func_hack, std::integral_constant<std::size_t, dim - 1>{});
+        }
+    }
+
     /**
      * Apply one or more operators on the subset
+     *
+     * If OpenMP is enabled and all the operators are parallel (see
+     * is_parallel_operator), the subset is traversed in parallel.
      * @param op operator to apply on each element of the subset
      * @sa operator
      */
@@ -192,11 +299,23 @@ namespace samurai
     template <class... Op>
     inline void subset_operator<F, CT...>::apply_op(Op&&... op)
     {
-        reset();
+        SAMURAI_PROFILE_SCOPE_LEVEL("subset/apply_op", m_ref_level);
         auto func = [&](auto& interval, auto& index, auto&)
         {
             (void)std::initializer_list<int>{(op(m_ref_level, interval, index), 0)...};
         };
+
+#ifdef SAMURAI_WITH_OPENMP
+        if constexpr (dim > 1 && (detail::is_parallel_op<std::decay_t<Op>>::value && ...))
+        {
+            if (omp_get_max_threads() > 1)
+            {
+                apply_by_chunks(func);
+                return;
+            }
+        }
+#endif
+        reset();
         apply(func, std::integral_constant<std::size_t, dim - 1>{});
     }
 
@@ -277,6 +396,70 @@ namespace samurai
         return is_empty_impl(std::make_index_sequence<sizeof...(CT)>());
     }
 
+    /**
+     * Return the number of intervals of the nodes for the current dimension.
+     *
+     * Used as a measure of the work needed to traverse the current position of
+     * the upper dimension.
+     */
+    template <class F, class... CT>
+    inline std::size_t subset_operator<F, CT...>::nb_intervals() const
+    {
+        return nb_intervals_impl(std::make_index_sequence<sizeof...(CT)>());
+    }
+
+    /**
+     * Split the outermost dimension of the subset in ranges [start, end[
+     * with the same number of intervals of the nodes.
+     * @param n_chunks the expected number of chunks
+     */
+    template <class F, class... CT>
+    inline auto subset_operator<F, CT...>::chunks(std::size_t n_chunks) -> std::vector<std::pair<coord_index_t, coord_index_t>>
+    {
+        std::vector<std::pair<coord_index_t, coord_index_t>> ranges;
+
+        // Positions along the outermost dimension with their number of
+        // intervals
+        std::vector<std::pair<coord_index_t, std::size_t>> rows;
+        std::size_t total = 0;
+
+        reset();
+        if (is_empty())
+        {
+            return ranges;
+        }
+        sweep(dim - 1,
+              [&](const interval_t& result)
+              {
+                  for (coord_index_t i = result.start; i < result.end; ++i)
+                  {
+                      decrement_dim(i);
+                      std::size_t weight = 1 + nb_intervals();
+                      increment_dim();
+                      rows.emplace_back(i, weight);
+                      total += weight;
+                  }
+              });
+
+        if (rows.empty())
+        {
+            return ranges;
+        }
+
+        n_chunks          = std::max(n_chunks, std::size_t(1));
+        std::size_t count = 0;
+        coord_index_t start = rows.front().first;
+        for (std::size_t r = 0; r < rows.size(); ++r)
+        {
+            count += rows[r].second;
+            if (r + 1 == rows.size() || count * n_chunks >= total * (ranges.size() + 1))
+            {
+                ranges.emplace_back(start, rows[r].first + 1);
+                start = rows[r].first + 1;
+            }
+        }
+        return ranges;
+    }
     /**
      * Initialize the next dimension with the interval found for the
      * current dimension.
@@ -355,7 +538,15 @@ namespace samurai
     template <class Func, std::size_t d>
     inline void subset_operator<F, CT...>::sub_apply(Func&& func, std::integral_constant<std::size_t, d>)
     {
-        for (int i = m_result[d].start; i < m_result[d].end; ++i)
+        coord_index_t start = m_result[d].start;
+        coord_index_t end   = m_result[d].end;
+        if constexpr (d == dim - 1)
+        {
+            start = std::max(start, m_chunk_start);
+            end   = std::min(end, m_chunk_end);
+        }
+
+        for (coord_index_t i = start; i < end; ++i)
         {
             m_index_yz[d - 1] = i;
 
@@ -373,11 +564,6 @@ namespace samurai
     template <class Func>
     inline void subset_operator<F, CT...>::sub_apply(Func&& func, std::integral_constant<std::size_t, 0>)
     {
-        std::vector<std::size_t> index;
-        // Store into index the intervals of each node that are
-        // in the subset.
-        get_interval_index(index);
-
         // If the ref_level <= to common_level then the result
         // is a projection to a lower level which means that the result
         // is already at the right level and we can call func on it.
@@ -386,7 +572,7 @@ namespace samurai
         // result on the ref_level before calling func on it.
         if (m_ref_level <= common_level())
         {
-            func(m_result[0], m_index_yz, index);
+            func(m_result[0], m_index_yz, *this);
         }
         else
         {
@@ -403,7 +589,7 @@ namespace samurai
                                         [&](auto stencil)
                                         {
                                             auto index_yz = xt::eval(shift_index_yz + stencil);
-                                            func(shift_result[0], index_yz, index);
+                                            func(shift_result[0], index_yz, *this);
                                         });
         }
     }
@@ -427,6 +613,22 @@ namespace samurai
             return;
         }
 
+        sweep(d,
+              [&](const interval_t& result)
+              {
+                  m_result[d] = result;
+                  sub_apply(std::forward<Func>(func), std::integral_constant<std::size_t, d>{});
+              });
+    }
+
+    /**
+     * Sweep line on the dimension d which calls on_result for each interval
+     * of the subset found.
+     */
+    template <class F, class... CT>
+    template <class Func>
+    inline void subset_operator<F, CT...>::sweep(std::size_t d, Func&& on_result)
+    {
         interval_t result;
         std::size_t r_ipos = 0;
 
@@ -466,8 +668,7 @@ namespace samurai
                     // spdlog::debug("result found {}", result);
                     if (result.is_valid())
                     {
-                        m_result[d] = result;
-                        sub_apply(std::forward<Func>(func), std::integral_constant<std::size_t, d>{});
+                        on_result(result);
                     }
                 }
             }
@@ -481,12 +682,82 @@ namespace samurai
         }
     }
 
+    /**
+     * Traverse the subset by chunks of the outermost dimension: each chunk is
+     * a copy of the subset restricted to a range of this dimension, so that the
+     * chunks can be evaluated by different threads.
+     */
+    template <class F, class... CT>
+    template <class Func>
+    inline void subset_operator<F, CT...>::apply_by_chunks(Func&& func)
+    {
+#ifdef SAMURAI_WITH_OPENMP
+        if (omp_in_parallel())
+        {
+            reset();
+            apply(func, std::integral_constant<std::size_t, dim - 1>{});
+            return;
+        }
+        std::size_t n_threads = static_cast<std::size_t>(omp_get_max_threads());
+#else
+        std::size_t n_threads = 1;
+#endif
+        auto ranges = chunks(detail::subset_chunks_per_thread * n_threads);
+
+#pragma omp parallel for schedule(dynamic)
+        for (std::size_t c = 0; c < ranges.size(); ++c)
+        {
+            subset_operator<F, CT...> chunk{*this};
+            chunk.m_chunk_start = ranges[c].first;
+            chunk.m_chunk_end   = ranges[c].second;
+            chunk.reset();
+            chunk.apply(func, std::integral_constant<std::size_t, dim - 1>{});
+        }
+    }
+
     template <class F, class... CT>
     inline void subset_operator<F, CT...>::get_interval_index(std::vector<std::size_t>& index) const
     {
         return get_interval_index_impl(index, std::make_index_sequence<sizeof...(CT)>());
     }
 
+    /**
+     * Store into storage, for each set, the result with the position of
+     * its start in the storage of the set (its index), or StorageCursor::npos
+     * if the set does not hold the whole result at the reference level.
+     */
+    template <class F, class... CT>
+    inline void subset_operator<F, CT...>::get_interval_storage(interval_t* storage, const interval_t& result) const
+    {
+        if (m_ref_level > common_level())
+        {
+            // The result is projected from the common level
+            for (std::size_t l = 0; l < nb_leaves; ++l)
+            {
+                storage[l]       = result;
+                storage[l].index = StorageCursor<dim, interval_t>::npos;
+            }
+            return;
+        }
+        get_interval_storage_impl(storage, result, std::make_index_sequence<sizeof...(CT)>());
+    }
+
+    template <class F, class... CT>
+    template <class Func, class Set>
+    inline void subset_operator<F, CT...>::call(Func&& func, const interval_t& interval, const index_yz_t& index, const Set& set)
+    {
+        if constexpr (std::is_invocable_v<Func&, const interval_t&, const index_yz_t&, const storage_t&>)
+        {
+            storage_t storage;
+            set.get_interval_storage(storage.data(), interval);
+            func(interval, index, storage);
+        }
+        else
+        {
+            func(interval, index);
+        }
+    }
+
     template <class F, class... CT>
     template <std::size_t... I>
     inline bool subset_operator<F, CT...>::eval_impl(coord_index_t scan, std::size_t d, std::index_sequence<I...>) const
@@ -501,6 +772,13 @@ namespace samurai
         return m_functor.is_empty(std::get<I>(m_e).is_empty()...);
     }
 
+    template <class F, class... CT>
+    template <std::size_t... I>
+    inline std::size_t subset_operator<F, CT...>::nb_intervals_impl(std::index_sequence<I...>) const
+    {
+        return (std::size_t(0) + ... + std::get<I>(m_e).nb_intervals());
+    }
+
     template <class F, class... CT>
     template <std::size_t... I>
     inline void subset_operator<F, CT...>::update_impl(coord_index_t scan, coord_index_t sentinel, std::index_sequence<I...>)
@@ -564,6 +842,19 @@ namespace samurai
         (void)std::initializer_list<int>{(std::get<I>(m_e).get_interval_index(index), 0)...};
     }
 
+    template <class F, class... CT>
+    template <std::size_t... I>
+    inline void
+    subset_operator<F, CT...>::get_interval_storage_impl(interval_t* storage, const interval_t& result, std::index_sequence<I...>) const
+    {
+        auto store = [&](const auto& set)
+        {
+            set.get_interval_storage(storage, result);
+            storage += detail::nb_leaves<std::decay_t<decltype(set)>>::value;
+        };
+        (store(std::get<I>(m_e)), ...);
+    }
+
     template <class D>
     class node_op;
 
@@ -1,13 +1,12 @@
-#ifdef SAMURAI_WITH_MPI
-#include <boost/mpi.hpp>
-#endif
 #include <gtest/gtest.h>
 
+#include <samurai/samurai.hpp>
+
 int main(int argc, char* argv[])
 {
-#ifdef SAMURAI_WITH_MPI
-    boost::mpi::environment env(argc, argv);
-#endif
+    samurai::initialize(argc, argv);
     ::testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
+    int result = RUN_ALL_TESTS();
+    samurai::finalize();
+    return result;
 }
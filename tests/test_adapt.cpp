@@ -33,4 +33,85 @@ namespace samurai
         adapt(1e-4, 2);
         ::samurai::finalize();
     }
+
+    TYPED_TEST(adapt_test, incremental)
+    {
+        ::samurai::initialize();
+
+        static constexpr std::size_t dim = TypeParam::value;
+        using config                     = MRConfig<dim>;
+        using mesh_id_t                  = typename MRMesh<config>::mesh_id_t;
+
+        auto init = [](auto& u)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              auto center = cell.center();
+                              u[cell]     = std::tanh(50. * (xt::sum(center)() - 0.5 * dim));
+                          });
+        };
+
+        auto mesh_1 = MRMesh<config>({xt::zeros<double>({dim}), xt::ones<double>({dim})}, 2, 5);
+        auto u_1    = make_field<double, 1>("u_1", mesh_1);
+        init(u_1);
+        auto adapt_1 = make_MRAdapt(u_1);
+        adapt_1(1e-3, 1);
+
+        auto mesh_2 = MRMesh<config>({xt::zeros<double>({dim}), xt::ones<double>({dim})}, 2, 5);
+        auto u_2    = make_field<double, 1>("u_2", mesh_2);
+        init(u_2);
+        auto adapt_2 = make_MRAdapt(u_2);
+        adapt_2.set_incremental();
+        EXPECT_TRUE(adapt_2.incremental());
+        adapt_2(1e-3, 1);
+
+        EXPECT_EQ(mesh_1[mesh_id_t::cells], mesh_2[mesh_id_t::cells]);
+        ::samurai::finalize();
+    }
+
+    TYPED_TEST(adapt_test, incremental_moving_front)
+    {
+        ::samurai::initialize();
+
+        static constexpr std::size_t dim = TypeParam::value;
+        using config                     = MRConfig<dim>;
+        using mesh_id_t                  = typename MRMesh<config>::mesh_id_t;
+
+        auto init = [](auto& u, double position)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              auto center = cell.center();
+                              u[cell]     = std::tanh(50. * (xt::sum(center)() - position * dim));
+                          });
+        };
+
+        auto mesh_full  = MRMesh<config>({xt::zeros<double>({dim}), xt::ones<double>({dim})}, 2, 5);
+        auto mesh_inc   = MRMesh<config>({xt::zeros<double>({dim}), xt::ones<double>({dim})}, 2, 5);
+        auto u_full     = make_field<double, 1>("u", mesh_full);
+        auto u_inc      = make_field<double, 1>("u", mesh_inc);
+        auto adapt_full = make_MRAdapt(u_full);
+        auto adapt_inc  = make_MRAdapt(u_inc);
+        adapt_inc.set_incremental();
+
+        // The front moves by a few cells of the finest level at each step
+        for (std::size_t step = 0; step < 6; ++step)
+        {
+            double position = 0.3 + 0.05 * static_cast<double>(step);
+            init(u_full, position);
+            init(u_inc, position);
+            adapt_full(1e-3, 1);
+            adapt_inc(1e-3, 1);
+
+            ASSERT_EQ(mesh_full[mesh_id_t::cells], mesh_inc[mesh_id_t::cells]) << "step " << step;
+            for_each_cell(mesh_full,
+                          [&](const auto& cell)
+                          {
+                              EXPECT_EQ(u_full[cell], u_inc[cell]);
+                          });
+        }
+        ::samurai::finalize();
+    }
 }
@@ -0,0 +1,82 @@
+#include <exception>
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/async_save.hpp>
+#include <samurai/checkpoint.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+
+namespace samurai
+{
+    TEST(async_save, snapshot)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_t              = MRMesh<config>;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        mesh_t mesh(box, 2, 3);
+        auto u = make_field<double, 1>("u", mesh);
+
+        auto path = std::filesystem::temp_directory_path();
+        {
+            AsyncSaver saver(1);
+            u.fill(1.);
+            saver.save(path, "samurai_test_async_1", mesh, u);
+            // The field can be modified as soon as save returns
+            u.fill(2.);
+            saver.save(path, "samurai_test_async_2", mesh, u);
+            EXPECT_LE(saver.nb_pending(), 1U);
+            u.fill(3.);
+            saver.wait();
+            EXPECT_EQ(saver.nb_pending(), 0U);
+        }
+
+        for (int i = 1; i <= 2; ++i)
+        {
+            std::string filename = fmt::format("samurai_test_async_{}", i);
+            {
+                HighFive::File file((path / (filename + ".h5")).string(), HighFive::File::ReadOnly);
+                std::vector<double> values;
+                file.getDataSet("/mesh/fields/u").read(values);
+                EXPECT_EQ(values.size(), mesh.nb_cells(mesh_t::mesh_id_t::cells));
+                EXPECT_EQ(values, std::vector<double>(values.size(), static_cast<double>(i)));
+            }
+            std::filesystem::remove(path / (filename + ".h5"));
+            std::filesystem::remove(path / (filename + ".xdmf"));
+        }
+    }
+
+    TEST(async_save, error)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_t              = MRMesh<config>;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        mesh_t mesh(box, 2, 3);
+        auto u = make_field<double, 1>("u", mesh);
+        u.fill(1.);
+
+        auto path = std::filesystem::temp_directory_path();
+        AsyncSaver saver(2);
+        // The file cannot be created: the error of the output thread is rethrown in the calling one
+        saver.save(path / "samurai_test_async_missing_directory", "samurai_test_async_error", mesh, u);
+        EXPECT_THROW(saver.wait(), std::exception);
+        EXPECT_NO_THROW(saver.wait());
+
+        // The checkpoints can be written while an output is pending
+        saver.save(path, "samurai_test_async_3", mesh, u);
+        save_checkpoint(path, "samurai_test_async_checkpoint", mesh, u);
+        EXPECT_NO_THROW(saver.wait());
+
+        EXPECT_TRUE(std::filesystem::exists(path / "samurai_test_async_3.h5"));
+        EXPECT_TRUE(std::filesystem::exists(path / "samurai_test_async_checkpoint.h5"));
+        std::filesystem::remove(path / "samurai_test_async_3.h5");
+        std::filesystem::remove(path / "samurai_test_async_3.xdmf");
+        std::filesystem::remove(path / "samurai_test_async_checkpoint.h5");
+    }
+}
@@ -0,0 +1,120 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include <samurai/numeric/batched_newton.hpp>
+
+namespace samurai
+{
+    TEST(batched_newton, converges_lane_by_lane)
+    {
+        constexpr std::size_t width = 4;
+        NewtonBatch<2, width> batch;
+        batch.size = 3;
+
+        // x0^2 = a, x0 x1 = c: solution (sqrt(a), c / sqrt(a))
+        std::array<double, width> a = {4, 1, 100, 0};
+        std::array<double, width> c = {2, 1, 20, 0};
+        for (std::size_t l = 0; l < batch.size; ++l)
+        {
+            batch.x[0][l] = 1;
+            batch.x[1][l] = 1;
+            batch.b[0][l] = a[l];
+            batch.b[1][l] = c[l];
+        }
+
+        BatchedNewton<2, width> newton;
+        newton.rtol = 1e-14;
+        newton.stol = 0;
+        auto status = newton.solve(
+            batch,
+            [](std::size_t, const auto& x, auto& fx)
+            {
+                fx[0] = x[0] * x[0];
+                fx[1] = x[0] * x[1];
+            },
+            [](std::size_t, const auto& x, auto& jac)
+            {
+                jac[0] = {2 * x[0], 0};
+                jac[1] = {x[1], x[0]};
+            });
+
+        EXPECT_EQ(status, NewtonStatus::Converged);
+        for (std::size_t l = 0; l < batch.size; ++l)
+        {
+            EXPECT_NEAR(batch.x[0][l], std::sqrt(a[l]), 1e-10);
+            EXPECT_NEAR(batch.x[1][l], c[l] / std::sqrt(a[l]), 1e-10);
+        }
+        // The second system is solved by the initial guess, the third one is the farthest
+        EXPECT_EQ(batch.iterations[1], std::size_t{0});
+        EXPECT_GT(batch.iterations[0], std::size_t{0});
+        EXPECT_GT(batch.iterations[2], batch.iterations[0]);
+    }
+
+    TEST(batched_newton, pivoting)
+    {
+        constexpr std::size_t width = 4;
+        NewtonBatch<2, width> batch;
+        batch.size = width;
+        for (std::size_t l = 0; l < width; ++l)
+        {
+            batch.x[0][l] = 0;
+            batch.x[1][l] = 0;
+            batch.b[0][l] = 1;
+            batch.b[1][l] = static_cast<double>(l);
+        }
+
+        // Linear systems, the first pivot of the odd lanes is zero
+        BatchedNewton<2, width> newton;
+        auto status = newton.solve(
+            batch,
+            [](std::size_t l, const auto& x, auto& fx)
+            {
+                double d = l % 2 == 0 ? 1 : 0;
+                fx[0]    = d * x[0] + x[1];
+                fx[1]    = x[0] + d * x[1] + x[1];
+            },
+            [](std::size_t l, const auto&, auto& jac)
+            {
+                double d = l % 2 == 0 ? 1 : 0;
+                jac[0]   = {d, 1};
+                jac[1]   = {1, d + 1};
+            });
+
+        EXPECT_EQ(status, NewtonStatus::Converged);
+        for (std::size_t l = 0; l < width; ++l)
+        {
+            double d = l % 2 == 0 ? 1 : 0;
+            EXPECT_NEAR(d * batch.x[0][l] + batch.x[1][l], 1, 1e-12);
+            EXPECT_NEAR(batch.x[0][l] + (d + 1) * batch.x[1][l], static_cast<double>(l), 1e-12);
+            EXPECT_EQ(batch.iterations[l], std::size_t{1});
+        }
+    }
+
+    TEST(batched_newton, max_iterations)
+    {
+        NewtonBatch<1, 4> batch;
+        batch.size    = 1;
+        batch.x[0][0] = 1;
+        batch.b[0][0] = -1;
+
+        // x^2 = -1 has no real solution
+        BatchedNewton<1, 4> newton;
+        newton.max_iterations = 10;
+        auto status           = newton.solve(
+            batch,
+            [](std::size_t, const auto& x, auto& fx)
+            {
+                fx[0] = x[0] * x[0];
+            },
+            [](std::size_t, const auto& x, auto& jac)
+            {
+                jac[0][0] = 2 * x[0];
+            });
+
+        EXPECT_NE(status, NewtonStatus::Converged);
+        EXPECT_TRUE(status == NewtonStatus::MaxIterations || status == NewtonStatus::Diverged);
+    }
+}
@@ -74,4 +74,24 @@ namespace samurai
         EXPECT_EQ(u.get_bc()[0]->value({1}, cell, coords), 0);
     }
 
+    TEST(bc, extrapolation_cache)
+    {
+        static constexpr std::size_t dim = 2;
+        using config                     = MRConfig<dim>;
+        Box<double, dim> box{{0, 0}, {1, 1}};
+        auto mesh = MRMesh<config>(box, 2, 4);
+        auto u    = make_field<double, 1>("u", mesh);
+        u.fill(1.);
+        make_bc<Dirichlet<1>>(u, 1.);
+
+        update_bc(u);
+        const auto* bc = &u.extrapolation_bc().get<2>(mesh.domain(), mesh.version());
+        update_bc(u);
+        EXPECT_EQ(&u.extrapolation_bc().get<2>(mesh.domain(), mesh.version()), bc);
+
+        // The copies build their own extrapolations
+        auto v = u;
+        EXPECT_NE(&v.extrapolation_bc().get<2>(mesh.domain(), mesh.version()), bc);
+    }
+
 }
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <samurai/cell_array.hpp>
 #include <samurai/cell_list.hpp>
+#include <samurai/subset/subset_op.hpp>
 
 namespace samurai
 {
@@ -10,4 +12,39 @@ namespace samurai
 
         CellList<dim> cell_list;
     }
+
+    TEST(cell_list, parallel_fill)
+    {
+        constexpr size_t dim = 2;
+
+        LevelCellList<dim> lcl{4};
+        for (int j = 0; j < 40; ++j)
+        {
+            lcl[{j}].add_interval({j % 7, 10 + j % 5});
+            lcl[{j}].add_interval({14 + j % 3, 20});
+        }
+        LevelCellArray<dim> lca{lcl};
+
+        // Cells and their neighbours in y on the levels 4 and 3
+        auto add_cells = [](const auto& i, const auto& index, auto& cell_list)
+        {
+            for (int s = -1; s <= 1; ++s)
+            {
+                cell_list[4][{index[0] + s}].add_interval(i);
+                cell_list[3][{(index[0] >> 1) + s}].add_interval(i >> 1);
+            }
+        };
+
+        CellList<dim> expected;
+        auto set = intersection(lca, lca);
+        set(
+            [&](const auto& i, const auto& index)
+            {
+                add_cells(i, index, expected);
+            });
+
+        CellList<dim> cell_list;
+        parallel_fill(set, add_cells, cell_list);
+        EXPECT_EQ(CellArray<dim>(cell_list), CellArray<dim>(expected));
+    }
 }
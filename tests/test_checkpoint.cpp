@@ -0,0 +1,81 @@
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/bc.hpp>
+#include <samurai/checkpoint.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+
+namespace samurai
+{
+    TEST(checkpoint, save_and_load)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_t              = MRMesh<config>;
+        using mesh_id_t           = typename mesh_t::mesh_id_t;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        mesh_t mesh(box, 2, 4);
+        auto u = make_field<double, 1>("u", mesh);
+        auto v = make_field<double, 2>("v", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          u[cell]    = cell.center(0);
+                          v[cell][0] = cell.center(1);
+                          v[cell][1] = static_cast<double>(cell.index);
+                      });
+        make_bc<Dirichlet<1>>(u, 0.);
+
+        auto path = std::filesystem::temp_directory_path();
+        save_checkpoint(path, "samurai_test_checkpoint", mesh, u, v);
+
+        mesh_t restored;
+        auto u_restored = make_field<double, 1>("u", restored);
+        auto v_restored = make_field<double, 2>("v", restored);
+        load_checkpoint(path, "samurai_test_checkpoint", restored, u_restored, v_restored);
+
+        EXPECT_NE(restored.version(), mesh.version());
+        EXPECT_EQ(restored.min_level(), mesh.min_level());
+        EXPECT_EQ(restored.max_level(), mesh.max_level());
+        for (std::size_t id = 0; id < static_cast<std::size_t>(mesh_id_t::count); ++id)
+        {
+            auto mesh_id = static_cast<mesh_id_t>(id);
+            for (std::size_t level = 0; level <= mesh_t::max_refinement_level; ++level)
+            {
+                const auto& lca          = mesh[mesh_id][level];
+                const auto& lca_restored = restored[mesh_id][level];
+                EXPECT_EQ(lca_restored.level(), level);
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    // The storage indices are part of the comparison of the intervals
+                    EXPECT_EQ(lca_restored[d], lca[d]);
+                }
+                EXPECT_EQ(lca_restored.offsets(1), lca.offsets(1));
+            }
+        }
+        EXPECT_EQ(u_restored.array(), u.array());
+        EXPECT_EQ(v_restored.array(), v.array());
+
+        // The boundary conditions are attached again after the loading
+        make_bc<Dirichlet<1>>(u_restored, 0.);
+        EXPECT_NO_THROW(check_checkpoint_bc(path, "samurai_test_checkpoint", u_restored, v_restored));
+        make_bc<Neumann<1>>(v_restored, 0., 0.);
+        EXPECT_THROW(check_checkpoint_bc(path, "samurai_test_checkpoint", v_restored), std::runtime_error);
+
+        // The description does not depend on the ABI of the compiler
+        {
+            std::vector<std::string> stored;
+            HighFive::File file((path / "samurai_test_checkpoint.h5").string(), HighFive::File::ReadOnly);
+            file.getDataSet("/fields/u/bc").read(stored);
+            EXPECT_EQ(stored, std::vector<std::string>{"DirichletImpl (stencil size 2, constant value)"});
+        }
+
+        std::filesystem::remove(path / "samurai_test_checkpoint.h5");
+    }
+}
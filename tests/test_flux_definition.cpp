@@ -0,0 +1,101 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/mr/mesh.hpp>
+#include <samurai/schemes/fv.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        template <std::size_t field_size>
+        auto create_field()
+        {
+            static constexpr std::size_t dim = 2;
+            using config                     = MRConfig<dim, 3>;
+            using mesh_t                     = MRMesh<config>;
+
+            Box<double, dim> box{{0, 0}, {1, 1}};
+            auto mesh = mesh_t(box, 2, 4);
+            auto u    = make_field<double, field_size>("u", mesh);
+
+            // Values of both signs, to use both upwind directions
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              auto x = cell.center(0);
+                              auto y = cell.center(1);
+                              for (std::size_t i = 0; i < field_size; ++i)
+                              {
+                                  field_value(u, cell, i) = std::sin(6 * x + static_cast<double>(i)) * std::cos(4 * y);
+                              }
+                          });
+            make_bc<Dirichlet<3>>(u);
+            return u;
+        }
+
+        /// Same flux definition as @param scheme, but with the type-erased flux functions
+        template <class Scheme>
+        auto type_erased(const Scheme& scheme)
+        {
+            using cfg = FluxConfig<Scheme::cfg_t::scheme_type,
+                                   Scheme::cfg_t::output_field_size,
+                                   Scheme::cfg_t::stencil_size,
+                                   typename Scheme::cfg_t::input_field_t>;
+
+            FluxDefinition<cfg> flux_definition;
+            for (std::size_t d = 0; d < cfg::dim; ++d)
+            {
+                flux_definition[d].stencil            = scheme.flux_definition()[d].stencil;
+                flux_definition[d].cons_flux_function = scheme.flux_definition()[d].cons_flux_function;
+            }
+            return make_flux_based_scheme(flux_definition);
+        }
+
+        template <class Field>
+        void expect_equal(const Field& f1, const Field& f2)
+        {
+            for_each_cell(f1.mesh(),
+                          [&](const auto& cell)
+                          {
+                              for (std::size_t i = 0; i < Field::size; ++i)
+                              {
+                                  EXPECT_NEAR(field_value(f1, cell, i), field_value(f2, cell, i), 1e-12);
+                              }
+                          });
+        }
+    }
+
+    TEST(flux_definition, static_upwind)
+    {
+        auto u = create_field<1>();
+
+        auto conv = make_convection_upwind<decltype(u)>();
+        static_assert(has_static_flux_v<decltype(conv)::cfg_t>);
+        expect_equal(conv(u), type_erased(conv)(u));
+
+        auto v     = create_field<2>();
+        auto conv2 = make_convection_upwind<decltype(v)>();
+        expect_equal(conv2(v), type_erased(conv2)(v));
+    }
+
+    TEST(flux_definition, static_weno5)
+    {
+        auto u = create_field<1>();
+
+        auto conv = make_convection_weno5<decltype(u)>();
+        expect_equal(conv(u), type_erased(conv)(u));
+    }
+
+    TEST(flux_definition, static_algebra)
+    {
+        auto u = create_field<1>();
+
+        auto conv = make_convection_weno5<decltype(u)>();
+        auto ref  = type_erased(conv);
+        expect_equal((0.5 * conv)(u), (0.5 * ref)(u));
+        expect_equal((-conv)(u), (-ref)(u));
+        expect_equal((conv + conv)(u), (ref + ref)(u));
+    }
+}
@@ -0,0 +1,122 @@
+#include <cmath>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include <samurai/algorithm/update.hpp>
+#include <samurai/bc.hpp>
+#include <samurai/box.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+
+namespace samurai
+{
+    TEST(ghost_exchange, apply_on_all_the_cells)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_id_t           = typename MRMesh<config>::mesh_id_t;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        MRMesh<config> mesh(box, 2, 4);
+        auto u = make_field<double, 2>("u", mesh);
+        auto v = make_field<double, 1>("v", mesh);
+        u.fill(0.);
+        v.fill(0.);
+
+        // Each cell is computed once: in the first call on a single process
+        for (std::size_t level = mesh.min_level(); level <= mesh.max_level(); ++level)
+        {
+            std::size_t nb_calls = 0;
+            apply_with_ghost_exchange(
+                level,
+                2,
+                [&](const auto& plan)
+                {
+                    if (nb_calls == 1)
+                    {
+                        EXPECT_TRUE(plan.empty());
+                    }
+                    plan(
+                        [&](const auto& i, const auto& index, const auto& cursor)
+                        {
+                            EXPECT_EQ(cursor.offset, u.storage_offset(u.storage_cursor(level, i, index[0])));
+                            u(cursor) += 1.;
+                        });
+                    ++nb_calls;
+                },
+                u);
+            EXPECT_EQ(nb_calls, std::size_t{2});
+            EXPECT_EQ(u.ghost_exchange().interior(mesh, level, 2).nb_cells(), mesh[mesh_id_t::cells][level].nb_cells());
+        }
+
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(u[cell][0], 1.);
+                          EXPECT_EQ(u[cell][1], 1.);
+                      });
+
+        // The exchanges without neighbours leave the field unchanged
+        update_ghost_subdomains(u);
+        update_ghost_subdomains(mesh.max_level(), u, v);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(u[cell][0], 1.);
+                      });
+    }
+
+    TEST(ghost_exchange, projection_during_the_exchange)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_id_t           = typename MRMesh<config>::mesh_id_t;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        MRMesh<config> mesh(box, 2, 6);
+        auto u = make_field<double, 1>("u", mesh);
+        make_bc<Dirichlet<1>>(u, 0.);
+
+        auto init = [&]()
+        {
+            u.fill(-1.);
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              u[cell] = std::tanh(20. * (cell.center(0) + cell.center(1) - 1.));
+                          });
+        };
+        init();
+        auto adapt = make_MRAdapt(u);
+        adapt(1e-3, 1);
+        ASSERT_LT(mesh[mesh_id_t::cells].min_level(), mesh[mesh_id_t::cells].max_level());
+
+        init();
+        update_ghost_mr(u);
+        auto expected = u.array();
+
+        // The parents of each level are split between the two phases of the exchange
+        for (std::size_t level = mesh[mesh_id_t::cells].min_level() + 1; level <= mesh[mesh_id_t::cells].max_level(); ++level)
+        {
+            auto parents = intersection(mesh[mesh_id_t::reference][level], mesh[mesh_id_t::proj_cells][level - 1]).on(level - 1);
+            std::size_t nb_parents = 0;
+            parents(
+                [&](const auto& i, const auto&)
+                {
+                    nb_parents += i.size();
+                });
+            const auto& interior = u.ghost_exchange().projection_interior(mesh, level);
+            const auto& boundary = u.ghost_exchange().projection_boundary(mesh, level);
+            EXPECT_EQ(interior.nb_cells() + boundary.nb_cells(), nb_parents);
+        }
+
+        // With a neighbour (without cells), the projection is split: the ghosts are the same
+        mesh.mpi_neighbourhood().emplace_back(0);
+        init();
+        update_ghost_mr(u);
+        mesh.mpi_neighbourhood().clear();
+        EXPECT_EQ(u.array(), expected);
+    }
+}
@@ -0,0 +1,191 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/cell_array.hpp>
+#include <samurai/cell_list.hpp>
+#include <samurai/field.hpp>
+#include <samurai/hdf5.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        /// Points (x, y, z) and connectivity (flattened by cell) of a mesh
+        template <class Mesh>
+        auto points_and_connectivity(const Mesh& mesh)
+        {
+            std::size_t nb_points = 0;
+            std::vector<std::array<double, 3>> coords;
+            std::vector<std::size_t> connectivity;
+            for_each_point_and_connectivity(
+                mesh,
+                [&](std::size_t n)
+                {
+                    nb_points = n;
+                },
+                [&](const std::array<double, 3>& point)
+                {
+                    coords.push_back(point);
+                },
+                [&](std::size_t id)
+                {
+                    // The points are passed before the corners using them
+                    EXPECT_LT(id, coords.size());
+                    connectivity.push_back(id);
+                });
+            EXPECT_EQ(coords.size(), nb_points);
+            return std::make_pair(coords, connectivity);
+        }
+    }
+
+    TEST(hdf5, coords_and_connectivity)
+    {
+        constexpr std::size_t dim = 2;
+
+        CellList<dim> cell_list;
+        cell_list[1][{0}].add_interval({-1, 1});
+        cell_list[2][{2}].add_interval({-2, 2});
+        cell_list[2][{3}].add_interval({-2, 0});
+        cell_list[3][{7}].add_interval({0, 4});
+        CellArray<dim> cell_array(cell_list);
+
+        auto [coords, connectivity] = points_and_connectivity(cell_array);
+        ASSERT_EQ(connectivity.size(), cell_array.nb_cells() * 4);
+
+        auto element = get_element(std::integral_constant<std::size_t, dim>{});
+        std::set<std::array<double, dim>> points;
+        std::size_t index       = 0;
+        std::size_t max_seen_id = 0;
+        for_each_cell(cell_array,
+                      [&](const auto& cell)
+                      {
+                          for (std::size_t e = 0; e < element.size(); ++e)
+                          {
+                              auto id = connectivity[index * element.size() + e];
+                              ASSERT_LT(id, coords.size());
+                              // The points are numbered in the order of their first appearance
+                              EXPECT_LE(id, max_seen_id + (index == 0 && e == 0 ? 0 : 1));
+                              max_seen_id = std::max(max_seen_id, id);
+
+                              std::array<double, dim> corner;
+                              for (std::size_t d = 0; d < dim; ++d)
+                              {
+                                  corner[d] = cell.corner(d) + cell.length * static_cast<double>(element[e][d]);
+                                  EXPECT_EQ(coords[id][d], corner[d]);
+                              }
+                              EXPECT_EQ(coords[id][2], 0.);
+                              points.insert(corner);
+                          }
+                          ++index;
+                      });
+        EXPECT_EQ(coords.size(), points.size());
+    }
+
+    TEST(hdf5, compact_and_chunks)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_t              = MRMesh<config>;
+        using mesh_id_t           = typename mesh_t::mesh_id_t;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        mesh_t mesh(box, 2, 5);
+        auto u = make_field<double, 1>("u", mesh);
+        auto v = make_field<double, 2>("v", mesh);
+
+        auto init = [&]()
+        {
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              auto x     = cell.center(0);
+                              auto y     = cell.center(1);
+                              u[cell]    = std::tanh(40. * (x + y - 1.));
+                              v[cell][0] = x;
+                              v[cell][1] = u[cell] * y;
+                          });
+        };
+        init();
+        auto adapt = make_MRAdapt(u);
+        adapt(1e-3, 1);
+        v.resize();
+        init();
+
+        const auto& cells = mesh[mesh_id_t::cells];
+        ASSERT_GT(cells.max_level(), cells.min_level());
+
+        auto path = std::filesystem::temp_directory_path();
+        for (bool compact : {false, true})
+        {
+            std::string filename = compact ? "samurai_hdf5_compact" : "samurai_hdf5_chunks";
+            Hdf5Options<Mesh_base<mesh_t, config>> options;
+            options.compact    = compact;
+            options.chunk_size = 3; // Smaller than the data: several chunks per dataset
+            save(path, filename, options, mesh, u, v);
+
+            HighFive::File file((path / (filename + ".h5")).string(), HighFive::File::ReadOnly);
+
+            // Fields, in the order of the cells
+            std::vector<double> u_values;
+            std::vector<double> v0_values;
+            std::vector<double> v1_values;
+            file.getDataSet("/mesh/fields/u").read(u_values);
+            file.getDataSet("/mesh/fields/v_0").read(v0_values);
+            file.getDataSet("/mesh/fields/v_1").read(v1_values);
+            ASSERT_EQ(u_values.size(), cells.nb_cells());
+            ASSERT_EQ(v0_values.size(), cells.nb_cells());
+            ASSERT_EQ(v1_values.size(), cells.nb_cells());
+            std::size_t index = 0;
+            for_each_cell(cells,
+                          [&](const auto& cell)
+                          {
+                              EXPECT_EQ(u_values[index], u[cell]);
+                              EXPECT_EQ(v0_values[index], v[cell][0]);
+                              EXPECT_EQ(v1_values[index], v[cell][1]);
+                              ++index;
+                          });
+
+            if (compact)
+            {
+                // The mesh is rebuilt from the intervals (level, start, end, y)
+                EXPECT_EQ(load_compact<dim>(path, filename), cells);
+                EXPECT_FALSE(file.exist("/mesh/connectivity"));
+            }
+            else
+            {
+                auto [coords, connectivity] = points_and_connectivity(cells);
+                std::vector<std::vector<std::size_t>> connectivity_read;
+                std::vector<std::vector<double>> points_read;
+                file.getDataSet("/mesh/connectivity").read(connectivity_read);
+                file.getDataSet("/mesh/points").read(points_read);
+                ASSERT_EQ(connectivity_read.size(), cells.nb_cells());
+                ASSERT_EQ(points_read.size(), coords.size());
+                for (std::size_t c = 0; c < connectivity_read.size(); ++c)
+                {
+                    ASSERT_EQ(connectivity_read[c].size(), std::size_t{1} << dim);
+                    for (std::size_t e = 0; e < connectivity_read[c].size(); ++e)
+                    {
+                        EXPECT_EQ(connectivity_read[c][e], connectivity[c * connectivity_read[c].size() + e]);
+                    }
+                }
+                for (std::size_t p = 0; p < points_read.size(); ++p)
+                {
+                    for (std::size_t d = 0; d < 3; ++d)
+                    {
+                        EXPECT_EQ(points_read[p][d], coords[p][d]);
+                    }
+                }
+            }
+            std::filesystem::remove(path / (filename + ".h5"));
+            std::filesystem::remove(path / (filename + ".xdmf"));
+        }
+    }
+}
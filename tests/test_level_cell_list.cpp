@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <xtensor/xarray.hpp>
 
+#include <samurai/level_cell_array.hpp>
 #include <samurai/level_cell_list.hpp>
 
 namespace samurai
@@ -11,4 +12,30 @@ namespace samurai
         LevelCellList<dim> lcl;
         lcl[{0}].add_interval({-3, 3});
     }
+
+    TEST(level_cell_list, merge)
+    {
+        constexpr size_t dim = 2;
+        LevelCellList<dim> lcl{3};
+        LevelCellList<dim> lcl_1{3};
+        LevelCellList<dim> lcl_2;
+
+        for (int j = 0; j < 10; ++j)
+        {
+            lcl[{j}].add_interval({j, j + 4});
+            (j < 6 ? lcl_1 : lcl_2)[{j}].add_interval({j, j + 4});
+        }
+        // Overlapping rows and intervals
+        for (int j = 4; j < 8; ++j)
+        {
+            lcl[{j}].add_interval({-2 * j, -j});
+            lcl[{j}].add_interval({j + 3, j + 6});
+            lcl_2[{j}].add_interval({-2 * j, -j});
+            lcl_2[{j}].add_interval({j + 3, j + 6});
+        }
+
+        lcl_1.merge(std::move(lcl_2));
+        EXPECT_EQ(lcl_1.level(), 3U);
+        EXPECT_EQ(LevelCellArray<dim>(lcl_1), LevelCellArray<dim>(lcl));
+    }
 }
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/schemes/fv.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        template <class Field>
+        void init(Field& u)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              double x = cell.center(0);
+                              u[cell]  = std::exp(-20. * x * x);
+                          });
+        }
+
+        template <class Field>
+        double mass(const Field& u)
+        {
+            double m = 0;
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              m += u[cell] * cell.length;
+                          });
+            return m;
+        }
+    }
+
+    TEST(local_time_stepping, single_level)
+    {
+        using config = MRConfig<1>;
+        Box<double, 1> box({-1}, {1});
+        MRMesh<config> mesh(box, 5, 5);
+        auto u = make_field<double, 1>("u", mesh);
+        init(u);
+        make_bc<Dirichlet<1>>(u, 0.);
+        auto conv = make_convection_upwind<decltype(u)>();
+
+        // Without level jump, a step is a step of explicit Euler
+        auto expected = make_field<double, 1>("expected", mesh);
+        expected.copy_bc_from(u);
+        expected.array() = u.array();
+        update_ghost_mr(expected);
+        auto conv_u = conv(expected);
+
+        LocalTimeStepping<decltype(u)> lts;
+        double dt = 0.5 * cell_length(5);
+        EXPECT_EQ(lts.nb_substeps(mesh), 1U);
+        EXPECT_EQ(lts.step(conv, u, dt), dt);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_NEAR(u[cell], expected[cell] - dt * conv_u[cell], 1e-14);
+                      });
+    }
+
+    TEST(local_time_stepping, conservation)
+    {
+        using config    = MRConfig<1>;
+        using mesh_id_t = MRMesh<config>::mesh_id_t;
+        Box<double, 1> box({-1}, {1});
+        MRMesh<config> mesh(box, 3, 7);
+        auto u = make_field<double, 1>("u", mesh);
+        init(u);
+        make_bc<Dirichlet<1>>(u, 0.);
+        auto adapt = make_MRAdapt(u);
+        adapt(1e-3, 1);
+        ASSERT_LT(mesh[mesh_id_t::cells].min_level(), mesh[mesh_id_t::cells].max_level());
+
+        auto conv = make_convection_upwind<decltype(u)>();
+        LocalTimeStepping<decltype(u)> lts;
+        std::size_t nb_substeps = lts.nb_substeps(mesh);
+        double dt               = 0.5 * cell_length(mesh[mesh_id_t::cells].max_level());
+
+        // The solution vanishes on the boundary: the fluxes through the level jumps must balance
+        double initial_mass = mass(u);
+        EXPECT_EQ(lts.step(conv, u, dt), dt * static_cast<double>(nb_substeps));
+        EXPECT_NEAR(mass(u), initial_mass, 1e-12);
+    }
+
+    TEST(local_time_stepping, global_time_stepping)
+    {
+        using config    = MRConfig<1>;
+        using mesh_id_t = MRMesh<config>::mesh_id_t;
+        Box<double, 1> box({-1}, {1});
+        MRMesh<config> mesh(box, 3, 7);
+        auto u = make_field<double, 1>("u", mesh);
+        init(u);
+        make_bc<Dirichlet<1>>(u, 0.);
+        auto adapt = make_MRAdapt(u);
+        adapt(1e-3, 1);
+        ASSERT_LT(mesh[mesh_id_t::cells].min_level() + 1, mesh[mesh_id_t::cells].max_level());
+
+        auto u_global = make_field<double, 1>("u_global", mesh);
+        u_global.copy_bc_from(u);
+        u_global.array()  = u.array();
+        auto u_initial    = make_field<double, 1>("u_initial", mesh);
+        u_initial.array() = u.array();
+
+        auto conv = make_convection_upwind<decltype(u)>();
+        LocalTimeStepping<decltype(u)> lts;
+        std::size_t nb_substeps = lts.nb_substeps(mesh);
+        double dt               = 0.5 * cell_length(mesh[mesh_id_t::cells].max_level());
+        lts.step(conv, u, dt);
+
+        // The same time with the time step of the finest level everywhere
+        for (std::size_t k = 0; k < nb_substeps; ++k)
+        {
+            update_ghost_mr(u_global);
+            auto conv_u = conv(u_global);
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              u_global[cell] -= dt * conv_u[cell];
+                          });
+        }
+
+        // The coarse cells are advanced with larger time steps: both solutions only agree up to the time error
+        double max_change = 0;
+        double max_diff   = 0;
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          max_change = std::max(max_change, std::abs(u_global[cell] - u_initial[cell]));
+                          max_diff   = std::max(max_diff, std::abs(u[cell] - u_global[cell]));
+                      });
+        EXPECT_GT(max_change, 1e-2);
+        EXPECT_LT(max_diff, 0.1 * max_change);
+    }
+}
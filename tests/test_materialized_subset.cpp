@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/box.hpp>
+#include <samurai/cell_list.hpp>
+#include <samurai/field.hpp>
+#include <samurai/level_cell_array.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/subset/materialized_subset.hpp>
+#include <samurai/subset/subset_op.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        auto create_lca(std::size_t level, int shift)
+        {
+            LevelCellList<2> lcl{level};
+            for (int j = 0; j < 20; ++j)
+            {
+                lcl[{j}].add_interval({(j + shift) % 5, 10 + j % 7});
+                lcl[{j}].add_interval({12 + j % 3, 15 + (j + shift) % 4});
+            }
+            return LevelCellArray<2>(lcl);
+        }
+    }
+
+    TEST(materialized_subset, same_as_subset)
+    {
+        auto lca_1 = create_lca(4, 0);
+        auto lca_2 = create_lca(4, 2);
+
+        auto set = difference(lca_1, lca_2);
+        std::vector<std::array<int, 3>> expected;
+        set(
+            [&](const auto& i, const auto& index)
+            {
+                expected.push_back({i.start, i.end, index[0]});
+            });
+
+        MaterializedSubset<2, default_config::interval_t> plan(set, lca_1, 3);
+        EXPECT_EQ(plan.level(), 4U);
+        EXPECT_EQ(plan.version(), 3U);
+        EXPECT_EQ(plan.nb_intervals(), expected.size());
+
+        std::vector<std::array<int, 3>> intervals;
+        plan(
+            [&](const auto& i, const auto& index)
+            {
+                intervals.push_back({i.start, i.end, index[0]});
+            });
+        EXPECT_EQ(intervals, expected);
+
+        for (const auto& r : plan.records())
+        {
+            EXPECT_EQ(r.offset, lca_1.get_index(r.interval.start, r.index[0]));
+        }
+    }
+
+    TEST(materialized_subset, offset_not_found)
+    {
+        auto lca_1 = create_lca(4, 0);
+        auto lca_2 = create_lca(4, 2);
+
+        auto set = difference(lca_2, lca_1);
+        MaterializedSubset<2, default_config::interval_t> plan(set, lca_1);
+        ASSERT_FALSE(plan.empty());
+        for (const auto& r : plan.records())
+        {
+            EXPECT_EQ(r.offset, plan.npos);
+        }
+    }
+
+    TEST(materialized_subset, colored_parallel_apply)
+    {
+        auto lca = create_lca(4, 0);
+        auto set = intersection(lca, lca);
+        MaterializedSubset<2, default_config::interval_t> plan(set, lca);
+
+        std::map<std::array<int, 2>, std::size_t> position;
+        for (std::size_t r = 0; r < plan.nb_intervals(); ++r)
+        {
+            position[{plan.records()[r].interval.start, plan.records()[r].index[0]}] = r;
+        }
+
+        for (std::size_t direction = 0; direction < 2; ++direction)
+        {
+            // Rank of the visit of each interval: the intervals of even y must all be visited before the odd ones
+            std::atomic<std::size_t> counter{0};
+            std::vector<std::size_t> rank(plan.nb_intervals(), plan.nb_intervals());
+            plan.colored_parallel_apply(direction,
+                                        [&](const auto& i, const auto& index)
+                                        {
+                                            rank[position.at({i.start, index[0]})] = counter++;
+                                        });
+            EXPECT_EQ(counter, plan.nb_intervals());
+
+            std::size_t last_even = 0;
+            std::size_t first_odd = plan.nb_intervals();
+            for (std::size_t r = 0; r < plan.nb_intervals(); ++r)
+            {
+                EXPECT_LT(rank[r], plan.nb_intervals());
+                if (plan.records()[r].index[0] % 2 == 0)
+                {
+                    last_even = std::max(last_even, rank[r]);
+                }
+                else
+                {
+                    first_odd = std::min(first_odd, rank[r]);
+                }
+            }
+            if (direction == 1)
+            {
+                EXPECT_LT(last_even, first_odd);
+            }
+        }
+    }
+
+    TEST(materialized_subset, mesh_cache)
+    {
+        using Config  = MRConfig<2>;
+        using mesh_id = MRMesh<Config>::mesh_id_t;
+        Box<double, 2> box{{0, 0}, {1, 1}};
+        MRMesh<Config> mesh(box, 2, 4);
+
+        std::size_t nb_evaluations = 0;
+        auto make_subset           = [&]()
+        {
+            ++nb_evaluations;
+            return intersection(mesh[mesh_id::cells][4], mesh[mesh_id::reference][4]).on(4);
+        };
+
+        const auto& plan_1 = mesh.subset_plan("cells", 4, make_subset);
+        const auto& plan_2 = mesh.subset_plan("cells", 4, make_subset);
+        EXPECT_EQ(&plan_1, &plan_2);
+        EXPECT_EQ(nb_evaluations, 1U);
+        EXPECT_EQ(plan_1.version(), mesh.version());
+        EXPECT_EQ(plan_1.nb_cells(), mesh.nb_cells(4, mesh_id::cells));
+
+        // The direction is part of the key
+        mesh.subset_plan("cells", 4, xt::xtensor_fixed<int, xt::xshape<2>>{1, 0}, make_subset);
+        EXPECT_EQ(nb_evaluations, 2U);
+
+        // And so is the index (0 by default)
+        mesh.subset_plan("cells", 0, 4, xt::xtensor_fixed<int, xt::xshape<2>>{1, 0}, make_subset);
+        EXPECT_EQ(nb_evaluations, 2U);
+        mesh.subset_plan("cells", 1, 4, xt::xtensor_fixed<int, xt::xshape<2>>{1, 0}, make_subset);
+        EXPECT_EQ(nb_evaluations, 3U);
+
+        // A new mesh invalidates the plans
+        MRMesh<Config> new_mesh(box, 2, 4);
+        EXPECT_NE(new_mesh.version(), mesh.version());
+        mesh.swap(new_mesh);
+        const auto& plan_3 = mesh.subset_plan("cells", 4, make_subset);
+        EXPECT_EQ(nb_evaluations, 4U);
+        EXPECT_EQ(plan_3.version(), mesh.version());
+    }
+
+    TEST(materialized_subset, storage_cursor)
+    {
+        using Config  = MRConfig<2>;
+        using mesh_id = MRMesh<Config>::mesh_id_t;
+        Box<double, 2> box{{0, 0}, {1, 1}};
+        MRMesh<Config> mesh(box, 2, 4);
+        auto u = make_field<double, 1>("u", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          u[cell] = static_cast<double>(cell.index);
+                      });
+
+        const auto& plan = mesh.subset_plan("cells",
+                                            4,
+                                            [&]()
+                                            {
+                                                return intersection(mesh[mesh_id::cells][4], mesh[mesh_id::reference][4]).on(4);
+                                            });
+        std::size_t nb_cells = 0;
+        plan(
+            [&](const auto& i, const auto& index, const auto& cursor)
+            {
+                EXPECT_EQ(cursor.interval, i);
+                EXPECT_EQ(cursor.index, index);
+                EXPECT_EQ(cursor.version, mesh.version());
+                EXPECT_EQ(u.storage_offset(cursor), mesh[mesh_id::reference][4].get_index(i.start, index[0]));
+                EXPECT_EQ(u(cursor), u(4, i, index[0]));
+                nb_cells += i.size();
+            });
+        EXPECT_EQ(nb_cells, mesh.nb_cells(4, mesh_id::cells));
+
+        // A cursor without offset is looked for as with the coordinates
+        auto cursor = u.storage_cursor(4, {0, 4}, 1);
+        EXPECT_EQ(u(cursor), u(4, {0, 4}, 1));
+        cursor.offset = cursor.npos;
+        EXPECT_EQ(u(cursor), u(4, {0, 4}, 1));
+    }
+
+    TEST(materialized_subset, subset_storage)
+    {
+        auto lca_1 = create_lca(4, 0);
+        auto lca_2 = create_lca(4, 2);
+
+        std::size_t nb_intervals = 0;
+        intersection(lca_1, lca_1)(
+            [&](const auto& i, const auto& index, const auto& storage)
+            {
+                ASSERT_EQ(storage.size(), 2U);
+                EXPECT_EQ(storage[0].start, i.start);
+                EXPECT_EQ(storage[0].end, i.end);
+                EXPECT_EQ(storage[0].index + i.start, lca_1.get_index(i.start, index[0]));
+                ++nb_intervals;
+            });
+        EXPECT_GT(nb_intervals, 0U);
+
+        // The intervals of the result are not in the second set of a difference
+        difference(lca_1, lca_2)(
+            [&](const auto&, const auto&, const auto& storage)
+            {
+                EXPECT_EQ(storage[1].index, MaterializedSubset<2, default_config::interval_t>::npos);
+            });
+    }
+}
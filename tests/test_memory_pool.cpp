@@ -0,0 +1,94 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/memory_pool.hpp>
+
+namespace samurai
+{
+    TEST(memory_pool, size_class)
+    {
+        using pool_t = FieldMemoryPool;
+
+        EXPECT_EQ(pool_t::size_class(1), pool_t::alignment);
+        EXPECT_EQ(pool_t::size_class(pool_t::min_pooled_size), pool_t::min_pooled_size);
+
+        for (std::size_t bytes = pool_t::min_pooled_size; bytes < std::size_t{1} << 30; bytes = bytes * 3 / 2 + 7)
+        {
+            auto size = pool_t::size_class(bytes);
+            EXPECT_GE(size, bytes);
+            EXPECT_LE(size, bytes + bytes / 4);
+            EXPECT_EQ(size % pool_t::page_size, std::size_t{0});
+            EXPECT_EQ(pool_t::size_class(size), size);
+        }
+    }
+
+    TEST(memory_pool, reuse_across_adaptations)
+    {
+        using vector_t = std::vector<double, pool_allocator<double>>;
+        auto& pool     = FieldMemoryPool::instance();
+        pool.release();
+        EXPECT_EQ(pool.min_cached_bytes(), std::size_t{0});
+        // Nothing else is in use: the released buffer is kept by the floor
+        pool.set_min_cached_bytes(std::size_t{1} << 20);
+
+        auto in_use         = pool.in_use_bytes();
+        auto nb_allocations = pool.nb_allocations();
+        auto nb_reuses      = pool.nb_reuses();
+
+        const double* data = nullptr;
+        {
+            vector_t old_field(100000, 1.);
+            data = old_field.data();
+            EXPECT_EQ(pool.in_use_bytes(), in_use + FieldMemoryPool::size_class(100000 * sizeof(double)));
+        }
+        EXPECT_EQ(pool.in_use_bytes(), in_use);
+        EXPECT_EQ(pool.cached_bytes(), FieldMemoryPool::size_class(100000 * sizeof(double)));
+
+        // A slightly smaller field of the same size class takes the released buffer
+        vector_t new_field(99000, 2.);
+        EXPECT_EQ(new_field.data(), data);
+        EXPECT_EQ(pool.nb_allocations(), nb_allocations + 1);
+        EXPECT_EQ(pool.nb_reuses(), nb_reuses + 1);
+        EXPECT_EQ(pool.cached_bytes(), std::size_t{0});
+
+        // The small buffers bypass the pool
+        vector_t small(10, 0.);
+        EXPECT_EQ(pool.nb_allocations(), nb_allocations + 1);
+
+        new_field = vector_t();
+        pool.release();
+        EXPECT_EQ(pool.cached_bytes(), std::size_t{0});
+        EXPECT_EQ(pool.in_use_bytes(), in_use);
+        pool.set_min_cached_bytes(0);
+    }
+
+    TEST(memory_pool, huge_pages_accounting)
+    {
+        using vector_t = std::vector<char, pool_allocator<char>>;
+        auto& pool     = FieldMemoryPool::instance();
+        pool.release();
+        pool.huge_pages_if(true);
+
+        auto in_use = pool.in_use_bytes();
+        for (std::size_t bytes : {3 * FieldMemoryPool::huge_page_size + 1, 9 * FieldMemoryPool::huge_page_size + 1})
+        {
+            auto size = FieldMemoryPool::size_class(bytes);
+            {
+                vector_t buffer(bytes);
+                EXPECT_EQ(pool.in_use_bytes(), in_use + size);
+                if (size >= FieldMemoryPool::min_huge_page_size)
+                {
+                    EXPECT_EQ(size % FieldMemoryPool::huge_page_size, std::size_t{0});
+                    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer.data()) % FieldMemoryPool::huge_page_size, std::uintptr_t{0});
+                }
+            }
+            EXPECT_EQ(pool.in_use_bytes(), in_use);
+        }
+
+        pool.huge_pages_if(false);
+        pool.release();
+    }
+}
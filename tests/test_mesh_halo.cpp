@@ -0,0 +1,115 @@
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/level_cell_array.hpp>
+#include <samurai/level_cell_list.hpp>
+#include <samurai/mesh_halo.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        // L-shaped domain with a hole of one cell
+        bool inside(int i, int j)
+        {
+            bool in_l = i >= 0 && j >= 0 && i < 24 && j < 24 && (i < 12 || j < 12);
+            return in_l && !(i == 6 && j == 7);
+        }
+
+        LevelCellArray<2> brute_force_erosion(std::size_t level, int radius)
+        {
+            LevelCellList<2> lcl{level};
+            for (int j = 0; j < 24; ++j)
+            {
+                for (int i = 0; i < 24; ++i)
+                {
+                    bool eroded = true;
+                    for (int b = -radius; b <= radius; ++b)
+                    {
+                        for (int a = -radius; a <= radius; ++a)
+                        {
+                            eroded = eroded && inside(i + a, j + b);
+                        }
+                    }
+                    if (eroded)
+                    {
+                        lcl[{j}].add_interval({i, i + 1});
+                    }
+                }
+            }
+            return {lcl};
+        }
+    }
+
+    TEST(mesh_halo, erode)
+    {
+        const std::size_t level = 5;
+        auto lca                = brute_force_erosion(level, 0);
+
+        for (int radius = 1; radius < 7; ++radius)
+        {
+            auto expected = brute_force_erosion(level, radius);
+            EXPECT_EQ(detail::erode(lca, static_cast<std::size_t>(radius)), expected);
+
+            // Erosion of a set which is already eroded
+            auto partially_eroded = brute_force_erosion(level, 1);
+            EXPECT_EQ(detail::erode(partially_eroded, static_cast<std::size_t>(radius), 1), expected);
+        }
+        EXPECT_TRUE(detail::erode(lca, 13).empty());
+    }
+
+    TEST(mesh_halo, dilate)
+    {
+        const std::size_t level = 5;
+        LevelCellList<2> lcl{level};
+        lcl[{10}].add_interval({3, 4});
+        lcl[{11}].add_interval({12, 15});
+        LevelCellArray<2> lca = {lcl};
+
+        for (int radius = 0; radius < 6; ++radius)
+        {
+            LevelCellList<2> expected_lcl{level};
+            for (int j = -radius; j <= radius; ++j)
+            {
+                expected_lcl[{10 + j}].add_interval({3 - radius, 4 + radius});
+                expected_lcl[{11 + j}].add_interval({12 - radius, 15 + radius});
+            }
+            LevelCellArray<2> expected = {expected_lcl};
+            EXPECT_EQ(detail::dilate(lca, static_cast<std::size_t>(radius)), expected);
+        }
+    }
+
+    TEST(mesh_halo, buffer)
+    {
+        auto lca = brute_force_erosion(5, 2);
+
+        std::vector<char> buffer;
+        detail::HaloWriter writer(buffer);
+        writer.write(std::size_t{3});
+        writer.write(lca);
+        writer.write(LevelCellArray<2>(7));
+
+        std::size_t value = 0;
+        LevelCellArray<2> lca_read;
+        LevelCellArray<2> empty_read;
+        detail::HaloReader reader(buffer);
+        reader.read(value);
+        reader.read(lca_read);
+        reader.read(empty_read);
+        EXPECT_TRUE(reader.at_end());
+
+        EXPECT_EQ(value, std::size_t{3});
+        EXPECT_EQ(lca_read, lca);
+        EXPECT_EQ(empty_read.level(), std::size_t{7});
+        EXPECT_TRUE(empty_read.empty());
+
+        // Truncated buffer
+        buffer.resize(buffer.size() / 2);
+        detail::HaloReader truncated(buffer);
+        truncated.read(value);
+        EXPECT_THROW(truncated.read(lca_read), std::runtime_error);
+    }
+}
@@ -0,0 +1,118 @@
+#include <cmath>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include <samurai/algorithm/update.hpp>
+#include <samurai/bc.hpp>
+#include <samurai/box.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+
+// Run with mpiexec -n 2 and mpiexec -n 4
+namespace samurai
+{
+    namespace
+    {
+        template <class Field>
+        void init(Field& u)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              auto x  = cell.center(0);
+                              auto y  = cell.center(1);
+                              u[cell] = std::tanh(30. * (x + 0.5 * y - 0.7)) + x * y;
+                          });
+        }
+
+        template <class Mesh>
+        auto make_adapted_field(Mesh& mesh)
+        {
+            auto u = make_field<double, 1>("u", mesh);
+            make_bc<Dirichlet<1>>(u, 0.);
+            init(u);
+            auto adapt = make_MRAdapt(u);
+            adapt(1e-3, 1);
+            return u;
+        }
+    }
+
+    TEST(mpi_ghost_exchange, halo_and_full_mesh)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_t              = MRMesh<config>;
+        using mesh_id_t           = typename mesh_t::mesh_id_t;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+
+        // The neighbours exchange the band of mpi_halo_width() cells of each level
+        mesh_t mesh(box, 2, 6);
+        auto u = make_adapted_field(mesh);
+
+        // The neighbours exchange their whole mesh
+        mesh_t mesh_full(box, 2, 6);
+        mesh_full.set_mpi_halo_width(std::size_t{1} << 20);
+        mesh_full.update_mesh_neighbour();
+        auto u_full = make_adapted_field(mesh_full);
+        EXPECT_EQ(mesh_full.mpi_halo_width(), std::size_t{1} << 20);
+
+        for (std::size_t id = 0; id < static_cast<std::size_t>(mesh_id_t::count); ++id)
+        {
+            auto mesh_id = static_cast<mesh_id_t>(id);
+            ASSERT_EQ(mesh[mesh_id], mesh_full[mesh_id]);
+        }
+
+        // Each neighbour only holds the cells close to the subdomain
+        for (const auto& neighbour : mesh.mpi_neighbourhood())
+        {
+            const auto& cells = neighbour.mesh[mesh_id_t::cells];
+            for (std::size_t level = cells.min_level(); level <= cells.max_level(); ++level)
+            {
+                if (cells[level].empty())
+                {
+                    continue;
+                }
+                auto radius = mesh.mpi_halo_width() << (mesh.subdomain().level() - level);
+                auto close  = detail::dilate(mesh.subdomain(), radius);
+                auto kept   = typename mesh_t::lca_type(intersection(cells[level], close).on(level));
+                EXPECT_EQ(kept, cells[level]);
+            }
+        }
+
+        u.fill(0.);
+        u_full.fill(0.);
+        init(u);
+        init(u_full);
+        update_ghost_mr(u);
+        update_ghost_mr(u_full);
+
+        // The sub meshes are the same: so are the storage indices
+        EXPECT_EQ(u.array(), u_full.array());
+
+        // The parents projected during and after the exchange are the mean of their children
+        for (std::size_t level = mesh[mesh_id_t::cells].min_level() + 1; level <= mesh[mesh_id_t::cells].max_level(); ++level)
+        {
+            auto parents = intersection(mesh[mesh_id_t::reference][level], mesh[mesh_id_t::proj_cells][level - 1]).on(level - 1);
+            parents(
+                [&](const auto& i, const auto& index)
+                {
+                    auto j = index[0];
+                    for (auto x = i.start; x < i.end; ++x)
+                    {
+                        double mean = 0;
+                        for (int a = 0; a < 2; ++a)
+                        {
+                            for (int b = 0; b < 2; ++b)
+                            {
+                                mean += 0.25 * u(static_cast<std::size_t>(mesh.get_index(level, 2 * x + a, 2 * j + b)));
+                            }
+                        }
+                        EXPECT_NEAR(u(static_cast<std::size_t>(mesh.get_index(level - 1, x, j))), mean, 1e-12);
+                    }
+                });
+        }
+    }
+}
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/bc.hpp>
+#include <samurai/box.hpp>
+#include <samurai/cell_list.hpp>
+#include <samurai/field.hpp>
+#include <samurai/interface.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+#include <samurai/schemes/fv.hpp>
+
+// Run with mpiexec -n 4
+namespace samurai
+{
+    namespace
+    {
+        template <class Field>
+        void init_rhs(Field& f)
+        {
+            for_each_cell(f.mesh(),
+                          [&](const auto& cell)
+                          {
+                              auto x  = cell.center(0);
+                              auto y  = cell.center(1);
+                              f[cell] = std::sin(3. * x) * std::cos(2. * y) + x * y;
+                          });
+        }
+
+        /// Solves with the default settings: the assembly is distributed if the mesh is partitioned
+        template <class Field>
+        void solve(Field& u, Field& f)
+        {
+            auto diff   = make_diffusion_order2<Field>();
+            auto id     = make_identity<Field>();
+            auto scheme = id + 0.05 * diff;
+
+            auto solver = petsc::make_solver(scheme);
+            KSPSetTolerances(solver.Ksp(), 1e-12, 1e-14, PETSC_DEFAULT, 1000);
+            solver.solve(u, f);
+            EXPECT_EQ(solver.assembly().is_distributed(), !u.mesh().mpi_neighbourhood().empty());
+            solver.destroy_petsc_objects();
+        }
+
+        /// Solution of the diffusion problem on the mesh
+        template <class Mesh>
+        auto make_solution(Mesh& mesh)
+        {
+            auto u = make_field<double, 1>("u", mesh);
+            auto f = make_field<double, 1>("f", mesh);
+            make_bc<Dirichlet<1>>(u, 0.);
+            u.fill(0.);
+            f.fill(0.);
+            init_rhs(f);
+            solve(u, f);
+            return u;
+        }
+
+        /// Compares the solution on a partitioned mesh with the solution on the whole mesh
+        template <class Field>
+        void expect_same_solution(const Field& u, const Field& u_ref)
+        {
+            using mesh_id_t = typename Field::mesh_t::mesh_id_t;
+
+            const auto& mesh     = u.mesh();
+            const auto& mesh_ref = u_ref.mesh();
+
+            double max_ref = 0;
+            for_each_cell(mesh_ref,
+                          [&](const auto& cell)
+                          {
+                              max_ref = std::max(max_ref, std::abs(u_ref[cell]));
+                          });
+            EXPECT_GT(max_ref, 0.);
+
+            for_each_interval(mesh[mesh_id_t::cells],
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  auto j = index[0];
+                                  for (auto x = i.start; x < i.end; ++x)
+                                  {
+                                      auto value     = u(static_cast<std::size_t>(mesh.get_index(level, x, j)));
+                                      auto value_ref = u_ref(static_cast<std::size_t>(mesh_ref.get_index(level, x, j)));
+                                      EXPECT_NEAR(value, value_ref, 1e-8 * max_ref);
+                                  }
+                              });
+        }
+
+        /// Cells of all the subdomains
+        template <class Mesh>
+        auto gather_cells(const Mesh& mesh)
+        {
+            using mesh_id_t         = typename Mesh::mesh_id_t;
+            using ca_type           = typename Mesh::ca_type;
+            constexpr std::size_t d = Mesh::dim;
+
+            mpi::communicator world;
+            std::vector<ca_type> all_cells;
+            mpi::all_gather(world, mesh[mesh_id_t::cells], all_cells);
+
+            CellList<d> cl;
+            for (const auto& cells : all_cells)
+            {
+                for_each_interval(cells,
+                                  [&](std::size_t level, const auto& i, const auto& index)
+                                  {
+                                      cl[level][index].add_interval(i);
+                                  });
+            }
+            return cl;
+        }
+
+        /// Number of interfaces with a level jump between the subdomain and its neighbours, over all the processes
+        template <class Mesh>
+        std::size_t nb_subdomain_level_jumps(const Mesh& mesh)
+        {
+            constexpr std::size_t d = Mesh::dim;
+
+            std::size_t count = 0;
+            auto count_jump   = [&](const auto&, const auto&)
+            {
+                ++count;
+            };
+            for (std::size_t level = mesh.min_level(); level < mesh.max_level(); ++level)
+            {
+                for (std::size_t k = 0; k < d; ++k)
+                {
+                    DirectionVector<d> direction;
+                    direction.fill(0);
+                    direction[k] = 1;
+                    auto stencil = in_out_stencil<d>(direction);
+                    for_each_subdomain_interface___level_jump_direction(mesh, level, direction, stencil, count_jump);
+                    for_each_subdomain_interface___level_jump_opposite_direction(mesh, level, direction, stencil, count_jump);
+                }
+            }
+            mpi::communicator world;
+            return mpi::all_reduce(world, count, std::plus<std::size_t>());
+        }
+    }
+
+    // PETSc is initialized once for all the tests
+    class mpi_petsc_assembly : public ::testing::Test
+    {
+      protected:
+
+        static void SetUpTestSuite()
+        {
+            PetscInitialize(nullptr, nullptr, nullptr, nullptr);
+        }
+
+        static void TearDownTestSuite()
+        {
+            PetscFinalize();
+        }
+    };
+
+    TEST_F(mpi_petsc_assembly, distributed_equals_sequential)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_t              = MRMesh<config>;
+
+        constexpr std::size_t level = 5;
+        constexpr int n             = 1 << level;
+
+        // Partitioned over the processes
+        Box<double, dim> box({0, 0}, {1, 1});
+        mesh_t mesh(box, level, level);
+        EXPECT_FALSE(mesh.mpi_neighbourhood().empty());
+        auto u = make_solution(mesh);
+
+        // Whole mesh on each process
+        CellList<dim> cl;
+        for (int j = 0; j < n; ++j)
+        {
+            cl[level][{j}].add_interval({0, n});
+        }
+        mesh_t mesh_ref(cl, level, level);
+        EXPECT_TRUE(mesh_ref.mpi_neighbourhood().empty());
+        auto u_ref = make_solution(mesh_ref);
+
+        expect_same_solution(u, u_ref);
+    }
+
+    TEST_F(mpi_petsc_assembly, distributed_equals_sequential_with_level_jumps)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_t              = MRMesh<config>;
+
+        constexpr std::size_t min_level = 2;
+        constexpr std::size_t max_level = 6;
+
+        // Partitioned over the processes and adapted to a front crossing the subdomains
+        Box<double, dim> box({0, 0}, {1, 1});
+        mesh_t mesh(box, min_level, max_level);
+        EXPECT_FALSE(mesh.mpi_neighbourhood().empty());
+        auto front = make_field<double, 1>("front", mesh);
+        make_bc<Dirichlet<1>>(front, 0.);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          auto x      = cell.center(0);
+                          auto y      = cell.center(1);
+                          front[cell] = std::tanh(30. * (x + 0.5 * y - 0.7));
+                      });
+        auto adapt = make_MRAdapt(front);
+        adapt(1e-3, 1);
+        EXPECT_GT(nb_subdomain_level_jumps(mesh), std::size_t{0});
+        auto u = make_solution(mesh);
+
+        // Whole adapted mesh on each process
+        mesh_t mesh_ref(gather_cells(mesh), min_level, max_level);
+        EXPECT_TRUE(mesh_ref.mpi_neighbourhood().empty());
+        auto u_ref = make_solution(mesh_ref);
+
+        expect_same_solution(u, u_ref);
+    }
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include <samurai/bc.hpp>
+#include <samurai/box.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/multigrid.hpp>
+
+namespace samurai
+{
+    TEST(multigrid, poisson_dirichlet)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+
+        const double pi = std::acos(-1.);
+        Box<double, dim> box({0, 0}, {1, 1});
+        MRMesh<config> mesh(box, 2, 5);
+
+        auto f = make_field<double, 1>("f",
+                                       mesh,
+                                       [&](const auto& coords)
+                                       {
+                                           return 2 * pi * pi * std::sin(pi * coords[0]) * std::sin(pi * coords[1]);
+                                       });
+
+        for (auto cycle : {MultigridCycle::V, MultigridCycle::W, MultigridCycle::F})
+        {
+            for (auto smoother : {MultigridSmoother::RedBlackGaussSeidel, MultigridSmoother::Chebyshev})
+            {
+                auto u = make_field<double, 1>("u", mesh);
+                u.fill(0.);
+                make_bc<Dirichlet<1>>(u, 0.);
+
+                auto multigrid = make_multigrid(u);
+                multigrid.set_cycle(cycle);
+                multigrid.set_smoother(smoother);
+                multigrid.set_tolerance(1e-8);
+                multigrid.set_max_iterations(30);
+
+                std::size_t nb_iterations = multigrid.solve(u, f);
+                EXPECT_LT(nb_iterations, std::size_t{30});
+
+                double error = 0;
+                for_each_cell(mesh,
+                              [&](const auto& cell)
+                              {
+                                  auto x = cell.center();
+                                  error  = std::max(error, std::abs(u[cell] - std::sin(pi * x[0]) * std::sin(pi * x[1])));
+                              });
+                EXPECT_LT(error, 1e-2);
+            }
+        }
+    }
+
+    TEST(multigrid, poisson_adapted_mesh)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_id_t           = typename MRMesh<config>::mesh_id_t;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        MRMesh<config> mesh(box, 2, 6);
+
+        // Solution with a steep peak: the mesh is refined around it
+        auto exact = [](double x, double y)
+        {
+            return std::exp(-100. * ((x - 0.3) * (x - 0.3) + (y - 0.3) * (y - 0.3))) * x * (1 - x) * y * (1 - y);
+        };
+        auto v = make_field<double, 1>("v",
+                                       mesh,
+                                       [&](const auto& coords)
+                                       {
+                                           return exact(coords[0], coords[1]);
+                                       });
+        auto adapt = make_MRAdapt(v);
+        adapt(1e-4, 1);
+        ASSERT_LT(mesh[mesh_id_t::cells].min_level(), mesh[mesh_id_t::cells].max_level());
+
+        // Right-hand side -laplacian(exact) by finite differences
+        auto minus_laplacian = [&](double x, double y)
+        {
+            const double h = 1e-4;
+            double sum     = exact(x - h, y) + exact(x + h, y) + exact(x, y - h) + exact(x, y + h);
+            return (4 * exact(x, y) - sum) / (h * h);
+        };
+        auto f = make_field<double, 1>("f",
+                                       mesh,
+                                       [&](const auto& coords)
+                                       {
+                                           return minus_laplacian(coords[0], coords[1]);
+                                       });
+
+        auto u = make_field<double, 1>("u", mesh);
+        u.fill(0.);
+        make_bc<Dirichlet<1>>(u, 0.);
+
+        auto multigrid = make_multigrid(u);
+        multigrid.set_tolerance(1e-8);
+        multigrid.set_max_iterations(50);
+        std::size_t nb_iterations = multigrid.solve(u, f);
+        EXPECT_LT(nb_iterations, std::size_t{50});
+
+        // The finest grid only covers the finest leaves
+        std::size_t max_level = mesh.max_level();
+        EXPECT_EQ(multigrid.nb_level_cells(max_level), mesh[mesh_id_t::cells][max_level].nb_cells());
+        EXPECT_LT(multigrid.nb_level_cells(max_level), std::size_t{1} << (dim * max_level));
+
+        double error     = 0;
+        double max_exact = 0;
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          auto x    = cell.center();
+                          error     = std::max(error, std::abs(u[cell] - exact(x[0], x[1])));
+                          max_exact = std::max(max_exact, std::abs(exact(x[0], x[1])));
+                      });
+        EXPECT_LT(error, 0.1 * max_exact);
+    }
+}
@@ -0,0 +1,140 @@
+#include <cmath>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include <samurai/bc.hpp>
+#include <samurai/box.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+#include <samurai/schemes/fv.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        Mat operator_of(KSP ksp)
+        {
+            Mat A;
+            KSPGetOperators(ksp, &A, nullptr);
+            return A;
+        }
+
+        PetscObjectState state_of(Mat A)
+        {
+            PetscObjectState state;
+            PetscObjectStateGet(reinterpret_cast<PetscObject>(A), &state);
+            return state;
+        }
+
+        PetscInt nb_rows_of(Mat A)
+        {
+            PetscInt nb_rows;
+            MatGetSize(A, &nb_rows, nullptr);
+            return nb_rows;
+        }
+
+        template <class Field>
+        void expect_same_values(const Field& u, const Field& v)
+        {
+            using mesh_id_t = typename Field::mesh_t::mesh_id_t;
+
+            for_each_cell(u.mesh()[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              EXPECT_NEAR(u[cell], v[cell], 1e-10);
+                          });
+        }
+    }
+
+    TEST(petsc_linear_solver, matrix_reuse)
+    {
+        PetscInitialize(nullptr, nullptr, nullptr, nullptr);
+        {
+            constexpr std::size_t dim = 2;
+            using config              = MRConfig<dim>;
+            using mesh_t              = MRMesh<config>;
+
+            Box<double, dim> box({0, 0}, {1, 1});
+            mesh_t mesh(box, 2, 5);
+
+            auto u = make_field<double, 1>("u", mesh);
+            make_bc<Dirichlet<1>>(u, 0.);
+            auto init = [&](double x0)
+            {
+                for_each_cell(mesh,
+                              [&](const auto& cell)
+                              {
+                                  auto x  = cell.center(0) - x0;
+                                  auto y  = cell.center(1) - 0.5;
+                                  u[cell] = std::exp(-50. * (x * x + y * y));
+                              });
+            };
+            init(0.4);
+            auto adapt = make_MRAdapt(u);
+            adapt(1e-3, 1);
+
+            auto unp1 = make_field<double, 1>("unp1", mesh);
+            make_bc<Dirichlet<1>>(unp1, 0.);
+            auto expected = make_field<double, 1>("expected", mesh);
+            make_bc<Dirichlet<1>>(expected, 0.);
+
+            auto diff   = make_diffusion_order2<decltype(u)>();
+            auto id     = make_identity<decltype(u)>();
+            double dt   = 0.01;
+            auto scheme = id + dt * diff;
+
+            // Solution of a solver built for the current scheme and mesh
+            auto solve_fresh = [&]()
+            {
+                auto fresh = petsc::make_solver(scheme);
+                fresh.solve(expected, u);
+                return nb_rows_of(operator_of(fresh.Ksp()));
+            };
+
+            auto solver = petsc::make_solver(scheme);
+            solver.solve(unp1, u);
+            Mat A                  = operator_of(solver.Ksp());
+            PetscObjectState state = state_of(A);
+
+            // Same mesh, refreshed matrix: the new coefficient is assembled in the same matrix
+            dt     = 0.05;
+            scheme = id + dt * diff;
+            solver.refresh_matrix_if(true);
+            solver.solve(unp1, u);
+            EXPECT_EQ(operator_of(solver.Ksp()), A);
+            EXPECT_NE(state_of(A), state);
+            solve_fresh();
+            expect_same_values(unp1, expected);
+
+            // Same mesh without refresh: the matrix of dt = 0.05 is kept
+            state  = state_of(A);
+            scheme = id + 0.5 * diff;
+            solver.refresh_matrix_if(false);
+            solver.solve(unp1, u);
+            EXPECT_EQ(operator_of(solver.Ksp()), A);
+            EXPECT_EQ(state_of(A), state);
+            scheme = id + dt * diff;
+            solve_fresh();
+            expect_same_values(unp1, expected);
+
+            // New version of the mesh: the matrix is rebuilt with the current scheme
+            init(0.6);
+            adapt(1e-3, 1);
+            unp1.resize();
+            expected.resize();
+            EXPECT_TRUE(solver.mesh_has_changed());
+            scheme = id + 0.5 * diff;
+            solver.solve(unp1, u);
+            EXPECT_FALSE(solver.mesh_has_changed());
+            auto nb_rows = solve_fresh();
+            EXPECT_EQ(nb_rows_of(operator_of(solver.Ksp())), nb_rows);
+            expect_same_values(unp1, expected);
+
+            solver.destroy_petsc_objects();
+        }
+        PetscFinalize();
+    }
+}
@@ -0,0 +1,94 @@
+#include <cmath>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include <samurai/bc.hpp>
+#include <samurai/box.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+#include <samurai/schemes/fv.hpp>
+
+namespace samurai
+{
+    TEST(petsc_matrix_free, mult_equals_assembled_mult)
+    {
+        PetscInitialize(nullptr, nullptr, nullptr, nullptr);
+        {
+            constexpr std::size_t dim = 2;
+            using config              = MRConfig<dim>;
+            using mesh_t              = MRMesh<config>;
+            using mesh_id_t           = typename mesh_t::mesh_id_t;
+
+            Box<double, dim> box({0, 0}, {1, 1});
+            mesh_t mesh(box, 2, 5);
+
+            auto u = make_field<double, 1>("u", mesh);
+            make_bc<Dirichlet<1>>(u, 0.);
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              auto x  = cell.center(0) - 0.4;
+                              auto y  = cell.center(1) - 0.6;
+                              u[cell] = std::exp(-50. * (x * x + y * y));
+                          });
+            auto adapt = make_MRAdapt(u);
+            adapt(1e-3, 1);
+            // The projection and prediction ghosts of the level jumps are eliminated
+            EXPECT_LT(mesh[mesh_id_t::cells].min_level(), mesh[mesh_id_t::cells].max_level());
+
+            auto diff   = make_diffusion_order2<decltype(u)>();
+            auto id     = make_identity<decltype(u)>();
+            auto scheme = id + 0.1 * diff;
+
+            // Assembled matrix
+            auto assembly = petsc::make_assembly(scheme);
+            assembly.set_unknown(u);
+            assembly.include_scheme_if(true);
+            Mat A;
+            assembly.create_matrix(A);
+            assembly.assemble_matrix(A);
+
+            // Shell matrix
+            auto mf_assembly = petsc::make_assembly(scheme);
+            mf_assembly.set_unknown(u);
+            mf_assembly.include_scheme_if(false);
+            petsc::MatrixFreeOperator<decltype(scheme)> matrix_free;
+            Mat B;
+            matrix_free.create_matrix(mf_assembly, B);
+            matrix_free.assemble_matrix();
+
+            // Arbitrary values, ghosts included
+            auto x = make_field<double, 1>("x", mesh);
+            for (std::size_t i = 0; i < x.array().size(); ++i)
+            {
+                x.array()[i] = std::sin(1. + static_cast<double>(i));
+            }
+            Vec x_vec = petsc::create_petsc_vector_from(x);
+            Vec y;
+            Vec z;
+            VecDuplicate(x_vec, &y);
+            VecDuplicate(x_vec, &z);
+
+            MatMult(A, x_vec, y);
+            MatMult(B, x_vec, z);
+
+            double y_norm = 0;
+            VecNorm(y, NORM_INFINITY, &y_norm);
+            VecAXPY(z, -1., y);
+            double diff_norm = 0;
+            VecNorm(z, NORM_INFINITY, &diff_norm);
+            EXPECT_GT(y_norm, 0.);
+            EXPECT_LT(diff_norm, 1e-10 * y_norm);
+
+            VecDestroy(&x_vec);
+            VecDestroy(&y);
+            VecDestroy(&z);
+            MatDestroy(&A);
+            MatDestroy(&B);
+        }
+        PetscFinalize();
+    }
+}
@@ -0,0 +1,60 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <samurai/profiling.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        void profiled_function([[maybe_unused]] std::size_t level)
+        {
+            SAMURAI_PROFILE_SCOPE_LEVEL("test/function", level);
+            SAMURAI_PROFILE_COUNT("test/counter", level, 2);
+        }
+    }
+
+    TEST(profiling, timers_and_counters)
+    {
+        profiling::reset();
+        profiling::enable_trace();
+        {
+            SAMURAI_PROFILE_START(timer, "test/phase");
+            for (std::size_t level = 2; level < 4; ++level)
+            {
+                profiled_function(level);
+                profiled_function(level);
+            }
+            SAMURAI_PROFILE_STOP(timer);
+        }
+
+        auto filename = (std::filesystem::temp_directory_path() / "samurai_profiling.json").string();
+        std::filesystem::remove(filename);
+        profiling::save_json(filename);
+
+#ifdef SAMURAI_WITH_PROFILING
+        auto timers   = profiling::Profiler::instance().timers();
+        auto counters = profiling::Profiler::instance().counters();
+
+        EXPECT_EQ((timers.at({"test/phase", profiling::no_level}).count), 1U);
+        EXPECT_EQ((timers.at({"test/function", 2}).count), 2U);
+        EXPECT_EQ((timers.at({"test/function", 3}).count), 2U);
+        EXPECT_EQ((counters.at({"test/counter", 3})), 4U);
+        EXPECT_LE((timers.at({"test/function", 2}).total), (timers.at({"test/phase", profiling::no_level}).total));
+
+        std::ifstream file(filename);
+        std::stringstream content;
+        content << file.rdbuf();
+        EXPECT_NE(content.str().find(R"("name": "test/function", "level": 3, "count": 2)"), std::string::npos);
+#else
+        // Nothing is recorded
+        EXPECT_FALSE(std::filesystem::exists(filename));
+#endif
+        profiling::enable_trace(false);
+        profiling::reset();
+    }
+}
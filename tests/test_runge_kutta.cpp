@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/schemes/runge_kutta.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        /// F(u) = u: the solution of du/dt + F(u) = 0 is exp(-t)
+        struct IdentityScheme
+        {
+            template <class Field>
+            void apply(Field& output, Field& input) const
+            {
+                output.array() += input.array();
+            }
+        };
+
+        template <class Field>
+        double solve(Field& u, RungeKuttaMethod method, std::size_t nb_steps)
+        {
+            u.fill(1.);
+            ExplicitRungeKutta<Field> rk(method);
+            double dt = 1. / static_cast<double>(nb_steps);
+            for (std::size_t n = 0; n < nb_steps; ++n)
+            {
+                rk.step(IdentityScheme{}, u, dt);
+            }
+            double error = 0;
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              error = std::max(error, std::abs(u[cell] - std::exp(-1.)));
+                          });
+            return error;
+        }
+    }
+
+    TEST(runge_kutta, order)
+    {
+        using config = MRConfig<1>;
+        Box<double, 1> box({0}, {1});
+        MRMesh<config> mesh(box, 2, 4);
+        auto u = make_field<double, 1>("u", mesh);
+
+        std::vector<std::pair<RungeKuttaMethod, double>> methods{{RungeKuttaMethod::Euler, 1},
+                                                                 {RungeKuttaMethod::SSPRK2, 2},
+                                                                 {RungeKuttaMethod::SSPRK3, 3},
+                                                                 {RungeKuttaMethod::RK4, 4},
+                                                                 {RungeKuttaMethod::LowStorageRK4, 4}};
+        for (const auto& [method, order] : methods)
+        {
+            double error_1 = solve(u, method, 20);
+            double error_2 = solve(u, method, 40);
+            EXPECT_NEAR(std::log2(error_1 / error_2), order, 0.1);
+        }
+    }
+
+    TEST(runge_kutta, mesh_change)
+    {
+        using config = MRConfig<1>;
+        Box<double, 1> box({0}, {1});
+        MRMesh<config> mesh(box, 2, 4);
+        auto u = make_field<double, 1>("u", mesh);
+        u.fill(1.);
+
+        ExplicitRungeKutta<decltype(u)> rk(RungeKuttaMethod::RK4);
+        EXPECT_EQ(rk.nb_stages(), 4U);
+        rk.step(IdentityScheme{}, u, 0.1);
+
+        // The buffers follow the new mesh
+        MRMesh<config> new_mesh(box, 2, 3);
+        mesh.swap(new_mesh);
+        u.resize();
+        u.fill(1.);
+        rk.step(IdentityScheme{}, u, 0.1);
+        double expected = 1. - 0.1 + 0.01 / 2 - 0.001 / 6 + 0.0001 / 24;
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_NEAR(u[cell], expected, 1e-14);
+                      });
+    }
+}
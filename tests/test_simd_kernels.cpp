@@ -0,0 +1,458 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/algorithm/update.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/mr/operators.hpp>
+#include <samurai/numeric/prediction.hpp>
+#include <samurai/numeric/simd_kernels.hpp>
+#include <samurai/samurai.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        // Mean of a polynomial on [a, b]
+        double mean(const std::vector<double>& coeffs, double a, double b)
+        {
+            double m = 0;
+            for (std::size_t k = 0; k < coeffs.size(); ++k)
+            {
+                auto p = static_cast<double>(k + 1);
+                m += coeffs[k] * (std::pow(b, p) - std::pow(a, p)) / (p * (b - a));
+            }
+            return m;
+        }
+
+        /// Cell averages of a tensor product of polynomials of the given degree
+        template <std::size_t dim>
+        struct polynomial
+        {
+            explicit polynomial(std::size_t degree)
+            {
+                std::mt19937 gen(42);
+                std::uniform_real_distribution<double> dist(-1, 1);
+                for (auto& c : coeffs)
+                {
+                    c.resize(degree + 1);
+                    for (auto& v : c)
+                    {
+                        v = dist(gen);
+                    }
+                }
+            }
+
+            // Average on the cell of size h at (i, yz)
+            double operator()(double h, int i, const std::array<int, dim - 1>& yz) const
+            {
+                double value = mean(coeffs[0], i * h, (i + 1) * h);
+                for (std::size_t d = 0; d < dim - 1; ++d)
+                {
+                    value *= mean(coeffs[d + 1], yz[d] * h, (yz[d] + 1) * h);
+                }
+                return value;
+            }
+
+            std::array<std::vector<double>, dim> coeffs;
+        };
+
+        /// Coarse cells [x0, x0 + nx) x [y0, y0 + ny)^(dim - 1)
+        template <std::size_t dim>
+        struct coarse_data
+        {
+            template <class Func>
+            coarse_data(int x0_, int nx_, int y0_, int ny_, Func&& func)
+                : x0(x0_)
+                , nx(nx_)
+                , y0(y0_)
+                , ny(ny_)
+            {
+                std::size_t n_rows = 1;
+                for (std::size_t d = 0; d < dim - 1; ++d)
+                {
+                    n_rows *= static_cast<std::size_t>(ny);
+                }
+                values.resize(n_rows * static_cast<std::size_t>(nx));
+                for (std::size_t r = 0; r < n_rows; ++r)
+                {
+                    std::array<int, dim - 1> yz;
+                    std::size_t rr = r;
+                    for (std::size_t d = 0; d < dim - 1; ++d)
+                    {
+                        yz[d] = y0 + static_cast<int>(rr % static_cast<std::size_t>(ny));
+                        rr /= static_cast<std::size_t>(ny);
+                    }
+                    for (int i = 0; i < nx; ++i)
+                    {
+                        values[r * static_cast<std::size_t>(nx) + static_cast<std::size_t>(i)] = func(x0 + i, yz);
+                    }
+                }
+            }
+
+            const double* row(int start, const std::array<int, dim - 1>& yz) const
+            {
+                std::size_t r = 0;
+                for (std::size_t d = dim - 1; d-- > 0;)
+                {
+                    r = r * static_cast<std::size_t>(ny) + static_cast<std::size_t>(yz[d] - y0);
+                }
+                return values.data() + r * static_cast<std::size_t>(nx) + static_cast<std::size_t>(start - x0);
+            }
+
+            double operator()(const std::array<int, dim>& p) const
+            {
+                std::array<int, dim - 1> yz;
+                for (std::size_t d = 0; d < dim - 1; ++d)
+                {
+                    yz[d] = p[d + 1];
+                }
+                return *row(p[0], yz);
+            }
+
+            int x0, nx, y0, ny;
+            std::vector<double> values;
+        };
+
+        // Cell by cell evaluation of the Qs_* of prediction.hpp along the
+        // directions dirs, starting from the term tag
+        template <std::size_t dim, std::size_t order>
+        double reference_q(const coarse_data<dim>& u, const std::vector<std::size_t>& dirs, std::size_t tag, const std::array<int, dim>& p)
+        {
+            if (dirs.empty())
+            {
+                return u(p);
+            }
+            auto c = prediction_coeffs<order>();
+            std::vector<std::size_t> others(dirs.begin() + 1, dirs.end());
+            double q = 0;
+            for (std::size_t s = order; s >= tag; --s)
+            {
+                auto plus  = p;
+                auto minus = p;
+                plus[dirs[0]] += static_cast<int>(s);
+                minus[dirs[0]] -= static_cast<int>(s);
+                std::size_t inner = std::min(s + 1, order);
+                q += c[s - 1] * (reference_q<dim, order>(u, others, inner, plus) - reference_q<dim, order>(u, others, inner, minus));
+            }
+            return q;
+        }
+
+        // Prediction of the fine cell (f, fine_yz) from the formulas of prediction_op
+        template <std::size_t dim, std::size_t order>
+        double reference_prediction(const coarse_data<dim>& u, int f, const std::array<int, dim - 1>& fine_yz)
+        {
+            std::array<int, dim> fine;
+            std::array<int, dim> p;
+            fine[0] = f;
+            for (std::size_t d = 0; d < dim - 1; ++d)
+            {
+                fine[d + 1] = fine_yz[d];
+            }
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                p[d] = fine[d] >> 1;
+            }
+
+            double value = u(p);
+            if constexpr (order > 0)
+            {
+                for (std::size_t t = 1; t < (1 << dim); ++t)
+                {
+                    std::vector<std::size_t> dirs;
+                    double sign = -1;
+                    for (std::size_t d = 0; d < dim; ++d)
+                    {
+                        if ((t >> d) & 1)
+                        {
+                            dirs.push_back(d);
+                            sign *= (fine[d] & 1) ? 1 : -1;
+                        }
+                    }
+                    value += sign * reference_q<dim, order>(u, dirs, 1, p);
+                }
+            }
+            return value;
+        }
+
+        template <std::size_t dim>
+        void check_projection()
+        {
+            constexpr std::size_t n_rows = 1 << (dim - 1);
+            std::mt19937 gen(0);
+            std::uniform_real_distribution<double> dist(-1, 1);
+
+            for (std::size_t size = 0; size < 40; ++size)
+            {
+                std::array<std::vector<double>, n_rows> fine;
+                std::array<const double*, n_rows> fine_ptr;
+                for (std::size_t r = 0; r < n_rows; ++r)
+                {
+                    fine[r].resize(2 * size);
+                    for (auto& v : fine[r])
+                    {
+                        v = dist(gen);
+                    }
+                    fine_ptr[r] = fine[r].data();
+                }
+
+                std::vector<double> dest(size);
+                simd::projection<dim>(dest.data(), fine_ptr, size);
+
+                for (std::size_t n = 0; n < size; ++n)
+                {
+                    double expected = 0;
+                    if constexpr (dim == 2)
+                    {
+                        expected = .25 * (fine[0][2 * n] + fine[1][2 * n] + fine[0][2 * n + 1] + fine[1][2 * n + 1]);
+                    }
+                    else
+                    {
+                        for (std::size_t r = 0; r < n_rows; ++r)
+                        {
+                            expected += fine[r][2 * n];
+                            expected += fine[r][2 * n + 1];
+                        }
+                        expected /= (1 << dim);
+                    }
+                    EXPECT_DOUBLE_EQ(dest[n], expected);
+                }
+            }
+        }
+
+        template <std::size_t dim, std::size_t order, class Func>
+        void check_prediction(const coarse_data<dim>& coarse, Func&& fine_values)
+        {
+            std::array<int, dim - 1> yz;
+            yz.fill(0);
+
+            for (int start = -6; start < 4; ++start)
+            {
+                for (int end = start + 1; end < 50; end += 3)
+                {
+                    simd::prediction_stencil<dim, order> stencil;
+                    stencil.build(
+                        [&](int s, int, const std::array<int, dim - 1>& offset)
+                        {
+                            std::array<int, dim - 1> row = yz;
+                            for (std::size_t d = 0; d < dim - 1; ++d)
+                            {
+                                row[d] += offset[d];
+                            }
+                            return coarse.row(s, row);
+                        },
+                        start >> 1,
+                        ((end - 1) >> 1) + 1);
+
+                    for (std::size_t r = 0; r < (1 << (dim - 1)); ++r)
+                    {
+                        std::array<bool, dim - 1> odd;
+                        std::array<int, dim - 1> fine_yz;
+                        for (std::size_t d = 0; d < dim - 1; ++d)
+                        {
+                            odd[d]     = (r >> d) & 1;
+                            fine_yz[d] = 2 * yz[d] + odd[d];
+                        }
+
+                        auto size = static_cast<std::size_t>(end - start);
+                        std::vector<double> fine(size);
+                        std::vector<double> pred(size);
+                        std::vector<double> detail(size);
+                        for (int f = start; f < end; ++f)
+                        {
+                            fine[static_cast<std::size_t>(f - start)] = fine_values(f, fine_yz);
+                        }
+
+                        stencil.apply(pred.data(), static_cast<const double*>(nullptr), start, end, odd);
+                        stencil.apply(detail.data(), fine.data(), start, end, odd);
+
+                        for (std::size_t n = 0; n < size; ++n)
+                        {
+                            EXPECT_NEAR(pred[n], fine[n], 1e-10);
+                            EXPECT_NEAR(detail[n], 0., 1e-10);
+                        }
+                    }
+                }
+            }
+        }
+
+        // The prediction of order s is exact for the polynomials of degree 2s
+        template <std::size_t order>
+        void check_polynomial()
+        {
+            polynomial<1> p(2 * order);
+            coarse_data<1> coarse(-10,
+                                  40,
+                                  0,
+                                  1,
+                                  [&](int i, const auto& yz)
+                                  {
+                                      return p(1., i, yz);
+                                  });
+            check_prediction<1, order>(coarse,
+                                       [&](int f, const auto& yz)
+                                       {
+                                           return p(.5, f, yz);
+                                       });
+        }
+
+        template <std::size_t dim, std::size_t order>
+        void check_reference()
+        {
+            std::mt19937 gen(1);
+            std::uniform_real_distribution<double> dist(-1, 1);
+            coarse_data<dim> coarse(-10,
+                                    40,
+                                    -5,
+                                    11,
+                                    [&](int, const auto&)
+                                    {
+                                        return dist(gen);
+                                    });
+            check_prediction<dim, order>(coarse,
+                                         [&](int f, const auto& yz)
+                                         {
+                                             return reference_prediction<dim, order>(coarse, f, yz);
+                                         });
+        }
+    }
+
+    TEST(simd_kernels, projection)
+    {
+        check_projection<1>();
+        check_projection<2>();
+        check_projection<3>();
+    }
+
+    TEST(simd_kernels, prediction_polynomial)
+    {
+        check_polynomial<0>();
+        check_polynomial<1>();
+        check_polynomial<2>();
+    }
+
+    TEST(simd_kernels, prediction)
+    {
+        check_reference<1, 1>();
+        check_reference<1, 2>();
+        check_reference<2, 1>();
+        check_reference<2, 2>();
+        check_reference<3, 1>();
+        check_reference<3, 2>();
+    }
+
+    TEST(simd_kernels, prediction_order_0)
+    {
+        std::vector<double> u{1., 2., 3., 4.};
+        simd::prediction_stencil<2, 0> stencil;
+        stencil.build(
+            [&](int start, int, const std::array<int, 1>&)
+            {
+                return u.data() + start;
+            },
+            0,
+            4);
+
+        std::vector<double> out(7);
+        stencil.apply(out.data(), static_cast<const double*>(nullptr), 1, 8, {true});
+        EXPECT_EQ(out, (std::vector<double>{1., 2., 2., 3., 3., 4., 4.}));
+    }
+
+    namespace
+    {
+        /**
+         * Ghosts and details of a scalar field, computed by the kernels, and
+         * of a vector field with the same values in its two components,
+         * computed by the xtensor path, on an adapted mesh.
+         */
+        template <std::size_t dim, std::size_t order>
+        void check_adapted_mesh()
+        {
+            using config    = MRConfig<dim, std::max<std::size_t>(order, 1), default_config::graduation_width, order>;
+            using mesh_t    = MRMesh<config>;
+            using mesh_id_t = typename mesh_t::mesh_id_t;
+
+            static_assert(simd::use_kernels_v<Field<mesh_t, double, 1>, Field<mesh_t, double, 1>> == simd::enabled);
+            static_assert(!simd::use_kernels_v<Field<mesh_t, double, 2>, Field<mesh_t, double, 2>>);
+
+            std::mt19937 gen(3);
+            std::uniform_real_distribution<double> noise(-1e-3, 1e-3);
+            auto init = [&](auto& u)
+            {
+                for_each_cell(u.mesh(),
+                              [&](const auto& cell)
+                              {
+                                  auto center = cell.center();
+                                  u[cell]     = std::tanh(20. * (xt::sum(center)() - 0.4 * dim)) + noise(gen);
+                              });
+            };
+
+            Box<double, dim> box(xt::zeros<double>({dim}), xt::ones<double>({dim}));
+            mesh_t mesh(box, 2, dim == 3 ? 5 : 6);
+            auto u = make_field<double, 1>("u", mesh);
+            init(u);
+            auto adapt = make_MRAdapt(u);
+            adapt(1e-3, 1);
+            ASSERT_GT(mesh.nb_cells(mesh_id_t::cells), std::size_t{0});
+
+            auto v = make_field<double, 2>("v", mesh);
+            u.fill(0);
+            v.fill(0);
+            init(u);
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              v[cell][0] = u[cell];
+                              v[cell][1] = u[cell];
+                          });
+
+            auto expect_same = [&](const auto& scalar, const auto& vector)
+            {
+                for_each_cell(mesh[mesh_id_t::reference],
+                              [&](const auto& cell)
+                              {
+                                  double expected = vector[cell][0];
+                                  EXPECT_NEAR(scalar[cell], expected, 1e-12 * (1 + std::abs(expected)))
+                                      << "dim " << dim << ", order " << order << ", level " << cell.level;
+                                  EXPECT_EQ(vector[cell][1], expected);
+                              });
+            };
+
+            // Projection and prediction of the ghosts
+            update_ghost_mr(u);
+            update_ghost_mr(v);
+            expect_same(u, v);
+
+            // Details
+            auto detail_u = make_field<double, 1>("detail_u", mesh);
+            auto detail_v = make_field<double, 2>("detail_v", mesh);
+            detail_u.fill(0);
+            detail_v.fill(0);
+            for (std::size_t level = mesh.min_level() - 1; level < mesh.max_level(); ++level)
+            {
+                auto set = intersection(mesh[mesh_id_t::all_cells][level], mesh[mesh_id_t::cells][level + 1]).on(level);
+                set.apply_op(compute_detail(detail_u, u));
+                set.apply_op(compute_detail(detail_v, v));
+            }
+            expect_same(detail_u, detail_v);
+        }
+    }
+
+    TEST(simd_kernels, adapted_mesh)
+    {
+        ::samurai::initialize();
+        check_adapted_mesh<1, 1>();
+        check_adapted_mesh<1, 2>();
+        check_adapted_mesh<2, 1>();
+        check_adapted_mesh<2, 2>();
+        check_adapted_mesh<3, 1>();
+        check_adapted_mesh<3, 2>();
+        ::samurai::finalize();
+    }
+}
@@ -0,0 +1,205 @@
+#include <random>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <samurai/cell_array.hpp>
+#include <samurai/cell_list.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/sorted_cell_list.hpp>
+
+namespace samurai
+{
+    TEST(sorted_cell_list, merge_intervals)
+    {
+        constexpr size_t dim = 2;
+
+        SortedLevelCellList<dim> lcl{1};
+        lcl[{1}].add_interval({5, 8});
+        lcl[{1}].add_interval({2, 5});
+        lcl[{1}].add_interval({10, 12});
+        lcl[{1}].add_interval({11, 14});
+        lcl[{0}].add_point(3);
+        lcl[{0}].add_interval({4, 4});
+
+        const auto& records = lcl.records();
+        ASSERT_EQ(records.size(), 3);
+
+        EXPECT_EQ(records[0].yz[0], 0);
+        EXPECT_EQ(records[0].start, 3);
+        EXPECT_EQ(records[0].end, 4);
+
+        EXPECT_EQ(records[1].yz[0], 1);
+        EXPECT_EQ(records[1].start, 2);
+        EXPECT_EQ(records[1].end, 8);
+
+        EXPECT_EQ(records[2].yz[0], 1);
+        EXPECT_EQ(records[2].start, 10);
+        EXPECT_EQ(records[2].end, 14);
+    }
+
+    TEST(sorted_cell_list, level_cell_array_2d)
+    {
+        constexpr size_t dim = 2;
+
+        LevelCellList<dim> lcl{2};
+        SortedLevelCellList<dim> slcl{2};
+
+        lcl[{5}].add_interval({-2, 8});
+        lcl[{1}].add_interval({2, 5});
+        lcl[{5}].add_interval({9, 10});
+        lcl[{6}].add_interval({10, 12});
+        lcl[{-3}].add_interval({0, 1});
+
+        slcl[{5}].add_interval({-2, 8});
+        slcl[{1}].add_interval({2, 5});
+        slcl[{5}].add_interval({9, 10});
+        slcl[{6}].add_interval({10, 12});
+        slcl[{-3}].add_interval({0, 1});
+
+        EXPECT_EQ(LevelCellArray<dim>(lcl), LevelCellArray<dim>(slcl));
+    }
+
+    template <class TCellList>
+    void add_random_cells(TCellList& cl, std::size_t n_cells, std::mt19937& gen)
+    {
+        constexpr std::size_t dim = TCellList::dim;
+
+        std::uniform_int_distribution<std::size_t> level_dist(1, 5);
+        std::uniform_int_distribution<int> coord_dist(-40, 40);
+
+        for (std::size_t s = 0; s < n_cells; ++s)
+        {
+            auto level = level_dist(gen);
+            auto x     = coord_dist(gen);
+            auto y     = coord_dist(gen);
+
+            if constexpr (dim == 1)
+            {
+                cl[level][{}].add_interval({x, x + 3});
+            }
+            else if constexpr (dim == 2)
+            {
+                cl[level][{y}].add_interval({x, x + 3});
+            }
+            else
+            {
+                auto z = coord_dist(gen);
+                cl[level][{y, z}].add_interval({x, x + 3});
+            }
+        }
+    }
+
+    template <typename T>
+    class sorted_cell_list_random : public ::testing::Test
+    {
+    };
+
+    using sorted_cell_list_dims = ::testing::Types<std::integral_constant<std::size_t, 1>,
+                                                   std::integral_constant<std::size_t, 2>,
+                                                   std::integral_constant<std::size_t, 3>>;
+
+    TYPED_TEST_SUITE(sorted_cell_list_random, sorted_cell_list_dims, );
+
+    TYPED_TEST(sorted_cell_list_random, same_cell_array)
+    {
+        constexpr std::size_t dim = TypeParam::value;
+
+        // Same seed so that both lists receive the same cells
+        std::mt19937 gen1(42);
+        std::mt19937 gen2(42);
+
+        CellList<dim> cl;
+        SortedCellList<dim> scl;
+        add_random_cells(cl, 5000, gen1);
+        add_random_cells(scl, 5000, gen2);
+
+        CellArray<dim> ca1 = {cl};
+        CellArray<dim> ca2 = {scl};
+
+        EXPECT_EQ(ca1, ca2);
+        EXPECT_EQ(ca1.nb_cells(), ca2.nb_cells());
+    }
+
+    TYPED_TEST(sorted_cell_list_random, merge)
+    {
+        constexpr std::size_t dim = TypeParam::value;
+
+        // Lists filled by two threads, then merged as in parallel_fill
+        std::mt19937 gen1(7);
+        std::mt19937 gen2(7);
+
+        CellList<dim> cl;
+        CellList<dim> cl_other;
+        SortedCellList<dim> scl;
+        SortedCellList<dim> scl_other;
+        add_random_cells(cl, 2000, gen1);
+        add_random_cells(cl_other, 2000, gen1);
+        add_random_cells(scl, 2000, gen2);
+        add_random_cells(scl_other, 2000, gen2);
+
+        cl.merge(std::move(cl_other));
+        scl.merge(std::move(scl_other));
+
+        EXPECT_EQ(CellArray<dim>(cl), CellArray<dim>(scl));
+        for (std::size_t level = 0; level <= default_config::max_level; ++level)
+        {
+            EXPECT_TRUE(scl_other[level].empty());
+        }
+    }
+
+    template <std::size_t dim>
+    struct SortedMRConfig : public MRConfig<dim>
+    {
+        using cl_type = SortedCellList<dim>;
+    };
+
+    TYPED_TEST(sorted_cell_list_random, mr_mesh)
+    {
+        constexpr std::size_t dim = TypeParam::value;
+        using mesh_t              = MRMesh<MRConfig<dim>>;
+        using sorted_mesh_t       = MRMesh<SortedMRConfig<dim>>;
+        using mesh_id_t           = typename mesh_t::mesh_id_t;
+
+        static_assert(std::is_same_v<typename sorted_mesh_t::cl_type, SortedCellList<dim>>);
+
+        auto init = [](auto& u)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              auto center = cell.center();
+                              u[cell]     = std::tanh(50. * (xt::sum(center)() - 0.5 * dim));
+                          });
+        };
+
+        Box<double, dim> box(xt::zeros<double>({dim}), xt::ones<double>({dim}));
+        mesh_t mesh(box, 2, 5);
+        sorted_mesh_t sorted_mesh(box, 2, 5);
+        for (std::size_t id = 0; id < static_cast<std::size_t>(mesh_id_t::count); ++id)
+        {
+            EXPECT_EQ(mesh[static_cast<mesh_id_t>(id)], sorted_mesh[static_cast<mesh_id_t>(id)]);
+        }
+
+        auto u        = make_field<double, 1>("u", mesh);
+        auto u_sorted = make_field<double, 1>("u", sorted_mesh);
+        init(u);
+        init(u_sorted);
+        auto adapt        = make_MRAdapt(u);
+        auto adapt_sorted = make_MRAdapt(u_sorted);
+        adapt(1e-3, 1);
+        adapt_sorted(1e-3, 1);
+
+        for (std::size_t id = 0; id < static_cast<std::size_t>(mesh_id_t::count); ++id)
+        {
+            EXPECT_EQ(mesh[static_cast<mesh_id_t>(id)], sorted_mesh[static_cast<mesh_id_t>(id)]);
+        }
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(u[cell], u_sorted[cell]);
+                      });
+    }
+}
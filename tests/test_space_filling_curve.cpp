@@ -0,0 +1,215 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/cell_array.hpp>
+#include <samurai/cell_list.hpp>
+#include <samurai/field.hpp>
+#include <samurai/load_balancing.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/space_filling_curve.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        template <std::size_t dim>
+        void check_curve(SFCType curve, std::size_t bits, bool adjacent)
+        {
+            const std::uint64_t n  = std::uint64_t{1} << bits;
+            std::uint64_t nb_cells = 1;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                nb_cells *= n;
+            }
+
+            std::map<std::uint64_t, std::array<std::uint64_t, dim>> cells;
+            for (std::uint64_t c = 0; c < nb_cells; ++c)
+            {
+                std::array<std::uint64_t, dim> coords;
+                std::uint64_t r = c;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    coords[d] = r % n;
+                    r /= n;
+                }
+                cells[sfc_key<dim>(curve, coords, bits)] = coords;
+            }
+
+            // The curve is a bijection between the cells and [0, nb_cells)
+            ASSERT_EQ(cells.size(), nb_cells);
+            EXPECT_EQ(cells.rbegin()->first, nb_cells - 1);
+
+            if (adjacent)
+            {
+                auto previous = cells.begin()->second;
+                for (auto it = std::next(cells.begin()); it != cells.end(); ++it)
+                {
+                    long distance = 0;
+                    for (std::size_t d = 0; d < dim; ++d)
+                    {
+                        distance += std::labs(static_cast<long>(it->second[d]) - static_cast<long>(previous[d]));
+                    }
+                    EXPECT_EQ(distance, 1);
+                    previous = it->second;
+                }
+            }
+        }
+    }
+
+    TEST(space_filling_curve, keys)
+    {
+        check_curve<2>(SFCType::Morton, 4, false);
+        check_curve<3>(SFCType::Morton, 3, false);
+        check_curve<2>(SFCType::Hilbert, 4, true);
+        check_curve<3>(SFCType::Hilbert, 3, true);
+
+        EXPECT_EQ(sfc_key<2>(SFCType::Morton, {1, 0}, 2), std::uint64_t{1});
+        EXPECT_EQ(sfc_key<2>(SFCType::Morton, {0, 1}, 2), std::uint64_t{2});
+        EXPECT_EQ(sfc_key<2>(SFCType::Morton, {3, 3}, 2), std::uint64_t{15});
+    }
+
+    TEST(space_filling_curve, partition)
+    {
+        constexpr std::size_t dim = 2;
+        CellList<dim> cl;
+        for (int j = 0; j < 8; ++j)
+        {
+            cl[3][{j}].add_interval({0, 4});
+        }
+        for (int j = 0; j < 16; ++j)
+        {
+            cl[4][{j}].add_interval({8, 16});
+        }
+        CellArray<dim> ca = {cl};
+
+        auto weight = [](std::size_t level, std::size_t)
+        {
+            return level == 4 ? 2. : 1.;
+        };
+
+        for (auto curve : {SFCType::Morton, SFCType::Hilbert})
+        {
+            const std::size_t nb_parts = 5;
+            auto runs                  = sfc_partition(ca, curve, nb_parts, weight);
+
+            std::vector<double> loads(nb_parts, 0.);
+            std::size_t nb_cells = 0;
+            for (const auto& run : runs)
+            {
+                ASSERT_GE(run.rank, 0);
+                ASSERT_LT(run.rank, static_cast<int>(nb_parts));
+                loads[static_cast<std::size_t>(run.rank)] += static_cast<double>(run.end - run.start) * weight(run.level, 0);
+                nb_cells += static_cast<std::size_t>(run.end - run.start);
+
+                // The storage index follows the cells
+                const auto& interval = ca[run.level].get_interval({run.start, run.start + 1}, run.index);
+                EXPECT_EQ(run.storage, interval.index + run.start);
+            }
+            EXPECT_EQ(nb_cells, ca.nb_cells());
+
+            // Each part is balanced up to the weight of one cell
+            const double mean = (32. + 2. * 128.) / static_cast<double>(nb_parts);
+            for (double load : loads)
+            {
+                EXPECT_LE(std::abs(load - mean), 2.);
+            }
+        }
+    }
+
+    TEST(space_filling_curve, load_imbalance)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        MRMesh<config> mesh(box, 2, 4);
+        auto u = make_field<double, 1>("u", mesh);
+        u.fill(1.);
+
+        // A single process is always balanced: nothing is moved
+        EXPECT_DOUBLE_EQ(load_imbalance(mesh), 1.);
+        EXPECT_FALSE(load_balance(u));
+        EXPECT_EQ(u.array().size(), mesh.nb_cells());
+    }
+
+    TEST(space_filling_curve, migration)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+        using mesh_t              = MRMesh<config>;
+        using mesh_id_t           = typename mesh_t::mesh_id_t;
+        using cl_type             = typename mesh_t::cl_type;
+        using interval_t          = typename mesh_t::interval_t;
+        using run_t               = SFCRun<dim, interval_t>;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        mesh_t mesh(box, 2, 5);
+        auto u = make_field<double, 1>("u", mesh);
+        auto v = make_field<double, 2>("v", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          u[cell] = std::tanh(20. * (cell.center(0) + cell.center(1) - 1.));
+                      });
+        auto adapt = make_MRAdapt(u);
+        adapt(1e-3, 1);
+        v.resize();
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          v[cell][0] = cell.center(0);
+                          v[cell][1] = static_cast<double>(cell.level);
+                      });
+        ASSERT_LT(mesh[mesh_id_t::cells].min_level(), mesh[mesh_id_t::cells].max_level());
+
+        // The parts which would be sent to several processes are all received by this one
+        const std::size_t nb_parts = 4;
+        LoadBalancingOptions options;
+        auto runs                = sfc_partition(mesh[mesh_id_t::cells], options.curve, nb_parts, detail::load_balancing_weight(options));
+        auto buffers             = detail::pack_runs(runs, nb_parts, u, v);
+        std::size_t nb_non_empty = 0;
+        for (const auto& buffer : buffers)
+        {
+            nb_non_empty += buffer.empty() ? 0 : 1;
+        }
+        EXPECT_EQ(nb_non_empty, nb_parts);
+
+        cl_type cl = detail::unpack_cells<cl_type, run_t, decltype(u), decltype(v)>(buffers);
+        mesh_t new_mesh(cl, mesh);
+        EXPECT_EQ(new_mesh[mesh_id_t::cells], mesh[mesh_id_t::cells]);
+
+        auto new_u = make_field<double, 1>("u", new_mesh);
+        auto new_v = make_field<double, 2>("v", new_mesh);
+        detail::unpack_values<run_t>(buffers, new_mesh, new_u, new_v);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          auto new_cell = new_mesh.get_cell(cell.level, cell.indices[0], cell.indices[1]);
+                          EXPECT_EQ(new_u[new_cell], u[cell]);
+                          EXPECT_EQ(new_v[new_cell][0], v[cell][0]);
+                          EXPECT_EQ(new_v[new_cell][1], v[cell][1]);
+                      });
+    }
+
+    TEST(space_filling_curve, periodic_load_balance)
+    {
+        constexpr std::size_t dim = 2;
+        using config              = MRConfig<dim>;
+
+        Box<double, dim> box({0, 0}, {1, 1});
+        MRMesh<config> mesh(box, 2, 4, {true, false});
+        auto u = make_field<double, 1>("u", mesh);
+        u.fill(1.);
+
+        // A balanced mesh is left as it is, periodic or not
+        EXPECT_FALSE(load_balance(u));
+    }
+}
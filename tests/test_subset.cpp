@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/box.hpp>
+#include <samurai/cell_list.hpp>
+#include <samurai/level_cell_array.hpp>
+#include <samurai/subset/subset_op.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        template <class Set>
+        auto collect(Set& set, bool parallel)
+        {
+            std::vector<std::array<int, 4>> intervals;
+            auto add = [&](const auto& i, const auto& index)
+            {
+#pragma omp critical
+                intervals.push_back({i.start, i.end, index[0], index[1]});
+            };
+            if (parallel)
+            {
+                set.parallel_apply(add);
+            }
+            else
+            {
+                set(add);
+            }
+            std::sort(intervals.begin(), intervals.end());
+            return intervals;
+        }
+
+        auto create_lca(std::size_t level, int shift)
+        {
+            LevelCellList<3> lcl{level};
+            for (int k = 0; k < 20; ++k)
+            {
+                for (int j = 0; j < 20; ++j)
+                {
+                    lcl[{j, k}].add_interval({(j + k + shift) % 5, 10 + (j * k) % 7});
+                    lcl[{j, k}].add_interval({12 + k % 3, 15 + j % 4});
+                }
+            }
+            return LevelCellArray<3>(lcl);
+        }
+    }
+
+    TEST(subset, chunks)
+    {
+        auto lca_1 = create_lca(4, 0);
+        auto lca_2 = create_lca(4, 2);
+
+        auto set    = intersection(lca_1, lca_2);
+        auto ranges = set.chunks(7);
+
+        ASSERT_FALSE(ranges.empty());
+        EXPECT_LE(ranges.size(), 7);
+        EXPECT_EQ(ranges.front().first, 0);
+        EXPECT_EQ(ranges.back().second, 20);
+        for (std::size_t c = 0; c < ranges.size(); ++c)
+        {
+            EXPECT_LT(ranges[c].first, ranges[c].second);
+            if (c > 0)
+            {
+                EXPECT_EQ(ranges[c - 1].second, ranges[c].first);
+            }
+        }
+    }
+
+    TEST(subset, parallel_apply)
+    {
+        auto lca_1 = create_lca(4, 0);
+        auto lca_2 = create_lca(4, 2);
+        auto lca_3 = create_lca(3, 1);
+
+        auto set_1 = intersection(lca_1, lca_2);
+        EXPECT_EQ(collect(set_1, false), collect(set_1, true));
+
+        auto set_2 = difference(union_(lca_1, lca_2), lca_3).on(4);
+        EXPECT_EQ(collect(set_2, false), collect(set_2, true));
+
+        auto set_3 = intersection(lca_1, lca_3).on(3);
+        EXPECT_EQ(collect(set_3, false), collect(set_3, true));
+
+        auto set_4 = union_(lca_1, lca_3).on(5);
+        EXPECT_EQ(collect(set_4, false), collect(set_4, true));
+    }
+}